@@ -0,0 +1,529 @@
+/* bandfac.c
+   Banded matrix factorization and solution.   */
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+#include "cmath.h"
+#include <stdio.h>
+#ifndef NULL
+#define NULL 0
+#endif
+
+#define  MIN(arg1,arg2)  ( ((arg1) < (arg2)) ? (arg1) : (arg2) )
+#define  WINDEX(i,j,rowl)  ((i) * (rowl) + (j))
+
+/* Row r of the band matrix, indexed by the column of A, so that
+   A(r,c) is BROW(r)[c].  The pointer lies within w for every r.  */
+#define  BROW(r)  (w + (long) (r) * (ndim - 1) + middle)
+
+/* bandfac() eliminates BANDFAC_KB columns at a time, so that each
+   element of the trailing part of the band is read and written once
+   for every BANDFAC_KB pivots rather than for every pivot.
+   bfpanel() is written for BANDFAC_KB = 4.  */
+#define  BANDFAC_KB  4
+
+/* bandslvm() works on strips of BANDSLV_NB right hand sides,
+   shared among threads when compiled for OpenMP.  */
+#define  BANDSLV_NB  64
+
+/*-----------------------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static int bfpanel (double *w, int ndim, int n, int nbandl, int nbandu,
+                    int k0)
+
+#else
+
+static int bfpanel (w, ndim, n, nbandl, nbandu, k0)
+
+double  *w;
+int     ndim, n, nbandl, nbandu, k0;
+
+#endif
+
+/* Purpose ...
+   -------
+   Eliminate columns k0 .. k0+3 of the band matrix, k0+4 < n.
+   The rows affected are taken one at a time: the multipliers of
+   the row are found and the row is then updated by all four pivot
+   rows at once.  Returns 1 if a pivot is zero, 0 otherwise.
+*/
+
+{
+int    middle, k, k1, r, c, rmax, cmax, cfull;
+double t, l[BANDFAC_KB], *pk, *pr, *p0, *p1, *p2, *p3;
+
+middle = nbandl;
+k1 = k0 + BANDFAC_KB;
+p0 = BROW(k0);
+p1 = BROW(k0 + 1);
+p2 = BROW(k0 + 2);
+p3 = BROW(k0 + 3);
+rmax  = MIN(k1 - 1 + nbandl, n - 1);
+cfull = MIN(k0 + nbandu, n - 1);
+cmax  = MIN(k1 - 1 + nbandu, n - 1);
+
+for (r = k0; r <= rmax; ++r)
+   {
+   pr = BROW(r);
+
+   /* Multipliers for the pivots above row r, and the update of
+      the panel columns.  Multipliers outside the band are zero. */
+   for (k = k0; k < k1 && k < r; ++k)
+      {
+      if (r > k + nbandl)
+         {
+         l[k - k0] = 0.0;
+         continue;
+         }
+      pk = BROW(k);
+      t = pr[k] / pk[k];
+      pr[k] = t;
+      l[k - k0] = t;
+      for (c = k + 1; c <= MIN(k + nbandu, k1 - 1); ++c) pr[c] -= t * pk[c];
+      }
+
+   if (r < k1)
+      {
+      /* A pivot row: its pivot is now final, and its part right
+         of the panel is updated by the pivot rows above it. */
+      if (pr[r] == 0.0) return (1);
+      for (k = k0; k < r; ++k)
+         {
+         if (r > k + nbandl) continue;
+         t = l[k - k0];
+         pk = BROW(k);
+         for (c = k1; c <= MIN(k + nbandu, n - 1); ++c) pr[c] -= t * pk[c];
+         }
+      }
+   else
+      {
+      /* Rank-4 update.  Elements of U outside the band of a pivot
+         row are zero, which only affects the last three columns. */
+      for (c = k1; c <= cfull; ++c)
+         pr[c] -= l[0] * p0[c] + l[1] * p1[c] + l[2] * p2[c] + l[3] * p3[c];
+      for (c = (cfull + 1 > k1) ? cfull + 1 : k1; c <= cmax; ++c)
+         {
+         t = l[3] * p3[c];
+         if (c <= k0 + 2 + nbandu) t += l[2] * p2[c];
+         if (c <= k0 + 1 + nbandu) t += l[1] * p1[c];
+         pr[c] -= t;
+         }
+      }
+   }
+
+return (0);
+}
+
+/*-----------------------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int  bandfac (double *w, int ndim, int n, int nbandl,
+             int nbandu, int *flag)
+
+#else
+
+int  bandfac (w, ndim, n, nbandl, nbandu, flag)
+
+double  *w;
+int     ndim, n, nbandl, nbandu, *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Returns in w the lu-factorization (obtained without pivoting), of the
+   banded matrix A of order n with (nbandl + 1 + nbandu) bands or columns
+   in the work array w.
+
+   Input ...
+   -----
+   w         :  Work array of size (n, ndim) containing the
+                interesting part of a banded matrix A, with the diagonals
+                of A stored in the columns of w, while rows of A
+                correspond to rows of w.
+                Generally, each row of A has
+                   nbandl bands left (below) of the diagonal,
+                   1 main diagonal,
+                   nbandu bands right (above) of the diagonal,
+                and thus, with middle = nbandl,
+                A (i+j,j) is in w(j,i+middle) for i = -nbandl,....,nbandu
+                                                  j = 0,....,n-1.
+                All other entries of w not referenced in this way with an
+                entry of A are never referenced.
+   ndim      :  Row length of the work array w, must be
+                ndim >= nbandl + 1 + nbandu
+   n         :  Number of rows in the banded matrix.
+                i.e. the order of the matrix
+   nbandl    :  Number of bands of A below the main diagonal.
+   nbandu    :  Number of bands of A above the main diagonal.
+
+   Output ...
+   -----
+   flag      :  Integer indicating success or failure.
+                If flag = 1, one of the pivots was found to be zero
+                indicating that A does not have an LU-factorization.
+                If flag = 2, the number of rows, n, was < 1.
+                If flag = 3, the last diagonal term was zero.
+   w         :  Contains the lu-factorization of A into a unit lower triangular
+                matrix l and an upper triangular matrix u (both banded) and
+                stored over the corresponding entries of A.  This makes it
+                possible to solve any particular linear system A*x = b for x by
+                a call of bandslv (w, ndim, n, nbandl, nbandu, b)
+                with the solution x contained in b on return.
+
+
+   This C code written by ...  Nigel and Peter,
+   ----------------------      Design Software,
+                               42 Gubberley St,
+                               KENMORE, 4069,
+                               AUSTRALIA.
+
+   Version ...  1.0  FORTRAN, 1987.
+   -------      2.0  September, 1989.
+                2.1  14 October, 1989.  pj changed the addressing slightly
+                                        (and a few other bits and pieces)
+                2.2  19 October, 2026.  eliminate 4 columns at a time
+
+   Notes  ...
+   -----
+   (1)  Gaussian elimination without pivoting is used.  The routine is
+        intended for use with matrices A which do not require row interchanges
+        during factorization, especially for the totally positive matrices
+        which occur in spline calculations.
+        NOT FOR USE WITH ARBITRARY BANDED MATRICES.
+
+   (2)  Adapted from the FORTRAN code in:
+        de Boor, C.  A Practical Guide to Splines.  Applied Mathematical
+        Sciences Vol. 27.  Springer-Verlag, New York.  1978.
+
+   (3)  When the matrix has bands both sides of the diagonal, the
+        columns are eliminated BANDFAC_KB at a time by bfpanel(), and
+        each row below is given one rank-BANDFAC_KB update, with an
+        inner loop along the row of w that may be vectorized.  For wide
+        bands this is several times faster than one column at a time.
+        The factors differ from those of version 2.1 only by rounding.
+
+*/
+/*-------------------------------------------------------------------------*/
+
+{  /*  Beginning of procedure bandfac().  */
+int    i, j, jmax, k, kmax, middle;
+double factor, pivot;
+
+*flag = 0;
+/*for (i = 0; i < n; i++) for (j = 0; j < ndim; j++)
+  printf ("w[%d] [%d] = %f\n", i, j, w[WINDEX(i,j,ndim)]);*/
+
+/* Check user input. */
+if (n < 1 || w == NULL || /*n < ndim ||*/ ndim < nbandl+1+nbandu)
+   {
+   *flag = 1;
+   return (1);
+   }
+
+/* w(.,middle) contains the main diagonal of A. */
+middle = nbandl;
+
+if ( n > 1 )
+   {
+   /* we have a nontrivial case */
+   if ( nbandl <= 0 )
+      {
+      /*  a is upper triangular, check that diagonal is nonzero. */
+      for ( i = 0; i < n-1; i++)
+         {
+         if ( w[WINDEX(i,middle,ndim)] == 0.0 )
+            {
+            *flag = 2;
+            return (2);
+            }
+         }
+      }
+   else if ( nbandu <= 0 )
+      {
+      /*  a is lower triangular.
+          Check that diagonal is nonzero and divide each element
+          in the column below the diagonal by the diagonal.
+          This than becomes the multiplier to be saved for
+          the forward pass in bandslv(). */
+      for ( i = 0; i < n-1; i++)
+         {
+         pivot = w[WINDEX(i,middle,ndim)];
+         if ( pivot == 0.0 )
+            {
+            *flag = 2;
+            return (2);
+            }
+         jmax = MIN(nbandl, n - 1 - i);
+         for ( j = 1; j <= jmax; j++)
+            w[WINDEX(i+j,middle-j,ndim)] /= pivot;
+         }
+      }
+   else
+      {
+      /*  a is not just a triangular matrix.
+          Construct lu-factorization, BANDFAC_KB columns at a time
+          and then one at a time for the last few. */
+      for ( i = 0; i + BANDFAC_KB < n; i += BANDFAC_KB)
+         {
+         if (bfpanel (w, ndim, n, nbandl, nbandu, i) != 0)
+            {
+            *flag = 2;
+            return (2);
+            }
+         }
+
+      for ( ;  i < n-1;  i++)
+         {
+         /*  The diagonal, w(i,middle) is pivot for i-th step.*/
+         pivot = w[WINDEX(i,middle,ndim)];
+         if ( pivot == 0.0 )
+            {
+            *flag = 2;
+            return (2);
+            }
+
+         jmax = MIN(nbandl, n - 1 - i);  /* jmax is the number of (nonzero)
+                                            entries in column i below the
+                                            diagonal.*/
+         kmax = MIN(nbandu, n - 1 - i);  /* kmax is the number of (nonzero)
+                                            entries in row i to the
+                                            right of the diagonal.*/
+
+         for (j = 1; j <= jmax; j++)
+            {
+            /* divide each entry in column i below the diagonal by pivot.
+               This is the multiplier that is used in the forward
+               elimination.  It needs to be remembered for bandslv(). */
+            factor = w[WINDEX(i+j,middle-j,ndim)] / pivot;
+            w[WINDEX(i+j,middle-j,ndim)] = factor;
+
+            /* Subtract a(i,i+k)*(i-th column multiplier) from
+               (i+k)-th column below row i.*/
+            for ( k = 1; k <= kmax; k++)
+               w[WINDEX(i+j,middle-j+k,ndim)] -=
+                              w[WINDEX(i,middle+k,ndim)] * factor;
+            }
+
+         }     /* all number rows minus 1. */
+      }        /* end of LU factorization */
+
+   }  /* end of nontrivial case */
+
+/*  check last diagonal entry.  */
+if ( w[WINDEX(n-1,middle,ndim)] == 0.0 )
+   {
+   *flag = 3;
+   return (3);
+   }
+
+return (0);
+}  /*  End of bandfac().  */
+
+/*------------------------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int bandslv (double *w, int ndim, int n, int nbandl, int nbandu,
+               double b[])
+
+#else
+
+int bandslv (w, ndim, n, nbandl, nbandu, b)
+
+double  *w;
+int     ndim, n, nbandl, nbandu;
+double  b[];
+
+#endif
+
+/* Purpose ...
+   -------
+   Companion routine to bandfac.  It returns the solution x of the
+   linear system A*x = b in place of b, given the lu-factorization
+   for A in the work array w.
+
+   Input ...
+   -----
+   w,
+   ndim,
+   n,
+   nbandl,
+   nbandu    :  Describe the lu-factorization of a
+                banded matrix A of order n as constructed in bandfac.
+                For details see banfac.
+   b         :  Right hand side of the system to be solved.
+
+   Output ...
+   ------
+   b         :  Contains the solution x, of order n.
+
+   Notes ...
+   -----
+   (1)  With A = l*u as stored in w, the unit lower triangular system l(u*x) = b
+        is solved for y =u*x, and y stored in b.  Then the upper triangular
+        system u*x = y is solved for x.  The calculations are so
+        arranged that the innermost loops stay within columns.
+
+   (2)  Adapted from the FORTRAN code in:
+        de Boor, C.  A Practical Guide to Splines.  Applied Mathematical
+        Sciences Vol. 27.  Springer-Verlag, New York.  1978.
+
+*/
+/*-------------------------------------------------------------------------*/
+
+{  /*  Beginning of procedure bandslv().  */
+
+int    i, j, jmax, middle;
+
+middle = nbandl;
+
+if (n == 1)
+   {  /* this is our trivial one element case */
+   b[0] /= w[0];   /* just divide by the only diagonal element */
+   return (0);
+   }
+
+if ( nbandl != 0 )
+   {
+   /* Forward pass.
+      for i = 0, 1,....,n-2, subtract right side(i)*(i-th column of l)
+      from right side (below i-th row) */
+   for ( i = 0; i < n-1; i++)
+      {
+      jmax = MIN (nbandl, n-1-i);
+      for (j = 1; j <= jmax; j++)
+         b[i+j] -= b[i] * w[WINDEX(i+j,middle-j,ndim)];
+      }
+   }
+
+/*  backward pass.
+   for i = n, n-1,....,1, divide right side(i) by i-th diagonal
+   entry of u, then subtract right side(i)*(i-th column of u) from right side
+   (above i-th row)*/
+
+if ( nbandu == 0 )
+   {
+   /* a is lower triangular and the forward elimination has been done,
+      so just divide the RHS vector by the diagonal elements */
+   for ( i = 0; i < n; i ++)
+      {
+      b[i] /= w[WINDEX(i,middle,ndim)];
+      }
+   return (0);
+   }
+
+/* Backsubstitution in earnest. */
+for ( i = n-1; i >= 0; i--)
+   {
+   b[i] /= w[WINDEX(i,middle,ndim)];
+   jmax = MIN (nbandu, i);
+   for ( j = 1; j <= jmax; j++)
+      b[i-j] -= b[i] * w[WINDEX(i-j,middle+j,ndim)];
+   }
+
+return (0);
+}  /*  End of procedure bandslv().  */
+/*-------------------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int bandslvm (double *w, int ndim, int n, int nbandl, int nbandu,
+              int nrhs, int bdim, double *b)
+
+#else
+
+int bandslvm (w, ndim, n, nbandl, nbandu, nrhs, bdim, b)
+
+double  *w;
+int     ndim, n, nbandl, nbandu, nrhs, bdim;
+double  *b;
+
+#endif
+
+/* Purpose ...
+   -------
+   Companion routine to bandfac() which solves A*X = B for several
+   right hand sides at once.
+
+   Input ...
+   -----
+   w, ndim, n,
+   nbandl,
+   nbandu    :  the lu-factorization of A from bandfac().
+   nrhs      :  number of right hand sides
+   bdim      :  row dimension of b, bdim >= nrhs
+   b         :  the n by nrhs matrix of right hand sides, one per
+                column, b[i*bdim + j] = element i of column j
+
+   Output ...
+   ------
+   b         :  the solutions, in place of the right hand sides
+
+   Version ...  1.0  19 October, 2026.
+   -------
+
+   Notes ...
+   -----
+   (1)  The operations are those of bandslv() on each column of b, but
+        the inner loops run along the rows of b, and each element of w
+        is read once per strip of BANDSLV_NB columns.
+   (2)  If compiled with OpenMP, the strips are shared among threads.
+*/
+/*-------------------------------------------------------------------------*/
+
+{  /*  Beginning of procedure bandslvm().  */
+
+int    i, j, jmax, r, jj, jb, middle;
+double t, *bi, *bj;
+
+middle = nbandl;
+if (n < 1 || nrhs < 1) return (0);
+
+#if (PARALLEL)
+#pragma omp parallel for schedule(dynamic) \
+        private(jb, i, j, jmax, r, t, bi, bj)
+#endif
+for (jj = 0; jj < nrhs; jj += BANDSLV_NB)
+   {
+   jb = (jj + BANDSLV_NB < nrhs) ? jj + BANDSLV_NB : nrhs;
+
+   /* Forward pass with the unit lower triangle. */
+   for (i = 0; i < n-1 && nbandl > 0; i++)
+      {
+      bi = b + (long) i * bdim;
+      jmax = MIN (nbandl, n-1-i);
+      for (j = 1; j <= jmax; j++)
+         {
+         t  = w[WINDEX(i+j,middle-j,ndim)];
+         bj = bi + (long) j * bdim;
+         for (r = jj; r < jb; ++r) bj[r] -= bi[r] * t;
+         }
+      }
+
+   /* Backward pass with the upper triangle. */
+   for (i = n-1; i >= 0; i--)
+      {
+      bi = b + (long) i * bdim;
+      t  = w[WINDEX(i,middle,ndim)];
+      for (r = jj; r < jb; ++r) bi[r] /= t;
+      jmax = MIN (nbandu, i);
+      for (j = 1; j <= jmax; j++)
+         {
+         t  = w[WINDEX(i-j,middle+j,ndim)];
+         bj = bi - (long) j * bdim;
+         for (r = jj; r < jb; ++r) bj[r] -= bi[r] * t;
+         }
+      }
+   }
+
+return (0);
+}  /*  End of procedure bandslvm().  */
+/*-------------------------------------------------------------------------*/
@@ -0,0 +1,399 @@
+/* bdecomp.c
+   Gaussian elimination for a batch of small matrices, all of
+   the same order, stored interleaved.  */
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+#include "cmath.h"
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+/*-----------------------------------------------------------------*/
+
+/* The systems are taken BDECOMP_LANES at a time.  Element (i,j) of
+   system p is at a[(i*n + j)*stride + p], so that the innermost
+   loops run over consecutive systems and may be vectorized by the
+   compiler.  The kernel bodies are generated by the macros below
+   with the order N known at compile time for the common small
+   sizes, and with N = n for the rest.  */
+
+#define  BDECOMP_LANES  8
+
+#define  BA(i,j)  a[((i) * nc + (j)) * s + p]
+#define  BP(k)    pivot[(k) * s + p]
+#define  BB(i)    b[(i) * s + p]
+
+/* Factor systems p0 .. p1-1 as decomp() would, leaving the
+   factors and pivots of each in the same form.  Returns the
+   number of systems found singular.  */
+
+#define  BDC_BODY(N)                                                 \
+{                                                                    \
+int    i, j, k, m, p, nc, nsing, mk[BDECOMP_LANES];                  \
+double t, pv[BDECOMP_LANES], anorm[BDECOMP_LANES];                   \
+                                                                     \
+nc    = N;                                                           \
+nsing = 0;                                                           \
+a += p0; pivot += p0; p1 -= p0;                                      \
+                                                                     \
+/* 1-norm of each matrix, and +1 for the interchange count */        \
+for (p = 0; p < p1; ++p) { anorm[p] = 0.0; BP(N-1) = 1; }            \
+for (j = 0; j < N; ++j)                                              \
+   {                                                                 \
+   for (p = 0; p < p1; ++p) pv[p] = 0.0;                             \
+   for (i = 0; i < N; ++i)                                           \
+      for (p = 0; p < p1; ++p) pv[p] += fabs(BA(i,j));               \
+   for (p = 0; p < p1; ++p) if (pv[p] > anorm[p]) anorm[p] = pv[p];  \
+   }                                                                 \
+for (p = 0; p < p1; ++p) anorm[p] *= EPSILON;                        \
+                                                                     \
+for (k = 0; k < N-1; ++k)                                            \
+   {                                                                 \
+   /* find the pivot row of each system */                           \
+   for (p = 0; p < p1; ++p) { mk[p] = k; pv[p] = fabs(BA(k,k)); }    \
+   for (i = k+1; i < N; ++i)                                         \
+      for (p = 0; p < p1; ++p)                                       \
+         {                                                           \
+         t = fabs(BA(i,k));                                          \
+         if (t > pv[p]) { mk[p] = i; pv[p] = t; }                    \
+         }                                                           \
+                                                                     \
+   /* interchange, one system at a time */                           \
+   for (p = 0; p < p1; ++p)                                          \
+      {                                                              \
+      m = mk[p];                                                     \
+      BP(k) = m;                                                     \
+      if (m == k) continue;                                          \
+      BP(N-1) = -BP(N-1);                                            \
+      for (j = k; j < N; ++j)                                        \
+         { t = BA(m,j); BA(m,j) = BA(k,j); BA(k,j) = t; }            \
+      }                                                              \
+                                                                     \
+   /* a small pivot marks the system singular; carry on with */      \
+   /* a unit pivot to keep the arithmetic finite             */      \
+   for (p = 0; p < p1; ++p)                                          \
+      {                                                              \
+      pv[p] = BA(k,k);                                               \
+      if (fabs(pv[p]) < anorm[p] || pv[p] == 0.0)                    \
+         {                                                           \
+         if (BP(N-1) != 0) { BP(N-1) = 0; ++nsing; }                 \
+         pv[p] = 1.0;                                                \
+         }                                                           \
+      }                                                              \
+                                                                     \
+   /* compute multipliers and eliminate */                           \
+   for (i = k+1; i < N; ++i)                                         \
+      for (p = 0; p < p1; ++p) BA(i,k) = -BA(i,k) / pv[p];           \
+   for (i = k+1; i < N; ++i)                                         \
+      for (j = k+1; j < N; ++j)                                      \
+         for (p = 0; p < p1; ++p) BA(i,j) += BA(i,k) * BA(k,j);      \
+   }                                                                 \
+                                                                     \
+for (p = 0; p < p1; ++p)                                             \
+   {                                                                 \
+   t = BA(N-1,N-1);                                                  \
+   if ((fabs(t) < anorm[p] || t == 0.0) && BP(N-1) != 0)             \
+      { BP(N-1) = 0; ++nsing; }                                      \
+   }                                                                 \
+return (nsing);                                                      \
+}
+
+/* Forward elimination and back substitution for systems
+   p0 .. p1-1, as solve() would.  */
+
+#define  BSV_BODY(N)                                                 \
+{                                                                    \
+int    i, k, m, p, nc;                                               \
+double t, x[BDECOMP_LANES];                                          \
+                                                                     \
+nc = N;                                                              \
+a += p0; pivot += p0; b += p0; p1 -= p0;                             \
+                                                                     \
+for (k = 0; k < N-1; ++k)                                            \
+   {                                                                 \
+   for (p = 0; p < p1; ++p)                                          \
+      {                                                              \
+      m = BP(k);                                                     \
+      t = BB(m); BB(m) = BB(k); BB(k) = t;                           \
+      }                                                              \
+   for (i = k+1; i < N; ++i)                                         \
+      for (p = 0; p < p1; ++p) BB(i) += BA(i,k) * BB(k);             \
+   }                                                                 \
+                                                                     \
+for (k = N-1; k >= 0; --k)                                           \
+   {                                                                 \
+   for (p = 0; p < p1; ++p) x[p] = BB(k);                            \
+   for (i = k+1; i < N; ++i)                                         \
+      for (p = 0; p < p1; ++p) x[p] -= BA(k,i) * BB(i);              \
+   for (p = 0; p < p1; ++p) BB(k) = x[p] / BA(k,k);                  \
+   }                                                                 \
+}
+
+#if (PROTOTYPE)
+
+static int bdc2 (int s, int p0, int p1, double *a, int *pivot)
+BDC_BODY (2)
+static int bdc3 (int s, int p0, int p1, double *a, int *pivot)
+BDC_BODY (3)
+static int bdc4 (int s, int p0, int p1, double *a, int *pivot)
+BDC_BODY (4)
+static int bdc5 (int s, int p0, int p1, double *a, int *pivot)
+BDC_BODY (5)
+static int bdc6 (int s, int p0, int p1, double *a, int *pivot)
+BDC_BODY (6)
+static int bdc8 (int s, int p0, int p1, double *a, int *pivot)
+BDC_BODY (8)
+static int bdcn (int n, int s, int p0, int p1, double *a, int *pivot)
+BDC_BODY (n)
+
+static void bsv2 (int s, int p0, int p1, double *a, int *pivot, double *b)
+BSV_BODY (2)
+static void bsv3 (int s, int p0, int p1, double *a, int *pivot, double *b)
+BSV_BODY (3)
+static void bsv4 (int s, int p0, int p1, double *a, int *pivot, double *b)
+BSV_BODY (4)
+static void bsv5 (int s, int p0, int p1, double *a, int *pivot, double *b)
+BSV_BODY (5)
+static void bsv6 (int s, int p0, int p1, double *a, int *pivot, double *b)
+BSV_BODY (6)
+static void bsv8 (int s, int p0, int p1, double *a, int *pivot, double *b)
+BSV_BODY (8)
+static void bsvn (int n, int s, int p0, int p1, double *a, int *pivot,
+                  double *b)
+BSV_BODY (n)
+
+#else
+
+static int bdc2 (s, p0, p1, a, pivot)
+int s, p0, p1; double *a; int *pivot;
+BDC_BODY (2)
+static int bdc3 (s, p0, p1, a, pivot)
+int s, p0, p1; double *a; int *pivot;
+BDC_BODY (3)
+static int bdc4 (s, p0, p1, a, pivot)
+int s, p0, p1; double *a; int *pivot;
+BDC_BODY (4)
+static int bdc5 (s, p0, p1, a, pivot)
+int s, p0, p1; double *a; int *pivot;
+BDC_BODY (5)
+static int bdc6 (s, p0, p1, a, pivot)
+int s, p0, p1; double *a; int *pivot;
+BDC_BODY (6)
+static int bdc8 (s, p0, p1, a, pivot)
+int s, p0, p1; double *a; int *pivot;
+BDC_BODY (8)
+static int bdcn (n, s, p0, p1, a, pivot)
+int n, s, p0, p1; double *a; int *pivot;
+BDC_BODY (n)
+
+static void bsv2 (s, p0, p1, a, pivot, b)
+int s, p0, p1; double *a; int *pivot; double *b;
+BSV_BODY (2)
+static void bsv3 (s, p0, p1, a, pivot, b)
+int s, p0, p1; double *a; int *pivot; double *b;
+BSV_BODY (3)
+static void bsv4 (s, p0, p1, a, pivot, b)
+int s, p0, p1; double *a; int *pivot; double *b;
+BSV_BODY (4)
+static void bsv5 (s, p0, p1, a, pivot, b)
+int s, p0, p1; double *a; int *pivot; double *b;
+BSV_BODY (5)
+static void bsv6 (s, p0, p1, a, pivot, b)
+int s, p0, p1; double *a; int *pivot; double *b;
+BSV_BODY (6)
+static void bsv8 (s, p0, p1, a, pivot, b)
+int s, p0, p1; double *a; int *pivot; double *b;
+BSV_BODY (8)
+static void bsvn (n, s, p0, p1, a, pivot, b)
+int n, s, p0, p1; double *a; int *pivot; double *b;
+BSV_BODY (n)
+
+#endif
+
+#undef  BA
+#undef  BP
+#undef  BB
+#undef  BDC_BODY
+#undef  BSV_BODY
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int bdecomp (int n, int nbatch, int stride,
+             double *a, int *pivot, int *flag)
+
+#else
+
+int bdecomp (n, nbatch, stride, a, pivot, flag)
+
+int    n, nbatch, stride;
+double *a;
+int    *pivot, *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Decompose each of a batch of small real matrices by gaussian
+   elimination with partial pivoting.  Use bsolve() to compute
+   solutions to the linear systems.
+
+   Input ...
+   -----
+   n      : order of each matrix
+   nbatch : number of matrices
+   stride : the distance between successive elements of one
+            matrix, stride >= nbatch.  Element (i,j) of matrix p,
+            0 <= p < nbatch, is a[(i*n + j)*stride + p]
+   a      : the matrices to be triangularized
+
+   Output ...
+   ------
+   a      : the factors of each matrix, in the form left by decomp()
+   pivot  : the pivot vectors, element k for matrix p in
+            pivot[k*stride + p].
+            pivot[(n-1)*stride + p] = (-1)**(number of interchanges)
+            or 0 if matrix p is singular to working precision.
+   flag   : status indicator
+            = 0, normal return
+            = 2, illegal user input n < 1, nbatch < 1,
+                 stride < nbatch, a == NULL, pivot == NULL
+            = 3, one or more of the matrices is singular;
+                 the others have been factored
+
+   This C code written by ...  Peter & Nigel,
+   ----------------------      Design Software,
+                               42 Gubberley St,
+                               Kenmore, 4069,
+                               Australia.
+
+   Version ... 1.0,  19 October 2026
+   -------
+
+   Notes ...
+   -----
+   (1) The elimination for each matrix is the unblocked one of
+       decomp(), so that for n <= DECOMP_NB (96) the factors,
+       pivots and determinant are the same as from decomp().  For
+       larger n, decomp() accumulates its updates in a different
+       order and the results may differ by rounding.  No
+       condition estimate is made; singularity is tested with the
+       pivot against EPSILON times the 1-norm of the matrix.
+   (2) No workspace is allocated.  The matrices are worked on in
+       groups of BDECOMP_LANES, with the loops over the systems of
+       a group innermost.  Orders 2 to 6 and 8 have kernels with
+       the order fixed at compile time.
+   (3) If compiled with OpenMP, the groups are shared among
+       threads.
+*/
+
+/*-----------------------------------------------------------------*/
+
+{  /* begin bdecomp() */
+int p0, p1, nsing;
+
+*flag = 0;
+if (n < 1 || nbatch < 1 || stride < nbatch || a == NULL || pivot == NULL)
+   {
+   *flag = 2;
+   return (0);
+   }
+
+nsing = 0;
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(p1) \
+        reduction(+:nsing) if ((long) nbatch * n * n * n > 65536L)
+#endif
+for (p0 = 0; p0 < nbatch; p0 += BDECOMP_LANES)
+   {
+   p1 = (p0 + BDECOMP_LANES < nbatch) ? p0 + BDECOMP_LANES : nbatch;
+   switch (n)
+      {
+      case 2  : nsing += bdc2 (stride, p0, p1, a, pivot); break;
+      case 3  : nsing += bdc3 (stride, p0, p1, a, pivot); break;
+      case 4  : nsing += bdc4 (stride, p0, p1, a, pivot); break;
+      case 5  : nsing += bdc5 (stride, p0, p1, a, pivot); break;
+      case 6  : nsing += bdc6 (stride, p0, p1, a, pivot); break;
+      case 8  : nsing += bdc8 (stride, p0, p1, a, pivot); break;
+      default : nsing += bdcn (n, stride, p0, p1, a, pivot);
+      }
+   }
+
+if (nsing > 0) *flag = 3;
+return (0);
+}  /* end of bdecomp() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int bsolve (int n, int nbatch, int stride,
+            double *a, int *pivot, double *b)
+
+#else
+
+int bsolve (n, nbatch, stride, a, pivot, b)
+
+int    n, nbatch, stride;
+double *a;
+int    *pivot;
+double *b;
+
+#endif
+
+/* Purpose ...
+   -------
+   Solve each of the batch of linear systems a * x = b
+   factored by bdecomp().
+   The solutions for singular matrices are meaningless.
+
+   Input ...
+   -----
+   n, nbatch, stride, a, pivot : as passed to and returned by
+            bdecomp()
+   b      : the right hand sides, element i for system p
+            in b[i*stride + p]
+
+   Output ...
+   ------
+   b      : the solution vectors, stored as for the right hand sides
+*/
+
+/*-----------------------------------------------------------------*/
+
+{  /* begin bsolve() */
+int p0, p1;
+
+if (n < 1 || nbatch < 1) return (0);
+
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(p1) \
+        if ((long) nbatch * n * n > 65536L)
+#endif
+for (p0 = 0; p0 < nbatch; p0 += BDECOMP_LANES)
+   {
+   p1 = (p0 + BDECOMP_LANES < nbatch) ? p0 + BDECOMP_LANES : nbatch;
+   switch (n)
+      {
+      case 2  : bsv2 (stride, p0, p1, a, pivot, b); break;
+      case 3  : bsv3 (stride, p0, p1, a, pivot, b); break;
+      case 4  : bsv4 (stride, p0, p1, a, pivot, b); break;
+      case 5  : bsv5 (stride, p0, p1, a, pivot, b); break;
+      case 6  : bsv6 (stride, p0, p1, a, pivot, b); break;
+      case 8  : bsv8 (stride, p0, p1, a, pivot, b); break;
+      default : bsvn (n, stride, p0, p1, a, pivot, b);
+      }
+   }
+
+return (0);
+}  /* end of bsolve() */
+
+/*-----------------------------------------------------------------*/
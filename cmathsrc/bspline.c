@@ -0,0 +1,1654 @@
+/*  bspline.c
+    Calculation of B-spline control points for a given (x, y) data set.
+*/
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include "cmath.h"
+#if (STDLIBH)
+#include <stdlib.h>
+#endif
+
+/*-----------------------------------------------------------------*/
+
+#define  INDEX(i,j,rowl)  ((i) * (rowl) + (j))
+
+/*  When compiled for OpenMP (PARALLEL in cmath.h), bsplsq() splits
+    the data into as many as BSPLSQ_NBLK blocks of at least
+    BSPLSQ_BPTS points.  Each block is accumulated by a separate
+    thread into its own normal equations, which are then added.  */
+
+#define  BSPLSQ_NBLK  16
+#define  BSPLSQ_BPTS  4096
+
+/*  Workspace used by the old-style interv(), bsplvb() and bseval(),
+    which keep their search and recursion state between calls.
+    Routines wanting to run concurrently should use the ...w()
+    versions with a BSPLWORK structure of their own.  */
+
+static struct BSPLWORK  Bsplwork;
+
+
+/*---------------------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int  bspline (int number_of_data, double xdata[], double ydata[], int order,
+              struct BSPLSTRC *xbspl, struct BSPLSTRC *ybspl, int *flag)
+
+#else
+
+int  bspline (number_of_data, xdata, ydata, order, xbspl, ybspl, flag)
+
+int number_of_data;
+double xdata[], ydata[];
+int order;
+struct BSPLSTRC *xbspl;
+struct BSPLSTRC *ybspl;
+int *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Calculates the control points for the B-spline curve passing through the
+   data supplied.  Knot points are at the data points with the exception of
+   the first and last segments, where one data point is within the segment
+   to supply problem closure (i.e.  the end conditions).
+
+
+   Input ...
+   -----
+   number_of_data  :  number of (x, y) data points.
+   xdata[]         :  x data points, in order of occurence.
+   ydata[]         :  y data points, in order of occurence.
+   order           :  order of spline to be fitted to the data, must be
+                     <= number_of_data.
+
+   Output ...
+   ------
+   xbspl     :  Structure containing the definition of the x coordinate of
+                the fitted B-spline.
+   ybspl     :  Structure containing the definition of the y coordinate of
+                the fitted B-spline.
+   *flag     :  Status flag.
+                flag = 0  Successful completion of bspline().
+                flag = 1  Unable to allocate memory.
+                flag = 2  Parameter value outside range of knot vector.
+                flag = 3  Unable to factorize banded matrix.
+
+
+
+   This C code written by ...   Nigel and Peter.
+   ----------------------       Design Software
+                                42 Gubberley Street,
+                                KENMORE, QLD, 4069.
+                                AUSTRALIA.
+
+   Version ...   1.0, July 1989.
+   -------       2.0, October 1989.  Use structures.
+                 2.1, February, 1990.  Correct return flags.
+                      25 June, 1990.  Correct assignment of knots[number_cpnts].
+                 2.2, October, 2026.  Local workspace, reentrant.
+
+   Notes ...
+   -----
+
+   (1)  Uses the CMATH routines intervw(), bsplvbw(), bandfac(), bandslv().
+
+   (2)  The workspace for bsplvbw() is local to this routine, so bspline()
+        neither needs bsplinit() nor disturbs the workspace set up by it.
+
+*/
+/*-------------------------------------------------------------------------*/
+
+{  /*  Beginning of procedure bspline().  */
+int     i, j, number_cpnts, numberknots, band_width;
+int     index, left;
+double  *pval, *band, *bvector, *knots;
+double  sum, float1, float2;
+struct  BSPLWORK  work;
+
+
+/*
+  Before we get too involved ...
+
+  memory for bsplvbw()
+*/
+*flag = 0;
+bspwinit (order, &work, flag);
+if (*flag == 1)  {
+   *flag = 1;
+   return (1);
+   }
+
+/*
+  Memory for parameter values at data points.
+*/
+pval = (double *) malloc (number_of_data * sizeof (double));
+if (pval == NULL)  {
+   *flag = 1;
+   return (1);
+   }
+/*
+  Memory for banded matrix.
+*/
+band_width = 2*order - 1;
+band = (double *) malloc (number_of_data * band_width * sizeof (double));
+if (band == NULL)  {
+   *flag = 1;
+   return (1);
+   }
+
+/*printf ("Initializing knot vector.\n");*/
+/*  Using "not a knot" condition for spline ends, hence.  */
+number_cpnts = number_of_data;
+/*  and hence ...  */
+bvector = (double *)  malloc (number_cpnts * sizeof (double));
+if (bvector == NULL)  {
+   *flag = 1;
+   return (1);
+   }
+/*  and always ...  */
+numberknots = number_cpnts + order;
+knots =  (double *) malloc (numberknots * sizeof (double));
+if (knots == NULL)  {
+   *flag = 1;
+   return (1);
+   }
+
+/*  There is (number of control points + order) knots, numbered from 0.  */
+for (i = 0; i <= order-1; i ++)  {
+    knots[i] = 0.0e0;
+    knots[number_cpnts + i] = 1.0e0;
+}
+/*
+  Sum all the combinations of adjacent chord lengths, use to calculate
+  good knot values.  cf:
+      Parametrization of Bezier-type B-spline Curves and Surfaces.
+      Hartley, P. J., Judd C. J.  CAD, Vol. 10 Number 2.  March 1978.
+*/
+sum = 0.0e0;
+for ( i = 0 ; i <= number_cpnts - order;  i ++)
+  for ( j = i ; j  <= i+order-2 ;  j ++)  {
+      float1 = xdata[j+1] - xdata[j];
+      float2 = ydata[j+1] - ydata[j];
+      sum = sum + sqrt(float1 * float1 + float2 * float2);
+  }
+for ( i = 0 ; i < number_cpnts - order ;  i ++)  {
+    knots[i + order] = 0.0e0;
+    for ( j = i ; j  <= i+order-2 ;  j ++)  {
+        float1 = xdata[j+1] - xdata[j];
+        float2 = ydata[j+1] - ydata[j];
+        knots[i + order] = knots[i + order] +
+                            sqrt(float1 * float1 + float2 * float2);
+    }
+    knots[i + order] = knots[i + order]/sum + knots[i + order - 1];
+}
+/*   for ( i = 0 ; i < number_cpnts + order ; i ++)
+        printf ("knot %d = %f\n", i, knots[i]);*/
+
+/*   Use node points of the knot vector for parameter value at each data
+     point.  cf.
+      Parametrization and Shape of B-spline Curves for CAD.
+      Hartley, P. J., Judd, C. J.  CAD Vol. 12 Number 5.  Sept. 1980.
+*/
+for ( i = 0 ; i < number_of_data ;  i ++)  {
+   pval[i] = 0.0e0;
+   for ( j = 1 ; j <= order-1 ; j ++)  pval[i] = pval[i] + knots[i+j];
+   pval[i] = pval[i] / (double) (order-1);
+}
+
+/*  Initialize banded matrix to prevent WEIRD results.  */
+for ( i = 0 ; i <= number_cpnts-1 ;  i ++)
+   for ( j = 0 ; j <= (2*(order-1)) ; j ++)
+      *(band + INDEX(i, j, band_width)) = 0.0;
+
+index = 1;
+for ( i = 0 ; i  <= number_of_data-1 ;  i ++)  {
+   intervw (knots, numberknots, pval[i], &left, &work, flag);
+   if (*flag == -1)  {
+      *flag = 2;
+      return (2);
+      }
+/*      printf ("pval[%d]=%f left=%d knot[%d]=%f\n", i, pval[i], left, left, knots[left]);*/
+/*
+  This line is a fix for when the parameter value is actually equal to the
+  maximum knot value, in which case interv will correctly output left to be
+  at the end of the knot vector, but bsplvb will not spit out the value we
+  want, i.e. 1.0e0.  Flag will equal 1.
+*/
+   if ( pval[i] >= knots[number_cpnts+order-1] ) left = number_cpnts-1;
+   bsplvbw (knots, order, index, pval[i], left, work.values, &work, flag);
+/*  Store values in appropriate place in the banded matrix.  */
+   for (j = 0; j < order; j ++)  {
+      *(band + INDEX(i, left-i+j, band_width)) = work.values[j];
+/*	printf ("band[%d] [%d] = Bsplvalues[%f]\n",
+			  i,left-i+j, Bsplvalues[j]);*/
+   }
+/*       printf ("\n");*/
+   bvector[i] = xdata[i];
+}  /*  end of "for" each data point.  */
+
+
+/*for (i = 0; i <= number_cpnts - 1; i ++)  {
+   for (j = 0; j <= 2*order - 2; j ++)
+      printf (" %f", *(band + INDEX (i, j, band_width)));
+   printf ("\n");
+}
+*/
+/*  Factorize matrix.  */
+bandfac (band, band_width, number_cpnts, order-1, order-1, flag);
+switch (*flag)  {
+case 0:
+/*  Solve for x control points if factorization successful.  */
+   bandslv (band, band_width, number_cpnts, order-1, order-1, bvector);
+/*  Assemble x coordinate B-spline.  */
+   bsplmake (order, numberknots, knots, bvector, xbspl, flag);
+   for ( i = 0 ; i  <= number_cpnts - 1;  i ++)  bvector[i] = ydata[i];
+
+/*  Solve for y control points.  */
+   bandslv (band, band_width, number_cpnts, order-1, order-1, bvector);
+/*  Assemble y coordinate B-spline.  */
+   bsplmake (order, numberknots, knots, bvector, ybspl, flag);
+   /* fall through */
+default:
+/*  Free memory allocated for this routine.  */
+   bspwend (&work);  /*  local memory used by bsplvbw().  */
+   if (pval != NULL)  { free (pval);  pval = NULL; }
+   if (band != NULL)  { free (band);  band = NULL; }
+   if (bvector != NULL)  { free (bvector);  bvector = NULL; }
+   if (knots != NULL)  { free (knots);  knots = NULL; }
+}
+if (*flag != 0)  {
+   *flag = 3;
+   return (3);
+   }
+  else  {
+   *flag = 0;
+   return (0);  /*  Successful completion of bspline()  */
+   }
+
+}  /*  End of procedure bspline().  */
+
+/*-----------------------------------------------------------------*/
+/*  bsplsq.c
+    Least-squares fit of B-spline control points to data.
+*/
+
+/*  Purpose ...
+    -------
+    Calculates the control points of the B-spline, with given order and
+    knot vector, that fits the data (param[i], data[i]), i = 0 .. n-1,
+    in the weighted least-squares sense.  The number of data points may
+    be far larger than the number of control points.
+
+    The normal equations are banded, with order-1 bands each side of the
+    diagonal, and are accumulated point by point.  Storage is thus
+    proportional to (number of control points) * order and the time is
+    linear in the number of data points.
+
+
+  Input ...
+  -----
+  n          :  Number of data points.
+  param[]    :  Parameter value for each data point, within the range of
+                the knot vector.  Need not be in order, although sorted
+                values make the knot interval searches cheaper.
+  data[]     :  Data values.
+  weight[]   :  Weight for each data point, or NULL for unit weights.
+  bspldefn   :  B-spline structure with order, nknot and knots[] set up
+                and memory for cpnts[] allocated (see bsplmake()).
+
+  Output ...
+  ------
+  bspldefn   :  bspldefn->cpnts[] contains the fitted control points.
+  flag       :  Status indicator.
+                flag = 0  Successful.
+                flag = 1  Unable to allocate memory.
+                flag = 2  Parameter value outside range of knot vector.
+                flag = 3  Unable to factorize banded matrix.  Usually some
+                          knot interval (or set of order adjacent
+                          intervals) contains too few data points.
+                flag = 4  Invalid order or number of knots.
+
+  Version ...   1.0  October, 2026.
+
+  Notes ...
+  -----
+  (1)  Uses the CMATH routines bslsacc(), bslssolv(), bandfac(), bandslv().
+
+  (2)  When compiled for OpenMP and n is at least twice BSPLSQ_BPTS,
+       the data are split into blocks that are accumulated by
+       bslsacc() on separate threads, each into its own band-shaped
+       ata[] and atb[].  The blocks are then added, in block order,
+       and bslssolv() is called once.  The number of blocks depends
+       on n only, so the result does not depend on the number of
+       threads, but may differ from the one-block sum by rounding.
+  (3)  To fit several coordinates (e.g. x(u) and y(u) of a curve) with
+       the same param[], call bslsacc() and bslssolv() directly; the
+       same ata[] serves them all.
+
+*/
+
+#if (PROTOTYPE)
+
+int  bsplsq (int n, double param[], double data[], double weight[],
+             struct BSPLSTRC *bspldefn, int *flag)
+
+#else
+
+int  bsplsq (n, param, data, weight, bspldefn, flag)
+
+int     n;
+double  param[], data[], weight[];
+struct  BSPLSTRC *bspldefn;
+int     *flag;
+
+#endif
+
+{  /*  Beginning of procedure bsplsq().  */
+int     i, b, nblk, nsys, i0, i1, ncp, band_width;
+int     bflag[BSPLSQ_NBLK];
+double  *ata, *atb, *atab, *atbb;
+
+*flag = 0;
+ncp = bspldefn->nknot - bspldefn->order;
+if (bspldefn->order < 1 || ncp < 1)  {
+   *flag = 4;
+   return (4);
+   }
+band_width = 2 * bspldefn->order - 1;
+
+nblk = 1;
+#if (PARALLEL)
+nblk = n / BSPLSQ_BPTS;
+if (nblk > BSPLSQ_NBLK)  nblk = BSPLSQ_NBLK;
+if (nblk < 1)  nblk = 1;
+#endif
+
+/*  Block b has its ata[] and atb[] at ata + b * nsys, one after the
+    other; the sums are formed in block 0.  */
+nsys = ncp * (band_width + 1);
+ata = (double *) malloc (nblk * nsys * sizeof (double));
+if (ata == NULL)  {
+   *flag = 1;
+   return (1);
+   }
+atb = ata + ncp * band_width;
+
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(atab, atbb, i0, i1, i) \
+        if (nblk > 1)
+#endif
+for (b = 0; b < nblk; b ++)  {
+   atab = ata + b * nsys;
+   atbb = atab + ncp * band_width;
+   for (i = 0; i < nsys; i ++)  atab[i] = 0.0;
+   i0 = (int) ((long) n * b / nblk);
+   i1 = (int) ((long) n * (b + 1) / nblk);
+   bslsacc (bspldefn, i1 - i0, param + i0, data + i0,
+            (weight == NULL) ? weight : weight + i0,
+            atab, atbb, &bflag[b]);
+   }
+
+for (b = 0; b < nblk; b ++)  {
+   if (bflag[b] != 0)  {
+      *flag = bflag[b];
+      goto LeaveBsplsq;
+      }
+   }
+for (b = 1; b < nblk; b ++)  {
+   atab = ata + b * nsys;
+   for (i = 0; i < nsys; i ++)  ata[i] += atab[i];
+   }
+bslssolv (bspldefn, ata, atb, flag);
+
+LeaveBsplsq:
+free (ata);
+return (*flag);
+
+}  /*  End of procedure bsplsq().  */
+
+/*-----------------------------------------------------------------*/
+
+/*  Purpose ...
+    -------
+    Add the contributions of the data (param[i], data[i]), i = 0 .. n-1
+    to the banded normal equations ata * cpnts = atb for a least-squares
+    B-spline fit.
+
+  Input ...
+  -----
+  bspldefn   :  B-spline structure with order, nknot and knots[] set.
+  n, param[], data[], weight[]  :  As for bsplsq().
+  ata[]      :  Upper half and diagonal of the normal matrix so far, in
+                the band storage of bandfac() with
+                ndim = 2*order - 1 and nbandl = nbandu = order - 1.
+                The lower half is filled in by bslssolv().
+  atb[]      :  Right-hand side so far.
+                Both arrays should be zeroed before the first call.
+
+  Output ...
+  ------
+  ata[], atb[]  :  Updated sums.
+  flag       :  Status indicator, as for bsplsq().
+
+  Version ...   1.0  October, 2026.
+
+  Notes ...
+  -----
+  (1)  Nothing but the arguments is changed, so calls with separate
+       ata[], atb[] arrays may run concurrently.
+*/
+
+#if (PROTOTYPE)
+
+int  bslsacc (struct BSPLSTRC *bspldefn, int n, double param[],
+              double data[], double weight[],
+              double ata[], double atb[], int *flag)
+
+#else
+
+int  bslsacc (bspldefn, n, param, data, weight, ata, atb, flag)
+
+struct  BSPLSTRC *bspldefn;
+int     n;
+double  param[], data[], weight[];
+double  ata[], atb[];
+int     *flag;
+
+#endif
+
+{  /*  Beginning of procedure bslsacc().  */
+int     i, j, k, order, orderm1, ncp, band_width, left, row;
+double  wb, *bval;
+struct  BSPLWORK  work;
+
+*flag = 0;
+order = bspldefn->order;
+orderm1 = order - 1;
+ncp = bspldefn->nknot - order;
+band_width = 2 * order - 1;
+
+bspwinit (order, &work, flag);
+if (*flag != 0)  {
+   *flag = 1;
+   return (1);
+   }
+bval = work.values;
+
+for (i = 0; i < n; i ++)  {
+   intervw (bspldefn->knots, bspldefn->nknot, param[i], &left, &work, flag);
+/*  As in bspline(), the last knot belongs to the last interval.  */
+   if (param[i] == bspldefn->knots[bspldefn->nknot-1])  {
+      left = ncp - 1;
+      *flag = 0;
+      }
+   if (*flag != 0 || left < orderm1 || left > ncp - 1)  {
+      *flag = 2;
+      break;
+      }
+   bsplvbw (bspldefn->knots, order, 1, param[i], left, bval, &work, flag);
+
+/*  Row (left - orderm1 + j) collects bval[j] * bval[k], k >= j.  */
+   for (j = 0; j < order; j ++)  {
+      wb = (weight == NULL) ? bval[j] : weight[i] * bval[j];
+      row = left - orderm1 + j;
+      for (k = j; k < order; k ++)
+         ata[INDEX(row, orderm1 + k - j, band_width)] += wb * bval[k];
+      atb[row] += wb * data[i];
+      }
+   }
+
+bspwend (&work);
+return (*flag);
+
+}  /*  End of procedure bslsacc().  */
+
+/*-----------------------------------------------------------------*/
+
+/*  Purpose ...
+    -------
+    Solve the normal equations accumulated by bslsacc() for the control
+    points of the least-squares B-spline.
+
+  Input ...
+  -----
+  bspldefn   :  B-spline structure, as passed to bslsacc().
+  ata[]      :  Normal matrix from bslsacc().  It is overwritten by its
+                factorization.
+  atb[]      :  Right-hand side from bslsacc().
+
+  Output ...
+  ------
+  bspldefn   :  bspldefn->cpnts[] contains the control points.
+  atb[]      :  Also contains the control points.
+  flag       :  Status indicator.
+                flag = 0  Successful.
+                flag = 3  Unable to factorize banded matrix.
+
+  Version ...   1.0  October, 2026.
+
+  Notes ...
+  -----
+  (1)  The normal matrix is symmetric positive (semi-)definite, so
+       bandfac() needs no pivoting.
+*/
+
+#if (PROTOTYPE)
+
+int  bslssolv (struct BSPLSTRC *bspldefn, double ata[], double atb[],
+               int *flag)
+
+#else
+
+int  bslssolv (bspldefn, ata, atb, flag)
+
+struct  BSPLSTRC *bspldefn;
+double  ata[], atb[];
+int     *flag;
+
+#endif
+
+{  /*  Beginning of procedure bslssolv().  */
+int     i, k, orderm1, ncp, band_width;
+
+*flag = 0;
+orderm1 = bspldefn->order - 1;
+ncp = bspldefn->nknot - bspldefn->order;
+band_width = 2 * orderm1 + 1;
+
+/*  Mirror the upper half into the lower half.  */
+for (i = 0; i < ncp; i ++)
+   for (k = 1; k <= orderm1 && i + k < ncp; k ++)
+      ata[INDEX(i+k, orderm1 - k, band_width)] =
+         ata[INDEX(i, orderm1 + k, band_width)];
+
+bandfac (ata, band_width, ncp, orderm1, orderm1, flag);
+if (*flag != 0)  {
+   *flag = 3;
+   return (3);
+   }
+bandslv (ata, band_width, ncp, orderm1, orderm1, atb);
+for (i = 0; i < ncp; i ++)  bspldefn->cpnts[i] = atb[i];
+return (0);
+
+}  /*  End of procedure bslssolv().  */
+
+/*-----------------------------------------------------------------*/
+/*  bsplmake.c
+    Set up structure for B-spline data.
+*/
+
+/*  Purpose ...
+    -------
+    Setup structure for B-spline data.
+
+
+  Input ...
+  -----
+  nknot      :  Number of knots.
+  knots[]    :  Knot vector of the B-spline.
+  cpnts[]    :  Control points of the B-spline.
+  order      :  Order of spline.
+
+  Output ...
+  ------
+  bspldefn   :  Structure containing all the definition of a univariate
+                B-spline.
+  flag       :  Status indicator.
+                flag = 0  Successful.
+                flag = 1  Failed to assign memory required.
+
+  This C code written by ...   Nigel and Peter.
+  ----------------------       Design Software
+                               42 Gubberley Street,
+                               KENMORE, QLD, 4069.
+                               AUSTRALIA.
+
+  Version ...   1.0  October, 1989.
+
+  Notes ...
+  -----
+
+*/
+
+#if (PROTOTYPE)
+
+int  bsplmake (int order, int number_knots, double knots[],
+               double cpnts[], struct BSPLSTRC *bspldefn, int *flag)
+
+#else
+
+int  bsplmake (order, number_knots, knots, cpnts, bspldefn, flag)
+
+int     order;
+int     number_knots;
+double  knots[];
+double  cpnts[];
+struct  BSPLSTRC *bspldefn;
+int     *flag;
+
+#endif
+
+{  /*  Beginning of procedure bsplmake ().  */
+int  i;
+
+bspldefn->order = order;
+bspldefn->nknot = number_knots;
+bspldefn->knots = (double *) malloc (number_knots * sizeof (double));
+bspldefn->cpnts = (double *) malloc ((number_knots - order) *
+                                      sizeof (double));
+if (bspldefn->knots == NULL || bspldefn->cpnts == NULL)  {
+   *flag = 1;
+   return (1);
+}
+for (i = 0; i < number_knots; i++)  bspldefn->knots[i] = knots[i];
+for (i = 0; i < number_knots-order; i++)  bspldefn->cpnts[i] = cpnts[i];
+return (0);
+
+}  /*  End of procedure bsplmake ().  */
+
+/*-----------------------------------------------------------------*/
+/*  bspldest.c
+    Release memory used to store arrays in B-spline data structure.
+*/
+
+/*  Purpose ...
+    -------
+    Release memory used to store arrays in B-spline data structure.
+
+
+  Input ...
+  -----
+  bspldefn   :  Order of spline.
+
+  Output ...
+  ------
+  flag       :  Status indicator.
+                flag = 0  Successful.
+                flag = 1  NULL pointer for array location.
+
+  This C code written by ...   Nigel and Peter.
+  ----------------------       Design Software
+                               42 Gubberley Street,
+                               KENMORE, QLD, 4069.
+                               AUSTRALIA.
+
+  Version ...   1.0  C, October, 1989.
+
+  Notes ...
+  -----
+
+*/
+
+#if (PROTOTYPE)
+
+int  bspldest (struct BSPLSTRC *bspldefn, int *flag)
+
+#else
+
+int  bspldest (bspldefn, flag)
+
+struct  BSPLSTRC *bspldefn;
+int     *flag;
+
+#endif
+
+{  /*  Beginning of procedure bspldest ().  */
+
+*flag = 0;
+if (bspldefn->knots == NULL || bspldefn->cpnts == NULL)
+   {
+   *flag = 1;
+   return (1);
+   }
+  else
+   {
+   if (bspldefn->knots != NULL)
+      { free (bspldefn->knots); bspldefn->knots = NULL; }
+   if (bspldefn->cpnts != NULL)
+      { free (bspldefn->cpnts); bspldefn->cpnts = NULL; }
+   return (0);
+   }
+
+}  /*  End of procedure bspldest ().  */
+
+/*-----------------------------------------------------------------*/
+/*  bseval.c
+    Calculation of B-spline value.
+*/
+
+/*  Purpose ...
+    -------
+    Calculates the B-spline value at the location defined by the
+    parameter, knot vector, control points and order passed to this
+    routine.
+
+
+  Input ...
+  -----
+  index      :  Control order of B-spline basis functions calculated.  Normally
+                set to 1, unless the previous call to bsplvb or this routine
+                was for the same parameter, and the order of basis functions
+                one less than the previous call.  See bsplvb().
+  parameter  :  Parameter value at which to calculate the B-spline value.
+  left       :  Position in knot vector such that
+                knot[left] <= parameter < knot[left+1]  Generally found by
+                calling interv().
+  bspldefn   :  Structure containing the data defining the B-spline.
+
+  Output ...
+  ------
+  bseval     :  B-spline value.
+  flag       :  Status indicator.
+                flag = 0  Successful.
+                flag = 1  Failed to assign memory required within this
+                routine.
+
+  This C code written by ...   Nigel and Peter.
+  ----------------------       Design Software
+                               42 Gubberley Street,
+                               KENMORE, QLD, 4069.
+                               AUSTRALIA.
+
+  Version ...   1.0  FORTRAN, 1985.
+  -------       2.0  C, July 1989.
+
+  Notes ...
+  -----
+  (1)  Uses the CMATH routines bsplvb().
+
+  (2)  A call to bsplinit() must be made prior to the first call of this
+       routine, to allocate memory required by bsplvb() (based on the order
+       of the spline).
+
+  (3)  A call to bsplend() should be made when no there is to be no further
+       use of any routine which calls bsplvb() (to free associated memory).
+
+  (4)  If speed is of prime importance, then the code in this routine should
+       be used in-line.
+
+  (5)  bseval(), interv() and bsplvb() share a single static workspace.
+       Use bsevalw() where B-splines are to be evaluated concurrently.
+
+*/
+
+#if (PROTOTYPE)
+
+double  bseval (int index, double parameter,
+		struct BSPLSTRC *bspldefn, int *flag)
+
+#else
+
+double  bseval (index, parameter, bspldefn, flag)
+
+int     index;
+double  parameter;
+struct  BSPLSTRC *bspldefn;
+int     *flag;
+
+#endif
+
+{  /*  Beginning of procedure bseval ().  */
+
+return (bsevalw (index, parameter, bspldefn, &Bsplwork, flag));
+
+}  /*  End of procedure bseval()  */
+
+/*-------------------------------------------------------------------------*/
+
+/*  Purpose ...
+    -------
+    Reentrant version of bseval().  The knot interval search and the
+    basis function values are kept in the caller's workspace, so
+    separate workspaces may be used to evaluate (the same or different)
+    B-splines concurrently.
+
+  Input ...
+  -----
+  index      :  As for bseval().
+  parameter  :  Parameter value at which to calculate the B-spline value.
+  bspldefn   :  Structure containing the data defining the B-spline.
+  work       :  Workspace set up by bspwinit() for at least the order of
+                the B-spline.
+
+  Output ...
+  ------
+  bsevalw    :  B-spline value.
+  work       :  work->values[] holds the basis function values used.
+  flag       :  Status indicator, as for bseval().
+
+  Version ...   1.0  October, 2026.
+*/
+
+#if (PROTOTYPE)
+
+double  bsevalw (int index, double parameter,
+		 struct BSPLSTRC *bspldefn, struct BSPLWORK *work, int *flag)
+
+#else
+
+double  bsevalw (index, parameter, bspldefn, work, flag)
+
+int     index;
+double  parameter;
+struct  BSPLSTRC *bspldefn;
+struct  BSPLWORK *work;
+int     *flag;
+
+#endif
+
+{  /*  Beginning of procedure bsevalw ().  */
+int     left, i, orderm1;
+double  coord;
+
+*flag = 0;
+intervw (bspldefn->knots, bspldefn->nknot, parameter, &left, work, flag);
+if (parameter == bspldefn->knots[bspldefn->nknot-1])
+   {
+   left = bspldefn->nknot - bspldefn->order - 1;
+   *flag = 0;
+   }
+if (*flag != 0)
+   {
+   *flag = 1; return (0.0);
+   }
+bsplvbw (bspldefn->knots, bspldefn->order, index, parameter, left,
+	 work->values, work, flag);
+
+if (*flag == 1)
+   {
+   *flag = 2;  return (0.0);
+   }
+coord = 0.0e0;
+orderm1 = bspldefn->order - 1;
+for ( i = 0; i  <= orderm1;  i ++)
+   coord += work->values[i] * bspldefn->cpnts[left - orderm1 + i];
+return (coord);
+
+}  /*  End of procedure bsevalw()  */
+
+/*-------------------------------------------------------------------------*/
+
+/*  bsdcpnts.c
+    Calculation of control points for B-spline derivatives.
+*/
+
+/* Purpose ...
+   -------
+   Calculates the control points required for the computation of the
+   derivative(s) of a B-spline, from the control points and knot vector
+   of the undifferentiated spline.
+
+
+   Input ...
+   -----
+
+
+   Output ...
+   ------
+   deriv            :  Control points for the derivative of the B-spline.
+   flag             :  Status indicator.
+                       flag = 0  Successful.
+                       flag = 1  Failed to assign memory required within this
+                                 routine.
+
+   Version ...   1.0, August 1989.
+   -------       1.1, September 1989.  Implement check on zero denominator.
+
+   Notes ...
+   -----
+
+   (1)  Vectors orignl_cpnts[], deriv_cpnts[] must have memory allocated to
+        them prior to calling this routine.  Hopefully, there will also be
+        something useful in orignl_cpnts[].
+
+   (2)  If speed is of prime importance, then the code in this routine should
+        be used in-line.
+
+   (3)  For the x'th derivative, this routine must be called x times, using
+        the output from the previous call as input.
+
+   (4)  For a derivation of the relationship between a B-spline and its
+        derivatives, see:
+        de Boor, C.  On Calculating with B-splines.  J.  Approx. Theory.  6
+        (1972)  pp50-62.
+
+
+*/
+
+#if (PROTOTYPE)
+
+int  bsdcpnts (struct BSPLSTRC *orignl,
+               struct BSPLSTRC *deriv, int *flag)
+#else
+
+int  bsdcpnts (orignl, deriv, flag)
+
+struct BSPLSTRC *orignl;
+struct BSPLSTRC *deriv;
+int *flag;
+
+#endif
+
+{  /*  Beginning of procedure bsdcpnts ().  */
+int     origkm1, num_cpntsm1, i;
+double  temp_float;
+
+num_cpntsm1 = orignl->nknot - orignl->order - 1;
+/*  Difference number_cpnts, hence number_cpnts - 1 control points for
+   derivative.
+*/
+
+deriv->order = orignl->order-1;
+deriv->nknot = orignl->nknot - 2;
+deriv->knots = (double *) malloc (deriv->nknot * sizeof (double));
+deriv->cpnts = (double *) malloc ((deriv->nknot - deriv->order) *
+                                      sizeof (double));
+if (deriv->knots == NULL || deriv->cpnts == NULL)  {
+   *flag = 1;
+   return (1);
+}
+for (i = 0; i < deriv->nknot; i++) deriv->knots[i] = orignl->knots[i+1];
+
+origkm1 = orignl->order - 1;
+for ( i = 1; i  <= num_cpntsm1;  i ++)  {
+  temp_float = orignl->knots[i + origkm1] - orignl->knots[i];
+  if (temp_float <= 0.0)
+     deriv->cpnts [i-1] = 0.0;
+    else
+     deriv->cpnts [i-1] = (orignl->cpnts[i] - orignl->cpnts[i-1]) /
+                         temp_float * (float) origkm1;
+}
+return (0);
+}  /*  End of procedure bsdcpnts()  */
+
+/*-------------------------------------------------------------------------*/
+
+/*  Number of parameter values taken through de Boor's algorithm together
+    by bsevalv().  The working arrays are stored lane by lane so that the
+    innermost loops run with unit stride over the lanes.  */
+
+#define  BSPL_LANES  8
+
+#if (PROTOTYPE)
+
+static void  bsdeboor (int order, double knots[], double cpnts[], int nlane,
+                       int left[], double u[], double kn[], double d[],
+                       double result[])
+
+#else
+
+static void  bsdeboor (order, knots, cpnts, nlane, left, u, kn, d, result)
+
+int     order;
+double  knots[], cpnts[];
+int     nlane, left[];
+double  u[], kn[], d[], result[];
+
+#endif
+
+/*  Purpose ...
+    -------
+    de Boor's algorithm for up to BSPL_LANES parameter values at once.
+    kn[] and d[] are work arrays of (at least) 2*(order-1)*BSPL_LANES
+    and order*BSPL_LANES elements.  left[] must satisfy
+    order-1 <= left[] <= number of control points - 1.
+*/
+
+{  /*  Beginning of procedure bsdeboor()  */
+int     p, j, r, m, l;
+double  alpha;
+
+p = order - 1;
+
+/*  Gather the knots and control points for each lane.  */
+for (l = 0; l < nlane; l ++)  {
+   for (m = 0; m < 2*p; m ++)
+      kn[m*BSPL_LANES + l] = knots[left[l] - p + 1 + m];
+   for (j = 0; j <= p; j ++)
+      d[j*BSPL_LANES + l] = cpnts[left[l] - p + j];
+}
+
+/*  Triangular scheme, one column at a time across all lanes.  */
+for (r = 1; r <= p; r ++)
+   for (j = p; j >= r; j --)
+      for (l = 0; l < nlane; l ++)  {
+         alpha = (u[l] - kn[(j-1)*BSPL_LANES + l]) /
+                 (kn[(j-r+p)*BSPL_LANES + l] - kn[(j-1)*BSPL_LANES + l]);
+         d[j*BSPL_LANES + l] = d[(j-1)*BSPL_LANES + l] +
+                               alpha * (d[j*BSPL_LANES + l] -
+                                        d[(j-1)*BSPL_LANES + l]);
+      }
+
+for (l = 0; l < nlane; l ++)  result[l] = d[p*BSPL_LANES + l];
+
+}  /*  End of procedure bsdeboor()  */
+
+/*-------------------------------------------------------------------------*/
+
+/*  bsevalv.c
+    B-spline values (and derivatives) at many parameter values.
+*/
+
+/*  Purpose ...
+    -------
+    Calculates the B-spline values at each of the n parameter values in
+    param[], and optionally the values of its derivative.  The result is
+    the same as calling bseval() for each parameter but
+    (a) the knot interval search for each parameter starts from the
+        interval found for the previous one, so a sorted (or nearly
+        sorted) param[] needs almost no searching, and
+    (b) de Boor's algorithm is run on BSPL_LANES parameters at a time
+        with the loops over the parameters innermost, where the compiler
+        can vectorize them.
+
+
+  Input ...
+  -----
+  bspldefn   :  Structure containing the data defining the B-spline.
+  dbspldefn  :  Structure for the derivative of the B-spline, as set up
+                by bsdcpnts (bspldefn, dbspldefn, flag), or NULL if the
+                derivative is not needed.
+  n          :  Number of parameter values.
+  param[]    :  The parameter values, in any order.
+
+  Output ...
+  ------
+  value[]    :  B-spline values at param[i], i = 0 .. n-1.
+  dvalue[]   :  Derivative values at param[i].  Not referenced if
+                dbspldefn is NULL (and may then also be NULL).
+  flag       :  Status indicator.
+                flag = 0  Successful.
+                flag = 1  Some parameter values were not valid.  The
+                          corresponding elements of value[] and dvalue[]
+                          are set to 0.0.
+                flag = 2  Failed to assign memory required within this
+                          routine.
+
+  Version ...   1.0  October, 2026.
+
+  Notes ...
+  -----
+  (1)  No workspace from bsplinit() or bspwinit() is needed, and nothing
+       outside the arguments is changed, so separate calls may run
+       concurrently.
+
+  (2)  The routine is meant to be used for tessellating curves;  a
+       derivative B-spline from bsdcpnts() should be set up once and
+       passed to each call.
+
+*/
+
+#if (PROTOTYPE)
+
+int  bsevalv (struct BSPLSTRC *bspldefn, struct BSPLSTRC *dbspldefn,
+              int n, double param[], double value[], double dvalue[],
+              int *flag)
+
+#else
+
+int  bsevalv (bspldefn, dbspldefn, n, param, value, dvalue, flag)
+
+struct  BSPLSTRC *bspldefn;
+struct  BSPLSTRC *dbspldefn;
+int     n;
+double  param[], value[], dvalue[];
+int     *flag;
+
+#endif
+
+{  /*  Beginning of procedure bsevalv ().  */
+int     i, l, nlane, order, nknot, lastcp, lflag;
+int     left[BSPL_LANES], dleft[BSPL_LANES], index[BSPL_LANES];
+double  u[BSPL_LANES], result[BSPL_LANES];
+double  *kn, *d;
+struct  BSPLWORK  search;
+
+*flag = 0;
+order = bspldefn->order;
+nknot = bspldefn->nknot;
+lastcp = nknot - order - 1;
+
+kn = (double *) malloc ((2*order + 1) * BSPL_LANES * sizeof (double));
+d  = (double *) malloc ((order + 1) * BSPL_LANES * sizeof (double));
+if (kn == NULL || d == NULL)  {
+   if (kn != NULL)  free (kn);
+   if (d != NULL)  free (d);
+   *flag = 2;
+   return (2);
+}
+
+/*  Only the search position in this workspace is used.  */
+search.ilo = 0;
+
+i = 0;
+while (i < n)  {
+/*  Find the knot interval for the next lane-full of valid parameters.  */
+   nlane = 0;
+   while (i < n && nlane < BSPL_LANES)  {
+      intervw (bspldefn->knots, nknot, param[i], &left[nlane], &search,
+               &lflag);
+      if (param[i] == bspldefn->knots[nknot-1])
+         {
+         left[nlane] = lastcp;
+         lflag = 0;
+         }
+      if (lflag != 0 || left[nlane] < order-1 || left[nlane] > lastcp)  {
+         value[i] = 0.0;
+         if (dbspldefn != NULL)  dvalue[i] = 0.0;
+         *flag = 1;
+      }
+      else  {
+         u[nlane] = param[i];
+         index[nlane] = i;
+         ++ nlane;
+      }
+      ++ i;
+   }
+   if (nlane == 0)  continue;
+
+   bsdeboor (order, bspldefn->knots, bspldefn->cpnts, nlane, left, u,
+             kn, d, result);
+   for (l = 0; l < nlane; l ++)  value[index[l]] = result[l];
+
+/*  The derivative knots are the original knots less the first, so the
+    interval is one place to the left.  */
+   if (dbspldefn != NULL)  {
+      for (l = 0; l < nlane; l ++)  dleft[l] = left[l] - 1;
+      bsdeboor (dbspldefn->order, dbspldefn->knots, dbspldefn->cpnts,
+                nlane, dleft, u, kn, d, result);
+      for (l = 0; l < nlane; l ++)  dvalue[index[l]] = result[l];
+   }
+}
+
+free (kn);
+free (d);
+return (*flag);
+
+}  /*  End of procedure bsevalv()  */
+
+
+/*-------------------------------------------------------------------------*/
+
+
+#if (PROTOTYPE)
+
+int  interv (double knots[], int nknots, double parameter, int *left,
+             int *flag)
+
+#else
+
+int  interv (knots, nknots, parameter, left, flag)
+
+int    nknots, *left, *flag;
+double  knots[], parameter;
+
+#endif
+
+/* Purpose ...
+   Computes left = max(i, where 0 <= i < nknots and knots(i) <= parameter)
+   The programme is designed to be efficient in the common situation that
+   it is called repeatedly, with 'parameter' taken from an increasing or
+   decreasing sequence.
+
+
+   Input ...
+   -----
+   knots[]   :  A real sequence, of length nknots, assumed to be
+                non-decreasing.
+   nknots  :  Number of terms in the sequence knots.
+   parameter :  The point whose location with respect to the sequence 'knots'
+                is to be determined.
+
+   Output ...
+   ------
+   left      :  max(i, where 0 <= i < nknots and knots(i) <= parameter)
+   flag      :  status flag.
+                flag =  0  Normal return.
+                flag = -1  The parameter value is less than knot [0].
+                flag =  1  The parameter value is greater than
+                           knot [nknots - 1].
+
+
+   This C code written by ...  Nigel and Peter,
+   ----------------------      Design Software,
+                               42 Gubberley St,
+                               KENMORE, 4069,
+                               Australia.
+
+   Version ...   1.0, FORTRAN 1985.
+   -------       2.0, Pascal  1987.
+                 3.0, C April 1989.
+                 3.1, 17 July 1989.  (array indexing from zero, case for
+                                     index.)
+
+    Notes ...
+    -----
+    (1)  Adapted from the FORTRAN code in:
+         de Boor, C.  A Practical Guide to Splines.  Applied Mathematical
+         Sciences Volume 27.  Springer-Verlag, New York.  1978.
+
+    (2)  knots[0] must be less than knots[nknots-1].
+
+*/
+/*-------------------------------------------------------------------------*/
+
+{  /*  Begin procedure interv()  */
+
+return (intervw (knots, nknots, parameter, left, &Bsplwork, flag));
+
+}  /*  End on procedure interv()  */
+
+/*-------------------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int  intervw (double knots[], int nknots, double parameter, int *left,
+              struct BSPLWORK *work, int *flag)
+
+#else
+
+int  intervw (knots, nknots, parameter, left, work, flag)
+
+int    nknots, *left;
+double  knots[], parameter;
+struct BSPLWORK *work;
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   Reentrant version of interv().  The interval found by the last call is
+   kept in work->ilo rather than in a static variable, so searches using
+   different workspaces do not disturb each other.
+
+   Input ...
+   -----
+   knots[], nknots, parameter  :  As for interv().
+   work      :  Workspace holding the interval found by the previous call.
+                Set work->ilo = 0 (bspwinit() does this) before the first.
+
+   Output ...
+   ------
+   left, flag  :  As for interv().
+   work        :  work->ilo = left, to start the next search.
+
+   Version ...   1.0, October 2026.
+*/
+/*-------------------------------------------------------------------------*/
+
+{  /*  Begin procedure intervw()  */
+
+int     istep, ilo, ihi, middle;
+
+  *flag = 0;
+  ilo = work->ilo;
+  if ( ilo < 0 ) ilo = 0;
+  ihi = ilo + 1;
+  if ( ihi >= nknots ) {
+     ihi = nknots - 1;
+     ilo = ihi - 1;
+  }
+
+  if ( parameter < knots[ihi] ) {
+     if ( parameter >= knots[ilo] ) {  /*  have bracketed parameter - finished!  */
+        *left = ilo;
+        work->ilo = ilo;
+        return (0);
+     };
+
+/*  parameter < knots[ilo], decrease ilo  */
+     istep = 1;
+     Decr_ilo:
+        ihi = ilo;
+        ilo = ihi - istep;
+        if ( ilo <= 0 ) {
+/*  Check input data for validity.  Last resort.  */
+           if (parameter < knots[0])  {
+              *flag = -1;
+              *left = 0;
+              work->ilo = 0;
+              return (-1);
+           }
+           ilo = 0;
+           goto Bisect;
+        };
+        if ( parameter >= knots[ilo] ) goto Bisect;
+        istep = istep * 2;
+     goto Decr_ilo;
+     }
+    else  {
+/*  parameter >= knots[ihi], increase ihi  */
+     istep = 1;
+     Incr_ihi:
+        ilo = ihi;
+        ihi = ilo + istep;
+        if ( ihi >= nknots - 1 ) {
+           ihi = nknots - 1;
+/*  Check input data for validity.  Last resort.  */
+           if (parameter >= knots[ihi])  {
+              *flag = 1;
+              *left = ihi;
+              work->ilo = ilo;
+              return (1);
+           }
+           goto Bisect;
+        };
+        if ( parameter < knots[ihi] ) goto Bisect;
+        istep = istep * 2;
+     goto Incr_ihi;
+     }
+
+/*  Bisection search once the knot interval has been bracketed.  */
+  Bisect:
+  middle = (ilo + ihi) / 2;
+  while (middle != ilo) {
+     if (parameter < knots[middle])
+        ihi = middle;
+       else
+        ilo = middle;
+     middle = (ilo + ihi) / 2;
+  }
+  *left = ilo;
+  work->ilo = ilo;
+  return (0);
+}  /*  End on procedure intervw()  */
+
+/*-------------------------------------------------------------------------*/
+
+/*  bsplvb.c
+    Calculation of B-spline basis function values.
+*/
+
+
+#if (PROTOTYPE)
+
+int  bsplinit (int order, int *flag)
+
+#else
+
+int  bsplinit (order, flag)
+
+int  order, *flag;
+
+#endif
+
+/*  Purpose ...
+    Assign memory for matrices within bsplvb().
+    Done here for speed.
+*/
+{  /*  Beginning of procedure bsplinit()  */
+
+return (bspwinit (order, &Bsplwork, flag));
+
+}  /*  End of procedure bsplinit().  */
+
+/*-------------------------------------------------------------------------*/
+
+int  bsplend ()
+
+/*  Purpose ...
+    Free the memory used by bsplvb().
+*/
+{
+
+return (bspwend (&Bsplwork));
+
+}  /* End of procedure bsplend().  */
+
+/*-------------------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int  bspwinit (int order, struct BSPLWORK *work, int *flag)
+
+#else
+
+int  bspwinit (order, work, flag)
+
+int  order;
+struct BSPLWORK *work;
+int  *flag;
+
+#endif
+
+/*  Purpose ...
+    Set up a workspace for intervw(), bsplvbw() and bsevalw(), for
+    B-splines of up to the given order.  Each thread (or each curve
+    whose search state is to be kept separate) should have its own.
+
+    Input ...
+    -----
+    order      :  Highest order of B-spline to be evaluated.
+
+    Output ...
+    ------
+    work       :  Initialized workspace.
+    flag       :  Status flag.
+                  flag = 0  Normal return.
+                  flag = 1  Unable to allocate memory.
+
+    Notes ...
+    -----
+    (1)  Instead of calling bspwinit(), the caller may point
+         work->deltal, work->deltar and work->values at arrays of its own
+         of length order, set work->order, and set work->ilo = 0 and
+         work->j = 1.  bspwend() must not then be called.
+*/
+{  /*  Beginning of procedure bspwinit()  */
+*flag = 0;
+/*  A little ditty to make sure intervw() kicks off correctly.  */
+work->ilo = 0;
+work->j = 1;
+work->order = order;
+/*  Now fix startup for bsplvbw().  */
+work->deltal = (double *) malloc (order * sizeof(double));
+work->deltar = (double *) malloc (order * sizeof(double));
+/*  Memory for storing B-spline values in bspline() and bsevalw()  */
+work->values = (double *) malloc (order * sizeof(double));
+if (work->deltal == NULL || work->deltar == NULL || work->values == NULL)
+   {
+   bspwend (work);
+   *flag = 1;
+   return (1);
+   }
+
+return (0);
+}  /*  End of procedure bspwinit().  */
+
+/*-------------------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int  bspwend (struct BSPLWORK *work)
+
+#else
+
+int  bspwend (work)
+
+struct BSPLWORK *work;
+
+#endif
+
+/*  Purpose ...
+    Free the memory allocated by bspwinit().
+*/
+{
+if (work->deltal != NULL)  { free (work->deltal); work->deltal = NULL; }
+if (work->deltar != NULL)  { free (work->deltar); work->deltar = NULL; }
+if (work->values != NULL)  { free (work->values); work->values = NULL; }
+return (0);
+
+}  /* End of procedure bspwend().  */
+
+/*-------------------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int  bsplvb (double knots[], int jhigh, int index, double parameter,
+             int left, double biatp[], int *flag)
+
+#else
+
+int  bsplvb (knots, jhigh, index, parameter, left, biatp, flag)
+
+double  knots[];
+int     jhigh, index;
+double  parameter;
+int     left;
+double  biatp[];
+int     *flag;
+
+#endif
+
+/* Purpose ...
+   Calculates the value of all possibly nonzero B-spline basis functions at
+   parameter value 'parameter', of order
+               jout = max (jhigh, (j+1)*(index-1))
+   with knot sequence 'knots[]'.
+
+
+   Input ...
+   -----
+   knots[]    :  Knot sequence, of length at least left+jout, assumed to be
+                 non-decreasing.
+   jhigh,
+   index      :  Integers which determine the order jout of the B-splines
+                 whose values at 'parameter' are to be returned.
+                 Index is used to avoid recalculations when several columns
+                 of the triangular array of B-spline values are needed.
+                 eg. for calculation of derivatives.
+                 If index = 1,
+                 the calculations start from scratch and the entire triangular
+                 array of B-spline values of orders 1, 2,......jhigh is
+                 generated order by order, ie. column by column.
+                 If index = 2,
+                 only the B-spline values of order J+1, J+2,......,jout are
+                 generated, the assumption being that biatp, j, Deltal, Deltar,
+                 are, on entry, as they were on exit at the previous call.
+                 If jhigh = 0,
+                 then jout = j +  1, and just the next column of B-splines are
+                 calculated.
+   left      :  Unless you want STRANGE numbers, should be such that
+                knots(left) <= parameter < knots(left+1)
+
+   Output ...
+   ------
+   biatp      :  Vector of length jout, containing the values of the B-spline
+                 basis functions of use at 'parameter', of the polynomial of
+                 order jout.
+   *flag      :  Status flag.
+                 flag = 0  Normal return.
+                 flag = 1  Memory not assigned to work arrays.
+                 flag = 2  Invalid value of index passed.
+
+   Notes ...
+   -----
+   (1)  Adapted from the FORTRAN code in:
+        de Boor, C.  A Practical Guide to Splines.  Applied Mathematical
+        Sciences Vol. 27.  Springer-Verlag, New York.  1978.
+
+   (2)  A complete derivation of this (and one other) calculation technique
+        is given in:
+        de Boor, C.  On Calculating with B-splines.  J.  Approx. Theory.  6
+        (1972)  pp50-62.
+
+   (3)  Division by zero will result if knots[left] = knots[left+1]
+*/
+/*-------------------------------------------------------------------------*/
+
+{
+
+return (bsplvbw (knots, jhigh, index, parameter, left, biatp, &Bsplwork,
+                 flag));
+
+}  /*  End of procedure bsplvb()  */
+
+/*-------------------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int  bsplvbw (double knots[], int jhigh, int index, double parameter,
+              int left, double biatp[], struct BSPLWORK *work, int *flag)
+
+#else
+
+int  bsplvbw (knots, jhigh, index, parameter, left, biatp, work, flag)
+
+double  knots[];
+int     jhigh, index;
+double  parameter;
+int     left;
+double  biatp[];
+struct BSPLWORK *work;
+int     *flag;
+
+#endif
+
+/* Purpose ...
+   Reentrant version of bsplvb().  The differences Deltal, Deltar and the
+   order j reached by the last call (for index = 2) are kept in the
+   caller's workspace.
+
+   Input ...
+   -----
+   knots[], jhigh, index, parameter, left  :  As for bsplvb().
+   work       :  Workspace set up by bspwinit() for order >= jout.
+
+   Output ...
+   ------
+   biatp, flag  :  As for bsplvb().
+*/
+/*-------------------------------------------------------------------------*/
+
+{
+int     i, j, jp1, jm1;
+double  saved, term;
+double  *deltal, *deltar;
+
+*flag = 0;
+deltal = work->deltal;
+deltar = work->deltar;
+if (deltal == NULL || deltar == NULL)  {
+   *flag = 1;
+   return (1);
+}
+switch (index) {
+  case 1:  work->j = 1;
+           biatp[0] = 1.0e0;
+           /* fall through */
+  case 2:  j = work->j;
+           while (j < jhigh) {
+              jp1 = j + 1;
+              jm1 = j - 1;
+              deltar[jm1] = knots[left + j] - parameter;
+	      deltal[jm1] = parameter - knots[left - jm1];
+              saved = 0.0e0;
+              for (i = 0; i <= jm1; i++) {
+                 term = biatp[i] / (deltar[i] + deltal[jm1 - i]);
+                 biatp[i] = saved + deltar[i] * term;
+		 saved = deltal [jm1 - i] * term;
+              }
+	      biatp[j] = saved;
+              j = jp1;
+	   }  /* end of while */
+           work->j = j;
+           return (0);
+  default:  {
+            *flag = 2;
+            return (2);
+            }
+}
+
+}  /*  End of procedure bsplvbw()  */
+
+/*-------------------------------------------------------------------------*/
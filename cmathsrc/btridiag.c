@@ -0,0 +1,400 @@
+/* btridiag.c
+   Tridiagonal solvers for batches of systems and, by cyclic
+   reduction, for single long systems.  */
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+#include "cmath.h"
+#if (STDLIBH)
+#include <stdlib.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+/* Matrix elements smaller than TOL are assumed zero, as in
+   tridiag().  */
+#define  TOL  EPSILON
+
+/* The systems of a batch are taken BTRI_CHUNK at a time, each
+   chunk through all n equations, so that the rows being used
+   stay in cache.  Chunks are shared among threads when compiled
+   for OpenMP (PARALLEL in cmath.h) and the batch is larger than
+   BTRI_PMIN elements.  */
+#define  BTRI_CHUNK  256
+#define  BTRI_PMIN   32768L
+
+/* Levels of cyclic reduction with fewer than TRICR_PMIN
+   equations are done by one thread.  */
+#define  TRICR_PMIN  4096
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int btridiag (int n, int nbatch, int stride,
+              double ld[], double d[], double ud[],
+              int *flag)
+
+#else
+
+int btridiag (n, nbatch, stride, ld, d, ud, flag)
+int    n, nbatch, stride;
+double ld[], d[], ud[];
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Forward elimination for a batch of tridiagonal systems, as
+   tridiag() does for one.  Use btrisolve() for the solutions.
+
+   Input ...
+   -----
+   n      : order of each system
+   nbatch : the number of systems
+   stride : the distance between successive elements of one
+            system, stride >= nbatch.  Element j of system p is
+            held in ld[j*stride+p], d[j*stride+p] and ud[j*stride+p]
+            so that the same element of all the systems is
+            contiguous, e.g. one system per grid line of an
+            ADI sweep.
+   ld     : lower off-diagonals  (elements 1 .. n-1)
+   d      : diagonals            (elements 0 .. n-1)
+   ud     : upper off-diagonals  (elements 0 .. n-2)
+
+   Output ...
+   ------
+   d, ud, ld : the factors, as from tridiag()
+   ld[p]     : (element 0, not otherwise used) is set to 1.0 for a
+               system p for which elimination failed, 0.0 otherwise.
+   flag      : = 0, for normal return
+               = 1, elimination failed for one or more systems
+                    (a pivot was zero)
+               = 2, illegal user input, n < 3, nbatch < 1,
+                    stride < nbatch, NULL pointers
+
+   Version ... 1.0,  19 October 2026
+   -------
+
+   Notes ...
+   -----
+   (1) The elimination is that of tridiag() so the results agree
+       with it to the last bit.  The inner loops run across the
+       systems with unit stride and may be vectorized.
+   (2) A system that fails is carried on with zero multipliers
+       so that it cannot disturb the others.
+*/
+
+{  /* begin btridiag() */
+int    j, p, p1, p2, nfail;
+double mult, pivot, *dj, *dm, *lj, *um;
+
+*flag = 0;
+if (n < 3 || nbatch < 1 || stride < nbatch ||
+    ld == NULL || d == NULL || ud == NULL)
+   {
+   *flag = 2;
+   return (0);
+   }
+
+nfail = 0;
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) \
+        private(p2, j, p, mult, pivot, dj, dm, lj, um) \
+        reduction(+:nfail) if ((long) n * nbatch > BTRI_PMIN)
+#endif
+for (p1 = 0; p1 < nbatch; p1 += BTRI_CHUNK)
+   {
+   p2 = (p1 + BTRI_CHUNK < nbatch) ? p1 + BTRI_CHUNK : nbatch;
+   for (p = p1; p < p2; ++p) ld[p] = 0.0;
+   for (j = 1; j < n; ++j)
+      {  /* eliminate ld[j] in each system */
+      dj = d  + j * stride;
+      dm = dj - stride;
+      lj = ld + j * stride;
+      um = ud + (j-1) * stride;
+      for (p = p1; p < p2; ++p)
+         {
+         pivot = dm[p];
+         if (fabs(pivot) < TOL)
+            {
+            ld[p] = 1.0;
+            mult  = 0.0;
+            }
+         else
+            {
+            mult = lj[p] / pivot;
+            if (fabs(mult) <= TOL) mult = 0.0;
+            }
+         lj[p]  = mult;
+         dj[p] -= um[p] * mult;
+         }
+      }
+   for (p = p1; p < p2; ++p) if (ld[p] != 0.0) ++nfail;
+   }
+
+if (nfail > 0) *flag = 1;
+return (0);
+}  /* end of btridiag() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int btrisolve (int n, int nbatch, int stride,
+               double ld[], double d[], double ud[], double x[],
+               int *flag)
+
+#else
+
+int btrisolve (n, nbatch, stride, ld, d, ud, x, flag)
+int    n, nbatch, stride;
+double ld[], d[], ud[], x[];
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Solve a batch of tridiagonal systems factored by btridiag(),
+   as trisolve() does for one.
+
+   Input ...
+   -----
+   n, nbatch, stride : as for btridiag()
+   ld, d, ud         : the factors from btridiag()
+   x                 : the right hand sides, element j of system p
+                       in x[j*stride+p]
+
+   Output ...
+   ------
+   x      : the solutions
+   flag   : = 0, for normal return
+            = 1, a pivot was zero for one or more systems,
+                 whose solutions are not valid
+            = 2, illegal user input
+
+   Version ... 1.0,  19 October 2026
+   -------
+*/
+
+{  /* begin btrisolve() */
+int    j, p, p1, p2, nfail;
+double *xj, *xm, *lj, *dj, *uj, pivot;
+
+*flag = 0;
+if (n < 3 || nbatch < 1 || stride < nbatch ||
+    ld == NULL || d == NULL || ud == NULL || x == NULL)
+   {
+   *flag = 2;
+   return (0);
+   }
+
+nfail = 0;
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) \
+        private(p2, j, p, xj, xm, lj, dj, uj, pivot) \
+        reduction(+:nfail) if ((long) n * nbatch > BTRI_PMIN)
+#endif
+for (p1 = 0; p1 < nbatch; p1 += BTRI_CHUNK)
+   {
+   p2 = (p1 + BTRI_CHUNK < nbatch) ? p1 + BTRI_CHUNK : nbatch;
+
+   /* forward elimination with the recorded multipliers */
+   for (j = 1; j < n; ++j)
+      {
+      xj = x + j * stride;
+      xm = xj - stride;
+      lj = ld + j * stride;
+      for (p = p1; p < p2; ++p) xj[p] -= lj[p] * xm[p];
+      }
+
+   /* back substitution */
+   for (j = n-1; j >= 0; --j)
+      {
+      xj = x  + j * stride;
+      dj = d  + j * stride;
+      uj = ud + j * stride;
+      if (j < n-1)
+         for (p = p1; p < p2; ++p) xj[p] -= uj[p] * xj[p+stride];
+      for (p = p1; p < p2; ++p)
+         {
+         pivot = dj[p];
+         if (fabs(pivot) < TOL)
+            {
+            ++nfail;
+            pivot = 1.0;
+            }
+         xj[p] /= pivot;
+         }
+      }
+   }
+
+if (nfail > 0) *flag = 1;
+return (0);
+}  /* end of btrisolve() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int tricr (int n,
+           double ld[], double d[], double ud[], double x[],
+           int *flag)
+
+#else
+
+int tricr (n, ld, d, ud, x, flag)
+int    n;
+double ld[], d[], ud[], x[];
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Solve a single tridiagonal system by cyclic reduction.
+   The equations are the same as for tridiag().
+
+   Input ...
+   -----
+   n     : order of system
+   ld    : lower off-diagonal  (elements 1 .. n-1)
+   d     : diagonal            (elements 0 .. n-1)
+   ud    : upper off-diagonal  (elements 0 .. n-2)
+   x     : right-hand-side vector
+
+   Output ...
+   ------
+   x     : the solution; ld, d and ud are not changed
+   flag  : = 0, for normal return
+           = 1, for routine failure
+                (a diagonal element became zero)
+           = 2, illegal user input, n < 3, NULL pointers
+           = 3, could not allocate workspace
+
+   Workspace ...
+   ---------
+   3n doubles are allocated.
+
+   Version ... 1.0,  19 October 2026
+   -------
+
+   Notes ...
+   -----
+   (1) Each level of the reduction combines every other remaining
+       equation with its neighbours, halving the number of
+       unknowns; the equations of a level are independent and
+       are shared among threads when compiled for OpenMP.  The
+       solution is then found level by level in reverse.
+   (2) About 2.5 times the operations of tridiag() and trisolve()
+       are done, so the method is faster only with several
+       threads and large n.  For many systems use btridiag().
+   (3) As for tridiag(), there is no pivoting.  The method is
+       stable for diagonally dominant systems.
+*/
+
+{  /* begin tricr() */
+double *a, *b, *c, alpha, gamma;
+int    i, s, im, ip, nfail;
+
+*flag = 0;
+a = b = c = (double *) NULL;
+if (n < 3 || ld == NULL || d == NULL || ud == NULL || x == NULL)
+   {
+   *flag = 2;
+   return (0);
+   }
+
+a = (double *) malloc (n * sizeof(double));
+b = (double *) malloc (n * sizeof(double));
+c = (double *) malloc (n * sizeof(double));
+if (a == NULL || b == NULL || c == NULL)
+   {
+   *flag = 3;
+   goto LeaveTricr;
+   }
+for (i = 0; i < n; ++i)
+   {
+   a[i] = (i > 0)   ? ld[i] : 0.0;
+   b[i] = d[i];
+   c[i] = (i < n-1) ? ud[i] : 0.0;
+   }
+
+nfail = 0;
+
+/* ---- reduction: at level s, equation i = 2s-1, 4s-1, ...
+   absorbs equations i-s and i+s ---- */
+for (s = 1; 2 * s - 1 < n; s *= 2)
+   {
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(im, ip, alpha, gamma) \
+        reduction(+:nfail) if (n / (2 * s) > TRICR_PMIN)
+#endif
+   for (i = 2 * s - 1; i < n; i += 2 * s)
+      {
+      im = i - s;
+      ip = i + s;
+      if (fabs(b[im]) < TOL) { ++nfail; continue; }
+      alpha = -a[i] / b[im];
+      a[i]  = alpha * a[im];
+      b[i] += alpha * c[im];
+      x[i] += alpha * x[im];
+      if (ip < n)
+         {
+         if (fabs(b[ip]) < TOL) { ++nfail; continue; }
+         gamma = -c[i] / b[ip];
+         c[i]  = gamma * c[ip];
+         b[i] += gamma * a[ip];
+         x[i] += gamma * x[ip];
+         }
+      else
+         c[i] = 0.0;
+      }
+   if (nfail > 0)
+      {
+      *flag = 1;
+      goto LeaveTricr;
+      }
+   }
+
+/* ---- back substitution, from the top level down ---- */
+for ( ; s >= 1; s /= 2)
+   {
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(im, ip) \
+        reduction(+:nfail) if (n / (2 * s) > TRICR_PMIN)
+#endif
+   for (i = s - 1; i < n; i += 2 * s)
+      {
+      im = i - s;
+      ip = i + s;
+      if (fabs(b[i]) < TOL) { ++nfail; continue; }
+      if (im >= 0) x[i] -= a[i] * x[im];
+      if (ip < n)  x[i] -= c[i] * x[ip];
+      x[i] /= b[i];
+      }
+   if (nfail > 0)
+      {
+      *flag = 1;
+      goto LeaveTricr;
+      }
+   }
+
+LeaveTricr:
+if (c != NULL) free (c);
+if (b != NULL) free (b);
+if (a != NULL) free (a);
+return (0);
+}  /* end of tricr() */
+
+/*-----------------------------------------------------------------*/
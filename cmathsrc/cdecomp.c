@@ -0,0 +1,969 @@
+/* cdecomp.c
+   COMPLEX Matrix decomposition by Gaussian elimination */
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+#include "cmath.h"
+#if (STDLIBH)
+#include <stdlib.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+
+/*-----------------------------------------------------------------*/
+
+/* Blocking parameters for the elimination in cdecomp(), as for
+   decomp().  CDECOMP_NB columns are factored as a panel and then
+   applied to the rest of the matrix CDECOMP_JB columns at a time.
+   The update is done in tiles of CDECOMP_MR rows by CDECOMP_NR
+   columns held in local arrays.  The complex numbers are handled
+   as pairs of doubles (the layout of struct COMPLEX), with the
+   real and imaginary parts of each multiply-add written out, so
+   that the inner loops run over contiguous doubles and may be
+   vectorized by the compiler.  ccupdate() has one accumulator per
+   row so CDECOMP_MR must be 2.  When compiled for OpenMP
+   (PARALLEL in cmath.h) the row tiles of the update, the columns
+   of U to the right of the panel and the rows of the panel are
+   shared among threads for loops of more than CDECOMP_PMIN complex
+   multiply-adds.  */
+
+#define  CDECOMP_NB   64
+#define  CDECOMP_JB   192
+#define  CDECOMP_MR   2
+#define  CDECOMP_NR   8
+#define  CDECOMP_PMIN 16384L
+
+/* csolve_many() works on strips of the right-hand sides holding
+   about CDECOMP_SOLVEB complex numbers.  */
+
+#define  CDECOMP_SOLVEB 65536L
+
+#define  AINDEX(i,j) ((i) * ndim + (j))
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void ccrecip (double xr, double xi, double *zr, double *zi)
+
+#else
+
+static void ccrecip (xr, xi, zr, zi)
+double xr, xi, *zr, *zi;
+
+#endif
+
+/* Purpose ...
+   -------
+   z = 1 / x, scaled as in cdivsn() to avoid overflow.
+   x must not be zero.
+*/
+
+{
+double r, d;
+
+if (fabs(xr) >= fabs(xi))
+   {
+   r = xi / xr;
+   d = xr + r * xi;
+   *zr = 1.0 / d;
+   *zi = -r / d;
+   }
+else
+   {
+   r = xr / xi;
+   d = xi + r * xr;
+   *zr = r / d;
+   *zi = -1.0 / d;
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void ccupdate (int ndim, struct COMPLEX *a, int i1, int i2,
+                      int j1, int j2, int k1, int k2)
+
+#else
+
+static void ccupdate (ndim, a, i1, i2, j1, j2, k1, k2)
+
+int    ndim;
+struct COMPLEX *a;
+int    i1, i2, j1, j2, k1, k2;
+
+#endif
+
+/* Purpose ...
+   -------
+   Rank-(k2-k1) update of the block a[i1..i2-1][j1..j2-1]
+   a[i][j] -= sum over k1 <= k < k2 of a[i][k] * a[k][j]
+   (complex).
+*/
+
+{
+int    i, j, jj, jb, k, r, c;
+double c0[2*CDECOMP_NR], c1[2*CDECOMP_NR];
+double lr, li, l0r, l0i, l1r, l1i, *pb, *pc, *p0, *p1;
+
+for (jj = j1; jj < j2; jj += CDECOMP_JB)
+   {
+   jb = (jj + CDECOMP_JB < j2) ? jj + CDECOMP_JB : j2;
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) \
+        private(j, k, r, c, c0, c1, lr, li, l0r, l0i, l1r, l1i, \
+                pb, pc, p0, p1) \
+        if ((long) (i2 - i1) * (jb - jj) * (k2 - k1) > CDECOMP_PMIN)
+#endif
+   for (i = i1; i < i2; i += CDECOMP_MR)
+      {
+      if (i + CDECOMP_MR > i2)
+         {  /* odd row left over */
+         for (r = i; r < i2; ++r)
+            {
+            pc = (double *) (a + r * ndim);
+            for (k = k1; k < k2; ++k)
+               {
+               lr = pc[2*k];
+               li = pc[2*k+1];
+               pb = (double *) (a + k * ndim);
+               for (j = jj; j < jb; ++j)
+                  {
+                  pc[2*j]   -= lr * pb[2*j]   - li * pb[2*j+1];
+                  pc[2*j+1] -= lr * pb[2*j+1] + li * pb[2*j];
+                  }
+               }
+            }
+         continue;
+         }
+      for (j = jj; j + CDECOMP_NR <= jb; j += CDECOMP_NR)
+         {  /* the register tile */
+         for (c = 0; c < 2*CDECOMP_NR; ++c)
+            {
+            c0[c] = 0.0; c1[c] = 0.0;
+            }
+         p0 = (double *) (a + i * ndim);
+         p1 = (double *) (a + (i + 1) * ndim);
+         for (k = k1; k < k2; ++k)
+            {
+            pb = (double *) (a + k * ndim + j);
+            l0r = p0[2*k]; l0i = p0[2*k+1];
+            l1r = p1[2*k]; l1i = p1[2*k+1];
+            for (c = 0; c < 2*CDECOMP_NR; c += 2)
+               {
+               c0[c]   += l0r * pb[c]   - l0i * pb[c+1];
+               c0[c+1] += l0r * pb[c+1] + l0i * pb[c];
+               c1[c]   += l1r * pb[c]   - l1i * pb[c+1];
+               c1[c+1] += l1r * pb[c+1] + l1i * pb[c];
+               }
+            }
+         for (c = 0; c < 2*CDECOMP_NR; ++c)
+            {
+            p0[2*j+c] -= c0[c];
+            p1[2*j+c] -= c1[c];
+            }
+         }
+      if (j < jb)
+         {  /* odd columns left over */
+         for (r = i; r < i + CDECOMP_MR; ++r)
+            {
+            pc = (double *) (a + r * ndim);
+            for (k = k1; k < k2; ++k)
+               {
+               lr = pc[2*k];
+               li = pc[2*k+1];
+               pb = (double *) (a + k * ndim);
+               for (c = j; c < jb; ++c)
+                  {
+                  pc[2*c]   -= lr * pb[2*c]   - li * pb[2*c+1];
+                  pc[2*c+1] -= lr * pb[2*c+1] + li * pb[2*c];
+                  }
+               }
+            }
+         }
+      }
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void ccforsy (int n, int ndim, struct COMPLEX *a, int pivot[],
+                     int nswap, int ncol)
+
+#else
+
+static void ccforsy (n, ndim, a, pivot, nswap, ncol)
+
+int    n, ndim;
+struct COMPLEX *a;
+int    pivot[], nswap, ncol;
+
+#endif
+
+/* Purpose ...
+   -------
+   Convert the multipliers left by the blocked elimination (rows
+   fully interchanged, positive sign) to the form used by csolve().
+   The interchanges pivot[k], k < nswap, are undone in columns 0..k-1
+   and the multipliers in columns 0..ncol-1 are negated.
+*/
+
+{
+int    i, j, k, m, jmax;
+struct COMPLEX t, *pa, *pb;
+
+for (k = nswap-1; k > 0; --k)
+   {
+   m = pivot[k];
+   if (m == k) continue;
+   pa = a + m * ndim;
+   pb = a + k * ndim;
+   for (j = 0; j < k; ++j) { t = pa[j]; pa[j] = pb[j]; pb[j] = t; }
+   }
+for (i = 1; i < n; ++i)
+   {
+   pa   = a + i * ndim;
+   jmax = (i < ncol) ? i : ncol;
+   for (j = 0; j < jmax; ++j)
+      {
+      pa[j].re = -pa[j].re;
+      pa[j].im = -pa[j].im;
+      }
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int cdecomp (int n, int ndim,
+             struct COMPLEX *a, double *cond,
+             int pivot[], int *flag)
+
+#else
+
+int cdecomp (n, ndim, a, cond, pivot, flag)
+
+int    n,
+       ndim;
+struct COMPLEX *a;
+double *cond;
+int    pivot[],
+       *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Decomposes a COMPLEX matrix by gaussian elimination
+   and estimates the condition of the matrix.
+
+   Use csolve() or csolve_many() to compute solutions to linear
+   systems.
+
+   Input ...
+   -----
+   n    = order of the matrix
+   ndim = row dimension of matrix as defined in the calling program
+   *a   = pointer to the COMPLEX matrix to be triangularized
+
+   Output ...
+   ------
+   *a        = pointer to  an upper triangular matrix U and a
+	       permuted version of a lower triangular matrix I-L
+	       so that
+	       (permutation matrix) * a = L * U
+   cond      = an estimate of the condition of a .
+	       For the linear system a * x = b, changes in a and b
+	       may cause changes cond times as large in x.
+	       If cond+1.0 .eq. cond , a is singular to working
+	       precision, cond is set to 1.0e+32 if exact (or near)
+	       singularity is detected.
+   pivot     = the pivot vector.
+   pivot[k]  = the index of the k-th pivot row
+   pivot[n-1]= (-1)**(number of interchanges)
+   flag      = Status indicator
+               0 : successful execution
+               1 : could not allocate memory for workspace
+               2 : illegal user input n < 1, a == NULL,
+                   pivot == NULL, n > ndim.
+               3 : matrix is singular
+
+   Work Space ...
+   ----------
+   The vector work[0..n] is allocated internally by cdecomp().
+
+   This C code written by ...  Peter & Nigel,
+   ----------------------      Design Software,
+                               42 Gubberley St,
+                               Kenmore, 4069,
+                               Australia.
+
+   Version  ... 1.0 , 29-Oct-89
+   -------      2.0 , 19-Oct-26  (blocked elimination)
+
+   Notes ...
+   -----
+   (1) Subscripts range from 0 through (ndim-1).
+
+   (2) The determinant of a can be obtained on output by
+       det(a) = pivot[n-1] * a[0][0] * a[1][1] * ... * a[n-1][n-1].
+
+   (3) This routine has been adapted from that in the text
+       G.E. Forsythe, M.A. Malcolm & C.B. Moler
+       Computer Methods for Mathematical Computations.
+
+   (4) Uses the functions fabs(), free() and malloc().
+       the structure COMPLEX, and cmath routine cabslt.
+
+   (5) The elimination is done a panel of CDECOMP_NB columns at a
+       time, with whole rows interchanged, as in decomp().  The
+       multipliers are put back in the order and sign used by
+       Forsythe, Malcolm & Moler before returning, so csolve() and
+       the determinant formula above are unchanged.  The complex
+       arithmetic is written out in line rather than calling
+       cmultn() and cdivsn(); each pivot is inverted once.
+       Earlier versions skipped the update by multipliers smaller
+       than anorm * EPSILON; all multipliers are now applied.
+
+   (6) If compiled with OpenMP, the elimination for large n is
+       shared among the available threads.
+*/
+
+{   /* --- begin function cdecomp() --- */
+
+struct COMPLEX ek, t;
+double anorm, ynorm, znorm, tr, ti, pvtr, pr, pi, csum[CDECOMP_NR];
+int    i, j, k, m, kb, ke, jj, jb, nswap;
+struct COMPLEX *pa, *pb;      /* temporary pointers */
+struct COMPLEX *work;
+
+*flag = 0;
+work = (struct COMPLEX *) NULL;
+
+if (a == NULL || pivot == NULL || n < 1 || ndim < n)
+   {
+   *flag = 2;
+   return (0);
+   }
+
+pivot[n-1] = 1;
+if (n == 1)
+   {
+   /* One element only */
+   *cond = 1.0;
+   if (a[0].re == 0.0 && a[0].im == 0.0)
+      {
+      *cond = 1.0e+32;  /* singular */
+      *flag = 3;
+      return (0);
+      }
+   return (0);
+   }
+
+work = (struct COMPLEX *) malloc(n * sizeof(struct COMPLEX));
+if (work == NULL)
+   {
+   *flag = 1;
+   return (0);
+   }
+
+/* --- compute 1-norm of a, a row at a time for a strip
+   of columns --- */
+
+anorm = 0.0;
+for (jj = 0; jj < n; jj += CDECOMP_NR)
+   {
+   jb = (jj + CDECOMP_NR < n) ? jj + CDECOMP_NR : n;
+   for (j = jj; j < jb; ++j) csum[j-jj] = 0.0;
+   for (i = 0; i < n; ++i)
+      {
+      pa = a + AINDEX(i,0);
+      for (j = jj; j < jb; ++j) csum[j-jj] += cabslt(pa[j].re, pa[j].im);
+      }
+   for (j = jj; j < jb; ++j) if (csum[j-jj] > anorm) anorm = csum[j-jj];
+   }
+
+/* Apply Gaussian elimination with partial pivoting,
+   CDECOMP_NB columns at a time. */
+
+nswap = 0;
+for (kb = 0; kb < n; kb += CDECOMP_NB)
+   {
+   ke = (kb + CDECOMP_NB < n) ? kb + CDECOMP_NB : n;
+
+   /* Factor the panel of columns kb .. ke-1. */
+   for (k = kb; k < ke; ++k)
+      {
+      if (k < n-1)
+         {
+         /* Find pivot and label as row m.
+            This will be the element with largest magnitude in
+            the lower part of the kth column. */
+         m = k;
+         pa = a + AINDEX(m,k);
+         pvtr = cabslt(pa->re, pa->im);
+         for (i = k+1; i < n; ++i)
+            {
+            pa = a + AINDEX(i,k);
+            tr = cabslt(pa->re, pa->im);
+            if ( tr > pvtr )  { m = i; pvtr = tr; }
+            }
+         pivot[k] = m;
+         nswap = k + 1;
+
+         if (m != k)
+            {
+            pivot[n-1] = -pivot[n-1];
+            /* Interchange whole rows m and k. */
+            pa = a + AINDEX(m,0); pb = a + AINDEX(k,0);
+            for (j = 0; j < n; ++j)
+               {
+               t = pa[j]; pa[j] = pb[j]; pb[j] = t;
+               }
+            }
+         }
+      /* row k is now the pivot row */
+      pa = a + AINDEX(k,k);
+
+      /* Bail out if pivot is too small */
+      if (cabslt(pa->re, pa->im) < anorm * EPSILON)
+         {
+         /* Singular or nearly singular */
+         ccforsy (n, ndim, a, pivot, nswap, k);
+         for (i = nswap; i < n-1; ++i) pivot[i] = i;
+         *cond = 1.0e+32;
+         *flag = 3;
+         goto DecompExit;
+         }
+      ccrecip (pa->re, pa->im, &pr, &pi);
+
+      /* compute the multipliers in the k sub-column
+         and eliminate within the panel */
+      pb = a + AINDEX(k,0);
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(pa, tr, ti, j) \
+        if ((long) (n - k) * (ke - k) > CDECOMP_PMIN)
+#endif
+      for (i = k+1; i < n; ++i)
+         {
+         pa = a + AINDEX(i,0);
+         tr = pa[k].re * pr - pa[k].im * pi;
+         ti = pa[k].re * pi + pa[k].im * pr;
+         pa[k].re = tr;
+         pa[k].im = ti;
+         for (j = k+1; j < ke; ++j)
+            {
+            pa[j].re -= tr * pb[j].re - ti * pb[j].im;
+            pa[j].im -= tr * pb[j].im + ti * pb[j].re;
+            }
+         }
+      }
+
+   if (ke < n)
+      {
+      /* Rows of U to the right of the panel,
+         independently for each strip of columns. */
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(jb, i, k, j, tr, ti, pa, pb) \
+        if ((long) (ke - kb) * (ke - kb) * (n - ke) > 2 * CDECOMP_PMIN)
+#endif
+      for (jj = ke; jj < n; jj += CDECOMP_JB)
+         {
+         jb = (jj + CDECOMP_JB < n) ? jj + CDECOMP_JB : n;
+         for (i = kb+1; i < ke; ++i)
+            {
+            pa = a + AINDEX(i,0);
+            for (k = kb; k < i; ++k)
+               {
+               tr = pa[k].re;
+               ti = pa[k].im;
+               pb = a + AINDEX(k,0);
+               for (j = jj; j < jb; ++j)
+                  {
+                  pa[j].re -= tr * pb[j].re - ti * pb[j].im;
+                  pa[j].im -= tr * pb[j].im + ti * pb[j].re;
+                  }
+               }
+            }
+         }
+
+      /* Update the trailing matrix. */
+      ccupdate (ndim, a, ke, n, ke, n, kb, ke);
+      }
+
+   }  /* End of Gaussian elimination. */
+
+/* Undo the later interchanges in the columns of multipliers and
+   change their sign, for csolve(). */
+ccforsy (n, ndim, a, pivot, n-1, n-1);
+
+/* cond = (1-norm of a)*(an estimate of 1-norm of a-inverse)
+   estimate obtained by one step of inverse iteration for the
+   small singular vector. This involves solving two systems
+   of equations, (a-transpose)*y = e and a*z = y where e
+   is a vector of +1 or -1 chosen to cause growth in y.
+   estimate = (1-norm of z)/(1-norm of y)
+
+   Solve (a-transpose)*y = e   */
+
+for (k = 0; k < n; ++k)
+   {
+   t.re = 0.0;  t.im = 0.0;
+   for (i = 0; i < k; ++i)
+      {
+      pb = a + AINDEX(i,k);
+      t.re += pb->re * work[i].re - pb->im * work[i].im;
+      t.im += pb->re * work[i].im + pb->im * work[i].re;
+      }
+   ek.im = 0.0;
+   if (t.re < 0.0) ek.re = -1.0; else  ek.re = 1.0;
+   pa = a + AINDEX(k,k);
+   if (cabslt(pa->re, pa->im) < anorm * EPSILON)
+      {
+      /* Singular */
+      *cond = 1.0e+32;
+      *flag = 3;
+      goto DecompExit;
+      }
+
+   /* work[k] = -(ek + t) / *pa; */
+   tr = -(ek.re + t.re);
+   ti = -(ek.im + t.im);
+   ccrecip (pa->re, pa->im, &pr, &pi);
+   work[k].re = tr * pr - ti * pi;
+   work[k].im = tr * pi + ti * pr;
+   }
+
+for (k = n-2; k >= 0; --k)
+   {
+   t.re = 0.0;  t.im = 0.0;
+   for (i = k+1; i < n; i++)
+      {
+      pa = a + AINDEX(i,k);
+      t.re += pa->re * work[i].re - pa->im * work[i].im;
+      t.im += pa->re * work[i].im + pa->im * work[i].re;
+      /* we have used work[i] here, however the use of work[k]
+	 makes some difference to cond */
+      }
+   work[k] = t;
+   m = pivot[k];
+   if (m != k)
+      {
+      t = work[m]; work[m] = work[k]; work[k] = t;
+      }
+   }
+
+ynorm = 0.0;
+for (i = 0; i < n; ++i) ynorm += cabslt(work[i].re, work[i].im);
+
+/* --- solve a * z = y */
+csolve (n, ndim, a, work, pivot);
+
+znorm = 0.0;
+for (i = 0; i < n; ++i) znorm += cabslt(work[i].re, work[i].im);
+
+/* --- estimate condition --- */
+*cond = anorm * znorm / ynorm;
+if (*cond < 1.0) *cond = 1.0;
+if (*cond + 1.0 == *cond) *flag = 3;
+
+DecompExit:
+if (work != NULL) { free (work); work = (struct COMPLEX *) NULL; }
+return (0);
+}   /* --- end of function cdecomp() --- */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int csolve (int n, int ndim,
+           struct COMPLEX *a, struct COMPLEX b[],
+           int pivot[])
+
+#else
+
+int csolve (n, ndim, a, b, pivot)
+
+int    n,
+       ndim,
+       pivot[];
+struct COMPLEX *a, b[];
+
+#endif
+
+/* Purpose :
+   -------
+   Solution of a COMPLEX linear system, a * x = b.
+   Do not use if cdecomp() has detected singularity.
+
+   Input..
+   -----
+   n     = order of matrix
+   ndim  = row dimension of a
+   a     = triangularized matrix obtained from cdecomp()
+   b     = right hand side vector
+   pivot = pivot vector obtained from decomp()
+
+   Output..
+   ------
+   b = solution vector, x
+
+*/
+
+{   /* --- begin function solve() --- */
+
+int    i, j, k, m;
+struct COMPLEX t, *pa;
+double tr, ti, pr, pi;
+
+if (n == 1)
+   {
+   /* trivial  b[0] /= a[0] */
+   ccrecip (a[0].re, a[0].im, &pr, &pi);
+   t = b[0];
+   b[0].re = t.re * pr - t.im * pi;
+   b[0].im = t.re * pi + t.im * pr;
+   }
+else
+   {
+   /* Forward elimination: apply multipliers. */
+   for (k = 0; k < n-1; k ++)
+      {
+      m = pivot[k];
+      t = b[m]; b[m] = b[k]; b[k] = t;
+      for (i = k+1; i < n; ++i)
+         {
+         /* b[i] += a[AINDEX(i,k)] * t; */
+         pa = a + AINDEX(i,k);
+         b[i].re += pa->re * t.re - pa->im * t.im;
+         b[i].im += pa->re * t.im + pa->im * t.re;
+         }
+      }
+
+   /* Back substitution. */
+   for (k = n-1; k >= 0; --k)
+      {
+      tr = b[k].re;
+      ti = b[k].im;
+      pa = a + AINDEX(k,0);
+      for (j = k+1; j < n; ++j)
+         {
+         /* t -= a[AINDEX(k,j)] * b[j]; */
+         tr -= pa[j].re * b[j].re - pa[j].im * b[j].im;
+         ti -= pa[j].re * b[j].im + pa[j].im * b[j].re;
+         }
+      /* b[k] = t / a[AINDEX(k,k)]; */
+      ccrecip (pa[k].re, pa[k].im, &pr, &pi);
+      b[k].re = tr * pr - ti * pi;
+      b[k].im = tr * pi + ti * pr;
+      }
+   }
+
+return(0);
+}  /* --- end function solve() --- */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void ccaxpy (double tr, double ti, double *x, double *y,
+                    int j1, int j2)
+
+#else
+
+static void ccaxpy (tr, ti, x, y, j1, j2)
+double tr, ti, *x, *y;
+int    j1, j2;
+
+#endif
+
+/* Purpose ...
+   -------
+   y[j] += t * x[j], j = j1 .. j2-1, for complex t and complex
+   vectors x and y stored as pairs of doubles.
+*/
+
+{
+int j;
+
+for (j = 2*j1; j < 2*j2; j += 2)
+   {
+   y[j]   += tr * x[j]   - ti * x[j+1];
+   y[j+1] += tr * x[j+1] + ti * x[j];
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void ccstrip (int n, int ndim, struct COMPLEX *a, int pivot[],
+                     int bdim, struct COMPLEX *b, int j1, int j2)
+
+#else
+
+static void ccstrip (n, ndim, a, pivot, bdim, b, j1, j2)
+
+int    n, ndim;
+struct COMPLEX *a;
+int    pivot[], bdim;
+struct COMPLEX *b;
+int    j1, j2;
+
+#endif
+
+/* Purpose ...
+   -------
+   Forward elimination and back substitution, as for csolve(), on
+   columns j1 .. j2-1 of the right hand sides b.  Two pivot steps
+   (rows of U) are applied together so that each row of b is
+   loaded once for two complex multiply-adds.  Rows brought up by
+   an interchange in the middle of a pair are caught up first, as
+   in decomp().
+*/
+
+#define BINDEX(i,j) ((i) * bdim + (j))
+
+{
+int    i, j, k, m, q, c, kq, nlist, list[2], from[2];
+double t0r, t0i, t1r, t1i, tr, ti, pr, pi;
+double *pb, *pk, *p0, *p1;
+struct COMPLEX t, *bi, *bk;
+
+/* ---- Forward elimination, two pivot steps at a time. ---- */
+for (k = 0; k + 2 <= n-1; k += 2)
+   {
+   nlist = 0;
+   for (q = 0; q < 2; ++q)
+      {
+      kq = k + q;
+      m  = pivot[kq];
+      if (m > k+1)
+         {  /* row m has only been updated through column from[] */
+         for (i = 0; i < nlist && list[i] != m; ++i) ;
+         if (i == nlist) { list[i] = m; from[i] = k; ++nlist; }
+         for (c = from[i]; c < kq; ++c)
+            ccaxpy (a[AINDEX(m,c)].re, a[AINDEX(m,c)].im,
+                    (double *) (b + BINDEX(c,0)),
+                    (double *) (b + BINDEX(m,0)), j1, j2);
+         from[i] = kq;
+         }
+      bk = b + BINDEX(kq,0);
+      if (m != kq)
+         {
+         bi = b + BINDEX(m,0);
+         for (j = j1; j < j2; ++j) { t = bi[j]; bi[j] = bk[j]; bk[j] = t; }
+         }
+      if (q == 0)
+         ccaxpy (a[AINDEX(k+1,k)].re, a[AINDEX(k+1,k)].im,
+                 (double *) bk, (double *) (bk + bdim), j1, j2);
+      }
+
+   /* the deferred updates of the rows below the pair */
+   p0 = (double *) (b + BINDEX(k,0));
+   p1 = (double *) (b + BINDEX(k+1,0));
+   for (i = k+2; i < n; ++i)
+      {
+      pb = (double *) (b + BINDEX(i,0));
+      for (q = 0; q < nlist && list[q] != i; ++q) ;
+      if (q < nlist)
+         {
+         for (c = from[q]; c <= k+1; ++c)
+            ccaxpy (a[AINDEX(i,c)].re, a[AINDEX(i,c)].im,
+                    (double *) (b + BINDEX(c,0)), pb, j1, j2);
+         continue;
+         }
+      t0r = a[AINDEX(i,k)].re;   t0i = a[AINDEX(i,k)].im;
+      t1r = a[AINDEX(i,k+1)].re; t1i = a[AINDEX(i,k+1)].im;
+      for (j = 2*j1; j < 2*j2; j += 2)
+         {
+         pb[j]   += t0r * p0[j]   - t0i * p0[j+1]
+                  + t1r * p1[j]   - t1i * p1[j+1];
+         pb[j+1] += t0r * p0[j+1] + t0i * p0[j]
+                  + t1r * p1[j+1] + t1i * p1[j];
+         }
+      }
+   }
+
+/* the remaining pivot step */
+for ( ; k < n-1; ++k)
+   {
+   m  = pivot[k];
+   bk = b + BINDEX(k,0);
+   if (m != k)
+      {
+      bi = b + BINDEX(m,0);
+      for (j = j1; j < j2; ++j) { t = bi[j]; bi[j] = bk[j]; bk[j] = t; }
+      }
+   for (i = k+1; i < n; ++i)
+      ccaxpy (a[AINDEX(i,k)].re, a[AINDEX(i,k)].im,
+              (double *) bk, (double *) (b + BINDEX(i,0)), j1, j2);
+   }
+
+/* ---- Back substitution, two rows at a time. ---- */
+for (k = n-1; k >= 0; k -= 2)
+   {
+   if (k == 0)
+      {  /* the odd row at the top */
+      pk = (double *) (b + BINDEX(0,0));
+      for (i = 1; i < n; ++i)
+         {
+         tr = a[AINDEX(0,i)].re;
+         ti = a[AINDEX(0,i)].im;
+         pb = (double *) (b + BINDEX(i,0));
+         for (j = 2*j1; j < 2*j2; j += 2)
+            {
+            pk[j]   -= tr * pb[j]   - ti * pb[j+1];
+            pk[j+1] -= tr * pb[j+1] + ti * pb[j];
+            }
+         }
+      ccrecip (a[0].re, a[0].im, &pr, &pi);
+      for (j = 2*j1; j < 2*j2; j += 2)
+         {
+         tr = pk[j];
+         pk[j]   = tr * pr - pk[j+1] * pi;
+         pk[j+1] = tr * pi + pk[j+1] * pr;
+         }
+      break;
+      }
+   p0 = (double *) (b + BINDEX(k-1,0));
+   p1 = (double *) (b + BINDEX(k,0));
+   for (i = k+1; i < n; ++i)
+      {
+      t0r = a[AINDEX(k-1,i)].re; t0i = a[AINDEX(k-1,i)].im;
+      t1r = a[AINDEX(k,i)].re;   t1i = a[AINDEX(k,i)].im;
+      pb = (double *) (b + BINDEX(i,0));
+      for (j = 2*j1; j < 2*j2; j += 2)
+         {
+         p0[j]   -= t0r * pb[j]   - t0i * pb[j+1];
+         p0[j+1] -= t0r * pb[j+1] + t0i * pb[j];
+         p1[j]   -= t1r * pb[j]   - t1i * pb[j+1];
+         p1[j+1] -= t1r * pb[j+1] + t1i * pb[j];
+         }
+      }
+   /* the pair itself: row k, then row k-1 */
+   ccrecip (a[AINDEX(k,k)].re, a[AINDEX(k,k)].im, &pr, &pi);
+   for (j = 2*j1; j < 2*j2; j += 2)
+      {
+      tr = p1[j];
+      p1[j]   = tr * pr - p1[j+1] * pi;
+      p1[j+1] = tr * pi + p1[j+1] * pr;
+      }
+   t0r = a[AINDEX(k-1,k)].re;
+   t0i = a[AINDEX(k-1,k)].im;
+   ccrecip (a[AINDEX(k-1,k-1)].re, a[AINDEX(k-1,k-1)].im, &pr, &pi);
+   for (j = 2*j1; j < 2*j2; j += 2)
+      {
+      tr = p0[j]   - (t0r * p1[j]   - t0i * p1[j+1]);
+      ti = p0[j+1] - (t0r * p1[j+1] + t0i * p1[j]);
+      p0[j]   = tr * pr - ti * pi;
+      p0[j+1] = tr * pi + ti * pr;
+      }
+   }
+}
+
+#undef BINDEX
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int csolve_many (int n, int ndim,
+                 struct COMPLEX *a, int pivot[],
+                 int nrhs, int bdim, struct COMPLEX *b)
+
+#else
+
+int csolve_many (n, ndim, a, pivot, nrhs, bdim, b)
+
+int    n,
+       ndim;
+struct COMPLEX *a;
+int    pivot[],
+       nrhs,
+       bdim;
+struct COMPLEX *b;
+
+#endif
+
+/* Purpose :
+   -------
+   Solution of the COMPLEX linear systems a * X = B for several
+   right hand sides at once.
+   Do not use if cdecomp() has detected singularity.
+
+   Input..
+   -----
+   n     = order of matrix
+   ndim  = row dimension of a
+   a     = triangularized matrix obtained from cdecomp()
+   pivot = pivot vector obtained from cdecomp()
+   nrhs  = number of right hand sides
+   bdim  = row dimension of b, bdim >= nrhs
+   b     = the n by nrhs matrix of right hand sides, one
+           per column, b[i*bdim + j] = element i of column j
+
+   Output..
+   ------
+   b = the solutions, in place of the right hand sides
+
+   Notes ...
+   -----
+   (1) The columns of b are taken in strips chosen to stay in
+       cache and each element of the factors is read once per
+       strip, rather than once per right hand side as with
+       repeated calls to csolve().  The inner loops run along
+       the rows of a strip and may be vectorized by the compiler.
+   (2) If compiled with OpenMP, the strips are shared among
+       threads.
+*/
+
+{   /* --- begin function csolve_many() --- */
+
+int    jj, jb, nb;
+double pr, pi, tr;
+
+if (n < 1 || nrhs < 1) return (0);
+if (n == 1)
+   {
+   ccrecip (a[0].re, a[0].im, &pr, &pi);
+   for (jj = 0; jj < nrhs; ++jj)
+      {
+      tr = b[jj].re;
+      b[jj].re = tr * pr - b[jj].im * pi;
+      b[jj].im = tr * pi + b[jj].im * pr;
+      }
+   return (0);
+   }
+
+/* strip width, a multiple of 4 columns */
+nb = (int) (CDECOMP_SOLVEB / n);
+nb = (nb < 4) ? 4 : nb - nb % 4;
+
+#if (PARALLEL)
+#pragma omp parallel for schedule(dynamic) private(jb) \
+        if ((long) n * n * nrhs > CDECOMP_PMIN)
+#endif
+for (jj = 0; jj < nrhs; jj += nb)
+   {
+   jb = (jj + nb < nrhs) ? jj + nb : nrhs;
+   ccstrip (n, ndim, a, pivot, bdim, b, jj, jb);
+   }
+
+return (0);
+}  /* --- end function csolve_many() --- */
+
+/*-----------------------------------------------------------------*/
@@ -68,6 +68,10 @@
            = 0  -- don't bother looking
    PROTOTYPE = 1  -- use full function prototypes
              = 0  -- classical C; no prototypes
+   PARALLEL  = 1  -- share the large dense matrix operations
+                     among threads; set when the compiler is
+                     run with OpenMP enabled
+             = 0  -- single thread
 */
 
 #if (PE_UNIX || SUN3 || PYRAMID || HP_UX || CONVEX || APOLLO)
@@ -88,6 +92,12 @@
 #define  STRINGH  1
 #endif
 
+#ifdef _OPENMP
+#define  PARALLEL  1
+#else
+#define  PARALLEL  0
+#endif
+
 /*-----------------------------------------------------------------*/
 
 /* Machine epsilon :
@@ -111,6 +121,11 @@
 
 #define  EPSILON  2.2e-16
 
+/* The same for single precision (float) arithmetic, as used by
+   sdecomp() and mpsolve(). */
+
+#define  FEPSILON  1.2e-7
+
 /* Machine Overflow :
    ----------------
    The largest real number that can be represented. */
@@ -150,6 +165,115 @@ typedef struct BSPLSTRC  { int order;
                          double *knots;
                          double *cpnts; };
 
+/*  Workspace for the reentrant B-spline routines
+    intervw(), bsplvbw() and bsevalw().  */
+
+typedef struct BSPLWORK  { int order;
+                         int ilo;
+                         int j;
+                         double *deltal;
+                         double *deltar;
+                         double *values; };
+
+/*-----------------------------------------------------------------*/
+
+/*  The tensor-product spline structures.
+    -------------------------------------
+    See the file tpspline.c for details.  */
+
+typedef struct SPL2STRC  { int nx;
+                         int ny;
+                         double *x;
+                         double *y;
+                         double *coef; };
+
+typedef struct SPL3STRC  { int nx;
+                         int ny;
+                         int nz;
+                         double *x;
+                         double *y;
+                         double *z;
+                         double *coef; };
+
+/*-----------------------------------------------------------------*/
+
+/*  The sparse matrix structures.
+    -----------------------------
+    See the file sparse.c for details.  */
+
+typedef struct SPMAT  { int n;
+                      int nnz;
+                      int *rowptr;
+                      int *col;
+                      double *val; };
+
+typedef struct SPLU   { int n;
+                      int *q;
+                      int *pinv;
+                      int lnz, lmax;
+                      int *lp, *li;
+                      double *lx;
+                      int unz, umax;
+                      int *up, *ui;
+                      double *ux;
+                      int *cp, *ci;
+                      double *cx;
+                      double *w;
+                      int *iw; };
+
+/*  The preconditioner for the iterative solvers.
+    ---------------------------------------------
+    See the file krylov.c for details.  */
+
+#define  KPREC_NONE    0
+#define  KPREC_JACOBI  1
+#define  KPREC_ILU0    2
+#define  KPREC_USER    3
+
+#if (PROTOTYPE)
+typedef struct KPREC  { int type;
+                      int n;
+                      double *d;
+                      int *rowptr, *col, *diag;
+                      double *lu;
+                      int (*psolve)(int n, double r[], double z[]); };
+#else
+typedef struct KPREC  { int type;
+                      int n;
+                      double *d;
+                      int *rowptr, *col, *diag;
+                      double *lu;
+                      int (*psolve)(); };
+#endif
+
+/*  The accumulator for least squares on tall data.
+    -----------------------------------------------
+    See the file tsqr.c for details.  */
+
+typedef struct TSQR   { int n;
+                      long nrow;
+                      double *r;
+                      double *x;
+                      double *rb; };
+
+/*  The state of an rkf45r() integration.
+    -------------------------------------
+    See the file rkf45.c for details.  */
+
+typedef struct RKF45  { int neqn;
+                      double *f1, *f2, *f3, *f4, *f5;
+                      double savre, savae;
+                      int kop, init, jflag, kflag; };
+
+/*-----------------------------------------------------------------*/
+
+/*  Local spline methods.
+    ---------------------
+    See the file mspline.c for details.  */
+
+#define  MSPL_FRITSCH  0
+#define  MSPL_AKIMA    1
+
 /*-----------------------------------------------------------------*/
 
 /* Message handler definitions */
@@ -168,11 +292,33 @@ typedef struct BSPLSTRC  { int order;
 #define  CSOLVE_C    112
 #define  SVD_C       113
 #define  SVDSOLVE_C  114
+#define  BDECOMP_C   115
+#define  DECOMPNC_C  116
+#define  CONDEST_C   117
+#define  SDECOMP_C   118
+#define  MPSOLVE_C   119
+#define  SPDECOMP_C  120
+#define  SPORDER_C   121
+#define  SPCOLOR_C   122
+#define  KPRECINIT_C 123
+#define  CGSOLVE_C   124
+#define  GMRES_C     125
+#define  BICGSTAB_C  126
+#define  BTRIDIAG_C  127
+#define  BTRISOLV_C  128
+#define  TRICR_C     129
+#define  RSVD_C      130
+#define  TSQRINIT_C  131
+#define  TSQRADD_C   132
+#define  TSQRSOLV_C  133
+#define  SYMEIG_C    134
+#define  QRBATCH_C   135
 
 #define  ZEROIN_C    201
 #define  ZEROV_C     202
 #define  LAGUERRE_C  203
 #define  POLYROOT_C  204
+#define  ZEROVSP_C   205
 
 #define  SPLINE_C    301
 #define  SEVAL_C     302
@@ -185,15 +331,28 @@ typedef struct BSPLSTRC  { int order;
 #define  CHEBYI_C    309
 #define  FITPOLY_C   310
 #define  LSP_C       311
+#define  MSPLINE_C   312
+#define  MSPLRNG_C   313
+#define  MSPLUPD_C   314
+#define  SPL2MAKE_C  315
+#define  SPL2GRID_C  316
+#define  SPL3MAKE_C  317
 
 #define  BSPLINIT_C  320
-#define  BISECT_C    321
 #define  INTERV_C    322
 #define  BSPLVB_C    323
 #define  BSPLEND_C   324
 #define  BSEVAL_C    325
 #define  BSDCPNTS_C  326
 #define  BSPLINE_C   327
+#define  BSPWINIT_C  328
+#define  INTERVW_C   329
+#define  BSPLVBW_C   330
+#define  BSEVALW_C   331
+#define  BSEVALV_C   332
+#define  BSPLSQ_C    333
+#define  BSLSACC_C   334
+#define  BSLSSOLV_C  335
 
 #define  QK21_C      401
 #define  QK21INIT_C  402
@@ -205,11 +364,13 @@ typedef struct BSPLSTRC  { int order;
 #define  RKFINIT_C   502
 #define  RKFEND_C    503
 #define  FEHL45_C    504
+#define  RKFENS_C    505
 
 #define  STINT0_C    601
 #define  STINT1_C    602
 #define  STINT2_C    603
 #define  STINT3_C    604
+#define  STINT0SP_C  605
 
 #define  NELMIN_C    701
 #define  CONJGG_C    702
@@ -241,16 +402,34 @@ int  interv (double knots[],
              int numknots,
              double parameter,
              int *left, int *flag);
-int  bisect (void);
 /*  B-spline basis function calculation.  */
 int  bsplinit (int order, int *flag);
 int  bsplvb (double t[],  int jhigh, int index,
              double parameter, int left,
              double biatp[], int *flag);
 int  bsplend (void);
+/*  Reentrant versions, with the caller's workspace.  */
+int  bspwinit (int order, struct BSPLWORK *work, int *flag);
+int  bspwend (struct BSPLWORK *work);
+int  intervw (double knots[], int numknots, double parameter,
+              int *left, struct BSPLWORK *work, int *flag);
+int  bsplvbw (double t[],  int jhigh, int index,
+              double parameter, int left,
+              double biatp[], struct BSPLWORK *work, int *flag);
+double  bsevalw (int index, double parameter,
+                 struct BSPLSTRC *bspldefn,
+                 struct BSPLWORK *work, int *flag);
 /*  Fit B-spline to (x,y) data set.  */
 int  bspline (int number_of_data, double xdata[], double ydata[], int order,
               struct BSPLSTRC *xbspl, struct BSPLSTRC *ybspl, int *flag);
+/*  Least-squares B-spline fit.  */
+int  bsplsq (int n, double param[], double data[], double weight[],
+             struct BSPLSTRC *bspldefn, int *flag);
+int  bslsacc (struct BSPLSTRC *bspldefn, int n, double param[],
+              double data[], double weight[],
+              double ata[], double atb[], int *flag);
+int  bslssolv (struct BSPLSTRC *bspldefn, double ata[], double atb[],
+               int *flag);
 /*  Setup structure for  B-spline data.  */
 int  bsplmake (int order, int number_knots, double knots[],
                double cpnts[], struct BSPLSTRC *bspldefn, int *flag);
@@ -262,6 +441,10 @@ double  bseval (int index, double parameter,
 /*  B-spline derivative control points.  */
 int  bsdcpnts (struct BSPLSTRC *derivm1,
                struct BSPLSTRC *deriv, int *flag);
+/*  B-spline values at many parameter values.  */
+int  bsevalv (struct BSPLSTRC *bspldefn, struct BSPLSTRC *dbspldefn,
+              int n, double param[], double value[], double dvalue[],
+              int *flag);
 
 
 /*  Banded matrix solver.  */
@@ -269,6 +452,8 @@ int bandfac (double *w, int nroww, int nrow, int nbandl,
             int nbandu, int *flag);
 int bandslv (double *w, int nroww, int nrow, int nbandl, int nbandu,
                double b[]);
+int bandslvm (double *w, int nroww, int nrow, int nbandl, int nbandu,
+              int nrhs, int bdim, double *b);
 
 
 /* Some complex number bits. */
@@ -287,6 +472,9 @@ int cdecomp (int n, int ndim,
 int csolve (int n, int ndim,
            struct COMPLEX *a, struct COMPLEX b[],
            int pivot[]);
+int csolve_many (int n, int ndim,
+                 struct COMPLEX *a, int pivot[],
+                 int nrhs, int bdim, struct COMPLEX *b);
 
 
 /* Chebyshev polynomials */
@@ -331,6 +519,65 @@ int decomp (int n, int ndim,
 int solve (int n, int ndim,
            double *a, double b[],
            int pivot[]);
+/* Decompose without the condition estimate */
+int decompnc (int n, int ndim,
+              double *a, int pivot[],
+              double *anorm, int *flag);
+/* Estimate the condition of a decomposed matrix */
+int condest (int n, int ndim,
+             double *a, int pivot[],
+             double anorm, double *cond,
+             int *flag);
+/* Decompose and solve in single precision */
+int sdecomp (int n, int ndim,
+             float *a, int pivot[],
+             int *flag);
+int ssolve (int n, int ndim,
+            float *a, float b[],
+            int pivot[]);
+/* Mixed precision solution with iterative refinement */
+int mpsolve (int n, int ndim,
+             double *a, double b[], double x[],
+             double *cond, int *iter, int *flag);
+/* Sparse matrix decomposition and solution */
+int spluinit (struct SPLU *lu);
+int spdecomp (struct SPMAT *a, struct SPLU *lu, int *flag);
+int spsolve (struct SPLU *lu, double b[]);
+int spfree (struct SPLU *lu);
+int sporder (struct SPMAT *a, int q[], int *flag);
+int spcolor (struct SPMAT *a, int group[], int *ngroup, int *flag);
+int spmatvec (struct SPMAT *a, double x[], double y[]);
+/* Iterative solution of large linear systems */
+int kprecinit (struct SPMAT *a, int type, struct KPREC *prec, int *flag);
+int kprecfree (struct KPREC *prec);
+int cgsolve (int n,
+             int (*matvec)(int n, double x[], double y[]),
+             struct KPREC *prec,
+             double b[], double x[],
+             double tol, int maxit,
+             int *iter, double *resid, int *flag);
+int gmres (int n,
+           int (*matvec)(int n, double x[], double y[]),
+           struct KPREC *prec,
+           double b[], double x[],
+           int m, double tol, int maxit,
+           int *iter, double *resid, int *flag);
+int bicgstab (int n,
+              int (*matvec)(int n, double x[], double y[]),
+              struct KPREC *prec,
+              double b[], double x[],
+              double tol, int maxit,
+              int *iter, double *resid, int *flag);
+/* Solve for several right hand sides */
+int solve_many (int n, int ndim,
+                double *a, int pivot[],
+                int nrhs, int bdim, double *b);
+/* Decompose a batch of small matrices */
+int bdecomp (int n, int nbatch, int stride,
+             double *a, int *pivot, int *flag);
+/* Solve the batch of small systems */
+int bsolve (int n, int nbatch, int stride,
+            double *a, int *pivot, double *b);
 
 
 /* Discrete Fourier Transform */
@@ -445,6 +692,10 @@ int elmhes (int ndim, int n, int low, int igh,
             double *a, int *intg);
 int eltran (int ndim, int n, int low, int igh, double *a,
             int *intg, double *z);
+int orthes (int nm, int n, int low, int igh, double *a,
+            double *ort);
+int ortran (int nm, int n, int low, int igh, double *a,
+            double *ort, double *z);
 int hqr (int nm, int n, int Low, int igh, double *h,
          double *wr, double *wi, int *ierr);
 int hqr2 (int ndim, int n, int Low, int igh, double *h,
@@ -454,6 +705,12 @@ int balbak (int ndim, int n, int low, int igh, double *scale,
 int qrvector (int j, int nm, int n,
               double *z, double wr[], double wi[],
               double vr[], double vi[], int *flag);
+int qrbatch (int nmat, int n, double a[], double wr[], double wi[],
+             int ierr[], int *flag);
+
+/* eigensystem of a real symmetric matrix */
+int symeig (int nm, int n, double a[], double w[],
+            int matz, double z[], int il, int iu, int *ierr);
 
 
 /* adaptive Newton-Cotes quadrature */
@@ -481,6 +738,24 @@ int fehl45(int (*f)(int n, double t, double y[], double yp[]),
 int rkfinit (int n, int *fail);
 /* rkf45 clean-up */
 int rkfend (void);
+/* reentrant rkf45 with its own state */
+int rkf45init (int n, struct RKF45 *rk, int *fail);
+int rkf45r (struct RKF45 *rk,
+            int (*f)(int n, double t, double y[], double yp[]),
+            int n,
+            double y[], double yp[],
+            double *x1, double x2,
+            double *relerr, double abserr,
+            double *h,
+            int *nfe, int maxfe, int *flag);
+int rkf45free (struct RKF45 *rk);
+/* ensemble of trajectories with rkf45 error control */
+int rkfens (int (*f)(int n, int nlane, int ld, double t[],
+                     double y[], double yp[]),
+            int n, int ntraj,
+            double y[], double t[], double tout,
+            double relerr, double abserr, double h[],
+            int nfe[], int maxfe, int flag[]);
 
 
 /* Cubic spline coefficients */
@@ -504,10 +779,44 @@ double sinteg (int n, double u,
               double x[], double y[],
               double b[], double c[], double d[],
               int *last);
+/* local (Fritsch-Carlson or Akima) spline coefficients */
+int mspline (int n, int method,
+             double x[], double y[],
+             double b[], double c[], double d[],
+             int *flag);
+int msplrng (int n, int method, int lo, int hi,
+             double x[], double y[],
+             double b[], double c[], double d[],
+             int *flag);
+int msplupd (int n, int method, int k,
+             double x[], double y[],
+             double b[], double c[], double d[],
+             int *flag);
+/* bicubic and tricubic tensor-product splines */
+int spl2make (int nx, int ny,
+              double x[], double y[], double f[],
+              struct SPL2STRC *s, int *flag);
+int spl2dest (struct SPL2STRC *s);
+double spl2eval (double u, double v, struct SPL2STRC *s,
+                 int *lastx, int *lasty);
+int spl2evalv (struct SPL2STRC *s, int n,
+               double u[], double v[], double f[]);
+int spl2grid (struct SPL2STRC *s, int nu, double u[],
+              int nv, double v[], double f[], int *flag);
+int spl3make (int nx, int ny, int nz,
+              double x[], double y[], double z[], double f[],
+              struct SPL3STRC *s, int *flag);
+int spl3dest (struct SPL3STRC *s);
+double spl3eval (double u, double v, double w, struct SPL3STRC *s,
+                 int *lastx, int *lasty, int *lastz);
+int spl3evalv (struct SPL3STRC *s, int n,
+               double u[], double v[], double w[], double f[]);
 
 
 /* Stiff ODE intializer */
 int stint0(int n, int *fail);
+/* ... for a sparse jacobian */
+int stint0sp (int n, struct SPMAT *jpat, int *flag);
 /* Stiff ODE integrator */
 int stint1 (int n, double y[],
             double *x1, double x2,
@@ -537,6 +846,17 @@ int svd (int nm, int m, int n,
 int svdsolve (int nm, int m, int n,
     double u[], double w[], double v[], double b[], double x[],
     double tol, int *ierr);
+/* Truncated SVD by random projection. */
+int rsvd (int nm, int m, int n, double a[],
+          int k, int p, int q, double w[],
+          int matu, double u[], int matv, double v[],
+          int *ierr);
+/* Least squares on tall data, a block of rows at a time. */
+int tsqrinit (int n, struct TSQR *ts, int *flag);
+int tsqradd (struct TSQR *ts, int nrow, int lda, double a[], int *flag);
+int tsqrsolve (struct TSQR *ts, double relerr, double c[],
+               double *resid, int *flag);
+int tsqrfree (struct TSQR *ts);
 
 
 /* tridiagonal matrix solver */
@@ -547,6 +867,17 @@ int tridiag (int n,
 int trisolve (int n,
               double ld[], double d[], double ud[], double x[],
               int *flag);
+/* batches of tridiagonal systems */
+int btridiag (int n, int nbatch, int stride,
+              double ld[], double d[], double ud[],
+              int *flag);
+int btrisolve (int n, int nbatch, int stride,
+               double ld[], double d[], double ud[], double x[],
+               int *flag);
+/* one long system by cyclic reduction */
+int tricr (int n,
+           double ld[], double d[], double ud[], double x[],
+           int *flag);
 
 
 /* zero of a function */
@@ -565,6 +896,16 @@ double residsq (int n, double x[]);
 int dresid (int n, double x[], double dfdx[]);
 int jacobn (int n, int ndim, int (*f)(int n, double *x, double *fv),
             double *x, double *fv, double *dfdx, int *nfe);
+/* ... with a sparse jacobian */
+int zerovsp (int (*f)(int n, double *x, double *fv),
+             int (*jac) (int n, double *x, double *df),
+             struct SPMAT *jpat, int n,
+             double x[], double fvec[],
+             double xtol, double ftol,
+             int method, int *nfe, int *ifail);
+int jacobsp (int n, struct SPMAT *jpat, int group[], int ngroup,
+             int (*f)(int n, double *x, double *fv),
+             double *x, double *fv, double *val, int *nfe);
 
 
 #else
@@ -573,18 +914,27 @@ int jacobn (int n, int ndim, int (*f)(int n, double *x, double *fv),
 char   *cmathmsg ();             /* error message translator       */
 
 int     interv ();               /* B-spline knot vector interval search. */
-int     bisect ();
 int     bsplinit ();             /* B-spline basis function calculation. */
 int     bsplvb ();
 int     bsplend ();
+int     bspwinit ();             /* Reentrant B-spline workspace.       */
+int     bspwend ();
+int     intervw ();
+int     bsplvbw ();
+double  bsevalw ();
 int     bspline ();              /* Fit B-spline to (x,y) data set.     */
+int     bsplsq ();               /* Least-squares B-spline fit.         */
+int     bslsacc ();
+int     bslssolv ();
 int     bsplmake ();             /* Setup structure for  B-spline data. */
 int     bspldest ();             /* Free array memory in B-spline structure. */
 double  bseval ();               /* B-spline evaluation.                */
 int     bsdcpnts ();             /* B-spline derivative control points. */
+int     bsevalv ();              /* B-spline values at many parameters. */
 
 int    bandfac ();               /*  Banded matrix factorization    */
 int    bandslv ();
+int    bandslvm ();              /*  ... for many right hand sides   */
 
 int    csqroot ();               /* complex square-root            */
 double cabslt  ();               /* complex magnitude              */
@@ -593,6 +943,7 @@ int    cdivsn  ();               /* complex division               */
 
 int    cdecomp ();               /* Solve a COMPLEX matrix equation */
 int    csolve ();
+int    csolve_many ();           /* ... for several right sides    */
 
 int    chebyc ();                /* fit Chebyshev coefficients     */
 double cheby ();                 /* evaluate Chebyshev polynomials */
@@ -606,6 +957,26 @@ int    partiald ();              /* partial derivatives            */
 
 int    decomp ();                /* Decompose a square matrix      */
 int    solve  ();                /* Solve a linear system          */
+int    solve_many ();            /* ... for several right sides    */
+int    decompnc ();              /* decomp() without cond          */
+int    condest ();               /* condition of decomposed matrix */
+int    sdecomp ();               /* decomp() in single precision   */
+int    ssolve ();                /* solve() in single precision    */
+int    mpsolve ();               /* mixed precision solution       */
+int    bdecomp ();               /* Decompose a batch of matrices  */
+int    bsolve ();                /* ... and solve the systems      */
+int    spluinit ();              /* sparse LU structure            */
+int    spdecomp ();              /* Decompose a sparse matrix      */
+int    spsolve ();               /* ... and solve                  */
+int    spfree ();
+int    sporder ();               /* fill-reducing ordering         */
+int    spcolor ();               /* column groups for differences  */
+int    spmatvec ();              /* sparse matrix-vector product   */
+int    kprecinit ();             /* preconditioner for ...         */
+int    kprecfree ();
+int    cgsolve ();               /* ... conjugate gradients        */
+int    gmres ();                 /* ... GMRES(m)                   */
+int    bicgstab ();              /* ... BiCGSTAB                   */
 
 int    dft ();                   /* Discrete Fourier Transform     */
 int    chirpmult ();             /* multiply by Chirp function     */
@@ -648,10 +1019,14 @@ int    qrv ();                   /* eigenvalues and eigenvectors   */
 int    balanc ();                /* balance matrix                 */
 int    elmhes ();                /* reduce to upper Hessenberg     */
 int    eltran ();                /* accumulate transformations     */
+int    orthes ();                /* orthogonal Hessenberg reduction */
+int    ortran ();                /* accumulate orthes transforms   */
 int    hqr ();                   /* eigenvalues only               */
 int    hqr2 ();                  /* compute eigenvalues & vectors  */
 int    balbak ();                /* form eigenvectors              */
 int    qrvector ();              /* extract eigenvector from z     */
+int    qrbatch ();               /* eigenvalues, batch of matrices */
+int    symeig ();                /* symmetric eigensystem          */
 
 int    quanc8 ();                /* adaptive Newton-Cotes quadrature */
 
@@ -659,22 +1034,47 @@ int    rkf45   ();               /* ode integrator                 */
 int    fehl45  ();               /* single step part               */
 int    rkfinit ();               /* rkf45 initialization           */
 int    rkfend  ();               /* rkf45 clean-up                 */
+int    rkf45init ();             /* reentrant rkf45 ...            */
+int    rkf45r  ();
+int    rkf45free ();
+int    rkfens  ();               /* ensemble ode integrator        */
 
 int    spline ();                /* Cubic spline coefficients      */
 double seval  ();                /* spline evaluation              */
 double deriv  ();                /* derivative evaluation          */
 double sinteg ();                /* integral evaluation            */
+int    mspline ();               /* local spline coefficients      */
+int    msplrng ();               /* ... for a range of knots       */
+int    msplupd ();               /* ... after changing one knot    */
+int    spl2make ();              /* bicubic spline coefficients    */
+int    spl2dest ();
+double spl2eval ();              /* bicubic spline evaluation      */
+int    spl2evalv ();
+int    spl2grid ();
+int    spl3make ();              /* tricubic spline coefficients   */
+int    spl3dest ();
+double spl3eval ();              /* tricubic spline evaluation     */
+int    spl3evalv ();
 
 int    stint0 ();                /* Stiff ODE intializer           */
+int    stint0sp ();              /* ... for a sparse jacobian      */
 int    stint1 ();                /* easy-to-use stiff ODE integ.   */
 int    stint2 ();                /* difficult-to-use version       */
 int    stint3 ();                /* stint clean-up                 */
 
 int    svd ();                   /* Singular Value Decomposition   */
 int    svdsolve ();
+int    rsvd ();                  /* Truncated SVD, k largest        */
+int    tsqrinit ();              /* least squares on tall data     */
+int    tsqradd ();
+int    tsqrsolve ();
+int    tsqrfree ();
 
 int    tridiag ();               /* tridiagonal matrix solver      */
 int    trisolve ();              /* back-substitution              */
+int    btridiag ();              /* ... for a batch of systems     */
+int    btrisolve ();
+int    tricr ();                 /* cyclic reduction               */
 
 double zeroin ();                /* zero of a function             */
 
@@ -682,6 +1082,8 @@ int    zerov ();                 /* solution of simultaneous fns   */
 double residsq ();
 int    dresid ();
 int    jacobn ();
+int    zerovsp ();               /* ... with a sparse jacobian     */
+int    jacobsp ();
 
 #endif
 
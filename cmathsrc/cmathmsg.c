@@ -97,14 +97,6 @@ switch (routine)
          }
       break;
 
-   case BISECT_C :
-      switch (flag)
-         {
-         default :  strcpy (s, "bisect () :  no such error.");
-                    break;
-         }
-      break;
-
    case INTERV_C :
       switch (flag)
          {
@@ -166,6 +158,110 @@ switch (routine)
          }
       break;
 
+   case BSPWINIT_C :
+      switch (flag)
+         {
+         case 0  :  strcpy (s, "bspwinit () : normal return.");
+                    break;
+         case 1  :  strcpy (s, "bspwinit () : unable to reserve memory.");
+                    break;
+         default :  strcpy (s, "bspwinit () : no such error.");
+         }
+      break;
+
+   case INTERVW_C :
+      switch (flag)
+         {
+         case 0  :  strcpy (s, "intervw () : normal return.");
+                    break;
+         case -1 :  strcpy (s, "intervw () : parameter value < knot[0].");
+                    break;
+         case 1  :  strcpy (s, "intervw () : parameter value >= knot[maxi].");
+                    break;
+         default :  strcpy (s, "intervw () : no such error.");
+         }
+      break;
+
+   case BSPLVBW_C :
+      switch (flag)
+         {
+         case 0  :  strcpy (s, "bsplvbw () : normal return.");
+                    break;
+         case 1  :  strcpy (s, "bsplvbw () : workspace not allocated.");
+                    break;
+         case 2  :  strcpy (s, "bsplvbw () : invalid value for index.");
+                    break;
+         default :  strcpy (s, "bsplvbw () : no such error.");
+         }
+      break;
+
+   case BSEVALW_C :
+      switch (flag)
+         {
+         case 0  :  strcpy (s, "bsevalw () : normal return.");
+                    break;
+         case 1  :  strcpy (s, "bsevalw () : parameter value not valid.");
+                    break;
+         case 2  :  strcpy (s, "bsevalw () : workspace not allocated.");
+                    break;
+         default :  strcpy (s, "bsevalw () : no such error.");
+         }
+      break;
+
+   case BSEVALV_C :
+      switch (flag)
+         {
+         case 0  :  strcpy (s, "bsevalv () : normal return.");
+                    break;
+         case 1  :  strcpy (s, "bsevalv () : parameter value(s) not valid.");
+                    break;
+         case 2  :  strcpy (s, "bsevalv () : unable to reserve memory.");
+                    break;
+         default :  strcpy (s, "bsevalv () : no such error.");
+         }
+      break;
+
+   case BSPLSQ_C :
+      switch (flag)
+         {
+         case 0  :  strcpy (s, "bsplsq () : normal return.");
+                    break;
+         case 1  :  strcpy (s, "bsplsq () : unable to assign memory.");
+                    break;
+         case 2  :  strcpy (s, "bsplsq () : parameter out of knot range.");
+                    break;
+         case 3  :  strcpy (s, "bsplsq () : error in banded matrix solution.");
+                    break;
+         case 4  :  strcpy (s, "bsplsq () : invalid order or knots.");
+                    break;
+         default :  strcpy (s, "bsplsq () : no such error.");
+         }
+      break;
+
+   case BSLSACC_C :
+      switch (flag)
+         {
+         case 0  :  strcpy (s, "bslsacc () : normal return.");
+                    break;
+         case 1  :  strcpy (s, "bslsacc () : unable to assign memory.");
+                    break;
+         case 2  :  strcpy (s, "bslsacc () : parameter out of knot range.");
+                    break;
+         default :  strcpy (s, "bslsacc () : no such error.");
+         }
+      break;
+
+   case BSLSSOLV_C :
+      switch (flag)
+         {
+         case 0  :  strcpy (s, "bslssolv () : normal return.");
+                    break;
+         case 3  :  strcpy (s, "bslssolv () : error in banded matrix solution.");
+                    break;
+         default :  strcpy (s, "bslssolv () : no such error.");
+         }
+      break;
+
     case BSDCPNTS_C :
        switch (flag)
           {
@@ -192,6 +288,178 @@ switch (routine)
          };
       break;
 
+   case DECOMPNC_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "decompnc() : normal return");
+                   break;
+         case 2  : strcpy (s, "decompnc() : illegal user input");
+                   break;
+         case 3  : strcpy (s, "decompnc() : matrix is singular");
+                   break;
+         default : strcpy (s, "decompnc() : no such error");
+         };
+      break;
+
+   case CONDEST_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "condest() : normal return");
+                   break;
+         case 1  : strcpy (s, "condest() : could not allocate workspace");
+                   break;
+         case 2  : strcpy (s, "condest() : illegal user input");
+                   break;
+         default : strcpy (s, "condest() : no such error");
+         };
+      break;
+
+   case SDECOMP_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "sdecomp() : normal return");
+                   break;
+         case 2  : strcpy (s, "sdecomp() : illegal user input");
+                   break;
+         case 3  : strcpy (s, "sdecomp() : matrix is singular");
+                   break;
+         default : strcpy (s, "sdecomp() : no such error");
+         };
+      break;
+
+   case SPDECOMP_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "spdecomp() : normal return");
+                   break;
+         case 1  : strcpy (s, "spdecomp() : could not allocate workspace");
+                   break;
+         case 2  : strcpy (s, "spdecomp() : illegal user input");
+                   break;
+         case 3  : strcpy (s, "spdecomp() : matrix is singular");
+                   break;
+         default : strcpy (s, "spdecomp() : no such error");
+         };
+      break;
+
+   case SPORDER_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "sporder() : normal return");
+                   break;
+         case 1  : strcpy (s, "sporder() : could not allocate workspace");
+                   break;
+         case 2  : strcpy (s, "sporder() : illegal user input");
+                   break;
+         default : strcpy (s, "sporder() : no such error");
+         };
+      break;
+
+   case SPCOLOR_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "spcolor() : normal return");
+                   break;
+         case 1  : strcpy (s, "spcolor() : could not allocate workspace");
+                   break;
+         case 2  : strcpy (s, "spcolor() : illegal user input");
+                   break;
+         default : strcpy (s, "spcolor() : no such error");
+         };
+      break;
+
+   case KPRECINIT_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "kprecinit() : normal return");
+                   break;
+         case 1  : strcpy (s, "kprecinit() : could not allocate workspace");
+                   break;
+         case 2  : strcpy (s, "kprecinit() : illegal user input");
+                   break;
+         case 3  : strcpy (s, "kprecinit() : zero diagonal element or pivot");
+                   break;
+         default : strcpy (s, "kprecinit() : no such error");
+         };
+      break;
+
+   case CGSOLVE_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "cgsolve() : normal return");
+                   break;
+         case 1  : strcpy (s, "cgsolve() : could not allocate workspace");
+                   break;
+         case 2  : strcpy (s, "cgsolve() : illegal user input");
+                   break;
+         case 3  : strcpy (s, "cgsolve() : did not converge");
+                   break;
+         case 4  : strcpy (s, "cgsolve() : matrix not positive definite");
+                   break;
+         default : strcpy (s, "cgsolve() : no such error");
+         };
+      break;
+
+   case GMRES_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "gmres() : normal return");
+                   break;
+         case 1  : strcpy (s, "gmres() : could not allocate workspace");
+                   break;
+         case 2  : strcpy (s, "gmres() : illegal user input");
+                   break;
+         case 3  : strcpy (s, "gmres() : did not converge");
+                   break;
+         default : strcpy (s, "gmres() : no such error");
+         };
+      break;
+
+   case BICGSTAB_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "bicgstab() : normal return");
+                   break;
+         case 1  : strcpy (s, "bicgstab() : could not allocate workspace");
+                   break;
+         case 2  : strcpy (s, "bicgstab() : illegal user input");
+                   break;
+         case 3  : strcpy (s, "bicgstab() : did not converge");
+                   break;
+         case 4  : strcpy (s, "bicgstab() : breakdown");
+                   break;
+         default : strcpy (s, "bicgstab() : no such error");
+         };
+      break;
+
+   case MPSOLVE_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "mpsolve() : normal return");
+                   break;
+         case 1  : strcpy (s, "mpsolve() : could not allocate workspace");
+                   break;
+         case 2  : strcpy (s, "mpsolve() : illegal user input");
+                   break;
+         case 3  : strcpy (s, "mpsolve() : matrix is singular");
+                   break;
+         default : strcpy (s, "mpsolve() : no such error");
+         };
+      break;
+
+   case BDECOMP_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "bdecomp() : normal return");
+                   break;
+         case 2  : strcpy (s, "bdecomp() : illegal user input");
+                   break;
+         case 3  : strcpy (s, "bdecomp() : one or more matrices singular");
+                   break;
+         default : strcpy (s, "bdecomp() : no such error");
+         };
+      break;
+
    case CDECOMP_C :
       switch (flag)
          {
@@ -227,6 +495,65 @@ switch (routine)
          }
       break;
 
+   case RSVD_C :
+      if (flag > 0)
+         {
+         strcpy (s, "rsvd() : svd() of the projection failed");
+         }
+      else
+         {
+         switch (flag)
+            {
+            case 0  : strcpy (s, "rsvd() : normal return");
+                      break;
+            case -1 : strcpy (s, "rsvd() : could not allocate workspace");
+                      break;
+            case -2 : strcpy (s, "rsvd() : invalid user input");
+                      break;
+            default : strcpy (s, "rsvd() : no such error");
+            };
+         }
+      break;
+
+   case TSQRINIT_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "tsqrinit() : normal return");
+                   break;
+         case 1  : strcpy (s, "tsqrinit() : could not allocate workspace");
+                   break;
+         case 2  : strcpy (s, "tsqrinit() : invalid user input");
+                   break;
+         default : strcpy (s, "tsqrinit() : no such error");
+         };
+      break;
+
+   case TSQRADD_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "tsqradd() : normal return");
+                   break;
+         case 2  : strcpy (s, "tsqradd() : invalid user input");
+                   break;
+         default : strcpy (s, "tsqradd() : no such error");
+         };
+      break;
+
+   case TSQRSOLV_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "tsqrsolve() : normal return");
+                   break;
+         case 1  : strcpy (s, "tsqrsolve() : could not allocate workspace");
+                   break;
+         case 2  : strcpy (s, "tsqrsolve() : invalid user input");
+                   break;
+         case 3  : strcpy (s, "tsqrsolve() : svd() did not converge");
+                   break;
+         default : strcpy (s, "tsqrsolve() : no such error");
+         };
+      break;
+
    case SVDSOLVE_C :
       switch (flag)
          {
@@ -264,6 +591,47 @@ switch (routine)
          };
       break;
 
+   case BTRIDIAG_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "btridiag() : normal return");
+                   break;
+         case 1  : strcpy (s, "btridiag() : elimination failure");
+                   break;
+         case 2  : strcpy (s, "btridiag() : illegal user input");
+                   break;
+         default : strcpy (s, "btridiag() : no such error");
+         };
+      break;
+
+   case BTRISOLV_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "btrisolve() : normal return");
+                   break;
+         case 1  : strcpy (s, "btrisolve() : back-substitution failure");
+                   break;
+         case 2  : strcpy (s, "btrisolve() : illegal user input");
+                   break;
+         default : strcpy (s, "btrisolve() : no such error");
+         };
+      break;
+
+   case TRICR_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "tricr() : normal return");
+                   break;
+         case 1  : strcpy (s, "tricr() : elimination failure");
+                   break;
+         case 2  : strcpy (s, "tricr() : illegal user input");
+                   break;
+         case 3  : strcpy (s, "tricr() : could not allocate workspace");
+                   break;
+         default : strcpy (s, "tricr() : no such error");
+         };
+      break;
+
    case INVERT_C :
       switch (flag)
          {
@@ -319,6 +687,39 @@ switch (routine)
          }
       break;
 
+   case SYMEIG_C :
+      if (flag > 0)
+         {
+         strcpy (s, "symeig() : too many iterations required");
+         }
+      else
+         {
+         switch (flag)
+            {
+            case 0  : strcpy (s, "symeig() : normal return");
+                      break;
+            case -1 : strcpy (s, "symeig() : could not allocate workspace");
+                      break;
+            case -2 : strcpy (s, "symeig() : invalid user input");
+                      break;
+            default : strcpy (s, "symeig() : no such error");
+            };
+         }
+      break;
+
+   case QRBATCH_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "qrbatch() : normal return");
+                   break;
+         case 1  : strcpy (s, "qrbatch() : invalid user input");
+                   break;
+         case 2  : strcpy (s, "qrbatch() : some matrices did not converge");
+                   break;
+         default : strcpy (s, "qrbatch() : no such error");
+         };
+      break;
+
    case QRVECTOR_C :
       switch (flag)
          {
@@ -366,6 +767,25 @@ switch (routine)
          };
       break;
 
+   case ZEROVSP_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "zerovsp() : normal return");
+                   break;
+         case 1  : strcpy (s, "zerovsp() : invalid user input");
+                   break;
+         case 2  : strcpy (s, "zerovsp() : could not allocate workspace");
+                   break;
+         case 3  : strcpy (s, "zerovsp() : did not converge");
+                   break;
+         case 5  : strcpy (s, "zerovsp() : Newton-Raphson diverging");
+                   break;
+         case 6  : strcpy (s, "zerovsp() : singular Jacobian");
+                   break;
+         default : strcpy (s, "zerovsp() : no such error");
+         };
+      break;
+
    case POLYROOT_C :
       switch (flag)
          {
@@ -396,6 +816,96 @@ switch (routine)
          };
       break;
 
+   case MSPLINE_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "mspline() : normal return");
+                   break;
+         case 1  : strcpy (s, "mspline() : n < 2, cannot interpolate");
+                   break;
+         case 2  : strcpy (s, "mspline() : x[i] not in ascending order");
+                   break;
+         case 3  : strcpy (s, "mspline() : invalid value for method");
+                   break;
+         default : strcpy (s, "mspline() : no such error");
+         };
+      break;
+
+   case MSPLRNG_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "msplrng() : normal return");
+                   break;
+         case 1  : strcpy (s, "msplrng() : n < 2, cannot interpolate");
+                   break;
+         case 2  : strcpy (s, "msplrng() : x[i] not in ascending order");
+                   break;
+         case 3  : strcpy (s, "msplrng() : invalid value for method");
+                   break;
+         case 4  : strcpy (s, "msplrng() : invalid range lo .. hi");
+                   break;
+         default : strcpy (s, "msplrng() : no such error");
+         };
+      break;
+
+   case MSPLUPD_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "msplupd() : normal return");
+                   break;
+         case 1  : strcpy (s, "msplupd() : n < 2, cannot interpolate");
+                   break;
+         case 2  : strcpy (s, "msplupd() : x[i] not in ascending order");
+                   break;
+         case 3  : strcpy (s, "msplupd() : invalid value for method");
+                   break;
+         case 4  : strcpy (s, "msplupd() : k out of range");
+                   break;
+         default : strcpy (s, "msplupd() : no such error");
+         };
+      break;
+
+   case SPL2MAKE_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "spl2make() : normal return");
+                   break;
+         case 1  : strcpy (s, "spl2make() : n < 2 along an axis");
+                   break;
+         case 2  : strcpy (s, "spl2make() : knots not in ascending order");
+                   break;
+         case 3  : strcpy (s, "spl2make() : could not allocate memory");
+                   break;
+         default : strcpy (s, "spl2make() : no such error");
+         };
+      break;
+
+   case SPL2GRID_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "spl2grid() : normal return");
+                   break;
+         case 3  : strcpy (s, "spl2grid() : could not allocate workspace");
+                   break;
+         default : strcpy (s, "spl2grid() : no such error");
+         };
+      break;
+
+   case SPL3MAKE_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "spl3make() : normal return");
+                   break;
+         case 1  : strcpy (s, "spl3make() : n < 2 along an axis");
+                   break;
+         case 2  : strcpy (s, "spl3make() : knots not in ascending order");
+                   break;
+         case 3  : strcpy (s, "spl3make() : could not allocate memory");
+                   break;
+         default : strcpy (s, "spl3make() : no such error");
+         };
+      break;
+
    case FITSPL_C :
       switch (flag)
          {
@@ -606,6 +1116,26 @@ switch (routine)
       strcpy (s, "rkfend() : no such error");
       break;
 
+   case RKFENS_C :
+      if (flag > 0)
+         {
+         strcpy (s, "rkfens() : some trajectories did not reach tout");
+         }
+      else
+         {
+         switch (flag)
+            {
+            case 0  : strcpy (s, "rkfens() : normal return");
+                      break;
+            case -1 : strcpy (s, "rkfens() : invalid user input");
+                      break;
+            case -2 : strcpy (s, "rkfens() : could not allocate workspace");
+                      break;
+            default : strcpy (s, "rkfens() : no such error");
+            };
+         }
+      break;
+
    case STINT0_C :
       switch (flag)
          {
@@ -619,6 +1149,19 @@ switch (routine)
          };
       break;
 
+   case STINT0SP_C :
+      switch (flag)
+         {
+         case 0  : strcpy (s, "stint0sp() : normal return");
+                   break;
+         case 1  : strcpy (s, "stint0sp() : illegal value for n");
+                   break;
+         case 2  : strcpy (s, "stint0sp() : no workspace or invalid pattern");
+                   break;
+         default : strcpy (s, "stint0sp() : no such error");
+         };
+      break;
+
    case STINT1_C :
       if (flag > 0)
          {
@@ -640,6 +1183,8 @@ switch (routine)
                       break;
             case -6 : strcpy (s, "stint1() : corrector did not converge");
                       break;
+            case -8 : strcpy (s, "stint1() : could not allocate workspace");
+                      break;
             default : strcpy (s, "stint1() : no such error");
             };
          }
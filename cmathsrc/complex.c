@@ -0,0 +1,2187 @@
+/* complex.c
+   Complex number arithmetic.
+*/
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+/*
+
+Purpose ...
+-------
+This file provides a set of functions for complex number arithmetic
+based on a stack (similar in operation to the Hewlett-Packard
+calculators).  The operations generally involve one or two stack
+elements as operands.  These operands are obtained from the top of
+the stack and on return the result is left as the top element
+on the stack.
+
+Although the routines are not written for speed I hope that
+they will be robust as their FORTRAN counterparts.
+
+The list of functions follows.  Note that operands are stored
+on the stack in cartesian form.  This format is assumed by
+all routines except Cart() which expects the top element to be
+in polar form.   Most of the functions return an integer
+completion code.  For more details see the the notes at the
+start of each function.
+
+1. constants
+   ---------
+   zeroC = (0.0, 0.0)
+   oneC  = (1.0, 0.0)
+   imgC  = (0.0, 1.0)
+
+2. data conversions
+   ----------------
+   Cmplx(x, y, *z)    -- convert the two real elements to a complex number
+   x = Creal(*z)      -- return the real part of z
+   y = Cimag(*z)      -- return the complex part of z
+
+3. stack operations
+   ----------------
+   Cinit(n)       -- create a stack of n elements
+   Cend()         -- remove the complex stack
+   Creset()       -- reset the stack
+   Cpush(*z)      -- push z onto the top of the stack
+   Cpop(*z)       -- Pop the top element from the top of the stack and
+		     store as z
+   Cpushr(x)      -- push the real number x onto the stack
+   Cpopr(*x)      -- pop the real number x from the top of the stack
+   Cdrop()        -- drop top element from stack
+   Cdup()         -- duplicate the top element of the stack
+   Cswap()        -- swap the top two elements of the stack
+
+   Cprint(n)      -- print the top n stack elements without consuming
+		     them (useful for debugging)
+
+   Each of the stack, arithmetic and function routines in sections
+   3 to 5 also comes in a form that works on a stack context
+   struct CSTACK *s given as the first argument.  These are named
+   with "Cs" in place of "C" (Conjg becomes Csconjg), for example
+   Csinit(s, n), Cspush(s, *z), Csadd(s) and Cssin(s).  A context
+   holds its own stack so separate threads may each use their own.
+   The forms without the context work on a default stack; when
+   compiled with OpenMP each thread has its own default stack,
+   created by that thread's call to Cinit().
+
+4. arithmetic operations
+   ---------------------
+   Cadd()         -- pop the top two elements off the stack, add them
+		     and push the result back onto the stack
+   Csub()         -- subtract the second top element from the top
+   Cmult()        -- multiplicatiom
+   Cdiv()         -- divide the second top element by the top element
+   Cinv()         -- invert the top element
+   Cneg()         -- negate the top element
+   Conjg()        -- take the conjugate of the top element
+
+   Cmag(*x)       -- returns the magnitude of the top element in x
+   Cpolar()       -- convert the top element into polar coordinate form
+   Cart()         -- convert from polar to cartesian form
+
+5. functions
+   ---------
+   Cpow(r)        -- (top element)**r
+   Csqrt()        -- square root of top element
+
+   Cexp()         -- complex exponential
+   Clog()         -- natural logarithm
+
+   Csin()         -- complex sine
+   Ccos()         -- complex cosine
+   Ctan()         -- complex tangent
+
+6. bulk evaluation
+   ---------------
+   Crpn(nop, prog, nvar, var, npts, result, ierr)
+                  -- run a program of stack operations for each of
+                     npts sets of values of the variables var
+
+This C code written by ...  Peter & Nigel,
+----------------------      Design Software,
+                            42 Gubberley St,
+                            Kenmore, 4069,
+                            Australia.
+
+Version ... 1.0,  October 1987
+-------     2.0,  April   1988
+            2.1,  April   1989   stack now allocated dynamically
+            2.2,  July    1989   full function prototypes
+            3.0,  October 2026   stack contexts, Crpn(); fixed the
+                                 sign of Csin() and Ctan(), the
+                                 argument in Cpolar(), Clog() and
+                                 Cpow(), and Cmult() of zero
+
+Notes ...
+-----
+(1) The COMPLEX structure definition appears in complex.h.
+(2) This file needs the standard maths library and the standard I/O
+    library.
+(3) This is not the first such set of routines.  See, for example,
+    [2].  See [3] for a stack (implemented as a linked-list) oriented
+    set of routines.
+
+References ...
+----------
+[1] J.H. Wilkinson & C. Reinsch : "Handbook for automatic computation.
+    vol II. Linear Algebra".  Springer-Verlag 1971
+[2] D. Gedeon : "Complex math in Pascal". Byte July 1987.
+[3] J.T. Lapreste : "A Pascal tool for complex numbers". Journal of
+    Pacsal, Ada & Modula-2, May-June 1985.
+[4] P.H. Sterbenz : "Floating point computation". Prentice-Hall 1974.
+
+-------------------------------------------------------------------
+*/
+#include "cmath.h"
+#include "complex.h"
+
+#if (STDLIBH)
+#include <stdlib.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+/*-----------------------------------------------------------------*/
+
+/* global "COMPLEX" definitions */
+
+struct COMPLEX zeroC = {0.0, 0.0};
+struct COMPLEX oneC  = {1.0, 0.0};
+struct COMPLEX imgC  = {0.0, 1.0};
+
+/* the stack used by the functions without a context */
+static struct CSTACK Zdefault = {NULL, NULL, NULL, NULL, 0};
+#if (PARALLEL)
+#pragma omp threadprivate(Zdefault)
+#endif
+
+/*-----------------------------------------------------------------*/
+
+/* -------------------
+   2. data conversions
+   ------------------- */
+
+#if (PROTOTYPE)
+
+int Cmplx (double x, double y, struct COMPLEX *z)
+
+#else
+
+int Cmplx (x, y, z)
+double  x, y;
+struct COMPLEX *z;
+
+#endif
+
+/* Purpose ... convert the two real values into a complex value
+   Input   ... x  ... the real part
+	       y  ... the imaginary part
+               *z  ... pointer to the complex number
+   Output  ... none
+*/
+{
+z->re = x;
+z->im = y;
+return(0);
+}
+
+
+
+#if (PROTOTYPE)
+
+double Creal (struct COMPLEX *z)
+
+#else
+
+double Creal (z)
+struct COMPLEX *z;
+
+#endif
+
+/* Purpose ... return the real part of a complex value
+   Input   ... *z  ... pointer to the complex number
+   Output  ... real part of z
+*/
+{
+return (z->re);
+}
+
+
+
+#if (PROTOTYPE)
+
+double Cimag (struct COMPLEX *z)
+
+#else
+
+double Cimag (z)
+struct COMPLEX *z;
+
+#endif
+
+/* Purpose ... return the imaginary part of a complex value
+   Input   ... *z  ... pointer to the complex number
+   Output  ... imaginary part of z
+*/
+{
+return (z->im);
+}
+
+
+/* -------------------
+   3. stack operations
+   ------------------- */
+
+#if (PROTOTYPE)
+
+int Csinit (struct CSTACK *s, int n)
+
+#else
+
+int Csinit (s, n)
+struct CSTACK *s;
+int n;
+
+#endif
+
+/* Purpose ... Create the complex stack
+   Input   ... *s = the stack context
+               n  = number of elements
+   Output  ... 0 = successfully allocated stack
+               1 = something has gone wrong
+   Note    ... the new stack is empty, as after Csreset()
+*/
+{
+s->stack = (struct COMPLEX *) NULL;
+s->nmax = 0;
+if (n > 0) s->stack = (struct COMPLEX *) malloc(n * sizeof(struct COMPLEX));
+if (s->stack == NULL)
+   {
+   printf ("\nCinit() -- Cannot allocate space for complex stack.");
+   return (1);
+   }
+s->nmax = n;
+Csreset (s);
+return(0);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Csend (struct CSTACK *s)
+
+#else
+
+int Csend (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... Remove the complex stack
+   Input   ... *s = the stack context
+   Output  ... none
+*/
+{
+if (s->stack != NULL)
+   {
+   free (s->stack);
+   s->stack = (struct COMPLEX *) NULL;
+   }
+s->nmax = 0;
+return(0);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Csreset (struct CSTACK *s)
+
+#else
+
+int Csreset (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... Reset the stack and its pointers
+   Input   ... *s = the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. there is no stack
+*/
+{
+if (s->stack == NULL) return (1);
+s->bot = &s->stack[0];
+s->top = s->bot - 1;
+s->max = &s->stack[s->nmax - 1];
+s->bot->re = 0.0;
+s->bot->im = 0.0;
+return(0);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Cspush (struct CSTACK *s, struct COMPLEX *z)
+
+#else
+
+int Cspush (s, z)
+struct CSTACK *s;
+struct COMPLEX *z;
+
+#endif
+
+/* Purpose ... push the complex number z onto the stack
+   Input   ... *z .. pointer to the complex number
+   Output  ... return flag = 0 .. successful
+			   = 1 .. stack overflow
+*/
+{
+int flag;
+if (s->top < s->max)
+   {  /* push the element onto the stack */
+   ++s->top;
+   s->top->re = z->re;
+   s->top->im = z->im;
+   flag = 0;
+   }
+else flag = 1;  /* stack overflow */
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Cspop (struct CSTACK *s, struct COMPLEX *z)
+
+#else
+
+int Cspop (s, z)
+struct CSTACK *s;
+struct COMPLEX *z;
+
+#endif
+
+/* Purpose ... pop the top stack element into the complex number z
+   Input   ... *z .. pointer to the complex number
+   Output  ... return flag = 0 .. successful
+			   = 1 .. stack underflow
+*/
+{
+int flag;
+if (s->top >= s->bot)
+   {  /* get the element off the stack */
+   z->re = s->top->re;
+   z->im = s->top->im;
+   --s->top;
+   flag = 0;
+   }
+else flag = 1;  /* stack underflow */
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Cspushr (struct CSTACK *s, double x)
+
+#else
+
+int Cspushr (s, x)
+struct CSTACK *s;
+double x;
+
+#endif
+
+/* Purpose ... push the real number x onto the stack
+   Input   ... x .. the real number
+   Output  ... return flag = 0 .. successful
+			   = 1 .. stack overflow
+*/
+{
+int flag;
+if (s->top < s->max)
+   {  /* push the element onto the stack */
+   ++s->top;
+   s->top->re = x;
+   s->top->im = 0.0;
+   flag = 0;
+   }
+else flag = 1;  /* stack overflow */
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Cspopr (struct CSTACK *s, double *x)
+
+#else
+
+int Cspopr (s, x)
+struct CSTACK *s;
+double *x;
+
+#endif
+
+/* Purpose ... pop the real part of the top stack element into x
+   Input   ... *x .. pointer to the real number
+   Output  ... return flag = 0 .. successful
+			   = 1 .. stack underflow
+*/
+{
+int flag;
+if (s->top >= s->bot)
+   {  /* get the element off the stack */
+   *x = s->top->re;
+   --s->top;
+   flag = 0;
+   }
+else flag = 1;  /* stack underflow */
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Csprint (struct CSTACK *s, int n)
+
+#else
+
+int Csprint (s, n)
+struct CSTACK *s;
+int n;
+
+#endif
+
+/* Purpose ... print the top n elements of the stack
+   Input   ... n .. number of elements to print
+   Output  ... none
+*/
+{
+int    i, used;
+struct COMPLEX *ztemp;
+used = (int) (s->top - s->bot) + 1;
+printf ("\nComplex Stack size = %d, elements used = %d\n",
+        s->nmax, used);
+printf ("Stack Contents (z[1] is top of stack)...\n");
+ztemp = s->top;
+i = 1;
+while ((i <= n) && (ztemp >= s->bot))
+   {
+   printf ("z[%d] = (%f, %f)\n", i, ztemp->re, ztemp->im);
+   ++i;
+   --ztemp;
+   }
+return (0);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Csdrop (struct CSTACK *s)
+
+#else
+
+int Csdrop (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... drop the top element from the stack
+   Input   ... *s .. the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. stack was already empty
+*/
+{
+int flag;
+struct COMPLEX z1;
+flag = 0;
+if (Cspop (s, &z1)) {printf("\nCdrop -- stack was already empty\n"); flag = 1;}
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Csdup (struct CSTACK *s)
+
+#else
+
+int Csdup (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... duplicate the top element of the stack
+   Input   ... *s .. the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. stack is empty
+*/
+{
+int flag;
+struct COMPLEX z1;
+flag = 0;
+if (Cspop (s, &z1)) {printf("\nCdup -- stack is empty\n"); flag = 1;}
+if (!flag)
+   {
+   Cspush (s, &z1);
+   if (Cspush (s, &z1)) {printf ("\nCdup -- stack overflow\n"); flag = 1;}
+   }
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Csswap (struct CSTACK *s)
+
+#else
+
+int Csswap (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... swap the top two elements of the stack
+   Input   ... *s .. the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. two elements are not available
+*/
+{
+int flag;
+struct COMPLEX z1, z2;
+flag = 0;
+if (Cspop (s, &z1)) {printf("\nCswap -- stack is empty\n"); flag = 1;}
+if (Cspop (s, &z2)) {printf("\nCswap -- stack is empty\n"); flag = 1;}
+if (!flag)
+   {
+   Cspush (s, &z1);
+   Cspush (s, &z2);
+   }
+return (flag);
+}
+
+
+/* ------------------------
+   3. arithmetic operations
+   ------------------------ */
+
+#if (PROTOTYPE)
+
+int Csadd (struct CSTACK *s)
+
+#else
+
+int Csadd (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... add the top two stack elements together and place
+               the result on the stack
+   Input   ... *s .. the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. problems
+*/
+{
+int flag;
+struct COMPLEX z1, z2;
+flag = 0;
+if (Cspop (s, &z1)) {printf("\nCadd -- Stack underflow\n"); flag = 1;}
+if (Cspop (s, &z2)) {printf("\nCadd -- Stack underflow\n"); flag = 1;}
+if (!flag)
+   {
+   z1.re += z2.re;
+   z1.im += z2.im;
+   Cspush (s, &z1);
+   }
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Cssub (struct CSTACK *s)
+
+#else
+
+int Cssub (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... subtract the second top element from the top element
+               and place the result on the stack
+   Input   ... *s .. the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. problems
+*/
+{
+int flag;
+struct COMPLEX z1, z2;
+flag = 0;
+if (Cspop (s, &z1)) {printf("\nCsub -- Stack underflow\n"); flag = 1;}
+if (Cspop (s, &z2)) {printf("\nCsub -- Stack underflow\n"); flag = 1;}
+if (!flag)
+   {
+   z2.re -= z1.re;
+   z2.im -= z1.im;
+   Cspush (s, &z2);
+   }
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Csneg (struct CSTACK *s)
+
+#else
+
+int Csneg (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... negate the top element
+   Input   ... *s .. the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. problems
+*/
+{
+int flag;
+struct COMPLEX z1;
+flag = 0;
+if (Cspop (s, &z1)) {printf("\nCneg -- nothing on stack\n"); flag = 1;}
+if (!flag)
+   {
+   z1.re = -z1.re;
+   z1.im = -z1.im;
+   Cspush (s, &z1);
+   }
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Csconjg (struct CSTACK *s)
+
+#else
+
+int Csconjg (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... take the complex conjugate of the top element
+   Input   ... *s .. the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. problems
+*/
+{
+int flag;
+struct COMPLEX z1;
+flag = 0;
+if (Cspop (s, &z1)) {printf("\nConjg -- nothing on stack\n"); flag = 1;}
+if (!flag)
+   {
+   z1.im = -z1.im;
+   Cspush (s, &z1);
+   }
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Csmult (struct CSTACK *s)
+
+#else
+
+int Csmult (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... multiply the top two elements together
+               and place the result on the stack
+   Input   ... *s .. the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. problems
+   Notes   ... operands scaled as per reference [4]
+*/
+{
+int flag;
+struct COMPLEX z1, z2, z3;
+double scale, x1, y1, x2, y2;
+flag = 0;
+if (Cspop (s, &z1)) {printf("\nCmult -- Stack underflow\n"); flag = 1;}
+if (Cspop (s, &z2)) {printf("\nCmult -- Stack underflow\n"); flag = 1;}
+if (!flag)
+   {  /* proceed with multiplication */
+   x1 = z1.re;
+   scale = fabs(x1);
+   y1 = z1.im;
+   if (fabs(y1) > scale) scale = fabs(y1);
+   x2 = z2.re;
+   if (fabs(x2) > scale) scale = fabs(x2);
+   y2 = z2.im;
+   if (fabs(y2) > scale) scale = fabs(y2);
+   if (scale == 0.0)
+      {
+      z3.re = 0.0;
+      z3.im = 0.0;
+      }
+   else
+      {
+      x1 /= scale;
+      y1 /= scale;
+      x2 /= scale;
+      y2 /= scale;
+      scale *= scale;
+      z3.re = scale * (x1 * x2 - y1 * y2);
+      z3.im = scale * (x1 * y2 + x2 * y1);
+      }
+   Cspush (s, &z3);
+   }
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Csinv (struct CSTACK *s)
+
+#else
+
+int Csinv (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... invert the top element of the stack
+   Input   ... *s .. the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. problems
+   Notes   ... operands scaled as per reference [1]
+*/
+{
+int flag;
+struct COMPLEX z1;
+double theta, x1, y1, temp;
+flag = 0;
+if (Cspop (s, &z1)) {printf("\nCinv -- Stack underflow\n"); flag = 1;}
+if (!flag)
+   {  /* proceed with division */
+   x1 = z1.re;
+   y1 = z1.im;
+   if ((fabs(x1) < EPSILON) && (fabs(y1) < EPSILON))
+      {
+      printf ("\nCinv -- small or zero divisor\n");
+      flag = 1;
+      }
+   else
+      {
+      if (fabs(x1) > fabs(y1))
+         {
+         theta = y1 / x1;
+	 temp = 1.0 / (theta * y1 + x1);
+         z1.re = temp;
+         z1.im = -theta * temp;
+         }
+      else
+         {
+         theta = x1 / y1;
+	 temp = 1.0 / (theta * x1 + y1);
+         z1.re = theta * temp;
+         z1.im = -1.0 * temp;
+         }
+      Cspush (s, &z1);
+      }
+   }
+return (flag);
+}
+
+
+#if (PROTOTYPE)
+
+int Csdiv (struct CSTACK *s)
+
+#else
+
+int Csdiv (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... divide the top element by the second top element
+               and place the result on the stack
+   Input   ... *s .. the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. problems
+   Notes   ... uses Csinv() and Csmult()
+*/
+{
+int flag;
+flag = 0;
+if (Csinv (s))
+   {
+   printf ("\nCdiv -- problems inverting top element\n");
+   flag = 1;
+   }
+else
+   {
+   if (Csmult (s))
+      {
+      printf ("\nCdiv -- problems multiplying elements\n");
+      flag = 1;
+      }
+   }
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Csmag (struct CSTACK *s, double *x)
+
+#else
+
+int Csmag (s, x)
+struct CSTACK *s;
+double *x;
+
+#endif
+
+/* Purpose ... return the magnitude of the top element as x
+   Input   ... *x .. pointer to the returned value
+   Output  ... return flag = 0 .. successful
+			   = 1 .. empty stack
+   Notes   ... operands scaled as per reference [1]
+*/
+{
+int flag;
+struct COMPLEX z1;
+double temp, x1, y1;
+flag = 0;
+if (Cspop (s, &z1)) {printf("\nCmag -- Stack underflow\n"); flag = 1;}
+if (!flag)
+   {
+   x1 = fabs(z1.re);
+   y1 = fabs(z1.im);
+   if ((x1 == 0.0) && (y1 == 0.0))
+      *x = 0.0;
+   else
+      {
+      if (x1 > y1)
+         {
+	 temp = y1 / x1;
+	 *x = x1 * sqrt(1.0 + temp * temp);
+         }
+      else
+         {
+	 temp = x1 / y1;
+	 *x = y1 * sqrt(1.0 + temp * temp);
+         }
+      }
+   }
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Cscart (struct CSTACK *s)
+
+#else
+
+int Cscart (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... convert the top element to cartesian form
+   Input   ... *s .. the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. empty stack
+   Note    ... the polar form is stored z.re = magnitude
+					z.im = argument (radians)
+*/
+{
+int flag;
+struct COMPLEX z1;
+double x1, y1;
+flag = 0;
+if (Cspop (s, &z1)) {printf("\nCart -- Stack underflow\n"); flag = 1;}
+if (!flag)
+   {
+   x1 = z1.re;
+   y1 = z1.im;
+   z1.re = x1 * cos(y1);
+   z1.im = x1 * sin(y1);
+   Cspush (s, &z1);
+   }
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Cspolar (struct CSTACK *s)
+
+#else
+
+int Cspolar (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... convert the top element from cartesian to polar form
+   Input   ... *s .. the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. empty stack
+   Note    ... the polar form is stored z.re = magnitude
+					z.im = argument (radians)
+*/
+{
+int flag;
+struct COMPLEX z1;
+double temp, x1, y1;
+flag = 0;
+if (Csdup (s)) { printf ("\nCpolar -- stack overflow\n"); flag = 1;}
+if (Cspop (s, &z1)) { printf ("\nCpolar -- stack underflow\n"); flag = 1;}
+if (!flag)
+   {
+   x1 = z1.re;
+   y1 = z1.im;
+   Csmag (s, &temp);
+   z1.re = temp;
+   z1.im = atan2 (y1, x1);
+   Cspush (s, &z1);
+   }
+return (flag);
+}
+
+
+/* --------------------
+   4. complex functions
+   -------------------- */
+
+#if (PROTOTYPE)
+
+int Cssqrt (struct CSTACK *s)
+
+#else
+
+int Cssqrt (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... compute the square root of the top element
+   Input   ... *s .. the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. problems
+   Note    ... The returned value is in the right half plane.
+*/
+{
+int flag;
+struct COMPLEX z1;
+double temp, x1, y1, x2, y2;
+flag = 0;
+if (Csdup (s)) { printf ("\nCexp -- stack overflow\n"); flag = 1; }
+if (Cspop (s, &z1)) { printf ("\nCexp -- stack underflow\n"); flag = 1; }
+if (!flag)
+   {
+   x1 = z1.re;
+   y1 = z1.im;
+   if ((x1 == 0.0) && (y1 == 0.0))
+      {
+      printf ("\nCsqrt -- zero operand\n");
+      flag = 1;
+      }
+   else
+      {
+      Csmag (s, &temp);
+      if (x1 >= 0.0)
+	 {
+	 x2 = sqrt((x1 + temp) / 2.0);
+	 y2 = y1 / (2.0 * x2);
+	 }
+      else
+	 {
+	 y2 = sqrt((fabs(x1) + temp) / 2.0);
+	 y2 = y1 < 0.0 ? -fabs(y2) : fabs(y2);
+	 x2 = y1 / (2.0 * y2);
+	 }
+      z1.re = x2;
+      z1.im = y2;
+      Cspush (s, &z1);
+      }
+   }
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Csexp (struct CSTACK *s)
+
+#else
+
+int Csexp (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... compute exp(ztop) and place the result on the stack
+   Input   ... *s .. the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. problems
+*/
+{
+int flag;
+struct COMPLEX z1;
+double temp, y;
+flag = 0;
+if (Cspop (s, &z1)) {printf("\nCexp -- Stack underflow\n"); flag = 1;}
+if (!flag)
+   {
+   temp = exp(z1.re);
+   y = z1.im;
+   z1.re = temp * cos(y);
+   z1.im = temp * sin(y);
+   Cspush (s, &z1);
+   }
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Cslog (struct CSTACK *s)
+
+#else
+
+int Cslog (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... compute ln(ztop) and place the result on the stack
+   Input   ... *s .. the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. problems
+   Note    ... the branch cut is along the negative real axis.
+*/
+{
+int flag;
+struct COMPLEX z1;
+double temp;
+flag = 0;
+if (Cspolar (s)) { printf ("\nClog -- problems with polar\n"); flag = 1;}
+if (Cspop (s, &z1)) { printf ("\nClog -- stack underflow\n"); flag = 1;}
+if (!flag)
+   {
+   temp = z1.re;    /* this is the magnitude */
+   if (temp < EPSILON)
+      {
+      printf ("\nClog -- magnitude small or negative\n"); flag = 1;
+      }
+   else
+      {
+      z1.re = log(temp);
+      Cspush (s, &z1);
+      }
+   }
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Cspow (struct CSTACK *s, double y)
+
+#else
+
+int Cspow (s, y)
+struct CSTACK *s;
+double y;
+
+#endif
+
+/* Purpose ... compute ztop**y and place the result on the stack
+   Input   ... y .. real exponent
+   Output  ... return flag = 0 .. successful
+			   = 1 .. problems
+*/
+{
+int flag;
+struct COMPLEX z1;
+double temp;
+flag = 0;
+if (Cspolar (s)) { printf ("\nCpow -- problems with Cpolar\n"); flag = 1;}
+if (Cspop (s, &z1)) { printf ("\nCpow -- stack underflow\n"); flag = 1;}
+if (!flag)
+   {
+   temp = z1.re;        /* polar magnitude */
+   if (temp < 0.0)  /* you may change this test to <=0 if needed */
+      {
+      printf ("\nCpow -- magnitude negative\n");
+      flag = 1;
+      }
+   else
+      {
+      z1.re = pow (temp, y);
+      z1.im = (y) * z1.im;
+      Cspush (s, &z1);
+      Cscart (s);
+      }
+   }
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Cssin (struct CSTACK *s)
+
+#else
+
+int Cssin (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... compute sin(ztop) and place the result on the stack
+   Input   ... *s .. the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. problems
+   Note    ... currently no checks are made for stack overflow.
+*/
+{
+int flag;
+flag = 0;
+Cspush (s, &imgC);
+Csmult (s);
+Csexp (s);
+Csdup (s);
+Csinv (s);
+Cssub (s);
+Cspushr (s, 0.5);
+Csmult (s);
+Cspush (s, &imgC);
+Csmult (s);
+Csneg (s);
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Cscos (struct CSTACK *s)
+
+#else
+
+int Cscos (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... compute cos(ztop) and place the result on the stack
+   Input   ... *s .. the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. problems
+   Note    ... currently no checks are made for stack overflow.
+*/
+{
+int flag;
+flag = 0;
+Cspush (s, &imgC);
+Csmult (s);
+Csexp (s);
+Csdup (s);
+Csinv (s);
+Csadd (s);
+Cspushr (s, 0.5);
+Csmult (s);
+return (flag);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Cstan (struct CSTACK *s)
+
+#else
+
+int Cstan (s)
+struct CSTACK *s;
+
+#endif
+
+/* Purpose ... compute tan(ztop) and place the result on the stack
+   Input   ... *s .. the stack context
+   Output  ... return flag = 0 .. successful
+			   = 1 .. problems
+   Note    ... currently no checks are made for stack overflow.
+*/
+{
+int flag;
+double temp;
+flag = 0;
+Csdup (s);
+Cssin (s);
+Csswap (s);
+Cscos (s);
+Csdup (s);
+Csmag (s, &temp);
+if (temp < EPSILON)
+   {
+   printf ("\nCtan -- the cosine is very small\n");
+   flag = 1;
+   }
+if (!flag) Csdiv (s);
+return (flag);
+}
+
+
+/* ---------------------------------
+   6. functions on the default stack
+   --------------------------------- */
+
+/* The functions Cinit() .. Ctan() above without the "s" work on a
+   default stack that is private to the calling thread. */
+
+#if (PROTOTYPE)
+
+int Cinit (int n)
+
+#else
+
+int Cinit (n)
+int n;
+
+#endif
+
+{
+return (Csinit (&Zdefault, n));
+}
+
+
+#if (PROTOTYPE)
+
+int Cend (void)
+
+#else
+
+int Cend ()
+
+#endif
+
+{
+return (Csend (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Creset (void)
+
+#else
+
+int Creset ()
+
+#endif
+
+{
+return (Csreset (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Cpush (struct COMPLEX *z)
+
+#else
+
+int Cpush (z)
+struct COMPLEX *z;
+
+#endif
+
+{
+return (Cspush (&Zdefault, z));
+}
+
+
+#if (PROTOTYPE)
+
+int Cpop (struct COMPLEX *z)
+
+#else
+
+int Cpop (z)
+struct COMPLEX *z;
+
+#endif
+
+{
+return (Cspop (&Zdefault, z));
+}
+
+
+#if (PROTOTYPE)
+
+int Cpushr (double x)
+
+#else
+
+int Cpushr (x)
+double x;
+
+#endif
+
+{
+return (Cspushr (&Zdefault, x));
+}
+
+
+#if (PROTOTYPE)
+
+int Cpopr (double *x)
+
+#else
+
+int Cpopr (x)
+double *x;
+
+#endif
+
+{
+return (Cspopr (&Zdefault, x));
+}
+
+
+#if (PROTOTYPE)
+
+int Cdrop (void)
+
+#else
+
+int Cdrop ()
+
+#endif
+
+{
+return (Csdrop (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Cdup (void)
+
+#else
+
+int Cdup ()
+
+#endif
+
+{
+return (Csdup (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Cswap (void)
+
+#else
+
+int Cswap ()
+
+#endif
+
+{
+return (Csswap (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Cprint (int n)
+
+#else
+
+int Cprint (n)
+int n;
+
+#endif
+
+{
+return (Csprint (&Zdefault, n));
+}
+
+
+#if (PROTOTYPE)
+
+int Cadd (void)
+
+#else
+
+int Cadd ()
+
+#endif
+
+{
+return (Csadd (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Csub (void)
+
+#else
+
+int Csub ()
+
+#endif
+
+{
+return (Cssub (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Cmult (void)
+
+#else
+
+int Cmult ()
+
+#endif
+
+{
+return (Csmult (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Cdiv (void)
+
+#else
+
+int Cdiv ()
+
+#endif
+
+{
+return (Csdiv (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Cinv (void)
+
+#else
+
+int Cinv ()
+
+#endif
+
+{
+return (Csinv (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Cneg (void)
+
+#else
+
+int Cneg ()
+
+#endif
+
+{
+return (Csneg (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Conjg (void)
+
+#else
+
+int Conjg ()
+
+#endif
+
+{
+return (Csconjg (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Cmag (double *x)
+
+#else
+
+int Cmag (x)
+double *x;
+
+#endif
+
+{
+return (Csmag (&Zdefault, x));
+}
+
+
+#if (PROTOTYPE)
+
+int Cpolar (void)
+
+#else
+
+int Cpolar ()
+
+#endif
+
+{
+return (Cspolar (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Cart (void)
+
+#else
+
+int Cart ()
+
+#endif
+
+{
+return (Cscart (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Cpow (double y)
+
+#else
+
+int Cpow (y)
+double y;
+
+#endif
+
+{
+return (Cspow (&Zdefault, y));
+}
+
+
+#if (PROTOTYPE)
+
+int Csqrt (void)
+
+#else
+
+int Csqrt ()
+
+#endif
+
+{
+return (Cssqrt (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Cexp (void)
+
+#else
+
+int Cexp ()
+
+#endif
+
+{
+return (Csexp (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Clog (void)
+
+#else
+
+int Clog ()
+
+#endif
+
+{
+return (Cslog (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Csin (void)
+
+#else
+
+int Csin ()
+
+#endif
+
+{
+return (Cssin (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Ccos (void)
+
+#else
+
+int Ccos ()
+
+#endif
+
+{
+return (Cscos (&Zdefault));
+}
+
+
+#if (PROTOTYPE)
+
+int Ctan (void)
+
+#else
+
+int Ctan ()
+
+#endif
+
+{
+return (Cstan (&Zdefault));
+}
+
+
+/* ------------------
+   7. bulk evaluation
+   ------------------ */
+
+/* Crpn() runs the program over blocks of CRPN_NB points at a time.
+   The stack for a block is held as arrays of real and imaginary
+   parts, one row of CRPN_NB values per stack level, so that each
+   operation is a loop over the points of the block.  The depth of
+   the stack is limited to CRPN_DMAX.  When compiled for OpenMP
+   (PARALLEL in cmath.h) the blocks are shared among threads for
+   more than CRPN_PMIN operations in all.  */
+
+#define  CRPN_NB    64
+#define  CRPN_PMIN  16384L
+
+#if (PROTOTYPE)
+
+static int crblock (int nop, struct CRPN prog[], struct COMPLEX *var[],
+                    int i1, int nb, struct COMPLEX result[], int ierr[])
+
+#else
+
+static int crblock (nop, prog, var, i1, nb, result, ierr)
+int    nop;
+struct CRPN prog[];
+struct COMPLEX *var[];
+int    i1, nb;
+struct COMPLEX result[];
+int    ierr[];
+
+#endif
+
+/* Purpose ...
+   -------
+   Run the program prog[] for the points i1 .. i1+nb-1.
+   The program has been checked by Crpn().
+   Returns the number of points for which an operation failed.
+*/
+
+{
+double sr[CRPN_DMAX][CRPN_NB], si[CRPN_DMAX][CRPN_NB];
+double *xr, *xi, *yr, *yi;
+double x1, y1, x2, y2, scale, temp, theta;
+double ex, c, sn, ch, sh;
+struct COMPLEX *v;
+int    bad[CRPN_NB];
+int    d, ip, l, nbad;
+
+for (l = 0; l < nb; ++l) bad[l] = 0;
+d = -1;
+for (ip = 0; ip < nop; ++ip)
+   {
+   /* x is the top of the stack, y the element below it */
+   switch (prog[ip].op)
+      {
+      case CRPN_VAR :
+         ++d;
+         xr = sr[d]; xi = si[d];
+         v  = var[prog[ip].k] + i1;
+         for (l = 0; l < nb; ++l) { xr[l] = v[l].re; xi[l] = v[l].im; }
+         break;
+
+      case CRPN_CONST :
+         ++d;
+         xr = sr[d]; xi = si[d];
+         x1 = prog[ip].c.re; y1 = prog[ip].c.im;
+         for (l = 0; l < nb; ++l) { xr[l] = x1; xi[l] = y1; }
+         break;
+
+      case CRPN_DROP :
+         --d;
+         break;
+
+      case CRPN_DUP :
+         ++d;
+         for (l = 0; l < nb; ++l)
+            {
+            sr[d][l] = sr[d-1][l]; si[d][l] = si[d-1][l];
+            }
+         break;
+
+      case CRPN_SWAP :
+         xr = sr[d]; xi = si[d]; yr = sr[d-1]; yi = si[d-1];
+         for (l = 0; l < nb; ++l)
+            {
+            temp = xr[l]; xr[l] = yr[l]; yr[l] = temp;
+            temp = xi[l]; xi[l] = yi[l]; yi[l] = temp;
+            }
+         break;
+
+      case CRPN_ADD :
+         xr = sr[d]; xi = si[d]; yr = sr[d-1]; yi = si[d-1];
+         for (l = 0; l < nb; ++l) { yr[l] += xr[l]; yi[l] += xi[l]; }
+         --d;
+         break;
+
+      case CRPN_SUB :
+         xr = sr[d]; xi = si[d]; yr = sr[d-1]; yi = si[d-1];
+         for (l = 0; l < nb; ++l) { yr[l] -= xr[l]; yi[l] -= xi[l]; }
+         --d;
+         break;
+
+      case CRPN_MULT :
+         /* operands scaled as in Csmult() */
+         xr = sr[d]; xi = si[d]; yr = sr[d-1]; yi = si[d-1];
+         for (l = 0; l < nb; ++l)
+            {
+            x1 = xr[l]; y1 = xi[l]; x2 = yr[l]; y2 = yi[l];
+            scale = fabs(x1);
+            temp  = fabs(y1); scale = (temp > scale) ? temp : scale;
+            temp  = fabs(x2); scale = (temp > scale) ? temp : scale;
+            temp  = fabs(y2); scale = (temp > scale) ? temp : scale;
+            temp  = (scale == 0.0) ? 0.0 : 1.0 / scale;
+            x1 *= temp; y1 *= temp; x2 *= temp; y2 *= temp;
+            scale *= scale;
+            yr[l] = scale * (x1 * x2 - y1 * y2);
+            yi[l] = scale * (x1 * y2 + x2 * y1);
+            }
+         --d;
+         break;
+
+      case CRPN_INV :
+      case CRPN_DIV :
+         /* invert the top element as in Csinv() */
+         xr = sr[d]; xi = si[d];
+         for (l = 0; l < nb; ++l)
+            {
+            x1 = xr[l]; y1 = xi[l];
+            if ((fabs(x1) < EPSILON) && (fabs(y1) < EPSILON))
+               {
+               bad[l] = 1;
+               xr[l] = 0.0; xi[l] = 0.0;
+               }
+            else if (fabs(x1) > fabs(y1))
+               {
+               theta = y1 / x1;
+               temp  = 1.0 / (theta * y1 + x1);
+               xr[l] = temp;
+               xi[l] = -theta * temp;
+               }
+            else
+               {
+               theta = x1 / y1;
+               temp  = 1.0 / (theta * x1 + y1);
+               xr[l] = theta * temp;
+               xi[l] = -temp;
+               }
+            }
+         if (prog[ip].op == CRPN_INV) break;
+         /* then multiply as for CRPN_MULT */
+         yr = sr[d-1]; yi = si[d-1];
+         for (l = 0; l < nb; ++l)
+            {
+            x1 = xr[l]; y1 = xi[l]; x2 = yr[l]; y2 = yi[l];
+            scale = fabs(x1);
+            temp  = fabs(y1); scale = (temp > scale) ? temp : scale;
+            temp  = fabs(x2); scale = (temp > scale) ? temp : scale;
+            temp  = fabs(y2); scale = (temp > scale) ? temp : scale;
+            temp  = (scale == 0.0) ? 0.0 : 1.0 / scale;
+            x1 *= temp; y1 *= temp; x2 *= temp; y2 *= temp;
+            scale *= scale;
+            yr[l] = scale * (x1 * x2 - y1 * y2);
+            yi[l] = scale * (x1 * y2 + x2 * y1);
+            }
+         --d;
+         break;
+
+      case CRPN_NEG :
+         xr = sr[d]; xi = si[d];
+         for (l = 0; l < nb; ++l) { xr[l] = -xr[l]; xi[l] = -xi[l]; }
+         break;
+
+      case CRPN_CONJG :
+         xi = si[d];
+         for (l = 0; l < nb; ++l) xi[l] = -xi[l];
+         break;
+
+      case CRPN_MAG :
+      case CRPN_POLAR :
+      case CRPN_POW :
+      case CRPN_LOG :
+         /* magnitude and argument */
+         xr = sr[d]; xi = si[d];
+         for (l = 0; l < nb; ++l)
+            {
+            x1 = fabs(xr[l]); y1 = fabs(xi[l]);
+            if ((x1 == 0.0) && (y1 == 0.0))
+               temp = 0.0;
+            else if (x1 > y1)
+               {
+               temp = y1 / x1;
+               temp = x1 * sqrt(1.0 + temp * temp);
+               }
+            else
+               {
+               temp = x1 / y1;
+               temp = y1 * sqrt(1.0 + temp * temp);
+               }
+            xi[l] = (prog[ip].op == CRPN_MAG) ? 0.0 : atan2(xi[l], xr[l]);
+            xr[l] = temp;
+            }
+         if (prog[ip].op == CRPN_POW)
+            {
+            y2 = prog[ip].c.re;
+            for (l = 0; l < nb; ++l)
+               {
+               temp  = pow(xr[l], y2);
+               theta = y2 * xi[l];
+               xr[l] = temp * cos(theta);
+               xi[l] = temp * sin(theta);
+               }
+            }
+         else if (prog[ip].op == CRPN_LOG)
+            {
+            for (l = 0; l < nb; ++l)
+               {
+               if (xr[l] < EPSILON)
+                  {
+                  bad[l] = 1;
+                  xr[l] = 0.0; xi[l] = 0.0;
+                  }
+               else
+                  xr[l] = log(xr[l]);
+               }
+            }
+         break;
+
+      case CRPN_CART :
+         xr = sr[d]; xi = si[d];
+         for (l = 0; l < nb; ++l)
+            {
+            x1 = xr[l]; y1 = xi[l];
+            xr[l] = x1 * cos(y1);
+            xi[l] = x1 * sin(y1);
+            }
+         break;
+
+      case CRPN_SQRT :
+         /* as in Cssqrt() */
+         xr = sr[d]; xi = si[d];
+         for (l = 0; l < nb; ++l)
+            {
+            x1 = xr[l]; y1 = xi[l];
+            if ((x1 == 0.0) && (y1 == 0.0))
+               {
+               bad[l] = 1;
+               continue;
+               }
+            x2 = fabs(x1); y2 = fabs(y1);
+            if (x2 > y2)
+               {
+               temp = y2 / x2;
+               temp = x2 * sqrt(1.0 + temp * temp);
+               }
+            else
+               {
+               temp = x2 / y2;
+               temp = y2 * sqrt(1.0 + temp * temp);
+               }
+            if (x1 >= 0.0)
+               {
+               x2 = sqrt((x1 + temp) / 2.0);
+               y2 = y1 / (2.0 * x2);
+               }
+            else
+               {
+               y2 = sqrt((fabs(x1) + temp) / 2.0);
+               y2 = y1 < 0.0 ? -y2 : y2;
+               x2 = y1 / (2.0 * y2);
+               }
+            xr[l] = x2;
+            xi[l] = y2;
+            }
+         break;
+
+      case CRPN_EXP :
+         xr = sr[d]; xi = si[d];
+         for (l = 0; l < nb; ++l)
+            {
+            temp  = exp(xr[l]);
+            y1    = xi[l];
+            xr[l] = temp * cos(y1);
+            xi[l] = temp * sin(y1);
+            }
+         break;
+
+      case CRPN_SIN :
+      case CRPN_COS :
+      case CRPN_TAN :
+         xr = sr[d]; xi = si[d];
+         for (l = 0; l < nb; ++l)
+            {
+            x1 = xr[l]; y1 = xi[l];
+            ex = exp(y1);
+            ch = 0.5 * (ex + 1.0 / ex);
+            sh = (fabs(y1) < 1.0e-5) ? y1 * (1.0 + y1 * y1 / 6.0)
+                                     : 0.5 * (ex - 1.0 / ex);
+            sn = sin(x1);
+            c  = cos(x1);
+            if (prog[ip].op == CRPN_SIN)
+               {
+               xr[l] = sn * ch;
+               xi[l] = c * sh;
+               }
+            else if (prog[ip].op == CRPN_COS)
+               {
+               xr[l] = c * ch;
+               xi[l] = -sn * sh;
+               }
+            else
+               {  /* sin / cos, with |cos|**2 = c**2 + sh**2 */
+               temp = c * c + sh * sh;
+               if (sqrt(temp) < EPSILON)
+                  {
+                  bad[l] = 1;
+                  xr[l] = 0.0; xi[l] = 0.0;
+                  }
+               else
+                  {
+                  xr[l] = sn * c / temp;
+                  xi[l] = sh * ch / temp;
+                  }
+               }
+            }
+         break;
+      }
+   }
+
+/* the result is the top of the stack */
+nbad = 0;
+for (l = 0; l < nb; ++l)
+   {
+   result[i1+l].re = sr[d][l];
+   result[i1+l].im = si[d][l];
+   if (ierr != NULL) ierr[i1+l] = bad[l];
+   nbad += bad[l];
+   }
+return (nbad);
+}
+
+
+
+#if (PROTOTYPE)
+
+int Crpn (int nop, struct CRPN prog[], int nvar, struct COMPLEX *var[],
+          int npts, struct COMPLEX result[], int ierr[])
+
+#else
+
+int Crpn (nop, prog, nvar, var, npts, result, ierr)
+int    nop;
+struct CRPN prog[];
+int    nvar;
+struct COMPLEX *var[];
+int    npts;
+struct COMPLEX result[];
+int    ierr[];
+
+#endif
+
+/* Purpose ... Evaluate one stack program at many points.
+   Input   ... nop    .. number of operations in the program
+               prog   .. the program, prog[0] first.
+                         prog[ip].op is one of the CRPN_ codes in
+                         complex.h.  For CRPN_VAR, prog[ip].k is the
+                         variable to push.  For CRPN_CONST, prog[ip].c
+                         is the constant to push.  For CRPN_POW,
+                         prog[ip].c.re is the real exponent.
+               nvar   .. number of variables
+               var    .. var[k][i] is the value of variable k at
+                         point i, k = 0 .. nvar-1
+               npts   .. number of points
+   Output  ... result .. result[i] is the top of the stack after
+                         running the program for point i
+               ierr   .. ierr[i] = 1 if an operation failed at point
+                         i, else 0.  May be NULL.
+               return flag >= 0 .. number of points that failed
+                           = -1 .. illegal input, or the program pops
+                                   more elements than it pushed or
+                                   leaves the stack empty
+                           = -2 .. the program needs more than
+                                   CRPN_DMAX stack elements
+   Notes   ... (1) Each operation does what the corresponding Csxxx()
+                   function does for a stack context.  CRPN_MAG
+                   replaces the top element by its magnitude (the
+                   scalar Cmag() pops it).
+               (2) Where a scalar function would report a problem
+                   (small divisor, zero square root, small log or
+                   tan argument) the element is set to zero, the
+                   point is flagged and evaluation carries on.
+               (3) The points are taken in blocks and each operation
+                   is applied to a whole block at a time.
+*/
+{
+int    ip, d, dmax, need, push, i, nbad;
+
+if (nop < 1 || prog == NULL || npts < 0 || result == NULL) return (-1);
+if (nvar > 0 && var == NULL) return (-1);
+
+/* --- check the program and its stack depth --- */
+d = 0;
+dmax = 0;
+for (ip = 0; ip < nop; ++ip)
+   {
+   switch (prog[ip].op)
+      {
+      case CRPN_VAR :
+         if (prog[ip].k < 0 || prog[ip].k >= nvar) return (-1);
+         need = 0; push = 1;
+         break;
+      case CRPN_CONST :
+         need = 0; push = 1;
+         break;
+      case CRPN_DROP :
+         need = 1; push = -1;
+         break;
+      case CRPN_DUP :
+         need = 1; push = 1;
+         break;
+      case CRPN_SWAP :
+         need = 2; push = 0;
+         break;
+      case CRPN_ADD :
+      case CRPN_SUB :
+      case CRPN_MULT :
+      case CRPN_DIV :
+         need = 2; push = -1;
+         break;
+      case CRPN_INV :
+      case CRPN_NEG :
+      case CRPN_CONJG :
+      case CRPN_MAG :
+      case CRPN_POLAR :
+      case CRPN_CART :
+      case CRPN_POW :
+      case CRPN_SQRT :
+      case CRPN_EXP :
+      case CRPN_LOG :
+      case CRPN_SIN :
+      case CRPN_COS :
+      case CRPN_TAN :
+         need = 1; push = 0;
+         break;
+      default :
+         return (-1);
+      }
+   if (d < need) return (-1);
+   d += push;
+   if (d > dmax) dmax = d;
+   }
+if (d < 1) return (-1);
+if (dmax > CRPN_DMAX) return (-2);
+
+/* --- run it a block of points at a time --- */
+nbad = 0;
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) reduction(+:nbad) \
+        if ((long) npts * nop > CRPN_PMIN)
+#endif
+for (i = 0; i < npts; i += CRPN_NB)
+   {
+   nbad += crblock (nop, prog, var, i,
+                    (i + CRPN_NB < npts) ? CRPN_NB : npts - i,
+                    result, ierr);
+   }
+
+return (nbad);
+}
+
+/*-----------------------------------------------------------------*/
@@ -0,0 +1,281 @@
+/* complex.h
+   Header file for COMPLEX number routines.
+*/
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+/* This C code written by ...  Peter & Nigel,
+   ----------------------      Design Software,
+                               42 Gubberley St,
+                               Kenmore, 4069,
+                               Australia.         */
+
+/*-----------------------------------------------------------------*/
+
+
+/* -------------------------------------------------
+   1. COMPLEX data structure is contained in cmath.h
+   ------------------------------------------------- */
+
+/* -------------------
+   2. data conversions
+   ------------------- */
+
+#if (PROTOTYPE)
+/* Full function prototypes ... */
+
+int    Cmplx (double x, double y, struct COMPLEX *z);
+double Creal (struct COMPLEX *z);
+double Cimag (struct COMPLEX *z);
+
+#else
+
+int    Cmplx();   /* convert the two real elements to a complex number */
+double Creal();   /* return the real part of z */
+double Cimag();   /* return the complex part of z */
+
+#endif
+
+/* ---------------------------------------------------
+   2a. stack context, for the Csxxx() forms of sections
+       3, 4 and 5, which take it as their first argument
+   --------------------------------------------------- */
+
+struct CSTACK
+   {
+   struct COMPLEX *stack;   /* the elements                    */
+   struct COMPLEX *top;     /* the top element                 */
+   struct COMPLEX *bot;     /* the bottom element, stack[0]    */
+   struct COMPLEX *max;     /* the last element, stack[nmax-1] */
+   int    nmax;             /* number of elements              */
+   };
+
+/* -------------------
+   3. stack operations
+   ------------------- */
+
+#if (PROTOTYPE)
+
+int    Cinit (int n);
+int    Cend (void);
+int    Creset (void);
+int    Cpush (struct COMPLEX *z);
+int    Cpop (struct COMPLEX *z);
+int    Cpushr (double x);
+int    Cpopr (double *x);
+int    Cdrop (void);
+int    Cdup (void);
+int    Cswap (void);
+
+int    Cprint(int n);
+
+int    Csinit (struct CSTACK *s, int n);
+int    Csend (struct CSTACK *s);
+int    Csreset (struct CSTACK *s);
+int    Cspush (struct CSTACK *s, struct COMPLEX *z);
+int    Cspop (struct CSTACK *s, struct COMPLEX *z);
+int    Cspushr (struct CSTACK *s, double x);
+int    Cspopr (struct CSTACK *s, double *x);
+int    Csdrop (struct CSTACK *s);
+int    Csdup (struct CSTACK *s);
+int    Csswap (struct CSTACK *s);
+
+int    Csprint (struct CSTACK *s, int n);
+
+#else
+
+int    Cinit();   /* create a complex stack */
+int    Cend();    /* remove the complex stack */
+int    Creset();  /* reset the stack */
+int    Cpush();   /* push z onto the top of the stack */
+int    Cpop();    /* Pop the top element from the top of the stack and
+		     store as z */
+int    Cpushr();  /* push the real number x onto the stack */
+int    Cpopr();   /* pop the real number x from the top of the stack */
+int    Cdrop();   /* drop top element from stack */
+int    Cdup();    /* duplicate the top element of the stack */
+int    Cswap();   /* swap the top two elements of the stack */
+
+int    Cprint();  /* print the top n stack elements without consuming
+		     them (useful for debugging)  */
+
+int    Csinit();  /* the same on the stack context s */
+int    Csend();
+int    Csreset();
+int    Cspush();
+int    Cspop();
+int    Cspushr();
+int    Cspopr();
+int    Csdrop();
+int    Csdup();
+int    Csswap();
+
+int    Csprint();
+
+#endif
+
+/* ------------------------
+   4. arithmetic operations
+   ------------------------ */
+
+#if (PROTOTYPE)
+
+int    Cadd (void);
+int    Csub (void);
+int    Cmult (void);
+int    Cdiv (void);
+int    Cinv (void);
+int    Cneg (void);
+int    Conjg (void);
+
+int    Cmag (double *x);
+int    Cpolar (void);
+int    Cart (void);
+
+int    Csadd (struct CSTACK *s);
+int    Cssub (struct CSTACK *s);
+int    Csmult (struct CSTACK *s);
+int    Csdiv (struct CSTACK *s);
+int    Csinv (struct CSTACK *s);
+int    Csneg (struct CSTACK *s);
+int    Csconjg (struct CSTACK *s);
+
+int    Csmag (struct CSTACK *s, double *x);
+int    Cspolar (struct CSTACK *s);
+int    Cscart (struct CSTACK *s);
+
+#else
+
+int    Cadd();    /* pop the top two elements off the stack, add them
+		     and push the result back onto the stack */
+int    Csub();   /* subtract the second top element from the top */
+int    Cmult();  /* multiplicatiom */
+int    Cdiv();   /* divide the second top element by the top element */
+int    Cinv();   /* invert the top element */
+int    Cneg();   /* negate the top element */
+int    Conjg();  /* take the conjugate of the top element */
+
+int    Cmag();   /* returns the magnitude of the top element in x  */
+int    Cpolar(); /* convert the top element into polar coordinate form */
+int    Cart();   /* convert from polar to cartesian form */
+
+int    Csadd();   /* the same on the stack context s */
+int    Cssub();
+int    Csmult();
+int    Csdiv();
+int    Csinv();
+int    Csneg();
+int    Csconjg();
+
+int    Csmag();
+int    Cspolar();
+int    Cscart();
+
+#endif
+
+/* ------------
+   5. functions
+   ------------ */
+
+#if (PROTOTYPE)
+
+int    Cpow (double y);
+int    Csqrt (void);
+
+int    Cexp (void);
+int    Clog (void);
+
+int    Csin (void);
+int    Ccos (void);
+int    Ctan (void);
+
+int    Cspow (struct CSTACK *s, double y);
+int    Cssqrt (struct CSTACK *s);
+
+int    Csexp (struct CSTACK *s);
+int    Cslog (struct CSTACK *s);
+
+int    Cssin (struct CSTACK *s);
+int    Cscos (struct CSTACK *s);
+int    Cstan (struct CSTACK *s);
+
+#else
+
+int    Cpow();  /* (top element)**r  */
+int    Csqrt(); /* square root of top element  */
+
+int    Cexp();  /* complex exponential */
+int    Clog();  /* natural logarithm */
+
+int    Csin();  /* complex sine */
+int    Ccos();  /* complex cosine */
+int    Ctan();  /* complex tangent */
+
+int    Cspow(); /* the same on the stack context s */
+int    Cssqrt();
+
+int    Csexp();
+int    Cslog();
+
+int    Cssin();
+int    Cscos();
+int    Cstan();
+
+#endif
+
+/* ------------------
+   6. bulk evaluation
+   ------------------ */
+
+/* One operation of a program for Crpn().  For CRPN_VAR, k is the
+   variable to push; for CRPN_CONST, c is the constant to push; for
+   CRPN_POW, c.re is the exponent. */
+
+struct CRPN
+   {
+   int    op;               /* operation code, CRPN_xxx        */
+   int    k;                /* variable index                  */
+   struct COMPLEX c;        /* constant or exponent            */
+   };
+
+#define  CRPN_VAR     1     /* push var[k][i]                  */
+#define  CRPN_CONST   2     /* push c                          */
+#define  CRPN_DROP    3     /* Cdrop()                         */
+#define  CRPN_DUP     4     /* Cdup()                          */
+#define  CRPN_SWAP    5     /* Cswap()                         */
+#define  CRPN_ADD     6     /* Cadd()                          */
+#define  CRPN_SUB     7     /* Csub()                          */
+#define  CRPN_MULT    8     /* Cmult()                         */
+#define  CRPN_DIV     9     /* Cdiv()                          */
+#define  CRPN_INV    10     /* Cinv()                          */
+#define  CRPN_NEG    11     /* Cneg()                          */
+#define  CRPN_CONJG  12     /* Conjg()                         */
+#define  CRPN_MAG    13     /* replace the top by its magnitude */
+#define  CRPN_POLAR  14     /* Cpolar()                        */
+#define  CRPN_CART   15     /* Cart()                          */
+#define  CRPN_POW    16     /* Cpow(c.re)                      */
+#define  CRPN_SQRT   17     /* Csqrt()                         */
+#define  CRPN_EXP    18     /* Cexp()                          */
+#define  CRPN_LOG    19     /* Clog()                          */
+#define  CRPN_SIN    20     /* Csin()                          */
+#define  CRPN_COS    21     /* Ccos()                          */
+#define  CRPN_TAN    22     /* Ctan()                          */
+
+#define  CRPN_DMAX   16     /* greatest stack depth for Crpn() */
+
+#if (PROTOTYPE)
+
+int    Crpn (int nop, struct CRPN prog[], int nvar, struct COMPLEX *var[],
+             int npts, struct COMPLEX result[], int ierr[]);
+
+#else
+
+int    Crpn();  /* run a stack program over arrays of points */
+
+#endif
+
+/*-----------------------------------------------------------------*/
@@ -0,0 +1,1136 @@
+/* decomp.c
+   Matrix decomposition by Gaussian elimination */
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+#include "cmath.h"
+#if (STDLIBH)
+#include <stdlib.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+
+/*-----------------------------------------------------------------*/
+
+/* Blocking parameters for the elimination in decomp().
+   DECOMP_NB columns are factored as a panel and then applied to
+   the rest of the matrix DECOMP_JB columns at a time, so that the
+   rows of the panel being reused stay in cache.  The update is
+   done in tiles of DECOMP_MR rows by DECOMP_NR columns held in
+   local arrays, with the inner loops over contiguous columns
+   where they may be vectorized by the compiler.
+   dcupdate() has one accumulator per row so DECOMP_MR must be 4.
+   When compiled for OpenMP (PARALLEL in cmath.h) the row tiles
+   of the update, the columns of U to the right of the panel and
+   the rows of the panel are shared among threads, but only for
+   loops of more than DECOMP_PMIN multiply-adds.  */
+
+#define  DECOMP_NB   96
+#define  DECOMP_JB   384
+#define  DECOMP_MR   4
+#define  DECOMP_NR   12
+#define  DECOMP_PMIN 65536L
+
+/* solve_many() works on strips of the right-hand sides holding
+   about DECOMP_SOLVEB doubles, which should fit in the cache.  */
+
+#define  DECOMP_SOLVEB 131072L
+
+#define  AINDEX(i,j) ((i) * ndim + (j))
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void dcupdate (int ndim, double *a, int i1, int i2,
+                      int j1, int j2, int k1, int k2)
+
+#else
+
+static void dcupdate (ndim, a, i1, i2, j1, j2, k1, k2)
+
+int    ndim;
+double *a;
+int    i1, i2, j1, j2, k1, k2;
+
+#endif
+
+/* Purpose ...
+   -------
+   Rank-(k2-k1) update of the block a[i1..i2-1][j1..j2-1]
+   a[i][j] -= sum over k1 <= k < k2 of a[i][k] * a[k][j]
+*/
+
+{
+int    i, j, jj, jb, k, r, c;
+double c0[DECOMP_NR], c1[DECOMP_NR], c2[DECOMP_NR], c3[DECOMP_NR];
+double l, l0, l1, l2, l3, *pb, *pc, *p0, *p1, *p2, *p3;
+
+for (jj = j1; jj < j2; jj += DECOMP_JB)
+   {
+   jb = (jj + DECOMP_JB < j2) ? jj + DECOMP_JB : j2;
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) \
+        private(j, k, r, c, c0, c1, c2, c3, l, l0, l1, l2, l3, \
+                pb, pc, p0, p1, p2, p3) \
+        if ((long) (i2 - i1) * (jb - jj) * (k2 - k1) > DECOMP_PMIN)
+#endif
+   for (i = i1; i < i2; i += DECOMP_MR)
+      {
+      if (i + DECOMP_MR > i2)
+         {  /* odd rows left over */
+         for (r = i; r < i2; ++r)
+            {
+            pc = a + r * ndim;
+            for (k = k1; k < k2; ++k)
+               {
+               l  = pc[k];
+               pb = a + k * ndim;
+               for (j = jj; j < jb; ++j) pc[j] -= l * pb[j];
+               }
+            }
+         continue;
+         }
+      for (j = jj; j + DECOMP_NR <= jb; j += DECOMP_NR)
+         {  /* the register tile */
+         for (c = 0; c < DECOMP_NR; ++c)
+            {
+            c0[c] = 0.0; c1[c] = 0.0; c2[c] = 0.0; c3[c] = 0.0;
+            }
+         p0 = a + i * ndim;
+         p1 = p0 + ndim;
+         p2 = p1 + ndim;
+         p3 = p2 + ndim;
+         for (k = k1; k < k2; ++k)
+            {
+            pb = a + k * ndim + j;
+            l0 = p0[k]; l1 = p1[k]; l2 = p2[k]; l3 = p3[k];
+            for (c = 0; c < DECOMP_NR; ++c)
+               {
+               c0[c] += l0 * pb[c];
+               c1[c] += l1 * pb[c];
+               c2[c] += l2 * pb[c];
+               c3[c] += l3 * pb[c];
+               }
+            }
+         for (c = 0; c < DECOMP_NR; ++c)
+            {
+            p0[j+c] -= c0[c]; p1[j+c] -= c1[c];
+            p2[j+c] -= c2[c]; p3[j+c] -= c3[c];
+            }
+         }
+      if (j < jb)
+         {  /* odd columns left over */
+         for (r = i; r < i + DECOMP_MR; ++r)
+            {
+            pc = a + r * ndim;
+            for (k = k1; k < k2; ++k)
+               {
+               l  = pc[k];
+               pb = a + k * ndim;
+               for (c = j; c < jb; ++c) pc[c] -= l * pb[c];
+               }
+            }
+         }
+      }
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void dcforsy (int n, int ndim, double *a, int pivot[],
+                     int nswap, int ncol)
+
+#else
+
+static void dcforsy (n, ndim, a, pivot, nswap, ncol)
+
+int    n, ndim;
+double *a;
+int    pivot[], nswap, ncol;
+
+#endif
+
+/* Purpose ...
+   -------
+   Convert the multipliers left by the blocked elimination (rows
+   fully interchanged, positive sign) to the form used by solve().
+   The interchanges pivot[k], k < nswap, are undone in columns 0..k-1
+   and the multipliers in columns 0..ncol-1 are negated.
+*/
+
+{
+int    i, j, k, m, jmax;
+double t, *pa, *pb;
+
+for (k = nswap-1; k > 0; --k)
+   {
+   m = pivot[k];
+   if (m == k) continue;
+   pa = a + m * ndim;
+   pb = a + k * ndim;
+   for (j = 0; j < k; ++j) { t = pa[j]; pa[j] = pb[j]; pb[j] = t; }
+   }
+for (i = 1; i < n; ++i)
+   {
+   pa   = a + i * ndim;
+   jmax = (i < ncol) ? i : ncol;
+   for (j = 0; j < jmax; ++j) pa[j] = -pa[j];
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static int dcelim (int n, int ndim, double *a, int pivot[],
+                   double *anorm)
+
+#else
+
+static int dcelim (n, ndim, a, pivot, anorm)
+
+int    n, ndim;
+double *a;
+int    pivot[];
+double *anorm;
+
+#endif
+
+/* Purpose ...
+   -------
+   The elimination for decomp() and decompnc(), n >= 2.
+   Returns 0 with the factors and pivots in a and pivot[],
+   and the 1-norm of the original matrix in anorm.  Returns 3,
+   with the elimination abandoned, if a pivot smaller than
+   anorm * EPSILON is met.
+*/
+
+{
+double t, pvt, csum[DECOMP_NR];
+int    i, j, k, m, kb, ke, jj, jb, nswap;
+double *pa, *pb;
+
+nswap = 0;
+pivot[n-1] = 1;
+
+/* --- compute 1-norm of a, a row at a time for a strip
+   of columns --- */
+
+*anorm = 0.0;
+for (jj = 0; jj < n; jj += DECOMP_NR)
+   {
+   jb = (jj + DECOMP_NR < n) ? jj + DECOMP_NR : n;
+   for (j = jj; j < jb; ++j) csum[j-jj] = 0.0;
+   for (i = 0; i < n; ++i)
+      {
+      pa = a+AINDEX(i,0);
+      for (j = jj; j < jb; ++j) csum[j-jj] += fabs(pa[j]);
+      }
+   for (j = jj; j < jb; ++j) if (csum[j-jj] > *anorm) *anorm = csum[j-jj];
+   }
+
+/* Apply Gaussian elimination with partial pivoting,
+   DECOMP_NB columns at a time. */
+
+for (kb = 0; kb < n; kb += DECOMP_NB)
+   {
+   ke = (kb + DECOMP_NB < n) ? kb + DECOMP_NB : n;
+
+   /* Factor the panel of columns kb .. ke-1. */
+   for (k = kb; k < ke; ++k)
+      {
+      if (k < n-1)
+         {
+         /* Find pivot and label as row m.
+            This will be the element with largest magnitude in
+            the lower part of the kth column. */
+         m = k;
+         pvt = fabs(a[AINDEX(m,k)]);
+         for (i = k+1; i < n; ++i)
+            {
+            t = fabs(a[AINDEX(i,k)]);
+            if ( t > pvt )  { m = i; pvt = t; }
+            }
+         pivot[k] = m;
+         nswap = k + 1;
+
+         if (m != k)
+            {
+            pivot[n-1] = -pivot[n-1];
+            /* Interchange whole rows m and k. */
+            pa = a+AINDEX(m,0); pb = a+AINDEX(k,0);
+            for (j = 0; j < n; ++j)
+               {
+               t = pa[j]; pa[j] = pb[j]; pb[j] = t;
+               }
+            }
+         }
+      /* row k is now the pivot row */
+      pvt = a[AINDEX(k,k)];
+
+      /* Bail out if pivot is too small */
+      if (fabs(pvt) < *anorm * EPSILON)
+         {
+         /* Singular or nearly singular; leave the rest of
+            pivot[] harmless */
+         dcforsy (n, ndim, a, pivot, nswap, k);
+         for (i = nswap; i < n-1; ++i) pivot[i] = i;
+         return (3);
+         }
+
+      /* compute the multipliers in the k sub-column
+         and eliminate within the panel */
+      pb = a+AINDEX(k,0);
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(pa, t, j) \
+        if ((long) (n - k) * (ke - k) > DECOMP_PMIN)
+#endif
+      for (i = k+1; i < n; ++i)
+         {
+         pa = a+AINDEX(i,0);
+         t = pa[k] / pvt;
+         pa[k] = t;
+         for (j = k+1; j < ke; ++j) pa[j] -= t * pb[j];
+         }
+      }
+
+   if (ke < n)
+      {
+      /* Rows of U to the right of the panel,
+         independently for each strip of columns. */
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(jb, i, k, j, t, pa, pb) \
+        if ((long) (ke - kb) * (ke - kb) * (n - ke) > 2 * DECOMP_PMIN)
+#endif
+      for (jj = ke; jj < n; jj += DECOMP_JB)
+         {
+         jb = (jj + DECOMP_JB < n) ? jj + DECOMP_JB : n;
+         for (i = kb+1; i < ke; ++i)
+            {
+            pa = a+AINDEX(i,0);
+            for (k = kb; k < i; ++k)
+               {
+               t = pa[k];
+               pb = a+AINDEX(k,0);
+               for (j = jj; j < jb; ++j) pa[j] -= t * pb[j];
+               }
+            }
+         }
+
+      /* Update the trailing matrix. */
+      dcupdate (ndim, a, ke, n, ke, n, kb, ke);
+      }
+
+   }  /* End of Gaussian elimination. */
+
+/* Undo the later interchanges in the columns of multipliers and
+   change their sign, for solve(). */
+dcforsy (n, ndim, a, pivot, n-1, n-1);
+return (0);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int decomp (int n, int ndim,
+            double *a, double *cond,
+            int pivot[], int *flag)
+
+#else
+
+int decomp (n, ndim, a, cond, pivot, flag)
+
+int    n,
+       ndim;
+double *a,
+       *cond;
+int    pivot[],
+       *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Decomposes a real matrix by gaussian elimination
+   and estimates the condition of the matrix.
+
+   Use Solve to compute solutions to linear systems.
+
+   Input ...
+   -----
+   n    = order of the matrix
+   ndim = row dimension of matrix as defined in the calling program
+   *a   = pointer to matrix to be triangularized
+
+   Output ...
+   ------
+   *a          pointer to  an upper triangular matrix U and a
+	       permuted version of a lower triangular matrix I-L
+	       so that
+	       (permutation matrix) * a = L * U
+   cond      = an estimate of the condition of a .
+	       For the linear system a * x = b, changes in a and b
+	       may cause changes cond times as large in x.
+	       If cond+1.0 .eq. cond , a is singular to working
+	       precision, cond is set to 1.0e+32 if exact (or near)
+	       singularity is detected.
+   pivot     = the pivot vector.
+   pivot[k]  = the index of the k-th pivot row
+   pivot[n-1]= (-1)**(number of interchanges)
+   flag      = Status indicator
+               0 : successful execution
+               1 : could not allocate memory for workspace
+               2 : illegal user input n < 1, a == NULL,
+                   pivot == NULL, n > ndim.
+               3 : matrix is singular
+
+   Work Space ...
+   ----------
+   The vector work[0..n] is allocated internally by decomp().
+
+   This C code written by ...  Peter & Nigel,
+   ----------------------      Design Software,
+                               42 Gubberley St,
+                               Kenmore, 4069,
+                               Australia.
+
+   Version  ... 1.1 ,  2-Dec-87
+   -------      2.0 , 11-Feb-89  (pointer used for a)
+                2.1 , 15-Apr-89  (work[] allocated internally)
+                2.2 , 14-Aug-89  (fixed pivoting)
+                2.3 , 3 -Sep-89  (face lift)
+                3.0 , 30-Sep-89  (optimize for rowwise storage)
+                4.0 , 19-Oct-26  (blocked elimination)
+                4.1 , 19-Oct-26  (OpenMP threads)
+
+   Notes ...
+   -----
+   (1) Subscripts range from 0 through (ndim-1).
+
+   (2) The determinant of a can be obtained on output by
+       det(a) = pivot[n-1] * a[0][0] * a[1][1] * ... * a[n-1][n-1].
+
+   (3) This routine has been adapted from that in the text
+       G.E. Forsythe, M.A. Malcolm & C.B. Moler
+       Computer Methods for Mathematical Computations.
+
+   (4) Uses the functions fabs(), free() and malloc().
+
+   (5) The elimination is done a panel of DECOMP_NB columns at a
+       time, with whole rows interchanged as for LAPACK's dgetrf.
+       The multipliers are put back in the order and sign used
+       by Forsythe, Malcolm & Moler before returning, so solve()
+       and the determinant formula above are unchanged.
+
+   (6) If compiled with OpenMP, the elimination for large n is
+       shared among the available threads.  The results do not
+       depend on the number of threads.
+
+   (7) Where the condition estimate is not wanted, decompnc() does
+       the elimination alone.  condest() gives a generally sharper
+       estimate for either, on demand.
+*/
+
+{   /* --- function decomp() --- */
+
+double ek, t, anorm, ynorm, znorm;
+int    i, k, m;
+double *pa;           /* temporary pointer */
+double *work;
+
+*flag = 0;
+work = (double *) NULL;
+
+if (a == NULL || pivot == NULL || n < 1 || ndim < n)
+   {
+   *flag = 2;
+   return (0);
+   }
+
+pivot[n-1] = 1;
+if (n == 1)
+   {
+   /* One element only */
+   *cond = 1.0;
+   if (*a == 0.0)
+      {
+      *cond = 1.0e+32;  /* singular */
+      *flag = 3;
+      return (0);
+      }
+   return (0);
+   }
+
+work = (double *) malloc(n * sizeof(double));
+if (work == NULL)
+   {
+   *flag = 1;
+   return (0);
+   }
+
+if (dcelim (n, ndim, a, pivot, &anorm) != 0)
+   {
+   /* Singular or nearly singular */
+   *cond = 1.0e+32;
+   *flag = 3;
+   goto DecompExit;
+   }
+
+/* cond = (1-norm of a)*(an estimate of 1-norm of a-inverse)
+   estimate obtained by one step of inverse iteration for the
+   small singular vector. This involves solving two systems
+   of equations, (a-transpose)*y = e and a*z = y where e
+   is a vector of +1 or -1 chosen to cause growth in y.
+   estimate = (1-norm of z)/(1-norm of y)
+
+   Solve (a-transpose)*y = e   */
+
+for (k = 0; k < n; ++k)
+   {
+   t = 0.0;
+   if (k != 0)
+      {
+      for (i = 0; i < k; ++i)  t += a[AINDEX(i,k)] * work[i];
+      }
+   if (t < 0.0) ek = -1.0; else  ek = 1.0;
+   pa = a+AINDEX(k,k);
+   if (fabs(*pa) < anorm * EPSILON)
+      {
+      /* Singular */
+      *cond = 1.0e+32;
+      *flag = 3;
+      goto DecompExit;
+      }
+
+   work[k] = -(ek + t) / *pa;
+   }
+
+for (k = n-2; k >= 0; --k)
+   {
+   t = 0.0;
+   for (i = k+1; i < n; i++)
+      t += a[AINDEX(i,k)] * work[i];
+      /* we have used work[i] here, however the use of work[k]
+	 makes some difference to cond */
+   work[k] = t;
+   m = pivot[k];
+   if (m != k) { t = work[m]; work[m] = work[k]; work[k] = t; }
+   }
+
+ynorm = 0.0;
+for (i = 0; i < n; ++i) ynorm += fabs(work[i]);
+
+/* --- solve a * z = y */
+solve (n, ndim, a, work, pivot);
+
+znorm = 0.0;
+for (i = 0; i < n; ++i) znorm += fabs(work[i]);
+
+/* --- estimate condition --- */
+*cond = anorm * znorm / ynorm;
+if (*cond < 1.0) *cond = 1.0;
+if (*cond + 1.0 == *cond) *flag = 3;
+
+DecompExit:
+if (work != NULL) { free (work); work = (double *) NULL; }
+return (0);
+}   /* --- end of function decomp() --- */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int decompnc (int n, int ndim,
+              double *a, int pivot[],
+              double *anorm, int *flag)
+
+#else
+
+int decompnc (n, ndim, a, pivot, anorm, flag)
+
+int    n,
+       ndim;
+double *a;
+int    pivot[];
+double *anorm;
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Decomposes a real matrix by gaussian elimination, as for
+   decomp(), but without estimating the condition of the matrix.
+   Use solve() or solve_many() to compute solutions and, if it
+   is wanted later, condest() for the condition number.
+
+   Input ...
+   -----
+   n    = order of the matrix
+   ndim = row dimension of matrix as defined in the calling program
+   *a   = pointer to matrix to be triangularized
+
+   Output ...
+   ------
+   *a        = the factors, exactly as left by decomp()
+   pivot     = the pivot vector, as for decomp()
+   anorm     = the 1-norm of the original matrix, for condest()
+   flag      = Status indicator
+               0 : successful execution
+               2 : illegal user input n < 1, a == NULL,
+                   pivot == NULL, n > ndim.
+               3 : matrix is singular; a pivot smaller than
+                   anorm * EPSILON was found.
+
+   Notes ...
+   -----
+   (1) No workspace is allocated, and the cost is that of the
+       elimination alone.  The test for singularity is that made
+       during elimination by decomp(); a matrix that is merely
+       ill-conditioned is not detected.
+*/
+
+{   /* --- function decompnc() --- */
+
+*flag = 0;
+if (a == NULL || pivot == NULL || n < 1 || ndim < n)
+   {
+   *flag = 2;
+   return (0);
+   }
+
+pivot[n-1] = 1;
+*anorm = fabs(*a);
+if (n == 1)
+   {
+   if (*a == 0.0) *flag = 3;
+   return (0);
+   }
+
+if (dcelim (n, ndim, a, pivot, anorm) != 0) *flag = 3;
+
+return (0);
+}   /* --- end of function decompnc() --- */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int solve (int n, int ndim,
+           double *a, double b[],
+           int pivot[])
+
+#else
+
+int solve (n, ndim, a, b, pivot)
+
+int    n,
+       ndim,
+       pivot[];
+double *a,
+       b[];
+
+#endif
+
+/* Purpose :
+   -------
+   Solution of linear system, a * x = b.
+   Do not use if decomp() has detected singularity.
+
+   Input..
+   -----
+   n     = order of matrix
+   ndim  = row dimension of a
+   a     = triangularized matrix obtained from decomp()
+   b     = right hand side vector
+   pivot = pivot vector obtained from decomp()
+
+   Output..
+   ------
+   b = solution vector, x
+
+*/
+
+{   /* --- begin function solve() --- */
+
+int    i, j, k, m;
+double t;
+
+if (n == 1)
+   {
+   /* trivial */
+   b[0] /= a[0];
+   }
+else
+   {
+   /* Forward elimination: apply multipliers. */
+   for (k = 0; k < n-1; k ++)
+      {
+      m = pivot[k];
+      t = b[m]; b[m] = b[k]; b[k] = t;
+      for (i = k+1; i < n; ++i) b[i] += a[AINDEX(i,k)] * t;
+      }
+
+   /* Back substitution. */
+   for (k = n-1; k >= 0; --k)
+      {
+      t = b[k];
+      for (j = k+1; j < n; ++j) t -= a[AINDEX(k,j)] * b[j];
+      b[k] = t / a[AINDEX(k,k)];
+      }
+   }
+
+return(0);
+}  /* --- end function solve() --- */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void dcstrip (int n, int ndim, double *a, int pivot[],
+                     int bdim, double *b, int j1, int j2)
+
+#else
+
+static void dcstrip (n, ndim, a, pivot, bdim, b, j1, j2)
+
+int    n, ndim;
+double *a;
+int    pivot[], bdim;
+double *b;
+int    j1, j2;
+
+#endif
+
+/* Purpose ...
+   -------
+   Forward elimination and back substitution, as for solve(), on
+   columns j1 .. j2-1 of the right hand sides b.  Four pivot steps
+   (rows of U) are applied together so that each row of b is
+   loaded once for four multiply-adds.  Rows brought up by an
+   interchange in the middle of a group are caught up first.
+*/
+
+#define BINDEX(i,j) ((i) * bdim + (j))
+
+{
+int    i, j, k, m, q, c, kq, nlist, list[4], from[4];
+double t, t0, t1, t2, t3, *pb, *pk, *p0, *p1, *p2, *p3;
+
+/* ---- Forward elimination, four pivot steps at a time. ---- */
+for (k = 0; k + 4 <= n-1; k += 4)
+   {
+   nlist = 0;
+   for (q = 0; q < 4; ++q)
+      {
+      kq = k + q;
+      m  = pivot[kq];
+      if (m > k+3)
+         {  /* row m has only been updated through column from[] */
+         for (i = 0; i < nlist && list[i] != m; ++i) ;
+         if (i == nlist) { list[i] = m; from[i] = k; ++nlist; }
+         pb = b + BINDEX(m,0);
+         for (c = from[i]; c < kq; ++c)
+            {
+            t  = a[AINDEX(m,c)];
+            pk = b + BINDEX(c,0);
+            for (j = j1; j < j2; ++j) pb[j] += t * pk[j];
+            }
+         from[i] = kq;
+         }
+      pk = b + BINDEX(kq,0);
+      if (m != kq)
+         {
+         pb = b + BINDEX(m,0);
+         for (j = j1; j < j2; ++j) { t = pb[j]; pb[j] = pk[j]; pk[j] = t; }
+         }
+      for (i = kq+1; i <= k+3; ++i)
+         {
+         t  = a[AINDEX(i,kq)];
+         pb = b + BINDEX(i,0);
+         for (j = j1; j < j2; ++j) pb[j] += t * pk[j];
+         }
+      }
+
+   /* the deferred updates of the rows below the group */
+   p0 = b + BINDEX(k,0);
+   p1 = p0 + bdim;
+   p2 = p1 + bdim;
+   p3 = p2 + bdim;
+   for (i = k+4; i < n; ++i)
+      {
+      pb = b + BINDEX(i,0);
+      for (q = 0; q < nlist && list[q] != i; ++q) ;
+      if (q < nlist)
+         {
+         for (c = from[q]; c <= k+3; ++c)
+            {
+            t  = a[AINDEX(i,c)];
+            pk = b + BINDEX(c,0);
+            for (j = j1; j < j2; ++j) pb[j] += t * pk[j];
+            }
+         continue;
+         }
+      t0 = a[AINDEX(i,k)];   t1 = a[AINDEX(i,k+1)];
+      t2 = a[AINDEX(i,k+2)]; t3 = a[AINDEX(i,k+3)];
+      for (j = j1; j < j2; ++j)
+         pb[j] += t0 * p0[j] + t1 * p1[j] + t2 * p2[j] + t3 * p3[j];
+      }
+   }
+
+/* the remaining pivot steps, one at a time */
+for ( ; k < n-1; ++k)
+   {
+   m  = pivot[k];
+   pk = b + BINDEX(k,0);
+   if (m != k)
+      {
+      pb = b + BINDEX(m,0);
+      for (j = j1; j < j2; ++j) { t = pb[j]; pb[j] = pk[j]; pk[j] = t; }
+      }
+   for (i = k+1; i < n; ++i)
+      {
+      t  = a[AINDEX(i,k)];
+      pb = b + BINDEX(i,0);
+      for (j = j1; j < j2; ++j) pb[j] += t * pk[j];
+      }
+   }
+
+/* ---- Back substitution, four rows at a time. ---- */
+for (k = n-1; k >= 0; k -= 4)
+   {
+   if (k < 3)
+      {  /* the odd rows at the top */
+      for ( ; k >= 0; --k)
+         {
+         pk = b + BINDEX(k,0);
+         for (i = k+1; i < n; ++i)
+            {
+            t  = a[AINDEX(k,i)];
+            pb = b + BINDEX(i,0);
+            for (j = j1; j < j2; ++j) pk[j] -= t * pb[j];
+            }
+         t = a[AINDEX(k,k)];
+         for (j = j1; j < j2; ++j) pk[j] /= t;
+         }
+      break;
+      }
+   p0 = b + BINDEX(k-3,0);
+   p1 = p0 + bdim;
+   p2 = p1 + bdim;
+   p3 = p2 + bdim;
+   for (i = k+1; i < n; ++i)
+      {
+      t0 = a[AINDEX(k-3,i)]; t1 = a[AINDEX(k-2,i)];
+      t2 = a[AINDEX(k-1,i)]; t3 = a[AINDEX(k,i)];
+      pb = b + BINDEX(i,0);
+      for (j = j1; j < j2; ++j)
+         {
+         p0[j] -= t0 * pb[j]; p1[j] -= t1 * pb[j];
+         p2[j] -= t2 * pb[j]; p3[j] -= t3 * pb[j];
+         }
+      }
+   /* the triangle within the group */
+   for (q = k; q > k-4; --q)
+      {
+      pk = b + BINDEX(q,0);
+      for (i = q+1; i <= k; ++i)
+         {
+         t  = a[AINDEX(q,i)];
+         pb = b + BINDEX(i,0);
+         for (j = j1; j < j2; ++j) pk[j] -= t * pb[j];
+         }
+      t = a[AINDEX(q,q)];
+      for (j = j1; j < j2; ++j) pk[j] /= t;
+      }
+   }
+}
+
+#undef BINDEX
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int solve_many (int n, int ndim,
+                double *a, int pivot[],
+                int nrhs, int bdim, double *b)
+
+#else
+
+int solve_many (n, ndim, a, pivot, nrhs, bdim, b)
+
+int    n,
+       ndim;
+double *a;
+int    pivot[],
+       nrhs,
+       bdim;
+double *b;
+
+#endif
+
+/* Purpose :
+   -------
+   Solution of the linear systems a * X = B for several
+   right hand sides at once.
+   Do not use if decomp() has detected singularity.
+
+   Input..
+   -----
+   n     = order of matrix
+   ndim  = row dimension of a
+   a     = triangularized matrix obtained from decomp()
+   pivot = pivot vector obtained from decomp()
+   nrhs  = number of right hand sides
+   bdim  = row dimension of b, bdim >= nrhs
+   b     = the n by nrhs matrix of right hand sides, one
+           per column, b[i*bdim + j] = element i of column j
+
+   Output..
+   ------
+   b = the solutions, in place of the right hand sides
+
+   Notes ...
+   -----
+   (1) The columns of b are taken in strips chosen to stay in
+       cache and each element of the factors is read once per
+       strip, rather than once per right hand side as with
+       repeated calls to solve().  The inner loops run along
+       the rows of a strip and may be vectorized by the compiler.
+   (2) If compiled with OpenMP, the strips are shared among
+       threads.
+*/
+
+{   /* --- begin function solve_many() --- */
+
+int    jj, jb, nb;
+
+if (n < 1 || nrhs < 1) return (0);
+if (n == 1)
+   {
+   for (jj = 0; jj < nrhs; ++jj) b[jj] /= a[0];
+   return (0);
+   }
+
+/* strip width, a multiple of 8 columns */
+nb = (int) (DECOMP_SOLVEB / n);
+nb = (nb < 8) ? 8 : nb - nb % 8;
+
+#if (PARALLEL)
+#pragma omp parallel for schedule(dynamic) private(jb) \
+        if ((long) n * n * nrhs > DECOMP_PMIN)
+#endif
+for (jj = 0; jj < nrhs; jj += nb)
+   {
+   jb = (jj + nb < nrhs) ? jj + nb : nrhs;
+   dcstrip (n, ndim, a, pivot, bdim, b, jj, jb);
+   }
+
+return (0);
+}  /* --- end function solve_many() --- */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void dctsolv (int n, int ndim, double *a, int pivot[],
+                     double b[])
+
+#else
+
+static void dctsolv (n, ndim, a, pivot, b)
+
+int    n, ndim;
+double *a;
+int    pivot[];
+double b[];
+
+#endif
+
+/* Purpose ...
+   -------
+   Solution of the transposed system, (a-transpose) * x = b,
+   with the factors from decomp().  b is overwritten by x.
+*/
+
+{
+int    i, k, m;
+double t;
+
+/* (U-transpose) * y = b */
+for (k = 0; k < n; ++k)
+   {
+   t = b[k];
+   for (i = 0; i < k; ++i) t -= a[AINDEX(i,k)] * b[i];
+   b[k] = t / a[AINDEX(k,k)];
+   }
+
+/* then the multipliers and interchanges, in reverse */
+for (k = n-2; k >= 0; --k)
+   {
+   t = b[k];
+   for (i = k+1; i < n; ++i) t += a[AINDEX(i,k)] * b[i];
+   b[k] = t;
+   m = pivot[k];
+   if (m != k) { t = b[m]; b[m] = b[k]; b[k] = t; }
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int condest (int n, int ndim,
+             double *a, int pivot[],
+             double anorm, double *cond,
+             int *flag)
+
+#else
+
+int condest (n, ndim, a, pivot, anorm, cond, flag)
+
+int    n,
+       ndim;
+double *a;
+int    pivot[];
+double anorm,
+       *cond;
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Estimate the condition number, in the 1-norm, of a matrix that
+   has been factored by decomp() or decompnc().
+
+   Input ...
+   -----
+   n, ndim, a, pivot : the factored matrix as returned by
+           decomp() or decompnc()
+   anorm = the 1-norm of the original matrix, as returned
+           by decompnc()
+
+   Output ...
+   ------
+   cond  = an estimate of anorm * (1-norm of a-inverse).
+           cond is set to 1.0e+32 for an exactly singular factor.
+   flag  = Status indicator
+           0 : successful execution
+           1 : could not allocate memory for workspace
+           2 : illegal user input n < 1, a == NULL,
+               pivot == NULL, n > ndim.
+
+   Notes ...
+   -----
+   (1) The 1-norm of a-inverse is estimated by the method of
+       Hager as refined by Higham (LAPACK's dlacon).  Each step
+       costs one solve() and one transposed solve; at most five
+       steps are taken and usually two or three suffice.  The
+       estimate is a lower bound, almost always within a factor
+       of three of the true value.
+   (2) The vectors x[0..n-1] and z[0..n-1] are allocated
+       internally.
+   (3) Reference:
+       N.J. Higham, FORTRAN codes for estimating the one-norm of
+       a real or complex matrix, ACM TOMS 14 (1988) 381-396.
+*/
+
+{   /* --- function condest() --- */
+
+double *x, *z, est, t, zmax;
+int    i, j, iter, jlast;
+
+*flag = 0;
+x = (double *) NULL;
+z = (double *) NULL;
+
+if (a == NULL || pivot == NULL || n < 1 || ndim < n)
+   {
+   *flag = 2;
+   return (0);
+   }
+
+for (i = 0; i < n; ++i)
+   {
+   if (a[AINDEX(i,i)] == 0.0)
+      {
+      *cond = 1.0e+32;  /* singular */
+      return (0);
+      }
+   }
+
+x = (double *) malloc(n * sizeof(double));
+z = (double *) malloc(n * sizeof(double));
+if (x == NULL || z == NULL)
+   {
+   *flag = 1;
+   goto CondestExit;
+   }
+
+/* --- start from the vector of equal elements --- */
+for (i = 0; i < n; ++i) x[i] = 1.0 / n;
+est   = 0.0;
+jlast = -1;
+
+for (iter = 0; iter < 5; ++iter)
+   {
+   /* y = a-inverse * x, kept in x */
+   solve (n, ndim, a, x, pivot);
+   t = 0.0;
+   for (i = 0; i < n; ++i) t += fabs(x[i]);
+   if (iter > 0 && t <= est) break;   /* no further growth */
+   est = t;
+
+   /* z = a-inverse-transpose * sign(y) */
+   for (i = 0; i < n; ++i) z[i] = (x[i] >= 0.0) ? 1.0 : -1.0;
+   dctsolv (n, ndim, a, pivot, z);
+
+   j = 0;
+   zmax = fabs(z[0]);
+   for (i = 1; i < n; ++i)
+      if (fabs(z[i]) > zmax) { zmax = fabs(z[i]); j = i; }
+   if (j == jlast) break;             /* converged */
+   jlast = j;
+
+   for (i = 0; i < n; ++i) x[i] = 0.0;
+   x[j] = 1.0;
+   }
+
+/* --- a safeguard against special matrices --- */
+for (i = 0; i < n; ++i)
+   {
+   x[i] = 1.0 + (double) i / ((n > 1) ? n - 1 : 1);
+   if (i % 2) x[i] = -x[i];
+   }
+solve (n, ndim, a, x, pivot);
+t = 0.0;
+for (i = 0; i < n; ++i) t += fabs(x[i]);
+t = 2.0 * t / (3.0 * n);
+if (t > est) est = t;
+
+*cond = anorm * est;
+if (*cond < 1.0) *cond = 1.0;
+
+CondestExit:
+if (z != NULL) { free (z); z = (double *) NULL; }
+if (x != NULL) { free (x); x = (double *) NULL; }
+return (0);
+}   /* --- end of function condest() --- */
+
+/*-----------------------------------------------------------------*/
+
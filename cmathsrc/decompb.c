@@ -0,0 +1,131 @@
+/* decompb.c
+   Timing driver for decomp(), solve() and invert(). */
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+/* Purpose ...
+   -------
+   Time decomp(), solve() and invert() on a random n by n matrix
+   for 1, 2, 4, ... up to maxthreads OpenMP threads and report the
+   rate in GFLOP/s, with the error of the solution of A x = b for
+   x[i] = 1.
+
+   Usage ...
+   -----
+   decompb.x [n [maxthreads]]
+   n          : order of the matrix (default 1000)
+   maxthreads : largest number of threads (default as for OpenMP)
+
+   Build ...
+   -----
+   make decompb.x  from the top directory, or
+   cc -O2 -fopenmp decompb.c decomp.c invert.c cmathmsg.c -lm
+
+   Version ... 1.0, 19 October 2026
+   -------
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "cmath.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+static double seconds ()
+{
+#ifdef _OPENMP
+return (omp_get_wtime ());
+#else
+return ((double) clock () / CLOCKS_PER_SEC);
+#endif
+}
+
+int main (argc, argv)
+int  argc;
+char *argv[];
+{
+double *a, *a0, *ainv, *b, cond, t0, tlu, tsol, tinv, fn, err;
+int    n, nthr, maxthr, i, j, flag, *pivot;
+
+n = (argc > 1) ? atoi (argv[1]) : 1000;
+#ifdef _OPENMP
+maxthr = omp_get_max_threads ();
+#else
+maxthr = 1;
+#endif
+if (argc > 2) maxthr = atoi (argv[2]);
+if (n < 2 || maxthr < 1)
+   {
+   printf ("usage : decompb [n [maxthreads]]\n");
+   return (1);
+   }
+
+a     = (double *) malloc (n * n * sizeof(double));
+a0    = (double *) malloc (n * n * sizeof(double));
+ainv  = (double *) malloc (n * n * sizeof(double));
+b     = (double *) malloc (n * sizeof(double));
+pivot = (int *) malloc (n * sizeof(int));
+if (a == NULL || a0 == NULL || ainv == NULL || b == NULL || pivot == NULL)
+   {
+   printf ("could not allocate memory for n = %d\n", n);
+   return (1);
+   }
+
+srand (1);
+for (i = 0; i < n * n; ++i) a0[i] = (double) rand () / RAND_MAX - 0.5;
+fn = (double) n;
+
+printf ("\n\n  --- CMATH --- Design Software 1989\n");
+printf ("\nTiming driver for decomp(), solve() and invert(), n = %d\n\n", n);
+printf ("threads   decomp GF/s   solve ms   invert GF/s   error\n");
+
+for (nthr = 1; nthr <= maxthr;
+     nthr = (nthr < maxthr && 2 * nthr > maxthr) ? maxthr : 2 * nthr)
+   {
+#ifdef _OPENMP
+   omp_set_num_threads (nthr);
+#endif
+   for (i = 0; i < n * n; ++i) a[i] = a0[i];
+   t0 = seconds ();
+   decomp (n, n, a, &cond, pivot, &flag);
+   tlu = seconds () - t0;
+   if (flag != 0)
+      {
+      printf ("decomp : %s\n", cmathmsg (DECOMP_C, flag));
+      return (1);
+      }
+
+   /* right hand side for the solution x[i] = 1 */
+   for (i = 0; i < n; ++i)
+      {
+      b[i] = 0.0;
+      for (j = 0; j < n; ++j) b[i] += a0[i * n + j];
+      }
+   t0 = seconds ();
+   solve (n, n, a, b, pivot);
+   tsol = seconds () - t0;
+   err = 0.0;
+   for (i = 0; i < n; ++i) if (fabs (b[i] - 1.0) > err) err = fabs (b[i] - 1.0);
+
+   for (i = 0; i < n * n; ++i) a[i] = a0[i];
+   t0 = seconds ();
+   invert (n, n, a, ainv, &flag);
+   tinv = seconds () - t0;
+
+   printf ("%5d   %11.2f   %8.2f   %11.2f   %8.1e\n", nthr,
+           2.0 * fn * fn * fn / 3.0 / tlu * 1.0e-9,
+           tsol * 1.0e3,
+           2.0 * fn * fn * fn / tinv * 1.0e-9,
+           err);
+   }
+
+free (pivot); free (b); free (ainv); free (a0); free (a);
+return (0);
+}
@@ -0,0 +1,138 @@
+/* invert.c
+   Invert a matrix using decomp() and solve().
+*/
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+#include "cmath.h"
+#if (ANSII || IBM3083)
+#include <stdlib.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int invert (int n, int ndim,
+            double *a, double *ainv,
+            int *flag)
+
+#else
+
+int invert (n, ndim, a, ainv, flag)
+int    n, ndim;
+double *a, *ainv;
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Invert a matrix using direct methods (LU decomposition and
+   back-substitution).  The inverse is built up column by column
+   from the identity matrix.
+
+   Input ...
+   -----
+   n      : order of the matrices
+   ndim   : the declared dimension of the rows of the matrices
+   a      : matrix to be inverted
+
+   Output ...
+   ------
+   ainv   : inverse of a if a is nonsingular
+   a      : the matrix in a overwritten
+   flag   : status indicator
+            = 0, normal return
+            = 1, a is singular to working precision
+            = 2, could not allocate memory for workspace
+            = 3, invalid parameters
+                 n > ndim, a == NULL, ainv == NULL, n < 1
+
+   Workspace ...
+   ---------
+   A vector of n integer elements is allocated by invert().
+   Decomp() allocates a further n double elements.
+
+   This C code written by ...  Peter & Nigel,
+   ----------------------      Design Software,
+                               42 Gubberley St,
+                               Kenmore, 4069,
+                               Australia.
+
+   Version ... 1.0,  May 1989
+   -------     1.1,  19 October 2026  (columns solved in place, threads)
+               1.2,  19 October 2026  (all columns by solve_many())
+
+   Notes ...
+   -----
+   (1) All columns of the inverse are solved for in place in ainv
+       with a single call to solve_many(), which shares them among
+       threads if compiled with OpenMP.
+
+*/
+
+/*-----------------------------------------------------------------*/
+
+{  /* begin invert() ... */
+
+int    i, j, in, *piv, fail;
+double cond;
+
+*flag = 0;
+piv = (int *) NULL;
+
+if (n > ndim || n < 1 || a == NULL || ainv == NULL)
+   {
+   *flag = 3;
+   return (0);
+   }
+
+piv = (int *) malloc (n * sizeof(int));
+if (piv == NULL)
+   {
+   *flag = 2;
+   goto BailOut;
+   }
+
+decomp (n, ndim, a, &cond, piv, &fail);
+if (fail != 0)
+   {
+   *flag = 2;
+   goto BailOut;
+   }
+if (cond == (cond+1.0))
+   {
+   *flag = 1;
+   goto BailOut;
+   }
+
+/* set up identity matrix */
+for (i = 0; i < n; ++i)
+   {
+   in = i * ndim;
+   for (j = 0; j < n; ++j) ainv[in + j] = 0.0;
+   ainv[in + i] = 1.0;
+   }
+
+/* now, build up inverse by columns, all at once */
+solve_many (n, ndim, a, piv, n, ndim, ainv);
+
+BailOut:
+if (piv != NULL) { free(piv); piv = NULL; }
+
+return (0);
+}  /* ... end of invert() */
+
+/*-----------------------------------------------------------------*/
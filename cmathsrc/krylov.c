@@ -0,0 +1,896 @@
+/* krylov.c
+   Preconditioned iterative solvers for large linear systems:
+   conjugate gradients, GMRES and BiCGSTAB. */
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+#include "cmath.h"
+#if (STDLIBH)
+#include <stdlib.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+/* The vector operations are shared among threads when compiled
+   for OpenMP (PARALLEL in cmath.h), but only for vectors longer
+   than KRYLOV_PMIN elements.  */
+
+#define  KRYLOV_PMIN  32768
+
+/* Largest restart length for gmres(). */
+
+#define  KRYLOV_MMAX  200
+
+/*-----------------------------------------------------------------*/
+
+/* Vector kernels.  Each is a single loop over contiguous elements
+   that the compiler may vectorize.  */
+
+#if (PROTOTYPE)
+static double kdot (int n, double x[], double y[])
+#else
+static double kdot (n, x, y)
+int    n;
+double x[], y[];
+#endif
+{
+int    i;
+double s;
+s = 0.0;
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) reduction(+:s) \
+        if (n > KRYLOV_PMIN)
+#endif
+for (i = 0; i < n; ++i) s += x[i] * y[i];
+return (s);
+}
+
+#if (PROTOTYPE)
+static void kaxpy (int n, double a, double x[], double y[])
+#else
+static void kaxpy (n, a, x, y)
+int    n;
+double a, x[], y[];
+#endif
+/* y = y + a * x */
+{
+int i;
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) if (n > KRYLOV_PMIN)
+#endif
+for (i = 0; i < n; ++i) y[i] += a * x[i];
+}
+
+#if (PROTOTYPE)
+static void kxpby (int n, double x[], double b, double y[])
+#else
+static void kxpby (n, x, b, y)
+int    n;
+double x[], b, y[];
+#endif
+/* y = x + b * y */
+{
+int i;
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) if (n > KRYLOV_PMIN)
+#endif
+for (i = 0; i < n; ++i) y[i] = x[i] + b * y[i];
+}
+
+#if (PROTOTYPE)
+static void kcopy (int n, double x[], double y[])
+#else
+static void kcopy (n, x, y)
+int    n;
+double x[], y[];
+#endif
+{
+int i;
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) if (n > KRYLOV_PMIN)
+#endif
+for (i = 0; i < n; ++i) y[i] = x[i];
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static int kprec (struct KPREC *prec, int n, double r[], double z[])
+
+#else
+
+static int kprec (prec, n, r, z)
+struct KPREC *prec;
+int    n;
+double r[], z[];
+
+#endif
+
+/* Purpose ...
+   -------
+   Apply the preconditioner, z = M-inverse * r.
+   prec may be NULL for no preconditioning.
+*/
+
+{
+int    i, k, *rp, *col;
+double t, *v;
+
+if (prec == NULL || prec->type == KPREC_NONE)
+   {
+   kcopy (n, r, z);
+   return (0);
+   }
+
+switch (prec->type)
+   {
+   case KPREC_JACOBI :
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) if (n > KRYLOV_PMIN)
+#endif
+      for (i = 0; i < n; ++i) z[i] = prec->d[i] * r[i];
+      break;
+
+   case KPREC_ILU0 :
+      /* forward with unit L, then back with U,
+         the columns of each row being in order */
+      rp  = prec->rowptr;
+      col = prec->col;
+      v   = prec->lu;
+      for (i = 0; i < n; ++i)
+         {
+         t = r[i];
+         for (k = rp[i]; k < prec->diag[i]; ++k) t -= v[k] * z[col[k]];
+         z[i] = t;
+         }
+      for (i = n-1; i >= 0; --i)
+         {
+         t = z[i];
+         for (k = prec->diag[i] + 1; k < rp[i+1]; ++k)
+            t -= v[k] * z[col[k]];
+         z[i] = t / v[prec->diag[i]];
+         }
+      break;
+
+   case KPREC_USER :
+      (*prec->psolve) (n, r, z);
+      break;
+
+   default :
+      kcopy (n, r, z);
+   }
+return (0);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int kprecinit (struct SPMAT *a, int type, struct KPREC *prec, int *flag)
+
+#else
+
+int kprecinit (a, type, prec, flag)
+
+struct SPMAT *a;
+int    type;
+struct KPREC *prec;
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Set up a preconditioner for cgsolve(), gmres() and bicgstab()
+   from a sparse matrix.
+
+   Input ...
+   -----
+   a     : the matrix of the linear system, or an approximation to
+           it, in the compressed row form of spdecomp()
+   type  : KPREC_NONE   : no preconditioning
+           KPREC_JACOBI : the diagonal of a
+           KPREC_ILU0   : incomplete LU factors of a with no fill,
+                          i.e. L and U have the pattern of a
+           For a user defined preconditioner, set prec->type to
+           KPREC_USER and prec->psolve to a function
+           int psolve (int n, double r[], double z[])
+           which solves M z = r; kprecinit() is then not needed.
+
+   Output ...
+   ------
+   prec  : the preconditioner.  Release it with kprecfree().
+   flag  : status indicator
+           = 0, normal return
+           = 1, could not allocate memory for workspace
+           = 2, illegal user input
+           = 3, a zero diagonal element (or pivot, for KPREC_ILU0)
+
+   Version ... 1.0,  19 October 2026
+   -------
+
+   Notes ...
+   -----
+   (1) Rows of a need not have their columns in order; a sorted
+       copy of the pattern is made for the incomplete factors.
+   (2) The incomplete factorization is the IKJ form of gaussian
+       elimination with updates outside the pattern dropped, so
+       it takes work of about the sum of the squares of the row
+       lengths and storage of nnz elements.
+*/
+
+{  /* begin kprecinit() */
+
+int    n, i, j, k, kk, p, *iw, *col;
+double t;
+
+*flag = 0;
+iw = (int *) NULL;
+if (prec == NULL)
+   {
+   *flag = 2;
+   return (0);
+   }
+prec->type   = KPREC_NONE;
+prec->n      = 0;
+prec->d      = prec->lu = (double *) NULL;
+prec->rowptr = prec->col = prec->diag = (int *) NULL;
+prec->psolve = NULL;
+if (type == KPREC_NONE) return (0);
+
+if (a == NULL || a->n < 1 || a->rowptr == NULL || a->col == NULL ||
+    a->val == NULL || (type != KPREC_JACOBI && type != KPREC_ILU0))
+   {
+   *flag = 2;
+   return (0);
+   }
+n = a->n;
+prec->n = n;
+
+if (type == KPREC_JACOBI)
+   {
+   prec->d = (double *) malloc (n * sizeof(double));
+   if (prec->d == NULL)
+      {
+      *flag = 1;
+      return (0);
+      }
+   for (i = 0; i < n; ++i)
+      {
+      t = 0.0;
+      for (k = a->rowptr[i]; k < a->rowptr[i+1]; ++k)
+         if (a->col[k] == i) t += a->val[k];
+      if (t == 0.0)
+         {
+         *flag = 3;
+         kprecfree (prec);
+         return (0);
+         }
+      prec->d[i] = 1.0 / t;
+      }
+   prec->type = KPREC_JACOBI;
+   return (0);
+   }
+
+/* ---- ILU(0): sorted copy of a ---- */
+prec->rowptr = (int *) malloc ((n+1) * sizeof(int));
+prec->col    = (int *) malloc ((a->rowptr[n] + 1) * sizeof(int));
+prec->lu     = (double *) malloc ((a->rowptr[n] + 1) * sizeof(double));
+prec->diag   = (int *) malloc (n * sizeof(int));
+iw           = (int *) malloc (n * sizeof(int));
+if (prec->rowptr == NULL || prec->col == NULL || prec->lu == NULL ||
+    prec->diag == NULL || iw == NULL)
+   {
+   *flag = 1;
+   goto LeaveKprecinit;
+   }
+col = prec->col;
+for (i = 0; i <= n; ++i) prec->rowptr[i] = a->rowptr[i];
+for (i = 0; i < n; ++i)
+   {
+   /* insertion sort of the row, which is usually short */
+   prec->diag[i] = -1;
+   for (k = a->rowptr[i]; k < a->rowptr[i+1]; ++k)
+      {
+      j = a->col[k];
+      t = a->val[k];
+      for (p = k; p > a->rowptr[i] && col[p-1] > j; --p)
+         {
+         col[p] = col[p-1];
+         prec->lu[p] = prec->lu[p-1];
+         }
+      col[p] = j;
+      prec->lu[p] = t;
+      }
+   for (k = a->rowptr[i]; k < a->rowptr[i+1]; ++k)
+      if (col[k] == i) prec->diag[i] = k;
+   if (prec->diag[i] < 0)
+      {
+      *flag = 3;
+      goto LeaveKprecinit;
+      }
+   }
+
+/* ---- incomplete elimination, row by row ---- */
+for (j = 0; j < n; ++j) iw[j] = -1;
+for (i = 0; i < n; ++i)
+   {
+   for (k = prec->rowptr[i]; k < prec->rowptr[i+1]; ++k) iw[col[k]] = k;
+   for (k = prec->rowptr[i]; k < prec->diag[i]; ++k)
+      {
+      kk = col[k];
+      t = prec->lu[k] / prec->lu[prec->diag[kk]];
+      prec->lu[k] = t;
+      for (p = prec->diag[kk] + 1; p < prec->rowptr[kk+1]; ++p)
+         if (iw[col[p]] >= 0) prec->lu[iw[col[p]]] -= t * prec->lu[p];
+      }
+   for (k = prec->rowptr[i]; k < prec->rowptr[i+1]; ++k) iw[col[k]] = -1;
+   if (prec->lu[prec->diag[i]] == 0.0)
+      {
+      *flag = 3;
+      goto LeaveKprecinit;
+      }
+   }
+prec->type = KPREC_ILU0;
+
+LeaveKprecinit:
+if (iw != NULL) free (iw);
+if (*flag != 0) kprecfree (prec);
+return (0);
+}  /* end of kprecinit() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int kprecfree (struct KPREC *prec)
+
+#else
+
+int kprecfree (prec)
+struct KPREC *prec;
+
+#endif
+
+/* Purpose ...
+   -------
+   Release the storage of a preconditioner from kprecinit().
+*/
+
+{
+if (prec->d      != NULL) free (prec->d);
+if (prec->lu     != NULL) free (prec->lu);
+if (prec->diag   != NULL) free (prec->diag);
+if (prec->col    != NULL) free (prec->col);
+if (prec->rowptr != NULL) free (prec->rowptr);
+prec->d      = prec->lu = (double *) NULL;
+prec->rowptr = prec->col = prec->diag = (int *) NULL;
+prec->type   = KPREC_NONE;
+return (0);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int cgsolve (int n,
+             int (*matvec)(int n, double x[], double y[]),
+             struct KPREC *prec,
+             double b[], double x[],
+             double tol, int maxit,
+             int *iter, double *resid, int *flag)
+
+#else
+
+int cgsolve (n, matvec, prec, b, x, tol, maxit, iter, resid, flag)
+
+int    n;
+int    (*matvec)();
+struct KPREC *prec;
+double b[], x[], tol;
+int    maxit, *iter;
+double *resid;
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Solve the linear system A x = b, A symmetric and positive
+   definite, by the preconditioned conjugate gradient method.
+
+   Input ...
+   -----
+   n      : the order of the system
+   matvec : user supplied function that forms y = A x
+            int matvec (int n, double x[], double y[])
+   prec   : the preconditioner, from kprecinit(), or NULL.
+            It should also be symmetric and positive definite.
+   b      : the right hand side
+   x      : an initial guess for the solution, e.g. zero
+   tol    : the iteration stops when the residual satisfies
+            || b - A x || <= tol * || b || (2-norms)
+   maxit  : the largest number of iterations to take
+
+   Output ...
+   ------
+   x      : the solution
+   iter   : the number of iterations (products with A) taken
+   resid  : the final relative residual || b - A x || / || b ||
+   flag   : status indicator
+            = 0, normal return
+            = 1, could not allocate memory for workspace
+            = 2, illegal user input, n < 1, tol <= 0, maxit < 1,
+                 NULL pointers
+            = 3, did not converge in maxit iterations
+            = 4, breakdown, A or the preconditioner is not
+                 positive definite
+
+   Workspace ...
+   ---------
+   4 vectors of n elements are allocated.
+
+   Version ... 1.0,  19 October 2026
+   -------
+
+   Notes ...
+   -----
+   (1) A is used only through matvec(), so it need not be stored
+       as a matrix; with a sparse A the storage is O(nnz).
+       For a matrix held in a struct SPMAT, matvec() may simply
+       call spmatvec().
+*/
+
+{  /* begin cgsolve() */
+
+double *r, *z, *p, *q, alpha, beta, rho, rhold, bnorm, rnorm, pq;
+int    it;
+
+*flag  = 0;
+r = z = p = q = (double *) NULL;
+if (n < 1 || matvec == NULL || b == NULL || x == NULL ||
+    tol <= 0.0 || maxit < 1 || iter == NULL || resid == NULL)
+   {
+   *flag = 2;
+   return (0);
+   }
+*iter  = 0;
+
+r = (double *) malloc (n * sizeof(double));
+z = (double *) malloc (n * sizeof(double));
+p = (double *) malloc (n * sizeof(double));
+q = (double *) malloc (n * sizeof(double));
+if (r == NULL || z == NULL || p == NULL || q == NULL)
+   {
+   *flag = 1;
+   goto LeaveCgsolve;
+   }
+
+bnorm = sqrt (kdot (n, b, b));
+if (bnorm == 0.0) bnorm = 1.0;
+
+/* r = b - A x */
+(*matvec) (n, x, r);
+kxpby (n, b, -1.0, r);
+rnorm  = sqrt (kdot (n, r, r));
+*resid = rnorm / bnorm;
+if (*resid <= tol) goto LeaveCgsolve;
+
+rhold = 1.0;
+for (it = 1; it <= maxit; ++it)
+   {
+   kprec (prec, n, r, z);
+   rho = kdot (n, r, z);
+   if (rho <= 0.0)
+      {
+      *flag = 4;
+      goto LeaveCgsolve;
+      }
+   if (it == 1) kcopy (n, z, p);
+   else
+      {
+      beta = rho / rhold;
+      kxpby (n, z, beta, p);
+      }
+   (*matvec) (n, p, q);
+   pq = kdot (n, p, q);
+   if (pq <= 0.0)
+      {
+      *flag = 4;
+      goto LeaveCgsolve;
+      }
+   alpha = rho / pq;
+   kaxpy (n, alpha, p, x);
+   kaxpy (n, -alpha, q, r);
+   rhold = rho;
+   *iter = it;
+   rnorm  = sqrt (kdot (n, r, r));
+   *resid = rnorm / bnorm;
+   if (*resid <= tol) goto LeaveCgsolve;
+   }
+*flag = 3;
+
+LeaveCgsolve:
+if (q != NULL) free (q);
+if (p != NULL) free (p);
+if (z != NULL) free (z);
+if (r != NULL) free (r);
+return (0);
+}  /* end of cgsolve() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int gmres (int n,
+           int (*matvec)(int n, double x[], double y[]),
+           struct KPREC *prec,
+           double b[], double x[],
+           int m, double tol, int maxit,
+           int *iter, double *resid, int *flag)
+
+#else
+
+int gmres (n, matvec, prec, b, x, m, tol, maxit, iter, resid, flag)
+
+int    n;
+int    (*matvec)();
+struct KPREC *prec;
+double b[], x[];
+int    m;
+double tol;
+int    maxit, *iter;
+double *resid;
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Solve the linear system A x = b by the restarted generalized
+   minimum residual method, GMRES(m), with right preconditioning.
+
+   Input ...
+   -----
+   n      : the order of the system
+   matvec : user supplied function that forms y = A x
+            int matvec (int n, double x[], double y[])
+   prec   : the preconditioner, from kprecinit(), or NULL
+   b      : the right hand side
+   x      : an initial guess for the solution, e.g. zero
+   m      : the restart length, 1 <= m <= 200.  20 to 50 is usual.
+   tol    : the iteration stops when the residual satisfies
+            || b - A x || <= tol * || b || (2-norms)
+   maxit  : the largest number of iterations (products with A)
+
+   Output ...
+   ------
+   x      : the solution
+   iter   : the number of iterations taken
+   resid  : the final relative residual || b - A x || / || b ||
+   flag   : status indicator
+            = 0, normal return
+            = 1, could not allocate memory for workspace
+            = 2, illegal user input, n < 1, m out of range, tol <= 0,
+                 maxit < 1, NULL pointers
+            = 3, did not converge in maxit iterations
+
+   Workspace ...
+   ---------
+   (m+2) vectors of n elements, and (m+1)*(m+3) doubles for the
+   Hessenberg matrix and the Givens rotations, are allocated.
+
+   Version ... 1.0,  19 October 2026
+   -------
+
+   Notes ...
+   -----
+   (1) The basis is orthogonalized by modified Gram-Schmidt and the
+       least squares problem is updated with Givens rotations as in
+       Saad & Schultz (1986).  With right preconditioning the
+       residual monitored is that of the original system.
+   (2) The residual is recomputed from b - A x at each restart.
+*/
+
+{  /* begin gmres() */
+
+double *v, *w, *h, *cs, *sn, *g, bnorm, beta, t, hr;
+int    i, j, k, it, ldh;
+
+*flag = 0;
+v = w = h = (double *) NULL;
+if (n < 1 || matvec == NULL || b == NULL || x == NULL ||
+    m < 1 || m > KRYLOV_MMAX || tol <= 0.0 || maxit < 1 ||
+    iter == NULL || resid == NULL)
+   {
+   *flag = 2;
+   return (0);
+   }
+*iter = 0;
+
+v = (double *) malloc ((m + 1) * n * sizeof(double));
+w = (double *) malloc (n * sizeof(double));
+ldh = m;
+h = (double *) malloc ((m + 1) * (ldh + 3) * sizeof(double));
+if (v == NULL || w == NULL || h == NULL)
+   {
+   *flag = 1;
+   goto LeaveGmres;
+   }
+cs = h + (m + 1) * ldh;
+sn = cs + (m + 1);
+g  = sn + (m + 1);
+
+bnorm = sqrt (kdot (n, b, b));
+if (bnorm == 0.0) bnorm = 1.0;
+
+it = 0;
+while (1)
+   {
+   /* r = b - A x, v[0] = r / || r || */
+   (*matvec) (n, x, v);
+   kxpby (n, b, -1.0, v);
+   beta   = sqrt (kdot (n, v, v));
+   *resid = beta / bnorm;
+   if (*resid <= tol) goto LeaveGmres;
+   if (it >= maxit) break;
+   for (i = 0; i < n; ++i) v[i] /= beta;
+   for (i = 0; i <= m; ++i) g[i] = 0.0;
+   g[0] = beta;
+
+   for (j = 0; j < m && it < maxit; ++j)
+      {
+      /* w = A M-inverse v[j] */
+      kprec (prec, n, v + j * n, w);
+      (*matvec) (n, w, v + (j + 1) * n);
+      ++it;
+
+      /* orthogonalize against v[0..j] */
+      for (k = 0; k <= j; ++k)
+         {
+         t = kdot (n, v + (j + 1) * n, v + k * n);
+         h[k * ldh + j] = t;
+         kaxpy (n, -t, v + k * n, v + (j + 1) * n);
+         }
+      t = sqrt (kdot (n, v + (j + 1) * n, v + (j + 1) * n));
+      h[(j + 1) * ldh + j] = t;
+      if (t != 0.0)
+         for (i = 0; i < n; ++i) v[(j + 1) * n + i] /= t;
+
+      /* apply the earlier rotations to column j, then a new one */
+      for (k = 0; k < j; ++k)
+         {
+         hr = cs[k] * h[k * ldh + j] + sn[k] * h[(k + 1) * ldh + j];
+         h[(k + 1) * ldh + j] = -sn[k] * h[k * ldh + j]
+                                + cs[k] * h[(k + 1) * ldh + j];
+         h[k * ldh + j] = hr;
+         }
+      hr = sqrt (h[j * ldh + j] * h[j * ldh + j] + t * t);
+      if (hr == 0.0) { cs[j] = 1.0; sn[j] = 0.0; }
+      else           { cs[j] = h[j * ldh + j] / hr; sn[j] = t / hr; }
+      h[j * ldh + j] = hr;
+      h[(j + 1) * ldh + j] = 0.0;
+      g[j + 1] = -sn[j] * g[j];
+      g[j]     =  cs[j] * g[j];
+
+      *iter = it;
+      if (fabs (g[j + 1]) / bnorm <= tol || t == 0.0)
+         {
+         ++j;
+         break;
+         }
+      }
+
+   /* y = H-inverse g, then x = x + M-inverse V y */
+   for (k = j - 1; k >= 0; --k)
+      {
+      t = g[k];
+      for (i = k + 1; i < j; ++i) t -= h[k * ldh + i] * g[i];
+      g[k] = (h[k * ldh + k] != 0.0) ? t / h[k * ldh + k] : 0.0;
+      }
+   for (i = 0; i < n; ++i) v[i] *= g[0];
+   for (k = 1; k < j; ++k) kaxpy (n, g[k], v + k * n, v);
+   kprec (prec, n, v, w);
+   kaxpy (n, 1.0, w, x);
+   }
+*flag = 3;
+
+LeaveGmres:
+if (h != NULL) free (h);
+if (w != NULL) free (w);
+if (v != NULL) free (v);
+return (0);
+}  /* end of gmres() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int bicgstab (int n,
+              int (*matvec)(int n, double x[], double y[]),
+              struct KPREC *prec,
+              double b[], double x[],
+              double tol, int maxit,
+              int *iter, double *resid, int *flag)
+
+#else
+
+int bicgstab (n, matvec, prec, b, x, tol, maxit, iter, resid, flag)
+
+int    n;
+int    (*matvec)();
+struct KPREC *prec;
+double b[], x[], tol;
+int    maxit, *iter;
+double *resid;
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Solve the linear system A x = b by the stabilized biconjugate
+   gradient method, BiCGSTAB (van der Vorst 1992), with right
+   preconditioning.
+
+   Input ...
+   -----
+   As for cgsolve(), but A need not be symmetric.
+
+   Output ...
+   ------
+   x      : the solution
+   iter   : the number of iterations taken; each takes two
+            products with A
+   resid  : the final relative residual || b - A x || / || b ||
+   flag   : status indicator
+            = 0, normal return
+            = 1, could not allocate memory for workspace
+            = 2, illegal user input, n < 1, tol <= 0, maxit < 1,
+                 NULL pointers
+            = 3, did not converge in maxit iterations
+            = 4, breakdown (rho or omega became zero); gmres()
+                 may succeed
+
+   Workspace ...
+   ---------
+   7 vectors of n elements are allocated.
+
+   Version ... 1.0,  19 October 2026
+   -------
+
+   Notes ...
+   -----
+   (1) Memory is fixed at 7n, unlike gmres() whose storage grows
+       with the restart length, but the convergence is not
+       monotone.
+   (2) Convergence is confirmed with the true residual b - A x;
+       if that has drifted above the tolerance the iteration is
+       started again from x.
+*/
+
+{  /* begin bicgstab() */
+
+double *r, *rt, *p, *v, *s, *t, *z;
+double rho, rhold, alpha, omega, beta, bnorm, tt;
+int    it, first;
+
+*flag = 0;
+r = rt = p = v = s = t = z = (double *) NULL;
+if (n < 1 || matvec == NULL || b == NULL || x == NULL ||
+    tol <= 0.0 || maxit < 1 || iter == NULL || resid == NULL)
+   {
+   *flag = 2;
+   return (0);
+   }
+*iter = 0;
+
+r  = (double *) malloc (n * sizeof(double));
+rt = (double *) malloc (n * sizeof(double));
+p  = (double *) malloc (n * sizeof(double));
+v  = (double *) malloc (n * sizeof(double));
+s  = (double *) malloc (n * sizeof(double));
+t  = (double *) malloc (n * sizeof(double));
+z  = (double *) malloc (n * sizeof(double));
+if (r == NULL || rt == NULL || p == NULL || v == NULL ||
+    s == NULL || t == NULL || z == NULL)
+   {
+   *flag = 1;
+   goto LeaveBicgstab;
+   }
+
+bnorm = sqrt (kdot (n, b, b));
+if (bnorm == 0.0) bnorm = 1.0;
+
+(*matvec) (n, x, r);
+kxpby (n, b, -1.0, r);
+*resid = sqrt (kdot (n, r, r)) / bnorm;
+if (*resid <= tol) goto LeaveBicgstab;
+kcopy (n, r, rt);
+
+rhold = alpha = omega = 1.0;
+first = 1;
+for (it = 1; it <= maxit; ++it)
+   {
+   rho = kdot (n, rt, r);
+   if (rho == 0.0 || omega == 0.0)
+      {
+      *flag = 4;
+      goto LeaveBicgstab;
+      }
+   if (first) kcopy (n, r, p);
+   else
+      {
+      /* p = r + beta * (p - omega * v) */
+      beta = (rho / rhold) * (alpha / omega);
+      kaxpy (n, -omega, v, p);
+      kxpby (n, r, beta, p);
+      }
+   kprec (prec, n, p, z);
+   (*matvec) (n, z, v);
+   tt = kdot (n, rt, v);
+   if (tt == 0.0)
+      {
+      *flag = 4;
+      goto LeaveBicgstab;
+      }
+   alpha = rho / tt;
+   kaxpy (n, alpha, z, x);
+   /* s = r - alpha * v */
+   kcopy (n, r, s);
+   kaxpy (n, -alpha, v, s);
+   *iter  = it;
+   first  = 0;
+   *resid = sqrt (kdot (n, s, s)) / bnorm;
+   if (*resid <= tol)
+      {
+      kcopy (n, s, r);
+      goto Converged;
+      }
+
+   kprec (prec, n, s, z);
+   (*matvec) (n, z, t);
+   tt = kdot (n, t, t);
+   omega = (tt > 0.0) ? kdot (n, t, s) / tt : 0.0;
+   kaxpy (n, omega, z, x);
+   /* r = s - omega * t */
+   kcopy (n, s, r);
+   kaxpy (n, -omega, t, r);
+   *resid = sqrt (kdot (n, r, r)) / bnorm;
+   rhold = rho;
+   if (*resid > tol) continue;
+
+   Converged:
+   /* The updated residual may have drifted from b - A x.
+      If the true residual is too large, start again from it. */
+   (*matvec) (n, x, r);
+   kxpby (n, b, -1.0, r);
+   *resid = sqrt (kdot (n, r, r)) / bnorm;
+   if (*resid <= tol) goto LeaveBicgstab;
+   kcopy (n, r, rt);
+   rhold = alpha = omega = 1.0;
+   first = 1;
+   }
+*flag = 3;
+
+LeaveBicgstab:
+if (z  != NULL) free (z);
+if (t  != NULL) free (t);
+if (s  != NULL) free (s);
+if (v  != NULL) free (v);
+if (p  != NULL) free (p);
+if (rt != NULL) free (rt);
+if (r  != NULL) free (r);
+return (0);
+}  /* end of bicgstab() */
+
+/*-----------------------------------------------------------------*/
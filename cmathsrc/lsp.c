@@ -0,0 +1,168 @@
+/* lsp.c
+   Least-squares polynomial using singular value decomposition
+   to directly decompose the design matrix.  */
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+
+#include "cmath.h"
+#if (STDLIBH)
+#include <stdlib.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+
+#define  MINDX(i,j,rowsize)  (((i)-1) * (rowsize) + (j)-1)
+#define  VINDX(j)            ((j)-1)
+#define  MIN(a,b)            (((a) < (b)) ? (a) : (b))
+#define  MAX(a,b)            (((a) > (b)) ? (a) : (b))
+#define  SIGN(a,b)           (((b) >= 0.0) ? fabs(a) : -fabs(a))
+
+/* The rows of the design matrix are formed and passed to tsqradd()
+   LSP_CHUNK at a time.  */
+#define  LSP_CHUNK  1024
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int lsp (int n, int m,
+         double x[], double y[], double c[],
+         double shift, double relerr, double *resid,
+         int *ierr)
+
+#else
+
+int lsp (n, m, x, y, c, shift, relerr, resid, ierr)
+int n; int m;
+double x[]; double y[]; double c[];
+double shift; double relerr; double *resid;
+int *ierr;
+
+#endif
+
+
+/* Purpose ...
+   -------
+   Given a set of m data points x and y,such that y = y(x),
+   the n coefficients c of a least squares polynomial are computed.
+   The polynomial is
+        y = c(1) + c(2)*z + c(3)*z**2 + ... + c(n)*z**(n-1)
+   where z = x - shift.
+
+   Input ...
+   -----
+   n      : number of coefficients in least squares
+            polynomial. i.e. the order of the polynomial is (n-1).
+   m      : number of data points.
+   x      : data points, x coordinate. x[0] ... x[m-1]
+   y      : data points, y coordinate. y[0] ... y[m-1]
+   shift  : origin shift for x.  A suitable centering value can improve
+            the accuracy of the result.
+   relerr : relative error of the data. (e.g) If the data is correct
+            to 3 significant figures then set relerr=0.001.
+            If data is exact, set relerr=0.0.
+
+   Output ...
+   ------
+   c      : coefficients of shifted least squares polynomial.
+            c[0] ... c[n-1]
+   resid  : square root of the sum of squares of the residuals.
+   ierr   : Status flag
+            ierr =  0, normal return
+                 =  n, if a singular value has not been computed
+                       in 30 iterations.
+                 = -1, could not allocate memory for work arrays
+                 = -2, invalid user input
+
+   Workspace ...
+   ---------
+   LSP_CHUNK * (n+1) doubles for the rows of the design matrix, and
+   the workspace of tsqrinit() and tsqrsolve(), which is of order
+   n * n.  It does not depend on m.
+
+   This C code written by ...  Peter & Nigel,
+   ----------------------      Design Software,
+                               42 Gubberley St,
+                               Kenmore, 4069,
+                               Australia.
+
+   Version ... 1.0, 13 nov 1989
+   -------     2.0, 19 October 2026, design matrix by blocks of rows
+
+   Notes ...
+   -----
+   (1) Adapted from the FORTRAN code by John D. Day,
+       Department of Mechanical Engineering
+       University of Queensland.
+   (2) The design matrix is no longer stored, nor decomposed whole
+       by svd().  Its rows, with y, are reduced to an (n+1) by (n+1)
+       triangle by tsqradd() a block at a time, and tsqrsolve()
+       applies svd() and svdsolve() to the triangle.  The tolerance
+       on the singular values is as before.  See tsqr.c.
+*/
+
+{  /* begin function lsp() */
+
+int i, j, i0, nr, flag;
+double *a;
+struct TSQR ts;
+
+*ierr = 0;
+if (n < 2 || m < 2 || x == NULL || y == NULL || c == NULL)
+   {
+   *ierr = -2;
+   return (0);
+   }
+
+/* allocate memory for work arrays */
+a = (double *) malloc (LSP_CHUNK * (n + 1) * sizeof(double));
+tsqrinit (n, &ts, &flag);
+if (a == NULL || flag != 0)
+   {
+   *ierr = -1;
+   goto LeaveLSP;
+   }
+
+/* Set up the design matrix, with y as its last column, a block
+   of rows at a time. */
+
+for (i0 = 0; i0 < m; i0 += LSP_CHUNK)
+   {
+   nr = MIN(LSP_CHUNK, m - i0);
+   for (i = 1; i <= nr; ++i)
+      {
+      a[MINDX(i,1,n+1)] = 1.0;
+      for (j = 2; j <= n; ++j)
+         a[MINDX(i,j,n+1)] = (x[i0 + VINDX(i)] - shift) * a[MINDX(i,j-1,n+1)];
+      a[MINDX(i,n+1,n+1)] = y[i0 + VINDX(i)];
+      }
+   tsqradd (&ts, nr, n + 1, a, &flag);
+   }
+
+/* find coefficients and the square root of the sum of squares
+   of residuals. */
+tsqrsolve (&ts, relerr, c, resid, &flag);
+if (flag == 1) *ierr = -1;
+if (flag == 2) *ierr = -2;
+if (flag == 3) *ierr = n;
+
+LeaveLSP:
+/* clean up allocated memory. */
+if (a != NULL) { free(a); a = NULL; }
+tsqrfree (&ts);
+
+return (0);
+}  /* end of function lsp() */
+
+
+
@@ -0,0 +1,317 @@
+/* mpsolve.c
+   Solve a linear system to double precision accuracy from a
+   single precision factorization, by iterative refinement. */
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+#include "cmath.h"
+#if (STDLIBH)
+#include <stdlib.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+/* Refinement is attempted only if cond * FEPSILON <= MPSOLVE_CMAX
+   and is abandoned after MPSOLVE_ITMAX steps.  Elements larger than
+   MPSOLVE_FMAX in magnitude cannot be held as floats.  */
+
+#define  MPSOLVE_CMAX   0.1
+#define  MPSOLVE_ITMAX  30
+#define  MPSOLVE_FMAX   1.0e38
+
+#define  AINDEX(i,j) ((i) * ndim + (j))
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static double mpcond (int n, float *af, int pivot[], double anorm,
+                      float x[], float z[])
+
+#else
+
+static double mpcond (n, af, pivot, anorm, x, z)
+
+int    n;
+float  *af;
+int    pivot[];
+double anorm;
+float  x[], z[];
+
+#endif
+
+/* Purpose ...
+   -------
+   Estimate the 1-norm condition number from the float factors
+   af (row dimension n) as condest() does for the double factors.
+   x[] and z[] are workspace of n elements.
+*/
+
+{
+double est, t, zmax;
+float  s;
+int    i, j, k, m, iter, jlast, ndim;
+
+ndim = n;
+for (i = 0; i < n; ++i) x[i] = 1.0f / n;
+est   = 0.0;
+jlast = -1;
+
+for (iter = 0; iter < 5; ++iter)
+   {
+   ssolve (n, n, af, x, pivot);
+   t = 0.0;
+   for (i = 0; i < n; ++i) t += fabs(x[i]);
+   if (iter > 0 && t <= est) break;
+   est = t;
+
+   /* z = a-inverse-transpose * sign(x), as dctsolv() in decomp.c */
+   for (i = 0; i < n; ++i) z[i] = (x[i] >= 0.0f) ? 1.0f : -1.0f;
+   for (k = 0; k < n; ++k)
+      {
+      s = z[k];
+      for (i = 0; i < k; ++i) s -= af[AINDEX(i,k)] * z[i];
+      z[k] = s / af[AINDEX(k,k)];
+      }
+   for (k = n-2; k >= 0; --k)
+      {
+      s = z[k];
+      for (i = k+1; i < n; ++i) s += af[AINDEX(i,k)] * z[i];
+      z[k] = s;
+      m = pivot[k];
+      if (m != k) { s = z[m]; z[m] = z[k]; z[k] = s; }
+      }
+
+   j = 0;
+   zmax = fabs(z[0]);
+   for (i = 1; i < n; ++i)
+      if (fabs(z[i]) > zmax) { zmax = fabs(z[i]); j = i; }
+   if (j == jlast) break;
+   jlast = j;
+
+   for (i = 0; i < n; ++i) x[i] = 0.0f;
+   x[j] = 1.0f;
+   }
+
+for (i = 0; i < n; ++i)
+   {
+   x[i] = (float) (1.0 + (double) i / ((n > 1) ? n - 1 : 1));
+   if (i % 2) x[i] = -x[i];
+   }
+ssolve (n, n, af, x, pivot);
+t = 0.0;
+for (i = 0; i < n; ++i) t += fabs(x[i]);
+t = 2.0 * t / (3.0 * n);
+if (t > est) est = t;
+
+t = anorm * est;
+return ((t < 1.0) ? 1.0 : t);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int mpsolve (int n, int ndim,
+             double *a, double b[], double x[],
+             double *cond, int *iter, int *flag)
+
+#else
+
+int mpsolve (n, ndim, a, b, x, cond, iter, flag)
+
+int    n,
+       ndim;
+double *a,
+       b[],
+       x[],
+       *cond;
+int    *iter,
+       *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Solve the linear system a * x = b to double precision accuracy,
+   doing the elimination in single precision where that is enough.
+
+   The matrix is copied to float and factored by sdecomp().  If the
+   condition estimate from those factors shows that iterative
+   refinement will converge, the solution from ssolve() is refined
+   with residuals computed in double precision.  Otherwise, or if
+   the refinement stalls, the system is solved by decomp() and
+   solve() on a double precision copy of a.
+
+   Input ...
+   -----
+   n    = order of the matrix
+   ndim = row dimension of a as defined in the calling program
+   a    = the matrix, which is not changed
+   b    = the right hand side vector
+
+   Output ...
+   ------
+   x    = the solution vector
+   cond = an estimate of the condition of a, as from condest()
+          or from decomp() if it was used.
+   iter = the number of refinement steps taken, or
+          -1 if the solution was made in double precision
+   flag = Status indicator
+          0 : successful execution
+          1 : could not allocate memory for workspace
+          2 : illegal user input n < 1, a == NULL, b == NULL,
+              x == NULL, n > ndim.
+          3 : matrix is singular
+
+   Workspace ...
+   ---------
+   A float copy of a, n*n elements, and vectors of 2n float,
+   n double and n int elements are allocated.  A double copy of
+   a, with decomp()'s own workspace, is allocated only if needed.
+
+   Version ... 1.0,  19 October 2026
+   -------
+
+   Notes ...
+   -----
+   (1) Refinement stops when the residual satisfies
+       max |r[i]| <= max |x[i]| * (inf-norm of a) * EPSILON * sqrt(n)
+       as in LAPACK's dsgesv.
+   (2) The refinement converges if cond * FEPSILON is well below
+       one; this routine asks for cond * FEPSILON <= MPSOLVE_CMAX.
+   (3) The float factor takes half the memory of that used by
+       decomp(), and the elimination runs up to twice as fast.
+*/
+
+{  /* begin mpsolve() */
+
+float  *af, *rf, *zf;
+double *r, *ad, anorm, anormi, rnorm, xnorm, t, tol;
+int    i, j, it, *piv, fail;
+double *pa;
+
+*flag = 0;
+*iter = 0;
+af = rf = zf = (float *) NULL;
+r  = ad = (double *) NULL;
+piv = (int *) NULL;
+
+if (a == NULL || b == NULL || x == NULL || n < 1 || ndim < n)
+   {
+   *flag = 2;
+   return (0);
+   }
+
+af  = (float *) malloc (n * n * sizeof(float));
+rf  = (float *) malloc (n * sizeof(float));
+zf  = (float *) malloc (n * sizeof(float));
+r   = (double *) malloc (n * sizeof(double));
+piv = (int *) malloc (n * sizeof(int));
+if (af == NULL || rf == NULL || zf == NULL || r == NULL || piv == NULL)
+   {
+   *flag = 1;
+   goto MpsolveExit;
+   }
+
+/* --- float copy, and the 1- and inf-norms of a --- */
+anormi = 0.0;
+for (j = 0; j < n; ++j) r[j] = 0.0;
+for (i = 0; i < n; ++i)
+   {
+   pa = a + AINDEX(i,0);
+   t  = 0.0;
+   for (j = 0; j < n; ++j)
+      {
+      af[i * n + j] = (float) pa[j];
+      r[j] += fabs(pa[j]);
+      t    += fabs(pa[j]);
+      }
+   if (t > anormi) anormi = t;
+   }
+anorm = 0.0;
+for (j = 0; j < n; ++j) if (r[j] > anorm) anorm = r[j];
+if (anorm > MPSOLVE_FMAX) goto DoublePrecision;
+
+/* --- single precision elimination --- */
+sdecomp (n, n, af, piv, &fail);
+if (fail != 0) goto DoublePrecision;
+*cond = mpcond (n, af, piv, anorm, rf, zf);
+if (*cond * FEPSILON > MPSOLVE_CMAX) goto DoublePrecision;
+
+/* --- first solution, then refinement --- */
+for (i = 0; i < n; ++i) rf[i] = (float) b[i];
+ssolve (n, n, af, rf, piv);
+for (i = 0; i < n; ++i) x[i] = rf[i];
+
+tol = anormi * EPSILON * sqrt((double) n);
+for (it = 0; it <= MPSOLVE_ITMAX; ++it)
+   {
+   /* r = b - a * x in double precision */
+   rnorm = 0.0;
+   xnorm = 0.0;
+   for (i = 0; i < n; ++i)
+      {
+      pa = a + AINDEX(i,0);
+      t  = b[i];
+      for (j = 0; j < n; ++j) t -= pa[j] * x[j];
+      r[i] = t;
+      if (fabs(t) > rnorm) rnorm = fabs(t);
+      if (fabs(x[i]) > xnorm) xnorm = fabs(x[i]);
+      }
+   if (rnorm <= xnorm * tol)
+      {
+      *iter = it;
+      goto MpsolveExit;
+      }
+   if (it == MPSOLVE_ITMAX) break;
+
+   for (i = 0; i < n; ++i) rf[i] = (float) r[i];
+   ssolve (n, n, af, rf, piv);
+   for (i = 0; i < n; ++i) x[i] += rf[i];
+   }
+/* The refinement has stalled; fall through. */
+
+DoublePrecision:
+*iter = -1;
+free (af);
+af = (float *) NULL;
+ad = (double *) malloc (n * n * sizeof(double));
+if (ad == NULL)
+   {
+   *flag = 1;
+   goto MpsolveExit;
+   }
+for (i = 0; i < n; ++i)
+   {
+   pa = a + AINDEX(i,0);
+   for (j = 0; j < n; ++j) ad[i * n + j] = pa[j];
+   }
+decomp (n, n, ad, cond, piv, &fail);
+if (fail != 0)
+   {
+   *flag = fail;
+   goto MpsolveExit;
+   }
+for (i = 0; i < n; ++i) x[i] = b[i];
+solve (n, n, ad, x, piv);
+
+MpsolveExit:
+if (ad  != NULL) { free (ad);  ad  = (double *) NULL; }
+if (piv != NULL) { free (piv); piv = (int *) NULL; }
+if (r   != NULL) { free (r);   r   = (double *) NULL; }
+if (zf  != NULL) { free (zf);  zf  = (float *) NULL; }
+if (rf  != NULL) { free (rf);  rf  = (float *) NULL; }
+if (af  != NULL) { free (af);  af  = (float *) NULL; }
+return (0);
+}  /* end of mpsolve() */
+
+/*-----------------------------------------------------------------*/
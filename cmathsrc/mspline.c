@@ -0,0 +1,383 @@
+/* mspline.c
+   Local (Hermite) cubic interpolating splines :
+   Fritsch-Carlson monotone and Akima. */
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+#include "cmath.h"
+#include <math.h>
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static double msecant (int n, double x[], double y[], int k)
+
+#else
+
+static double msecant (n, x, y, k)
+int    n;
+double x[], y[];
+int    k;
+
+#endif
+
+/* Purpose ...
+   -------
+   Slope of the chord over segment k.  For k outside 0 .. n-2 the
+   chords are extended linearly, as Akima does at the ends.
+   Requires n >= 3 when k is out of range.
+*/
+
+{
+if (k < 0)   return (2.0 * msecant (n, x, y, k+1) - msecant (n, x, y, k+2));
+if (k > n-2) return (2.0 * msecant (n, x, y, k-1) - msecant (n, x, y, k-2));
+return ((y[k+1] - y[k]) / (x[k+1] - x[k]));
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static double mslope (int n, int method, double x[], double y[], int i)
+
+#else
+
+static double mslope (n, method, x, y, i)
+int    n, method;
+double x[], y[];
+int    i;
+
+#endif
+
+/* Purpose ...
+   -------
+   Slope of the interpolant at knot i.  The value depends only on
+   x[], y[] within two knots of i so that each knot may be done
+   independently of the others.
+*/
+
+{
+double s0, s1, sm1, sm2, h0, h1, w1, w2, t;
+
+if (n == 2) return ((y[1] - y[0]) / (x[1] - x[0]));
+
+if (method == MSPL_AKIMA)
+   {
+   sm2 = msecant (n, x, y, i-2);
+   sm1 = msecant (n, x, y, i-1);
+   s0  = msecant (n, x, y, i);
+   s1  = msecant (n, x, y, i+1);
+   w1  = fabs(s1 - s0);
+   w2  = fabs(sm1 - sm2);
+   if (w1 + w2 == 0.0) return (0.5 * (sm1 + s0));
+   return ((w1 * sm1 + w2 * s0) / (w1 + w2));
+   }
+
+/* ---- Fritsch-Carlson ---- */
+if (i == 0 || i == n-1)
+   {  /* one-sided three-point estimate, kept shape preserving */
+   if (i == 0)
+      {
+      h0 = x[1] - x[0];
+      h1 = x[2] - x[1];
+      s0 = (y[1] - y[0]) / h0;
+      s1 = (y[2] - y[1]) / h1;
+      }
+   else
+      {
+      h0 = x[n-1] - x[n-2];
+      h1 = x[n-2] - x[n-3];
+      s0 = (y[n-1] - y[n-2]) / h0;
+      s1 = (y[n-2] - y[n-3]) / h1;
+      }
+   t = ((2.0 * h0 + h1) * s0 - h0 * s1) / (h0 + h1);
+   if (t * s0 <= 0.0) return (0.0);
+   if (s0 * s1 <= 0.0 && fabs(t) > 3.0 * fabs(s0)) t = 3.0 * s0;
+   return (t);
+   }
+
+/* interior : weighted harmonic mean of the adjacent chords,
+   zero at a local extremum of the data */
+h0 = x[i] - x[i-1];
+h1 = x[i+1] - x[i];
+s0 = (y[i] - y[i-1]) / h0;
+s1 = (y[i+1] - y[i]) / h1;
+if (s0 * s1 <= 0.0) return (0.0);
+w1 = 2.0 * h1 + h0;
+w2 = h1 + 2.0 * h0;
+return ((w1 + w2) / (w1 / s0 + w2 / s1));
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int mspline (int n, int method,
+             double x[], double y[],
+             double b[], double c[], double d[],
+             int *iflag)
+
+#else
+
+int mspline (n, method, x, y, b, c, d, iflag)
+
+int    n, method;
+double x[], y[], b[], c[], d[];
+int    *iflag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Evaluate the coefficients b[i], c[i], d[i], i = 0, 1, .. n-1 for
+   a local cubic interpolating spline
+
+   S(xx) = Y[i] + b[i] * w + c[i] * w**2 + d[i] * w**3
+   where w = xx - x[i]
+   and   x[i] <= xx <= x[i+1]
+
+   The coefficients are in the same form as those from spline() so
+   that seval(), deriv() and sinteg() may be used unchanged.
+
+   Input :
+   -------
+   n       : The number of data points or knots (n >= 2)
+   method  : = MSPL_FRITSCH  Fritsch-Carlson monotone cubic.
+                             The interpolant is monotone wherever
+                             the data is and has no overshoot.
+             = MSPL_AKIMA    Akima's spline.  Follows the data
+                             closely with little wiggle near
+                             outliers.
+   x[]     : the abscissas of the knots in strictly
+             increasing order
+   y[]     : the ordinates of the knots
+
+   Output :
+   --------
+   b, c, d : arrays of spline coefficients as for spline()
+   iflag   : status flag
+            = 0 normal return
+            = 1 less than two data points; cannot interpolate
+            = 2 x[] are not in ascending order
+            = 3 invalid value for method
+
+   Version ... 1.0, 19 October 2026
+   -------
+
+   Notes ...
+   -----
+   (1) The interpolant is only C1.  The slope at each knot
+       is set from the neighbouring data alone, so there is no
+       tridiagonal system to solve as in spline().
+   (2) Each set of coefficients b[i], c[i], d[i] depends only on
+       x[], y[] within 3 knots of i.  Disjoint parts of the arrays
+       may therefore be filled independently (and concurrently)
+       with msplrng(), and a change to a single data point may be
+       absorbed with msplupd() at fixed cost.
+   (3) For the Fritsch-Carlson method, the interior slopes are the
+       weighted harmonic means of Fritsch & Butland (1984), which
+       meet the monotonicity conditions of Fritsch & Carlson (1980)
+       without a second sweep over the data.
+   (4) As for spline(), b[n-1], c[n-1] and d[n-1] are set to
+       continue the last segment past x[n-1].
+*/
+
+/*----------------------------------------------------------------*/
+
+{  /* begin procedure mspline() */
+
+msplrng (n, method, 0, n-1, x, y, b, c, d, iflag);
+return 0;
+}  /* end of mspline() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int msplrng (int n, int method, int lo, int hi,
+             double x[], double y[],
+             double b[], double c[], double d[],
+             int *iflag)
+
+#else
+
+int msplrng (n, method, lo, hi, x, y, b, c, d, iflag)
+
+int    n, method, lo, hi;
+double x[], y[], b[], c[], d[];
+int    *iflag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Evaluate the local spline coefficients b[i], c[i], d[i] for
+   i = lo .. hi only.  Other elements of b, c, d are neither read
+   nor written, so calls with disjoint ranges may run in parallel.
+
+   Input :
+   -------
+   n       : The number of data points or knots (n >= 2)
+   method  : MSPL_FRITSCH or MSPL_AKIMA, as for mspline()
+   lo, hi  : the range of coefficients to compute,
+             0 <= lo <= hi <= n-1
+   x[]     : the abscissas of the knots in strictly
+             increasing order
+   y[]     : the ordinates of the knots
+
+   Output :
+   --------
+   b, c, d : elements lo .. hi of the spline coefficients
+   iflag   : status flag
+            = 0 normal return
+            = 1 less than two data points; cannot interpolate
+            = 2 x[] are not in ascending order
+            = 3 invalid value for method
+            = 4 invalid range lo .. hi
+
+   Notes ...
+   -----
+   (1) Only x[lo-2] .. x[hi+3] are checked for ascending order.
+       These are all the knots that b, c, d for lo .. hi depend
+       on, the slope at knot hi+1 being needed for segment hi.
+*/
+
+/*----------------------------------------------------------------*/
+
+{  /* begin procedure msplrng() */
+
+int    i, i1, i2, nm1;
+double h, s, m0, m1, cc, dd;
+
+nm1    = n - 1;
+*iflag = 0;
+
+if (n < 2)
+   {
+   *iflag = 1;
+   goto LeaveMsplrng;
+   }
+if (method != MSPL_FRITSCH && method != MSPL_AKIMA)
+   {
+   *iflag = 3;
+   goto LeaveMsplrng;
+   }
+if (lo < 0 || hi > nm1 || lo > hi)
+   {
+   *iflag = 4;
+   goto LeaveMsplrng;
+   }
+
+i1 = (lo > 2) ? lo - 2 : 0;
+i2 = (hi < n-4) ? hi + 3 : nm1;
+for (i = i1 + 1; i <= i2; ++i)
+   {
+   if (x[i] <= x[i-1])
+      {
+      *iflag = 2;
+      goto LeaveMsplrng;
+      }
+   }
+
+/* ---- Hermite segments, carrying the right-hand slope ---- */
+if (lo < nm1) m0 = mslope (n, method, x, y, lo);
+for (i = lo; i <= hi && i < nm1; ++i)
+   {
+   m1   = mslope (n, method, x, y, i+1);
+   h    = x[i+1] - x[i];
+   s    = (y[i+1] - y[i]) / h;
+   b[i] = m0;
+   c[i] = (3.0 * s - 2.0 * m0 - m1) / h;
+   d[i] = (m0 + m1 - 2.0 * s) / (h * h);
+   m0   = m1;
+   }
+
+/* ---- continue the last segment past x[n-1] ---- */
+if (hi == nm1)
+   {
+   m0     = mslope (n, method, x, y, n-2);
+   m1     = mslope (n, method, x, y, nm1);
+   h      = x[nm1] - x[n-2];
+   s      = (y[nm1] - y[n-2]) / h;
+   cc     = (3.0 * s - 2.0 * m0 - m1) / h;
+   dd     = (m0 + m1 - 2.0 * s) / (h * h);
+   b[nm1] = m1;
+   c[nm1] = cc + 3.0 * dd * h;
+   d[nm1] = dd;
+   }
+
+LeaveMsplrng:
+return 0;
+}  /* end of msplrng() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int msplupd (int n, int method, int k,
+             double x[], double y[],
+             double b[], double c[], double d[],
+             int *iflag)
+
+#else
+
+int msplupd (n, method, k, x, y, b, c, d, iflag)
+
+int    n, method, k;
+double x[], y[], b[], c[], d[];
+int    *iflag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Update the local spline coefficients after the single data
+   point x[k], y[k] has been changed.  At most 7 sets of
+   coefficients are recomputed, whatever the value of n.
+
+   Input :
+   -------
+   n       : The number of data points or knots (n >= 2)
+   method  : MSPL_FRITSCH or MSPL_AKIMA, as used by mspline()
+   k       : the index of the changed point, 0 <= k <= n-1
+   x[]     : the abscissas of the knots in strictly
+             increasing order
+   y[]     : the ordinates of the knots
+   b, c, d : the coefficients from an earlier call to mspline()
+
+   Output :
+   --------
+   b, c, d : the updated coefficients
+   iflag   : status flag, as for msplrng()
+            = 4 k out of range
+*/
+
+/*----------------------------------------------------------------*/
+
+{  /* begin procedure msplupd() */
+
+int lo, hi;
+
+*iflag = 0;
+if (k < 0 || k > n-1)
+   {
+   *iflag = (n < 2) ? 1 : 4;
+   goto LeaveMsplupd;
+   }
+
+/* Slopes depend on knots within 2 of their own, and segment i
+   on the slopes at i and i+1. */
+lo = (k > 3) ? k - 3 : 0;
+hi = k + 2;
+if (hi >= n-2) hi = n-1;
+msplrng (n, method, lo, hi, x, y, b, c, d, iflag);
+
+LeaveMsplupd:
+return 0;
+}  /* end of msplupd() */
+/*-------------------------------------------------------------------*/
@@ -0,0 +1,2543 @@
+/* qr.c
+   QR eigenvalue and eigenvector solver.
+*/
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+
+#include "cmath.h"
+#if (STDLIBH)
+#include <stdlib.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+
+#define  zero  0.0
+#define  one   1.0
+#define  two   2.0
+#define  MINDX(i,j,rowsize)  (((i)-1) * (rowsize) + (j)-1)
+#define  VINDX(j)            ((j)-1)
+#define  MIN(a,b)            (((a) < (b)) ? (a) : (b))
+#define  SIGN(a,b)           (((b) >= 0.0) ? fabs(a) : -fabs(a))
+#define  MAX(a,b)            (((a) > (b)) ? (a) : (b))
+
+/* Hessenberg reduction: panel width, column block for the trailing
+   update, and the least amount of work that is shared among threads. */
+#define  QR_NB      32
+#define  QR_CB      64
+#define  QR_PMIN    20000L
+
+/* Multishift QR: blocks of at least QR_NMIN rows use aggressive early
+   deflation; a sweep is skipped when more than QR_NIBBLE percent of
+   the window deflates; exceptional shifts after QR_KEXSH fruitless
+   iterations; at most QR_NSMAX shifts; the far rows of a sweep are
+   updated every QR_NGRP steps. */
+#define  QR_NMIN    75
+#define  QR_NIBBLE  14
+#define  QR_KEXSH   6
+#define  QR_NSMAX   64
+#define  QR_NGRP    16
+#define  QR_SAFMIN  1.0e-300
+
+#if (PROTOTYPE)
+static int hqrms (int nm, int n, double *h, int low, int igh,
+                  int wantt, double *z, int ldz, int iz0, int iz1);
+#else
+static int hqrms ();
+#endif
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int qr (int nm, int n, double *a,
+        double *wr, double *wi, int *ierr)
+
+#else
+
+int qr (nm, n, a, wr, wi, ierr)
+int    nm, n;
+double *a;
+double *wr, *wi;
+int    *ierr;
+
+#endif
+
+/* Purpose ...
+   -------
+   Computes eigenvalues of real general matrix by the qr method.
+
+   Input...
+   -----
+   nm    : declared dimension of arrays.
+   n     : order of system. n <= nm.
+   a     : matrix to be analysed. Minimum dimension a[n][nm].
+           The contents of a are changed by qrv().
+           Elements of a are a[0..n-1][0..n-1].
+
+   Output...
+   ------
+   wr    : vector containing real parts of eigenvalues of a.
+           There is no particular order but conjugate pairs appear
+           together with the value having positive imaginary part
+           first.
+           Minimum dimension wr[n].
+           Elements of wr are wr[0..n-1].
+   wi    : vector containing imaginary parts of eigenvalues.
+           Minimum dimension wi[n].
+           Elements of wi are wi[0..n-1].
+   ierr  : error flag.
+           =  0, normal return.
+           = -1, could not allocate work space
+           = -2, incorrect user input: e.g. nm < 1, n > nm,
+                 or null pointers for the user arrays
+           >  0, more than 30 iterations required to determine
+                 an eigenvalue.  The eigenvalues in wr ,wi are
+                 correct for ierr,ierr+1,..,n-1.
+
+   Workspace ...
+   ---------
+   work  : Minimum dimension work[n].
+   ort   : Minimum dimension ort[n].
+
+   This C code written by ...  Peter & Nigel,
+   ----------------------      Design Software,
+                               42 Gubberley St,
+                               Kenmore, 4069,
+                               Australia.
+
+   Version ... 1.0, September 1989
+   -------     2.0, 19 October 2026, blocked Householder reduction,
+                    multishift QR with early deflation
+
+   Notes ...
+   -----
+   (1) The FORTRAN version of this program was published in :
+       B.T.Smith, J.M.Boyle, J.J.Dongarra, B.S.Garbow, Y.Ikebe,
+       V.C.Klema, C.B.Moler "Matrix eigensystem routines - eispack
+       guide"  Lecture notes in computer science, vol 6,
+       Springer-Verlag,Berlin (1976).
+   (2) Recall that the FORTRAN code used arrays with indices 1..n.
+       The looping indices in the following routines use the 1..n
+       convention but the macros MINDX and VINDX translate any
+       array indices to 0..n-1.
+   (3) The matrix is reduced to Hessenberg form by orthes(), a
+       blocked Householder reduction, and most of the eigenvalues
+       are then found by the multishift QR algorithm with
+       aggressive early deflation (hqrms() below) before hqr()
+       finishes and sorts out the 1 by 1 and 2 by 2 blocks.
+
+*/
+
+{  /* begin qr() */
+
+int    Low, igh;
+double *ort;
+double *work;
+
+*ierr = 0;
+ort = (double *) NULL;
+work = (double *) NULL;
+
+if (a == NULL || wr == NULL || wi == NULL || nm < 1 || n > nm)
+    {
+    *ierr = -2;
+    goto Bailout;
+    }
+
+ort = (double *) malloc (nm * sizeof(double));
+if (ort == NULL)
+   {
+   *ierr = -1;
+   goto Bailout;
+   }
+work = (double *) malloc (nm * sizeof(double));
+if (work == NULL)
+   {
+   *ierr = -1;
+   goto Bailout;
+   }
+
+balanc (nm, n, a, &Low, &igh, work);
+if (orthes (nm, n, Low, igh, a, ort) != 0)
+   {
+   *ierr = -1;
+   goto Bailout;
+   }
+hqrms  (nm, n, a, Low - 1, igh - 1, 0, (double *) NULL, 0, 0, 0);
+hqr    (nm, n, Low, igh, a, wr, wi, ierr);
+
+Bailout:
+if (ort != NULL) { free(ort); ort = (double *) NULL; }
+if (work != NULL) { free(work); work = (double *) NULL; }
+return(0);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int qrv (int nm, int n, double *a,
+         double *wr, double *wi, double *z,
+         int *ierr)
+
+#else
+
+int qrv (nm, n, a, wr, wi, z, ierr)
+int    nm, n;
+double *a;
+double *wr, *wi, *z;
+int    *ierr;
+
+#endif
+
+/* Purpose ...
+   -------
+   Computes eigenvalues and eigenvectors of real general matrix
+   by the qr method.
+
+   Input...
+   -----
+   nm    : declared dimension of arrays.
+   n     : order of system. n <= nm.
+   a     : matrix to be analysed. Minimum dimension a[n][nm].
+           The contents of a are changed by qr().
+           Elements of a are a[0..n-1][0..n-1].
+
+   Output...
+   ------
+   wr    : vector containing real parts of eigenvalues of a.
+           There is no particular order but conjugate pairs appear
+           together with the value having positive imaginary part
+           first.
+           Minimum dimension wr[n].
+           Elements of wr are wr[0..n-1].
+   wi    : vector containing imaginary parts of eigenvalues.
+           Minimum dimension wi[n].
+           Elements of wi are wi[0..n-1].
+   z     : If wi[j] is 0.0 (real eigenvalue),then z[i][j]
+           contains corresponding eigenvector.
+           If wi[j] is not 0.0 (complex eigenvalue) then z[i][j]
+           and z[i][j+1] contain real and imaginary parts of
+           eigenvector corresponding to eigenvalue with positive
+           imaginary part.
+           The conjugate of this vector corresponds to the conjugate
+           of this eigenvalue,but is not listed.
+           Minimum dimension z[n][nm]. Elements are z[0..n-1][0..n-1].
+   ierr  : error flag.
+           =  0, normal return.
+           = -1, could not allocate work space
+           = -2, incorrect user input: e.g. nm < 1, n > nm,
+                 or null pointers for the user arrays
+           >  0, more than 30 iterations required to determine
+                 an eigenvalue.  The eigenvalues in wr ,wi are
+                 correct for ierr,ierr+1,..,n-1, but no
+                 vectors are computed.
+
+   Workspace ...
+   ---------
+   work  : Minimum dimension work[n].
+   ort   : Minimum dimension ort[n].
+
+   This C code written by ...  Peter & Nigel,
+   ----------------------      Design Software,
+                               42 Gubberley St,
+                               Kenmore, 4069,
+                               Australia.
+
+   Version ... 1.0, July 1989
+   -------     2.0, 19 October 2026, blocked Householder reduction,
+                    multishift QR with early deflation
+
+   Notes ...
+   -----
+   (1) The FORTRAN version of this program was published in :
+       B.T.Smith, J.M.Boyle, J.J.Dongarra, B.S.Garbow, Y.Ikebe,
+       V.C.Klema, C.B.Moler "Matrix eigensystem routines - eispack
+       guide"  Lecture notes in computer science, vol 6,
+       Springer-Verlag,Berlin (1976).
+   (2) Recall that the FORTRAN code used arrays with indices 1..n.
+       The looping indices in the following routines use the 1..n
+       convention but the macros MINDX and VINDX translate any
+       array indices to 0..n-1.
+   (3) The matrix is reduced to Hessenberg form by orthes() and
+       ortran(), and brought close to real Schur form by the
+       multishift QR algorithm with aggressive early deflation
+       (hqrms() below); hqr2() then finishes the Schur form and
+       computes the vectors.
+
+*/
+
+{  /* begin qr() */
+
+int    Low, igh;
+double *ort;
+double *work;
+
+*ierr = 0;
+ort = (double *) NULL;
+work = (double *) NULL;
+
+if (a == NULL || z == NULL || wr == NULL || wi == NULL ||
+    nm < 1 || n > nm)
+    {
+    *ierr = -2;
+    goto Bailout;
+    }
+
+ort = (double *) malloc (nm * sizeof(double));
+if (ort == NULL)
+   {
+   *ierr = -1;
+   goto Bailout;
+   }
+work = (double *) malloc (nm * sizeof(double));
+if (work == NULL)
+   {
+   *ierr = -1;
+   goto Bailout;
+   }
+
+balanc (nm, n, a, &Low, &igh, work);
+if (orthes (nm, n, Low, igh, a, ort) != 0)
+   {
+   *ierr = -1;
+   goto Bailout;
+   }
+ortran (nm, n, Low, igh, a, ort, z);
+hqrms  (nm, n, a, Low - 1, igh - 1, 1, z, nm, Low - 1, igh - 1);
+hqr2   (nm, n, Low, igh, a, wr, wi, z, ierr);
+
+if (*ierr == 0) balbak (nm, n, Low, igh, work, n, z);
+
+Bailout:
+if (ort != NULL) { free(ort); ort = (double *) NULL; }
+if (work != NULL) { free(work); work = (double *) NULL; }
+return(0);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int balanc (int nm, int n, double *a, int *low, int *igh,
+            double *scale)
+
+#else
+
+int balanc (nm, n, a, low, igh, scale)
+int    nm, n;
+double *a;
+int    *low, *igh;
+double *scale;
+
+#endif
+
+/* Purpose ...
+   -------
+   Balance a real general matrix and isolate the eigenvalues
+   whenever possible.
+
+   Input ...
+   -----
+   nm    : declared dimension of arrays
+   n     : order of matrix
+   a     : matrix to be balanced.
+
+   Output ...
+   ------
+   a     : balanced matrix
+   low   : boundary index for the scaled matrix
+   igh   : boundary index for the scaled matrix
+   scale : vector containing infomation about the transformations
+*/
+
+{  /* begin balanc() */
+
+int    i, j, k, L, m;
+double c, f, g, r, s, b2, radix;
+int    noconv;
+
+/* radix is a machine dependent parameter specifying
+   the base of the machine floating point representation.  */
+
+radix = 2.0;
+b2 = radix * radix;
+
+k = 1;
+L = n;
+goto L100;
+
+/* Search for rows isolating an eigenvalue and push them down */
+
+L80:
+if (L == 1) goto L280;
+--L;
+
+L100:
+for (j = L; j >= 1; --j)
+   {
+   for (i = 1; i <= L; ++i)
+      {
+      if (i != j) { if (a[MINDX(j,i,nm)] != zero) goto L120; }
+      }
+
+   m = L;
+
+   /* In-line procedure for row and column exchange */
+   scale[VINDX(m)] = (double) j;
+   if (j != m)
+      {
+      for (i = 1; i <= L; ++i)
+         {
+         f = a[MINDX(i,j,nm)];
+         a[MINDX(i,j,nm)] = a[MINDX(i,m,nm)];
+         a[MINDX(i,m,nm)] = f;
+         }
+      for (i = k; i <= n; ++i)
+         {
+         f = a[MINDX(j,i,nm)];
+         a[MINDX(j,i,nm)] = a[MINDX(m,i,nm)];
+         a[MINDX(m,i,nm)] = f;
+         }
+      }
+
+   goto L80;
+   L120:;
+   }
+
+goto L140;
+
+L130:
+
+/* Search for columns isolating an eigenvalue and push them left */
+++k;
+
+L140:
+for (j = k; j <= L; ++j)
+   {
+   for (i = k; i <= L; ++i)
+      {
+      if (i != j) { if (a[MINDX(i,j,nm)] != zero) goto L170; }
+      }
+   m = k;
+
+   /* In-line procedure for row and column exchange */
+   scale[VINDX(m)] = (double) j;
+   if (j != m)
+      {
+      for (i = 1; i <= L; ++i)
+         {
+         f = a[MINDX(i,j,nm)];
+         a[MINDX(i,j,nm)] = a[MINDX(i,m,nm)];
+         a[MINDX(i,m,nm)] = f;
+         }
+      for (i = k; i <= n; ++i)
+         {
+         f = a[MINDX(j,i,nm)];
+         a[MINDX(j,i,nm)] = a[MINDX(m,i,nm)];
+         a[MINDX(m,i,nm)] = f;
+         }
+      }
+
+   goto L130;
+
+   L170:;
+   }
+
+/* Now balance the submatrix in rows k to L */
+for (i = k; i <= L; ++i)  scale[VINDX(i)] = one;
+
+/* Iterative loop for norm reduction. */
+L190:
+noconv = 0;
+
+for (i = k; i <= L; ++i)
+   {
+   c = zero;
+   r = zero;
+   for (j = k; j <= L; ++j)
+      {
+      if (j != i)
+         {
+         c += fabs(a[MINDX(j,i,nm)]);
+         r += fabs(a[MINDX(i,j,nm)]);
+         }
+      }
+
+   g = r / radix;
+   f = one;
+   s = c + r;
+
+   L210:
+   if (c < g)
+      {
+      f *= radix;
+      c *= b2;
+      goto L210;
+      }
+   g = r * radix;
+   L230:
+   if (c >= g)
+      {
+      f /= radix;
+      c /= b2;
+      goto L230;
+      }
+
+   /* Now balance */
+   if (((c + r) / f) < (0.95 * s))
+      {
+      g = one / f;
+      scale[VINDX(i)] *= f;
+      noconv = 1;
+      for (j = k; j <= n; ++j) a[MINDX(i,j,nm)] *= g;
+      for (j = 1; j <= L; ++j) a[MINDX(j,i,nm)] *= f;
+      }
+
+   L270:;
+   }
+
+if (noconv) goto L190;
+
+L280:
+*low = k;
+*igh = L;
+
+return(0);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int elmhes (int nm, int n, int low, int igh, double *a, int *intg)
+
+#else
+
+int elmhes (nm, n, low, igh, a, intg)
+int    nm, n, low, igh;
+double *a;
+int    *intg;
+
+#endif
+
+/* Purpose ...
+   -------
+   Reduce a real general matrix to upper Hessenberg form using
+   elementary similarity transformations.
+
+   Input ...
+   -----
+   n     : order of matrices
+   nm    : declared dimension of arrays
+   low   : boundary index from balanc()
+   igh   : boundary index from balanc()
+   a     : matrix to be reduced
+
+   Output ...
+   ------
+   a     : upper Hessenberg matrix and the multipliers used
+           in the reduction
+   intg  : vector identifying row and column interchanges
+
+*/
+
+{  /* begin elmhes() */
+
+int    i, j, m, la, kp1, mm1, mp1;
+double x, y;
+
+la = igh - 1;
+kp1 = low + 1;
+if (la < kp1) goto L200;
+
+for (m = kp1; m <= la; ++m)
+   {
+   mm1 = m - 1;
+   x = zero;
+   i = m;
+
+   for (j = m; j<= igh; ++j)
+      {
+      if (fabs(a[MINDX(j,mm1,nm)]) > fabs(x))
+         {
+         x = a[MINDX(j,mm1,nm)];
+         i = j;
+         }
+      }
+
+   intg[VINDX(m)] = i;
+   if (i != m)
+      {
+      /* Interchange for rows and columns of a */
+      for (j = mm1; j <= n; ++j)
+         {
+         y = a[MINDX(i,j,nm)];
+         a[MINDX(i,j,nm)] = a[MINDX(m,j,nm)];
+         a[MINDX(m,j,nm)] = y;
+         }
+
+      for (j = 1; j <= igh; ++j)
+         {
+         y = a[MINDX(j,i,nm)];
+         a[MINDX(j,i,nm)] = a[MINDX(j,m,nm)];
+         a[MINDX(j,m,nm)] = y;
+         }
+      }
+
+   L130:
+   if (x != zero)
+      {
+      mp1 = m + 1;
+      for (i = mp1; i <= igh; ++i)
+         {
+         y = a[MINDX(i,mm1,nm)];
+         if (y != zero)
+            {
+            y /= x;
+            a[MINDX(i,mm1,nm)] = y;
+            for (j = m; j <= n; ++j)
+               a[MINDX(i,j,nm)] -= (y * a[MINDX(m,j,nm)]);
+            for (j = 1; j <= igh; ++j)
+               a[MINDX(j,m,nm)] += (y * a[MINDX(j,i,nm)]);
+            }
+         }
+      }
+   }
+
+L200: return(0);
+}  /* end of elmhes() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int eltran (int nm, int n, int low, int igh, double *a,
+            int *intg, double *z)
+
+#else
+
+int eltran (nm, n, low, igh, a, intg, z)
+int    nm, n, low, igh;
+double *a;
+int    *intg;
+double *z;
+
+#endif
+
+/* Purpose ...
+   -------
+   Accumulate the stabilized elementary similarity transformations
+   used in the reduction of a real general matrix to upper
+   Hessenberg form by elmhes().
+
+   Input ...
+   -----
+   n     : order of matrices
+   nm    : declared dimension of arrays
+   low   : boundary index from balanc()
+   igh   : boundary index from balanc()
+   a     : matrix from elmhes()
+   intg  : vector identifying row and column interchanges in a
+
+   Output ...
+   ------
+   a     : transformation matrix
+
+*/
+
+{  /* begin eltran() */
+
+int i, j, kl, mp, mp1;
+
+/* Initialize z to identity matrix */
+for (i = 1; i <= n; ++i)
+   {
+   for (j = 1; j <= n; ++j) z[MINDX(i,j,nm)] = zero;
+   z[MINDX(i,i,nm)] = one;
+   }
+
+kl = igh - low - 1;
+if (kl < 1) goto L200;
+
+for (mp=igh-1; mp >= low+1; --mp)
+   {
+   mp1 = mp + 1;
+
+   for (i = mp1; i <= igh; ++i)  z[MINDX(i,mp,nm)] = a[MINDX(i,mp-1,nm)];
+
+   i = intg[VINDX(mp)];
+   if (i != mp)
+      {
+      for (j = mp; j <= igh; ++j)
+         {
+         z[MINDX(mp,j,nm)] = z[MINDX(i,j,nm)];
+         z[MINDX(i,j,nm)] = zero;
+         }
+      z[MINDX(i,mp,nm)] = one;
+      }
+   }
+
+L200: return(0);
+}  /* end of eltran() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int orthes (int nm, int n, int low, int igh, double *a, double *ort)
+
+#else
+
+int orthes (nm, n, low, igh, a, ort)
+int    nm, n, low, igh;
+double *a, *ort;
+
+#endif
+
+/* Purpose ...
+   -------
+   Reduce a real general matrix to upper Hessenberg form using
+   orthogonal (Householder) similarity transformations, QR_NB
+   columns at a time.
+
+   Input ...
+   -----
+   n     : order of matrices
+   nm    : declared dimension of arrays
+   low   : boundary index from balanc()
+   igh   : boundary index from balanc()
+   a     : matrix to be reduced
+
+   Output ...
+   ------
+   a     : upper Hessenberg matrix, with the Householder vectors
+           used in the reduction stored below the subdiagonal
+   ort   : the scale factors of the Householder reflections,
+           ort[0..n-1]
+   returns 0 normally, -1 if workspace could not be allocated
+           (a is then unchanged).
+
+   Notes ...
+   -----
+   (1) Reflection m (m = low ... igh-2, counting from 1) is
+       I - ort[m-1].v.v(T) with v[m+1] = 1 and v[m+2..igh] stored
+       in column m of a, below the subdiagonal.
+   (2) Each panel of QR_NB columns is reduced with the updates
+       from the right deferred, as in LAPACK's dgehrd; the
+       trailing matrix then takes the block reflection
+       I - V.T.V(T) from both sides in a few passes by rows.
+       These passes are shared among threads when compiled for
+       OpenMP (PARALLEL in cmath.h).
+
+*/
+
+{  /* begin orthes() */
+
+int    i, j, k, p, q, r, c0, lo, hi, pb, m0, jb, je;
+double *v, *vt, *y, *t, *b, *wk, *ar, *vi;
+double s, tau, beta, alpha;
+
+lo = low - 1;
+hi = igh - 1;
+for (i = 0; i < n; ++i) ort[i] = zero;
+if (hi - lo < 2) return (0);
+
+m0 = hi - lo;
+v  = (double *) malloc (((long) (2 * m0 + hi + 1 + QR_NB + n) * QR_NB
+                          + 2 * m0 + QR_NB) * sizeof(double));
+if (v == NULL) return (-1);
+vt = v  + (long) m0 * QR_NB;          /* V(T), by rows          */
+y  = vt + (long) m0 * QR_NB;          /* Y = A.V.T, hi+1 rows   */
+t  = y  + (long) (hi + 1) * QR_NB;    /* T, QR_NB by QR_NB      */
+b  = t  + (long) QR_NB * QR_NB;       /* column being reduced   */
+wk = b  + (long) 2 * m0 + QR_NB;      /* V(T).A, QR_NB by n     */
+
+for (c0 = lo; c0 <= hi - 2; c0 += QR_NB)
+   {
+   pb = (hi - 1 - c0 < QR_NB) ? hi - 1 - c0 : QR_NB;
+   m0 = hi - c0;      /* rows c0+1 ... hi hold V */
+   for (i = 0; i < m0 * pb; ++i) v[i] = zero;
+
+   for (p = 0; p < pb; ++p)
+      {
+      j = c0 + p;
+
+      /* Column j of the current matrix, rows c0+1 ... hi */
+      for (i = 0; i < m0; ++i) b[i] = a[(long) (c0 + 1 + i) * nm + j];
+      if (p > 0)
+         {
+         vi = v + (long) (j - c0 - 1) * pb;
+         for (i = 0; i < m0; ++i)
+            {
+            ar = y + (long) (c0 + 1 + i) * pb;
+            s = zero;
+            for (q = 0; q < p; ++q) s += ar[q] * vi[q];
+            b[i] -= s;
+            }
+         /* b = b - V.T(T).V(T).b */
+         for (q = 0; q < p; ++q) b[m0 + q] = zero;
+         for (i = 0; i < m0; ++i)
+            {
+            vi = v + (long) i * pb;
+            for (q = 0; q < p; ++q) b[m0 + q] += vi[q] * b[i];
+            }
+         for (q = p - 1; q >= 0; --q)
+            {
+            s = zero;
+            for (r = 0; r <= q; ++r) s += t[r * QR_NB + q] * b[m0 + r];
+            b[m0 + q] = s;
+            }
+         for (i = 0; i < m0; ++i)
+            {
+            vi = v + (long) i * pb;
+            s = zero;
+            for (q = 0; q < p; ++q) s += vi[q] * b[m0 + q];
+            b[i] -= s;
+            }
+         }
+
+      /* Reflection for rows j+1 ... hi of column j */
+      k = j - c0;        /* b[k] is row j+1 */
+      s = zero;
+      for (i = k + 1; i < m0; ++i) s += b[i] * b[i];
+      if (s == zero)
+         {
+         tau = zero;
+         beta = b[k];
+         }
+      else
+         {
+         alpha = b[k];
+         beta = sqrt (alpha * alpha + s);
+         if (alpha > zero) beta = -beta;
+         tau = (beta - alpha) / beta;
+         s = one / (alpha - beta);
+         for (i = k + 1; i < m0; ++i) b[i] *= s;
+         }
+      b[k] = beta;
+      for (i = 0; i < m0; ++i) a[(long) (c0 + 1 + i) * nm + j] = b[i];
+      ort[j] = tau;
+      v[(long) k * pb + p] = one;
+      for (i = k + 1; i < m0; ++i) v[(long) i * pb + p] = b[i];
+
+      /* w = V(T).v for the earlier reflections, in b[m0 ...] */
+      for (q = 0; q < p; ++q) b[m0 + q] = zero;
+      for (i = k; i < m0; ++i)
+         {
+         vi = v + (long) i * pb;
+         s = vi[p];
+         for (q = 0; q < p; ++q) b[m0 + q] += vi[q] * s;
+         }
+
+      /* Y(:,p) = tau.(A.v - Y.w), rows 0 ... hi; the columns of
+         a beyond j are not yet updated. */
+      for (i = k; i < m0; ++i) b[m0 + QR_NB + i] = v[(long) i * pb + p];
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(i, q, s, ar) \
+        if ((long) (hi + 1) * (m0 - k) > QR_PMIN)
+#endif
+      for (r = 0; r <= hi; ++r)
+         {
+         ar = a + (long) r * nm + c0 + 1;
+         s = zero;
+         for (i = k; i < m0; ++i) s += ar[i] * b[m0 + QR_NB + i];
+         for (q = 0; q < p; ++q) s -= y[(long) r * pb + q] * b[m0 + q];
+         y[(long) r * pb + p] = tau * s;
+         }
+
+      /* T(0:p-1,p) = -tau.T.w, T(p,p) = tau */
+      for (q = 0; q < p; ++q)
+         {
+         s = zero;
+         for (r = q; r < p; ++r) s += t[q * QR_NB + r] * b[m0 + r];
+         t[q * QR_NB + p] = -tau * s;
+         }
+      t[p * QR_NB + p] = tau;
+      }
+
+   /* V(T) by rows, for the update from the right */
+   for (q = 0; q < pb; ++q)
+      for (i = 0; i < m0; ++i)
+         vt[(long) q * m0 + i] = v[(long) i * pb + q];
+
+   /* A = A - Y.V(T): rows 0 ... hi for the columns beyond the panel,
+      rows 0 ... c0 for the panel (its other rows are final). */
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(i, j, q, s, ar, vi) \
+        if ((long) (hi + 1) * m0 > QR_PMIN)
+#endif
+   for (r = 0; r <= hi; ++r)
+      {
+      ar = a + (long) r * nm + c0 + 1;
+      i = (r <= c0) ? 0 : pb - 1;
+      for (q = 0; q < pb; ++q)
+         {
+         s  = y[(long) r * pb + q];
+         vi = vt + (long) q * m0;
+         for (j = i; j < m0; ++j) ar[j] -= s * vi[j];
+         }
+      }
+
+   /* A = (I - V.T(T).V(T)).A for rows c0+1 ... hi, columns
+      c0+pb ... n-1, by blocks of columns */
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(je, i, j, q, r, s, ar, vi) \
+        if ((long) m0 * (n - c0 - pb) > QR_PMIN)
+#endif
+   for (jb = c0 + pb; jb < n; jb += QR_CB)
+      {
+      je = (jb + QR_CB < n) ? jb + QR_CB : n;
+      for (q = 0; q < pb; ++q)
+         for (j = jb; j < je; ++j) wk[(long) q * n + j] = zero;
+      for (i = 0; i < m0; ++i)
+         {
+         ar = a + (long) (c0 + 1 + i) * nm;
+         vi = v + (long) i * pb;
+         for (q = 0; q < pb; ++q)
+            {
+            s = vi[q];
+            if (s == zero) continue;
+            for (j = jb; j < je; ++j) wk[(long) q * n + j] += s * ar[j];
+            }
+         }
+      for (q = pb - 1; q >= 0; --q)
+         {
+         for (j = jb; j < je; ++j) wk[(long) q * n + j] *= t[q * QR_NB + q];
+         for (r = 0; r < q; ++r)
+            {
+            s = t[r * QR_NB + q];
+            for (j = jb; j < je; ++j)
+               wk[(long) q * n + j] += s * wk[(long) r * n + j];
+            }
+         }
+      for (i = 0; i < m0; ++i)
+         {
+         ar = a + (long) (c0 + 1 + i) * nm;
+         vi = v + (long) i * pb;
+         for (q = 0; q < pb; ++q)
+            {
+            s = vi[q];
+            if (s == zero) continue;
+            for (j = jb; j < je; ++j) ar[j] -= s * wk[(long) q * n + j];
+            }
+         }
+      }
+   }
+
+free (v);
+return (0);
+}  /* end of orthes() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int ortran (int nm, int n, int low, int igh, double *a,
+            double *ort, double *z)
+
+#else
+
+int ortran (nm, n, low, igh, a, ort, z)
+int    nm, n, low, igh;
+double *a, *ort, *z;
+
+#endif
+
+/* Purpose ...
+   -------
+   Accumulate the orthogonal similarity transformations used in
+   the reduction of a real general matrix to upper Hessenberg form
+   by orthes().
+
+   Input ...
+   -----
+   n     : order of matrices
+   nm    : declared dimension of arrays
+   low   : boundary index from balanc()
+   igh   : boundary index from balanc()
+   a     : matrix from orthes()
+   ort   : scale factors from orthes()
+
+   Output ...
+   ------
+   z     : transformation matrix
+
+   Notes ...
+   -----
+   Each block of QR_CB columns of z takes all of the reflections
+   in turn.  The blocks are shared among threads when compiled
+   for OpenMP.
+
+*/
+
+{  /* begin ortran() */
+
+int    i, j, m, jb, je, lo, hi;
+double s[QR_CB], tau, vi, *zi;
+
+for (i = 0; i < n; ++i)
+   {
+   for (j = 0; j < n; ++j) z[(long) i * nm + j] = zero;
+   z[(long) i * nm + i] = one;
+   }
+
+lo = low - 1;
+hi = igh - 1;
+if (hi - lo < 2) return (0);
+
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(je, i, j, m, s, tau, vi, zi) \
+        if ((long) (hi - lo) * (hi - lo) > QR_PMIN)
+#endif
+for (jb = lo + 1; jb <= hi; jb += QR_CB)
+   {
+   je = (jb + QR_CB <= hi + 1) ? jb + QR_CB : hi + 1;
+   for (m = hi - 2; m >= lo; --m)
+      {
+      tau = ort[m];
+      if (tau == zero) continue;
+      for (j = jb; j < je; ++j) s[j-jb] = zero;
+      for (i = m + 1; i <= hi; ++i)
+         {
+         vi = (i == m + 1) ? one : a[(long) i * nm + m];
+         zi = z + (long) i * nm;
+         for (j = jb; j < je; ++j) s[j-jb] += vi * zi[j];
+         }
+      for (j = jb; j < je; ++j) s[j-jb] *= tau;
+      for (i = m + 1; i <= hi; ++i)
+         {
+         vi = (i == m + 1) ? one : a[(long) i * nm + m];
+         zi = z + (long) i * nm;
+         for (j = jb; j < je; ++j) zi[j] -= s[j-jb] * vi;
+         }
+      }
+   }
+
+return (0);
+}  /* end of ortran() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void hqrows (double *a, int lda, int r0, int r1, int nref,
+                    int *rk, int *rn, double *rv)
+
+#else
+
+static void hqrows (a, lda, r0, r1, nref, rk, rn, rv)
+double *a;
+int    lda, r0, r1, nref, *rk, *rn;
+double *rv;
+
+#endif
+
+/* Purpose ...
+   -------
+   Apply the reflections saved by hqsweep(), in order, from the right
+   to rows r0 ... r1 of a.  Reflection q acts on columns rk[q] ...
+   rk[q]+rn[q]-1 and is I - tau.v.v(T) with tau = rv[3q],
+   v = (1, rv[3q+1], rv[3q+2]).
+*/
+
+{
+int    r, q;
+double p, tau, v2, v3, *hr;
+
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(q, p, tau, v2, v3, hr) \
+        if ((long) (r1 - r0 + 1) * nref > QR_PMIN / 4)
+#endif
+for (r = r0; r <= r1; ++r)
+   {
+   for (q = 0; q < nref; ++q)
+      {
+      hr  = a + (long) r * lda + rk[q];
+      tau = rv[3 * q];
+      v2  = rv[3 * q + 1];
+      if (rn[q] == 3)
+         {
+         v3 = rv[3 * q + 2];
+         p = tau * (hr[0] + v2 * hr[1] + v3 * hr[2]);
+         hr[2] -= p * v3;
+         }
+      else
+         p = tau * (hr[0] + v2 * hr[1]);
+      hr[0] -= p;
+      hr[1] -= p * v2;
+      }
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void hqsweep (int nm, int n, double *h, int L, int ihi,
+                     int wantt, double *z, int ldz, int iz0, int iz1,
+                     int nb, double *ssum, double *sprod)
+
+#else
+
+static void hqsweep (nm, n, h, L, ihi, wantt, z, ldz, iz0, iz1,
+                     nb, ssum, sprod)
+int    nm, n;
+double *h;
+int    L, ihi, wantt;
+double *z;
+int    ldz, iz0, iz1, nb;
+double *ssum, *sprod;
+
+#endif
+
+/* Purpose ...
+   -------
+   One multishift QR sweep over the unreduced block L ... ihi
+   (0-based) of the Hessenberg matrix h.  Shift pair j has sum
+   ssum[j] and product sprod[j].  The nb double-shift bulges are
+   chased down together, three rows apart, deepest first.  If wantt
+   is nonzero the whole of h is updated, otherwise only the block.
+   The columns of z, rows iz0 ... iz1, take the same reflections
+   (z may be NULL).  The rows above the chain, and z, are updated
+   by hqrows() once every QR_NGRP steps, so that each row is read
+   once for all of the reflections of those steps.
+*/
+
+{
+int    i, j, k, t, t0, t1, c, r, nr, i1, i2, nsteps, ks, rlo, nref;
+int    rk[QR_NGRP * QR_NSMAX / 2], rn[QR_NGRP * QR_NSMAX / 2];
+double rv[3 * QR_NGRP * QR_NSMAX / 2];
+double x, y, w, s, tau, beta, v2, v3, p, *h0, *h1, *h2, *hr;
+double h00, h01, h10, h11, h21;
+
+i1 = wantt ? 0 : L;
+i2 = wantt ? n - 1 : ihi;
+nsteps = ihi - L + 3 * (nb - 1);
+
+for (t0 = 0; t0 < nsteps; t0 += QR_NGRP)
+   {
+   t1 = (t0 + QR_NGRP < nsteps) ? t0 + QR_NGRP : nsteps;
+   /* Rows above rlo are not reached by the chain in these steps. */
+   ks = L - 1 + t0 - 3 * (nb - 1);
+   rlo = (ks < L - 1) ? L : ks + 1;
+   nref = 0;
+
+   for (t = t0; t < t1; ++t)
+      {
+      for (j = 0; j < nb; ++j)
+         {
+         k = L - 1 + t - 3 * j;
+         if (k < L - 1) break;
+         if (k > ihi - 2) continue;
+         nr = (k + 3 <= ihi) ? 3 : 2;
+
+         if (k == L - 1)
+            {
+            /* First column of (H - s1.I)(H - s2.I) */
+            h00 = h[(long) L * nm + L];
+            h01 = h[(long) L * nm + L + 1];
+            h10 = h[(long) (L+1) * nm + L];
+            h11 = h[(long) (L+1) * nm + L + 1];
+            h21 = (nr == 3) ? h[(long) (L+2) * nm + L + 1] : zero;
+            s = fabs (h00) + fabs (h10) + fabs (h11) + fabs (ssum[j]);
+            if (s == zero) s = one;
+            x = (h00 * (h00 / s) + h01 * (h10 / s)) - ssum[j] * (h00 / s)
+                + sprod[j] / s;
+            y = (h10 / s) * (h00 + h11 - ssum[j]);
+            w = (h10 / s) * h21;
+            }
+         else
+            {
+            x = h[(long) (k+1) * nm + k];
+            y = h[(long) (k+2) * nm + k];
+            w = (nr == 3) ? h[(long) (k+3) * nm + k] : zero;
+            }
+
+         s = y * y + w * w;
+         if (s == zero) continue;
+         beta = sqrt (x * x + s);
+         if (x > zero) beta = -beta;
+         tau = (beta - x) / beta;
+         v2 = y / (x - beta);
+         v3 = w / (x - beta);
+         if (k >= L)
+            {
+            h[(long) (k+1) * nm + k] = beta;
+            h[(long) (k+2) * nm + k] = zero;
+            if (nr == 3) h[(long) (k+3) * nm + k] = zero;
+            }
+
+         /* From the left, rows k+1 ... k+nr */
+         c  = (k >= L) ? k + 1 : L;
+         h0 = h + (long) (k+1) * nm;
+         h1 = h0 + nm;
+         if (nr == 3)
+            {
+            h2 = h1 + nm;
+            for (i = c; i <= i2; ++i)
+               {
+               p = tau * (h0[i] + v2 * h1[i] + v3 * h2[i]);
+               h0[i] -= p;
+               h1[i] -= p * v2;
+               h2[i] -= p * v3;
+               }
+            }
+         else
+            {
+            for (i = c; i <= i2; ++i)
+               {
+               p = tau * (h0[i] + v2 * h1[i]);
+               h0[i] -= p;
+               h1[i] -= p * v2;
+               }
+            }
+
+         /* From the right, columns k+1 ... k+nr, rows near the chain */
+         r = (k + 4 <= ihi) ? k + 4 : ihi;
+         for (i = rlo; i <= r; ++i)
+            {
+            hr = h + (long) i * nm + k + 1;
+            if (nr == 3)
+               {
+               p = tau * (hr[0] + v2 * hr[1] + v3 * hr[2]);
+               hr[2] -= p * v3;
+               }
+            else
+               p = tau * (hr[0] + v2 * hr[1]);
+            hr[0] -= p;
+            hr[1] -= p * v2;
+            }
+
+         rk[nref] = k + 1;
+         rn[nref] = nr;
+         rv[3 * nref]     = tau;
+         rv[3 * nref + 1] = v2;
+         rv[3 * nref + 2] = v3;
+         ++nref;
+         }
+      }
+
+   if (nref == 0) continue;
+   if (rlo > i1) hqrows (h, nm, i1, rlo - 1, nref, rk, rn, rv);
+   if (z != NULL) hqrows (z, ldz, iz0, iz1, nref, rk, rn, rv);
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static int hqaed (int nm, int n, double *h, int L, int ihi, int nw,
+                  int wantt, double *z, int ldz, int iz0, int iz1,
+                  int ns, int *nsh, double *ssum, double *sprod)
+
+#else
+
+static int hqaed (nm, n, h, L, ihi, nw, wantt, z, ldz, iz0, iz1,
+                  ns, nsh, ssum, sprod)
+int    nm, n;
+double *h;
+int    L, ihi, nw, wantt;
+double *z;
+int    ldz, iz0, iz1, ns, *nsh;
+double *ssum, *sprod;
+
+#endif
+
+/* Purpose ...
+   -------
+   Aggressive early deflation on the trailing nw by nw window of
+   the unreduced block L ... ihi.  The window is reduced to Schur
+   form T = U(T).W.U; eigenvalues at the bottom of T whose part of
+   the spike h[kw][kw-1].U(first row) is negligible are deflated.
+   If any are, the rest of the window is returned to Hessenberg
+   form and the transformation is applied to h (and z).
+   Up to ns/2 shift pairs are taken from the undeflated eigenvalues
+   of T, bottom first, and returned in ssum[], sprod[] (*nsh pairs).
+   Returns the number of eigenvalues deflated.
+*/
+
+{
+int    i, j, k, m, bs, kw, nd, c0, c1, ok, ierr;
+double *tw, *u, *tmp, *sp, *ort, s, foo, tau, beta, alpha, x, a0, a1;
+
+*nsh = 0;
+kw = ihi - nw + 1;
+tw = (double *) malloc (((long) 3 * nw * nw + (long) nw * n + 3 * nw)
+                        * sizeof(double));
+if (tw == NULL) return (0);
+u   = tw + (long) nw * nw;
+tmp = u  + (long) nw * nw;
+sp  = tmp + (long) nw * nw + (long) nw * n;
+ort = sp + nw;
+
+for (i = 0; i < nw; ++i)
+   {
+   for (j = 0; j < nw; ++j)
+      {
+      tw[i * nw + j] = (j >= i - 1) ? h[(long) (kw + i) * nm + kw + j] : zero;
+      u[i * nw + j] = zero;
+      }
+   u[i * nw + i] = one;
+   }
+ierr = hqrms (nw, nw, tw, 0, nw - 1, 1, u, nw, 0, nw - 1);
+if (ierr != 0)
+   {
+   free (tw);
+   return (0);
+   }
+
+/* Deflation test, bottom up, without reordering. */
+s = h[(long) kw * nm + kw - 1];
+nd = 0;
+i = nw - 1;
+while (i >= 0)
+   {
+   bs = (i > 0 && tw[i * nw + i - 1] != zero) ? 2 : 1;
+   if (bs == 1)
+      {
+      foo = fabs (tw[i * nw + i]);
+      if (foo == zero) foo = fabs (s);
+      ok = fabs (s * u[i]) <= MAX(QR_SAFMIN, EPSILON * foo);
+      }
+   else
+      {
+      foo = fabs (tw[i * nw + i]) + sqrt (fabs (tw[i * nw + i - 1])) *
+            sqrt (fabs (tw[(i - 1) * nw + i]));
+      if (foo == zero) foo = fabs (s);
+      ok = MAX(fabs (s * u[i]), fabs (s * u[i-1])) <=
+           MAX(QR_SAFMIN, EPSILON * foo);
+      }
+   if (!ok) break;
+   nd += bs;
+   i -= bs;
+   }
+m = nw - nd;
+
+/* Shifts from the undeflated part, bottom first: 2 by 2 blocks as
+   they stand, real eigenvalues two at a time. */
+i = m - 1;
+x = zero;
+ok = 0;
+while (i >= 0 && 2 * (*nsh) < ns)
+   {
+   if (i > 0 && tw[i * nw + i - 1] != zero)
+      {
+      a0 = tw[(i - 1) * nw + i - 1];
+      a1 = tw[i * nw + i];
+      ssum[*nsh]  = a0 + a1;
+      sprod[*nsh] = a0 * a1 - tw[(i - 1) * nw + i] * tw[i * nw + i - 1];
+      ++(*nsh);
+      i -= 2;
+      }
+   else
+      {
+      a1 = tw[i * nw + i];
+      if (ok)
+         {
+         ssum[*nsh]  = x + a1;
+         sprod[*nsh] = x * a1;
+         ++(*nsh);
+         }
+      else
+         x = a1;
+      ok = !ok;
+      i -= 1;
+      }
+   }
+if (ok && 2 * (*nsh) < ns)
+   {
+   ssum[*nsh]  = x + x;
+   sprod[*nsh] = x * x;
+   ++(*nsh);
+   }
+
+if (nd == 0)
+   {
+   free (tw);
+   return (0);
+   }
+
+/* The spike over the undeflated part is reflected onto its first
+   element, and that part of the window returned to Hessenberg form;
+   both transformations are gathered in u. */
+for (i = 0; i < m; ++i) sp[i] = s * u[i];
+if (m > 1)
+   {
+   x = zero;
+   for (i = 1; i < m; ++i) x += sp[i] * sp[i];
+   if (x != zero)
+      {
+      alpha = sp[0];
+      beta = sqrt (alpha * alpha + x);
+      if (alpha > zero) beta = -beta;
+      tau = (beta - alpha) / beta;
+      x = one / (alpha - beta);
+      for (i = 1; i < m; ++i) sp[i] *= x;
+      sp[0] = one;
+      /* tw = P.tw.P on the leading m rows and columns, u = u.P */
+      for (j = 0; j < nw; ++j)
+         {
+         x = zero;
+         for (i = 0; i < m; ++i) x += sp[i] * tw[i * nw + j];
+         x *= tau;
+         for (i = 0; i < m; ++i) tw[i * nw + j] -= x * sp[i];
+         }
+      for (i = 0; i < nw; ++i)
+         {
+         x = zero;
+         for (j = 0; j < m; ++j) x += tw[i * nw + j] * sp[j];
+         x *= tau;
+         for (j = 0; j < m; ++j) tw[i * nw + j] -= x * sp[j];
+         x = zero;
+         for (j = 0; j < m; ++j) x += u[i * nw + j] * sp[j];
+         x *= tau;
+         for (j = 0; j < m; ++j) u[i * nw + j] -= x * sp[j];
+         }
+      sp[0] = beta;
+      }
+   if (m > 2 && orthes (nw, nw, 1, m, tw, ort) == 0)
+      {
+      /* u = u.H(0) ... H(m-3), by rows */
+      for (i = 0; i < nw; ++i)
+         {
+         for (k = 0; k < m - 2; ++k)
+            {
+            if (ort[k] == zero) continue;
+            x = u[i * nw + k + 1];
+            for (j = k + 2; j < m; ++j) x += u[i * nw + j] * tw[j * nw + k];
+            x *= ort[k];
+            u[i * nw + k + 1] -= x;
+            for (j = k + 2; j < m; ++j) u[i * nw + j] -= x * tw[j * nw + k];
+            }
+         }
+      }
+   else if (m > 2)
+      {
+      /* No workspace for the reduction: give up the deflation. */
+      free (tw);
+      return (0);
+      }
+   }
+
+/* Back into h: window, spike and the other rows and columns. */
+for (i = 0; i < nw; ++i)
+   for (j = 0; j < nw; ++j)
+      h[(long) (kw + i) * nm + kw + j] = (j >= i - 1) ? tw[i * nw + j] : zero;
+for (i = 0; i < nw; ++i)
+   h[(long) (kw + i) * nm + kw - 1] = (i == 0 && m > 0) ? sp[0] : zero;
+if (nd < nw && m < nw) h[(long) (kw + m) * nm + kw + m - 1] = zero;
+
+if (wantt && ihi < n - 1)
+   {
+   /* rows kw ... ihi, to the right of the window: U(T).h */
+   c0 = ihi + 1;
+   c1 = n - c0;
+   for (i = 0; i < nw * c1; ++i) tmp[i] = zero;
+   for (k = 0; k < nw; ++k)
+      {
+      for (i = 0; i < nw; ++i)
+         {
+         x = u[k * nw + i];
+         if (x == zero) continue;
+         for (j = 0; j < c1; ++j)
+            tmp[(long) i * c1 + j] += x * h[(long) (kw + k) * nm + c0 + j];
+         }
+      }
+   for (i = 0; i < nw; ++i)
+      for (j = 0; j < c1; ++j)
+         h[(long) (kw + i) * nm + c0 + j] = tmp[(long) i * c1 + j];
+   }
+
+/* rows above the window, and z: .U */
+c0 = wantt ? 0 : L;
+for (k = c0; k < kw; ++k)
+   {
+   for (j = 0; j < nw; ++j) tmp[j] = zero;
+   for (i = 0; i < nw; ++i)
+      {
+      x = h[(long) k * nm + kw + i];
+      for (j = 0; j < nw; ++j) tmp[j] += x * u[i * nw + j];
+      }
+   for (j = 0; j < nw; ++j) h[(long) k * nm + kw + j] = tmp[j];
+   }
+if (z != NULL)
+   {
+   for (k = iz0; k <= iz1; ++k)
+      {
+      for (j = 0; j < nw; ++j) tmp[j] = zero;
+      for (i = 0; i < nw; ++i)
+         {
+         x = z[(long) k * ldz + kw + i];
+         for (j = 0; j < nw; ++j) tmp[j] += x * u[i * nw + j];
+         }
+      for (j = 0; j < nw; ++j) z[(long) k * ldz + kw + j] = tmp[j];
+      }
+   }
+
+free (tw);
+return (nd);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static int hqrms (int nm, int n, double *h, int low, int igh,
+                  int wantt, double *z, int ldz, int iz0, int iz1)
+
+#else
+
+static int hqrms (nm, n, h, low, igh, wantt, z, ldz, iz0, iz1)
+int    nm, n;
+double *h;
+int    low, igh, wantt;
+double *z;
+int    ldz, iz0, iz1;
+
+#endif
+
+/* Purpose ...
+   -------
+   Reduce rows and columns low ... igh (0-based) of the upper
+   Hessenberg matrix h towards real Schur form by the multishift
+   QR algorithm with aggressive early deflation (Braman, Byers and
+   Mathias).  Blocks smaller than QR_NMIN take double-shift sweeps
+   only.  Negligible subdiagonal elements are set to zero, so that
+   hqr() or hqr2() afterwards find the 1 by 1 and 2 by 2 blocks at
+   once.  If wantt is nonzero the whole of h is kept up to date
+   (for the eigenvectors); the transformations are applied to the
+   columns of z, rows iz0 ... iz1, if z is not NULL.
+   Returns 0, or the (1-based) row at which the iteration limit was
+   reached; h is still similar to the original matrix then.
+*/
+
+{
+int    i, j, L, ihi, it, itmax, kdefl, nh, ns, nw, nd, nsh;
+double tst, ss, aa, ssum[QR_NSMAX / 2], sprod[QR_NSMAX / 2];
+
+for (i = low + 2; i <= igh; ++i)
+   for (j = low; j < i - 1; ++j) h[(long) i * nm + j] = zero;
+
+ihi = igh;
+itmax = 30 * ((igh - low + 1 > 10) ? igh - low + 1 : 10);
+kdefl = 0;
+for (it = 0; ihi >= low; ++it)
+   {
+   for (L = ihi; L > low; --L)
+      {
+      tst = fabs (h[(long) (L-1) * nm + L-1]) + fabs (h[(long) L * nm + L]);
+      if (fabs (h[(long) L * nm + L-1]) <= EPSILON * tst)
+         {
+         h[(long) L * nm + L-1] = zero;
+         break;
+         }
+      }
+   if (L >= ihi - 1)
+      {
+      ihi = L - 1;
+      kdefl = 0;
+      continue;
+      }
+   if (it >= itmax) return (ihi + 1);
+   nh = ihi - L + 1;
+   ++kdefl;
+
+   if (nh < QR_NMIN)
+      {
+      /* Francis double shift, with an exceptional shift now and then */
+      if (kdefl % 10 == 0)
+         {
+         ss = fabs (h[(long) ihi * nm + ihi-1]) +
+              fabs (h[(long) (ihi-1) * nm + ihi-2]);
+         aa = 0.75 * ss + h[(long) ihi * nm + ihi];
+         ssum[0]  = 2.0 * aa;
+         sprod[0] = aa * aa + 0.4375 * ss * ss;
+         }
+      else
+         {
+         ssum[0]  = h[(long) (ihi-1) * nm + ihi-1] + h[(long) ihi * nm + ihi];
+         sprod[0] = h[(long) (ihi-1) * nm + ihi-1] * h[(long) ihi * nm + ihi]
+                    - h[(long) (ihi-1) * nm + ihi] * h[(long) ihi * nm + ihi-1];
+         }
+      hqsweep (nm, n, h, L, ihi, wantt, z, ldz, iz0, iz1, 1, ssum, sprod);
+      continue;
+      }
+
+   /* Number of shifts and deflation window, after LAPACK's iparmq */
+   ns = (nh < 150) ? 10 : (nh < 590) ? 16 : (nh < 3000) ? 32 : QR_NSMAX;
+   nw = (3 * ns) / 2;
+   if (nw > nh - 1) nw = nh - 1;
+
+   nd = hqaed (nm, n, h, L, ihi, nw, wantt, z, ldz, iz0, iz1,
+               ns, &nsh, ssum, sprod);
+   if (nd > 0)
+      {
+      kdefl = 0;
+      ihi -= nd;
+      if (100 * nd > QR_NIBBLE * nw) continue;
+      if (ihi - L + 1 < QR_NMIN) continue;
+      }
+
+   if (kdefl % QR_KEXSH == 0 || nsh < 1)
+      {
+      /* Exceptional shifts from the bottom of the block */
+      nsh = 0;
+      for (i = ihi; i >= L + 2 && 2 * nsh < ns; i -= 2)
+         {
+         ss = fabs (h[(long) i * nm + i-1]) + fabs (h[(long) (i-1) * nm + i-2]);
+         aa = 0.75 * ss + h[(long) i * nm + i];
+         ssum[nsh]  = 2.0 * aa;
+         sprod[nsh] = aa * aa + 0.4375 * ss * ss;
+         ++nsh;
+         }
+      }
+   i = (ihi - L + 1) / 6;
+   if (nsh > i) nsh = (i > 1) ? i : 1;
+   hqsweep (nm, n, h, L, ihi, wantt, z, ldz, iz0, iz1, nsh, ssum, sprod);
+   }
+
+return (0);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int hqr (int nm, int n, int Low, int igh, double *h,
+         double *wr, double *wi, int *ierr)
+
+#else
+
+int hqr (nm, n, Low, igh, h, wr, wi, ierr)
+int    nm, n, Low, igh;
+double *h;
+double *wr, *wi;
+int    *ierr;
+
+#endif
+
+/* Purpose ...
+   -------
+   Compute the eigenvalues and eigenvectors of a real upper
+   Hessenberg matrix using the QR method.
+
+   Input ...
+   -----
+   nm    : declared dimension of arrays
+   n     : order of matrix
+   Low   : boundary index for the balanced matrix
+   igh   : boundary index for the balanced matrix
+   h     : upper Hessenberg matrix
+
+   Output ...
+   ------
+   h     : the contents are changed by hqr2()
+   wr    : real parts of the eigenvalues
+   wi    : imaginary parts of the eigenvalues
+   z     : transformation matrix
+
+*/
+
+{  /* begin hqr() */
+
+int    i, j, k, L, m, en, LL, mm, na;
+int    its, mp2, enm2;
+double p, q, r, s, t, w, x, y, zz, machep;
+int    notlas;
+
+/* machep is a machine dependent parameter specifying
+   the relative precision of floating point arithmetic. */
+
+machep = EPSILON;
+
+*ierr = 0;
+
+/* store roots isolated by balanc */
+for (i = 1; i <= n; ++i)
+   {
+   if (i < Low || i > igh)
+      {
+      wr[VINDX(i)] = h[MINDX(i,i,nm)];
+      wi[VINDX(i)] = zero;
+      }
+   }
+
+en = igh;
+t = zero;
+
+/* Search for next eigenvalue */
+L60:
+if (en < Low) return(0);
+its = 0;
+na = en - 1;
+enm2 = en - 2;
+
+/* Look for single small sub-diagonal element */
+
+/* for L=en step -1 until Low do ... */
+L70:
+L = Low;
+for (LL = Low; LL <= en; ++LL)
+   {
+   L = en + Low - LL;
+   if (L == Low) break;
+   if (fabs(h[MINDX(L,L-1,nm)]) <= machep * (fabs(h[MINDX(L-1,L-1,nm)])
+       + fabs(h[MINDX(L,L,nm)]))) break;
+   }
+
+/* Form shift */
+
+L100:
+x = h[MINDX(en,en,nm)];
+if (L == en) goto L270;
+y = h[MINDX(na,na,nm)];
+w = h[MINDX(en,na,nm)] * h[MINDX(na,en,nm)];
+if (L == na) goto L280;
+if (its == 30)
+   {
+   /* Set error -- no convergence to an
+      eigenvaLue after 30 iterations */
+   *ierr = en;
+   return (0);
+   }
+
+if (its == 10 || its == 20)
+   {
+   /* Form exceptional shift */
+   t += x;
+   for (i = Low; i <= en; ++i)  h[MINDX(i,i,nm)] -= x;
+   s = fabs(h[MINDX(en,na,nm)]) + fabs(h[MINDX(na,enm2,nm)]);
+   x = 0.75 * s;
+   y = x;
+   w = -0.4375 * s * s;
+   }
+
+++its;
+
+/* Look for two consecutive small sub-diagonal elements. */
+
+/* for m=en-2 step -1 untiL L do ... */
+for (mm = L; mm <= enm2; ++mm)
+   {
+   m = enm2 + L - mm;
+   zz = h[MINDX(m,m,nm)];
+   r = x - zz;
+   s = y - zz;
+   p = (r * s - w) / h[MINDX(m+1,m,nm)] + h[MINDX(m,m+1,nm)];
+   q = h[MINDX(m+1,m+1,nm)] - zz - r - s;
+   r = h[MINDX(m+2,m+1,nm)];
+   s = fabs(p) + fabs(q) + fabs(r);
+   p /= s;
+   q /= s;
+   r /= s;
+   if (m == L) break;
+   if (fabs(h[MINDX(m,m-1,nm)]) * (fabs(q) + fabs(r)) <=
+       machep * fabs(p) * (fabs(h[MINDX(m-1,m-1,nm)]) + fabs(zz) +
+       fabs(h[MINDX(m+1,m+1,nm)]))) break;
+   }
+
+L150:
+mp2 = m + 2;
+
+for (i = mp2; i <= en; ++i)
+   {
+   h[MINDX(i,i-2,nm)] = zero;
+   if (i != mp2) h[MINDX(i,i-3,nm)] = zero;
+   }
+
+/* double qr step involving rows L to en and coLumns m to en  */
+for (k = m; k <= na; ++k)
+   {
+   notlas = (k != na);
+   if (k != m)
+      {
+      p = h[MINDX(k,k-1,nm)];
+      q = h[MINDX(k+1,k-1,nm)];
+      r = zero;
+      if (notlas) r = h[MINDX(k+2,k-1,nm)];
+      x = fabs(p) + fabs(q) + fabs(r);
+      if (x == zero) continue;
+      p /= x;
+      q /= x;
+      r /= x;
+      }
+   s = SIGN(sqrt(p*p+q*q+r*r),p);
+   if (k == m)
+      {
+      if (L != m) h[MINDX(k,k-1,nm)] = -h[MINDX(k,k-1,nm)];
+      }
+   else
+      {
+      h[MINDX(k,k-1,nm)] = -s * x;
+      }
+   p += s;
+   x = p / s;
+   y = q / s;
+   zz = r / s;
+   q /= p;
+   r /= p;
+   /* Row modification */
+   for (j = k; j <= en; ++j)
+      {
+      p = h[MINDX(k,j,nm)] + q * h[MINDX(k+1,j,nm)];
+      if (notlas)
+         {
+         p += (r * h[MINDX(k+2,j,nm)]);
+         h[MINDX(k+2,j,nm)] -= (p * zz);
+         }
+      h[MINDX(k+1,j,nm)] -= (p * y);
+      h[MINDX(k,j,nm)] -= (p * x);
+      }
+
+   j = MIN(en,k+3);
+
+   /* Column modification */
+   for (i = L; i <= j; ++i)
+      {
+      p = x * h[MINDX(i,k,nm)] + y * h[MINDX(i,k+1,nm)];
+      if (notlas)
+         {
+         p += (zz * h[MINDX(i,k+2,nm)]);
+         h[MINDX(i,k+2,nm)] -= (p * r);
+         }
+      h[MINDX(i,k+1,nm)] -= (p * q);
+      h[MINDX(i,k,nm)] -= p;
+      }
+   }
+
+goto L70;
+
+L270: /* One root found. */
+wr[VINDX(en)] = x + t;
+wi[VINDX(en)] = zero;
+en = na;
+goto L60;
+
+L280: /* Two roots found. */
+p = (y - x) / two;
+q = p * p + w;
+zz = sqrt(fabs(q));
+x = x + t;
+
+if (q >= zero)
+   {  /* Real pair. */
+   zz = p + SIGN(zz,p);
+   wr[VINDX(na)] = x + zz;
+   wr[VINDX(en)] = wr[VINDX(na)];
+   if (zz != zero) wr[VINDX(en)] = x - w / zz;
+   wi[VINDX(na)] = zero;
+   wi[VINDX(en)] = zero;
+   }
+else
+   { /* Complex pair */
+   wr[VINDX(na)] = x + p;
+   wr[VINDX(en)] = x + p;
+   wi[VINDX(na)] = zz;
+   wi[VINDX(en)] = -zz;
+   }
+
+en = enm2;
+goto L60;
+
+}  /* end of hqr() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int hqr2 (int nm, int n, int Low, int igh, double *h,
+          double *wr, double *wi, double *z, int *ierr)
+
+#else
+
+int hqr2 (nm, n, Low, igh, h, wr, wi, z, ierr)
+int    nm, n, Low, igh;
+double *h;
+double *wr, *wi;
+double *z;
+int    *ierr;
+
+#endif
+
+/* Purpose ...
+   -------
+   Compute the eigenvalues and eigenvectors of a real upper
+   Hessenberg matrix using the QR method.
+
+   Input ...
+   -----
+   nm    : declared dimension of arrays
+   n     : order of matrix
+   Low   : boundary index for the balanced matrix
+   igh   : boundary index for the balanced matrix
+   h     : upper Hessenberg matrix
+
+   Output ...
+   ------
+   h     : the contents are changed by hqr2()
+   wr    : real parts of the eigenvalues
+   wi    : imaginary parts of the eigenvalues
+   z     : transformation matrix
+
+*/
+
+{  /* begin hqr2() */
+
+int    i, j, k, L, m, en, ii, jj, LL, mm, na, nn;
+int    its, mp2, enm2;
+double p, q, r, s, t, w, x, y, ra, sa, vi, vr, zz, norm, machep;
+int    notlas;
+double t3r, t3i;
+
+/* machep is a machine dependent parameter specifying
+   the relative precision of floating point arithmetic. */
+
+machep = EPSILON;
+
+*ierr = 0;
+
+/* store roots isolated by balanc */
+for (i = 1; i <= n; ++i)
+   {
+   if (i < Low || i > igh)
+      {
+      wr[VINDX(i)] = h[MINDX(i,i,nm)];
+      wi[VINDX(i)] = zero;
+      }
+   }
+
+en = igh;
+t = zero;
+
+/* Search for next eigenvalue */
+L60:
+if (en < Low) goto L340;
+its = 0;
+na = en - 1;
+enm2 = na - 1;
+
+/* Look for single small sub-diagonal element */
+
+/* for L=en step -1 until Low do ... */
+L70:
+L = Low;
+for (LL = Low; LL <= en; ++LL)
+   {
+   L = en + Low - LL;
+   if (L == Low) break;
+   if (fabs(h[MINDX(L,L-1,nm)]) <= machep * (fabs(h[MINDX(L-1,L-1,nm)])
+       + fabs(h[MINDX(L,L,nm)]))) break;
+   }
+
+/* Form shift */
+
+L100:
+x = h[MINDX(en,en,nm)];
+if (L == en) goto L270;
+y = h[MINDX(na,na,nm)];
+w = h[MINDX(en,na,nm)] * h[MINDX(na,en,nm)];
+if (L == na) goto L280;
+if (its == 30)
+   {
+   /* Set error -- no convergence to an
+      eigenvaLue after 30 iterations */
+   *ierr = en;
+   goto L1001;
+   }
+
+if (its == 10 || its == 20)
+   {
+   /* Form exceptional shift */
+   t += x;
+   for (i = Low; i <= en; ++i)  h[MINDX(i,i,nm)] -= x;
+   s = fabs(h[MINDX(en,na,nm)]) + fabs(h[MINDX(na,enm2,nm)]);
+   x = 0.75 * s;
+   y = x;
+   w = -0.4375 * s * s;
+   }
+
+++its;
+
+/* Look for two consecutive small sub-diagonal elements. */
+
+/* for m=en-2 step -1 untiL L do ... */
+for (mm = L; mm <= enm2; ++mm)
+   {
+   m = enm2 + L - mm;
+   zz = h[MINDX(m,m,nm)];
+   r = x - zz;
+   s = y - zz;
+   p = (r * s - w) / h[MINDX(m+1,m,nm)] + h[MINDX(m,m+1,nm)];
+   q = h[MINDX(m+1,m+1,nm)] - zz - r - s;
+   r = h[MINDX(m+2,m+1,nm)];
+   s = fabs(p) + fabs(q) + fabs(r);
+   p /= s;
+   q /= s;
+   r /= s;
+   if (m == L) break;
+   if (fabs(h[MINDX(m,m-1,nm)]) * (fabs(q) + fabs(r)) <=
+       machep * fabs(p) * (fabs(h[MINDX(m-1,m-1,nm)]) + fabs(zz) +
+       fabs(h[MINDX(m+1,m+1,nm)]))) break;
+   }
+
+L150:
+mp2 = m + 2;
+
+for (i = mp2; i <= en; ++i)
+   {
+   h[MINDX(i,i-2,nm)] = zero;
+   if (i != mp2) h[MINDX(i,i-3,nm)] = zero;
+   }
+
+/* double qr step involving rows L to en and coLumns m to en  */
+for (k = m; k <= na; ++k)
+   {
+   notlas = (k != na);
+   if (k != m)
+      {
+      p = h[MINDX(k,k-1,nm)];
+      q = h[MINDX(k+1,k-1,nm)];
+      r = zero;
+      if (notlas) r = h[MINDX(k+2,k-1,nm)];
+      x = fabs(p) + fabs(q) + fabs(r);
+      if (x == zero) continue;
+      p /= x;
+      q /= x;
+      r /= x;
+      }
+   s = SIGN(sqrt(p*p+q*q+r*r),p);
+   if (k == m)
+      {
+      if (L != m) h[MINDX(k,k-1,nm)] = -h[MINDX(k,k-1,nm)];
+      }
+   else
+      {
+      h[MINDX(k,k-1,nm)] = -s * x;
+      }
+   p += s;
+   x = p / s;
+   y = q / s;
+   zz = r / s;
+   q /= p;
+   r /= p;
+   /* Row modification */
+   for (j = k; j <= n; ++j)
+      {
+      p = h[MINDX(k,j,nm)] + q * h[MINDX(k+1,j,nm)];
+      if (notlas)
+         {
+         p += (r * h[MINDX(k+2,j,nm)]);
+         h[MINDX(k+2,j,nm)] -= (p * zz);
+         }
+      h[MINDX(k+1,j,nm)] -= (p * y);
+      h[MINDX(k,j,nm)] -= (p * x);
+      }
+
+   j = MIN(en,k+3);
+
+   /* Column modification */
+   for (i = 1; i <= j; ++i)
+      {
+      p = x * h[MINDX(i,k,nm)] + y * h[MINDX(i,k+1,nm)];
+      if (notlas)
+         {
+         p += (zz * h[MINDX(i,k+2,nm)]);
+         h[MINDX(i,k+2,nm)] -= (p * r);
+         }
+      h[MINDX(i,k+1,nm)] -= (p * q);
+      h[MINDX(i,k,nm)] -= p;
+      }
+
+   /* Accumulate transformations  */
+   for (i = Low; i <= igh; ++i)
+      {
+      p = x * z[MINDX(i,k,nm)] + y * z[MINDX(i,k+1,nm)];
+      if (notlas)
+         {
+         p += (zz * z[MINDX(i,k+2,nm)]);
+         z[MINDX(i,k+2,nm)] -= (p * r);
+         }
+      z[MINDX(i,k+1,nm)] -= (p * q);
+      z[MINDX(i,k,nm)] -= p;
+      }
+
+   }
+
+goto L70;
+
+L270: /* One root found. */
+h[MINDX(en,en,nm)] = x + t;
+wr[VINDX(en)] = h[MINDX(en,en,nm)];
+wi[VINDX(en)] = zero;
+en = na;
+goto L60;
+
+L280: /* Two roots found. */
+p = (y - x) / two;
+q = p * p + w;
+zz = sqrt(fabs(q));
+h[MINDX(en,en,nm)] = x + t;
+x = h[MINDX(en,en,nm)];
+h[MINDX(na,na,nm)] = y + t;
+
+if (q >= zero)
+   {  /* Real pair. */
+   zz = p + SIGN(zz,p);
+   wr[VINDX(na)] = x + zz;
+   wr[VINDX(en)] = wr[VINDX(na)];
+   if (zz != zero) wr[VINDX(en)] = x - w / zz;
+   wi[VINDX(na)] = zero;
+   wi[VINDX(en)] = zero;
+   x = h[MINDX(en,na,nm)];
+   r = sqrt(x * x + zz * zz);
+   p = x / r;
+   q = zz / r;
+
+   /* Row modification. */
+   for (j = na; j <= n; ++j)
+      {
+      zz = h[MINDX(na,j,nm)];
+      h[MINDX(na,j,nm)] = q * zz + p * h[MINDX(en,j,nm)];
+      h[MINDX(en,j,nm)] = q * h[MINDX(en,j,nm)] - p * zz;
+      }
+
+   /* Column modification. */
+   for (i = 1; i <= en; ++i)
+      {
+      zz = h[MINDX(i,na,nm)];
+      h[MINDX(i,na,nm)] = q * zz + p * h[MINDX(i,en,nm)];
+      h[MINDX(i,en,nm)] = q * h[MINDX(i,en,nm)] - p * zz;
+      }
+
+   /* Accumulate transformations. */
+   for (i = Low; i <= igh; ++i)
+      {
+      zz = z[MINDX(i,na,nm)];
+      z[MINDX(i,na,nm)] = q * zz + p * z[MINDX(i,en,nm)];
+      z[MINDX(i,en,nm)] = q * z[MINDX(i,en,nm)] - p * zz;
+      }
+   }
+else
+   { /* Complex pair */
+   wr[VINDX(na)] = x + p;
+   wr[VINDX(en)] = x + p;
+   wi[VINDX(na)] = zz;
+   wi[VINDX(en)] = -zz;
+   }
+
+en = enm2;
+goto L60;
+
+L340: /* All roots found.  backsubstitute to find
+         vectors of upper triangular form  */
+norm = zero;
+k = 1;
+
+for (i = 1; i <= n; ++i)
+   {
+   for (j = k; j <= n; ++j)   norm += fabs(h[MINDX(i,j,nm)]);
+   k = i;
+   }
+
+if (norm == zero) goto L1001;
+
+/* for en=n step -1 untiL 1 do ... */
+for (nn = 1; nn <= n; ++nn)
+   {
+   en = n + 1 - nn;
+   p = wr[VINDX(en)];
+   q = wi[VINDX(en)];
+   na = en - 1;
+
+   if (q == zero)
+      { /* Real vector. */
+      m = en;
+      h[MINDX(en,en,nm)] = one;
+      if (na == 0) goto L800;
+      /* for i=en-1 step -1 untiL 1 do ... */
+      for (ii = 1; ii <= na; ++ii)
+         {
+         i = en - ii;
+         w = h[MINDX(i,i,nm)] - p;
+         r = h[MINDX(i,en,nm)];
+         if (m <= na)
+            {
+            for (j = m; j <= na; ++j)
+               r += h[MINDX(i,j,nm)] * h[MINDX(j,en,nm)];
+            }
+
+         if (wi[VINDX(i)] < zero)
+            {
+            zz = w;
+            s = r;
+            goto L700;
+            }
+
+         m = i;
+         if (wi[VINDX(i)] == zero)
+            {
+            t = w;
+            if (w == zero) t = machep * norm;
+            h[MINDX(i,en,nm)] = -r / t;
+            goto L700;
+            }
+
+         /* Solve real equations */
+         x = h[MINDX(i,i+1,nm)];
+         y = h[MINDX(i+1,i,nm)];
+         q = (wr[VINDX(i)] - p) * (wr[VINDX(i)] - p) +
+             wi[VINDX(i)] * wi[VINDX(i)];
+         t = (x * s - zz * r) / q;
+         h[MINDX(i,en,nm)] = t;
+         if (fabs(x) > fabs(zz))
+            {
+            h[MINDX(i+1,en,nm)] = (-r - w * t) / x;
+            goto L700;
+            }
+         h[MINDX(i+1,en,nm)] = (-s - y * t) / zz;
+
+         L700:;
+         }
+      }  /* End real vector. */
+   else if (q < zero)
+      {  /* Complex vector. */
+      m = na;
+      /* Last vector component chosen imaginary so that
+         eigenvector matrix is triangular */
+      if (fabs(h[MINDX(en,na,nm)]) <= fabs(h[MINDX(na,en,nm)]))
+         {
+         cdivsn (zero, -h[MINDX(na,en,nm)], h[MINDX(na,na,nm)]-p, q,
+                 &t3r, &t3i);
+         h[MINDX(na,na,nm)] = t3r;
+         h[MINDX(na,en,nm)] = t3i;
+         }
+      else
+         {
+         h[MINDX(na,na,nm)] = q / h[MINDX(en,na,nm)];
+         h[MINDX(na,en,nm)] = -(h[MINDX(en,en,nm)] - p) /
+                              h[MINDX(en,na,nm)];
+         }
+
+      h[MINDX(en,na,nm)] = zero;
+      h[MINDX(en,en,nm)] = one;
+      enm2 = na - 1;
+      if (enm2 == 0) goto L800;
+
+      for (ii = 1; ii <= enm2; ++ii)
+         {
+         i = na - ii;
+         w = h[MINDX(i,i,nm)] - p;
+         ra = zero;
+         sa = h[MINDX(i,en,nm)];
+
+         for (j = m; j <= na; ++j)
+            {
+            ra += (h[MINDX(i,j,nm)] * h[MINDX(j,na,nm)]);
+            sa += (h[MINDX(i,j,nm)] * h[MINDX(j,en,nm)]);
+            }
+
+         if (wi[VINDX(i)] < zero)
+            {
+            zz = w;
+            r = ra;
+            s = sa;
+            goto L790;
+            }
+
+         m = i;
+         if (wi[VINDX(i)] == zero)
+            {
+            cdivsn (-ra, -sa, w, q, &t3r, &t3i);
+            h[MINDX(i,na,nm)] = t3r;
+            h[MINDX(i,en,nm)] = t3i;
+            goto L790;
+            }
+
+         /* Solve complex equations */
+         x = h[MINDX(i,i+1,nm)];
+         y = h[MINDX(i+1,i,nm)];
+         vr = (wr[VINDX(i)] - p) * (wr[VINDX(i)] - p) +
+               wi[VINDX(i)] * wi[VINDX(i)] - q * q;
+         vi = (wr[VINDX(i)] - p) * two * q;
+         if (vr == zero && vi == zero)
+            vr = machep * norm *
+                 (fabs(w) + fabs(q) + fabs(x) + fabs(y) + fabs(zz));
+         cdivsn (x*r-zz*ra+q*sa, x*s-zz*sa-q*ra, vr, vi, &t3r, &t3i);
+         h[MINDX(i,na,nm)] = t3r;
+         h[MINDX(i,en,nm)] = t3i;
+         if (fabs(x) > fabs(zz) + fabs(q))
+            {
+            h[MINDX(i+1,na,nm)] = (-ra - w * h[MINDX(i,na,nm)] +
+                                   q * h[MINDX(i,en,nm)]) / x;
+            h[MINDX(i+1,en,nm)] = (-sa - w * h[MINDX(i,en,nm)] -
+                                   q * h[MINDX(i,na,nm)]) / x;
+            goto L790;
+            }
+
+         cdivsn(-r-y*h[MINDX(i,na,nm)], -s-y*h[MINDX(i,en,nm)], zz, q,
+                &t3r, &t3i);
+         h[MINDX(i+1,na,nm)] = t3r;
+         h[MINDX(i+1,en,nm)] = t3i;
+
+         L790:;
+         }
+      }  /* End complex vector. */
+   L800:;
+   }
+/* End back substitution. */
+
+/* vectors of isolated roots. */
+for (i = 1; i <= n; ++i)
+   {
+   if (i < Low || i > igh)
+      {
+      for (j = i; j <= n; ++j) z[MINDX(i,j,nm)] = h[MINDX(i,j,nm)];
+      }
+   }
+
+/* Multiply by transformation matrix to give
+   vectors of original full matrix.  */
+
+/* for j=n step -1 until Low do ... */
+for (jj = Low; jj <= n; ++jj)
+   {
+   j = n + Low - jj;
+   m = MIN(j,igh);
+
+   for (i = Low; i <= igh; ++i)
+      {
+      zz = zero;
+      for (k = Low; k <= m; ++k)
+         zz += (z[MINDX(i,k,nm)] * h[MINDX(k,j,nm)]);
+      z[MINDX(i,j,nm)] = zz;
+      }
+   }
+
+L1001: return(0);
+
+}  /* end of hqr2() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int balbak (int nm, int n, int low, int igh, double *scale,
+            int m, double *z)
+
+#else
+
+int balbak (nm, n, low, igh, scale, m, z)
+int    nm, n, low, igh;
+double *scale;
+int    m;
+double *z;
+
+#endif
+
+/* Purpose ...
+   -------
+   Form the eigenvectors of a real general matrix from the
+   eigenvectors of that matrix transformed by balanc().
+
+   Input ...
+   -----
+   nm    : declared dimension of arrays
+   n     : order of matrix
+   low   : boundary index for the balanced matrix
+   igh   : boundary index for the balanced matrix
+   scale : vector of information on transformations
+   m     : number of columns of z to be back-transformed
+   z     : matrix of eigenvectors
+
+   Output ...
+   ------
+   z     : backtransformed matrix of eigenvectors
+
+*/
+
+{  /* begin balbak() */
+
+int    i, j, k, ii;
+double s;
+
+if (igh != low)
+   {
+   for (i = low; i <= igh; ++i)
+      {
+      s = scale[VINDX(i)];
+      /*
+      left hand eigenvectors are back transformed
+      if the foregoing statement is replaced by
+      s = one / scale[VINDX(i)];
+      */
+      for (j = 1; j <= m; ++j)  z[MINDX(i,j,nm)] *= s;
+      }
+   }
+
+/* for i=low-1 step -1 until 1,
+      for igh+1 step 1 until n do ... */
+for (ii = 1; ii <= n; ++ii)
+   {
+   i = ii;
+   if (i < low || i > igh)
+      {
+      if (i < low) i = low - ii;
+      k = scale[VINDX(i)];
+      if (k != i)
+         {
+         for (j = 1; j <= m; ++j)
+            {
+            s = z[MINDX(i,j,nm)];
+            z[MINDX(i,j,nm)] = z[MINDX(k,j,nm)];
+            z[MINDX(k,j,nm)] = s;
+            }
+         }
+      }
+   }
+
+return(0);
+}  /* end of balbak() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int qrvector (int k, int nm, int n,
+              double *z, double wr[], double wi[],
+              double vr[], double vi[], int *flag)
+
+#else
+
+int qrvector (k, nm, n, z, wr, wi, vr, vi, flag)
+int    k, nm, n;
+double *z, wr[], wi[], vr[], vi[];
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Extract the kth eigenvector from the packed matrix as
+   returned by qr().
+
+   Input ...
+   -----
+   k     : index of eigenvector required
+   nm    : declared dimension of arrays
+   n     : order of matrix
+   z     : packed matrix of eigenvectors
+   wr,wi : eigenvalues as returned by qr()
+
+   Output ...
+   ------
+   vr,vi : real and imaginary parts of the jth eigenvector
+           (with corresponding eigenvalue wr[j] + i wi[j])
+   flag  : status indicator
+           flag == 0, normal return
+           flag == 1, invalid user input
+           flag == 2, could not locate complex conjugate eigenvalue.
+
+   This C code written by ...  Peter & Nigel,
+   ----------------------      Design Software,
+                               42 Gubberley St,
+                               Kenmore, 4069,
+                               Australia.
+
+   Version ... 1.0, August 1989
+   -------
+
+   Notes ...
+   -----
+   The eigenvector matrix is packed as follows ...
+   if wi[j] == 0.0  (real eigenvalue) the real parts of the
+                    eigenvector are stored as z[i][j] while
+                    the imaginary parts are zero.
+   if wi[j] > 0.0   (complex eigenvalue) the real parts of the
+                    eigenvector is stored as z[i][j] and the
+                    imaginary parts as z[i][j+1].
+   if wi[j] < 0.0   (complex eigenvalue) the eigenvector is the
+                    conjugate of the eigenvector stored for the
+                    conjugate of this eigenvalue
+
+*/
+
+{  /* begin qrvector() */
+int i, j;
+double diff, size, small;
+
+*flag = 0;
+
+if (n < 1 || n > nm || nm < 1 || z == NULL || wr == NULL ||
+    wi == NULL || vr == NULL || vi == NULL || k < 0 || k >= n)
+    {
+    *flag = 1;
+    return (0);
+    }
+
+if (wi[k] == 0.0)
+   {
+   /* real eigenvalue */
+   for (i = 0; i < n; ++i)
+      {
+      vr[i] = z[i * nm + k];
+      vi[i] = 0.0;
+      }
+   }
+
+if (wi[k] > 0.0)
+   {
+   /* complex eigenvalue */
+   for (i = 0; i < n; ++i)
+      {
+      vr[i] = z[i * nm + k];
+      vi[i] = z[i * nm + k + 1];
+      }
+   }
+
+if (wi[k] < 0.0)
+   {
+   /* complex eigenvalue not stored in z */
+   /* First, find the conjugate eigenvalue */
+   j = 0;
+   small = 1000.0;
+   size = cabslt (wr[k], wi[k]);
+   for (i = 0; i < n; ++i)
+      {
+      diff = fabs (cabslt(wr[i], wi[i]) - size);
+      if (i != k && diff < small)
+         {
+         small = diff;
+         j = i;
+         }
+      }
+   if (small > sqrt(EPSILON))
+      {
+      /* did not find conjugate (to a satisfactory precision) */
+      *flag = 2;
+      return (0);
+      }
+   /* Now, unpack eigenvector */
+   for (i = 0; i < n; ++i)
+      {
+      vr[i] = z[i * nm + j];
+      vi[i] = -z[i * nm + j + 1];
+      }
+   }
+
+return(0);
+}  /* end of qrvector() */
+
+/*-----------------------------------------------------------------*/
+
@@ -0,0 +1,725 @@
+/* qrbatch.c
+   Eigenvalues of many small real general matrices.
+*/
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+
+#include "cmath.h"
+#if (STDLIBH)
+#include <stdlib.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+#define  SIGN(a,b)  (((b) >= 0.0) ? fabs(a) : -fabs(a))
+
+/* Largest order handled, and the number of matrices (lanes) that are
+   carried through the QR iteration together.  Each step of the
+   iteration is done for all of the lanes in an inner loop of fixed
+   length QRB_LANES, over contiguous storage, which the compiler can
+   turn into vector instructions.  */
+#define  QRB_NMAX    16
+#define  QRB_LANES   8
+
+/* Iteration limit, per eigenvalue, as in hqr().  */
+#define  QRB_ITS     30
+
+/* Matrices of order 3 are done in closed form, with QRB_NEWT Newton
+   steps on each root, unless some root has a sensitivity to the
+   coefficients (see qrb3x3()) above QRB_KMAX.  */
+#define  QRB_NEWT    3
+#define  QRB_KMAX    64.0
+
+/* Local copy of element (i,j) of the lanes of a block.  */
+#define  HB(i,j)  (hb + ((i) * QRB_NMAX + (j)) * QRB_LANES)
+
+static double zero = 0.0;
+static double one  = 1.0;
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void qrb2x2 (double a, double b, double c, double d,
+                    double *r1, double *i1, double *r2, double *i2)
+
+#else
+
+static void qrb2x2 (a, b, c, d, r1, i1, r2, i2)
+double a, b, c, d;
+double *r1, *i1, *r2, *i2;
+
+#endif
+
+/* Purpose ...
+   -------
+   Eigenvalues of the 2 by 2 matrix [a b; c d], as in hqr().
+   A complex pair is returned with the positive imaginary part
+   first.
+*/
+
+{
+double p, q, w, zz;
+
+w  = b * c;
+p  = 0.5 * (a - d);
+q  = p * p + w;
+zz = sqrt (fabs (q));
+if (q >= zero)
+   {
+   zz = p + SIGN (zz, p);
+   *r1 = d + zz;
+   *r2 = (zz != zero) ? d - w / zz : *r1;
+   *i1 = zero;
+   *i2 = zero;
+   }
+else
+   {
+   *r1 = d + p;
+   *r2 = d + p;
+   *i1 = zz;
+   *i2 = -zz;
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static double qrbnewt (double c2, double c1, double c0,
+                       double *x, double *y)
+
+#else
+
+static double qrbnewt (c2, c1, c0, x, y)
+double c2, c1, c0;
+double *x, *y;
+
+#endif
+
+/* Purpose ...
+   -------
+   Polish the root z = x + i y of p(z) = z^3 - c2 z^2 + c1 z - c0
+   by at most QRB_NEWT Newton steps.  A step that does not reduce
+   |p(z)| is not taken.  Returns the sensitivity of the root,
+   (1 + |z| + |z|^2 + |z|^3) / |p'(z)|, which with coefficients of
+   order one bounds its error in units of their rounding errors.
+*/
+
+{
+int    k;
+double pr, pi, dr, di, tr, ti, az, zx, zy, pz, xs, ys, ds, ps;
+
+zx = *x;
+zy = *y;
+xs = ys = ds = zero;
+ps = -one;
+for (k = 0; k <= QRB_NEWT; ++k)
+   {
+   /* Horner's rule for p and p', in complex arithmetic */
+   pr = zx - c2;                  pi = zy;
+   dr = 3.0 * zx - 2.0 * c2;      di = 3.0 * zy;
+   tr = pr * zx - pi * zy + c1;   ti = pr * zy + pi * zx;
+   pr = tr * zx - ti * zy - c0;   pi = tr * zy + ti * zx;
+   tr = dr * zx - di * zy + c1;   ti = dr * zy + di * zx;
+   dr = tr;                       di = ti;
+   pz = fabs (pr) + fabs (pi);
+   if (ps >= zero && !(pz < ps)) break;   /* keep the last point */
+   xs = zx;  ys = zy;  ds = dr * dr + di * di;  ps = pz;
+   if (k == QRB_NEWT || pz == zero || ds == zero) break;
+   /* z -= p / p' */
+   zx -= (pr * dr + pi * di) / ds;
+   if (zy != zero) zy -= (pi * dr - pr * di) / ds;
+   }
+*x = xs;
+*y = ys;
+if (ds == zero) return (one / EPSILON);
+az = sqrt (xs * xs + ys * ys);
+return ((one + az * (one + az * (one + az))) / sqrt (ds));
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static int qrb3x3 (double h[], double zr[], double zi[])
+
+#else
+
+static int qrb3x3 (h, zr, zi)
+double h[], zr[], zi[];
+
+#endif
+
+/* Purpose ...
+   -------
+   Eigenvalues of the 3 by 3 matrix h (by rows, scaled so that its
+   largest element is near one) as the roots of the characteristic
+   polynomial, found in closed form and polished by qrbnewt().
+   A complex pair is returned with the positive imaginary part
+   first.  Returns 1 if some root is too sensitive to the rounding
+   errors in the coefficients, as for close or multiple eigenvalues,
+   and the QR method should be used instead; 0 otherwise.
+*/
+
+{
+int    k;
+double c2, c1, c0, q, r, s, t, c, sn, c23;
+
+/* p(z) = z^3 - c2 z^2 + c1 z - c0 */
+c2 = h[0] + h[4] + h[8];
+c1 = (h[0] * h[4] - h[1] * h[3]) + (h[0] * h[8] - h[2] * h[6])
+     + (h[4] * h[8] - h[5] * h[7]);
+c0 = h[0] * (h[4] * h[8] - h[5] * h[7]) - h[1] * (h[3] * h[8] - h[5] * h[6])
+     + h[2] * (h[3] * h[7] - h[4] * h[6]);
+
+/* z = t + c2/3 gives t^3 - 3 q t + 2 r = 0 */
+c23 = c2 / 3.0;
+q = (c2 * c2 - 3.0 * c1) / 9.0;
+r = (c2 * (9.0 * c1 - 2.0 * c2 * c2) - 27.0 * c0) / 54.0;
+if (r * r < q * q * q)
+   {  /* three real roots */
+   t = acos (r / (q * sqrt (q))) / 3.0;
+   s = -2.0 * sqrt (q);
+   c = cos (t);
+   sn = 0.8660254037844386 * sin (t);
+   /* cos(t +- 2 pi / 3) = -c/2 -+ sqrt(3)/2 sin(t) */
+   zr[0] = s * c + c23;
+   zr[1] = s * (-0.5 * c - sn) + c23;
+   zr[2] = s * (-0.5 * c + sn) + c23;
+   zi[0] = zi[1] = zi[2] = zero;
+   }
+else
+   {  /* one real root and a complex pair (or a multiple root) */
+   s = -SIGN (pow (fabs (r) + sqrt (r * r - q * q * q), one / 3.0), r);
+   t = (s != zero) ? q / s : zero;
+   zr[0] = s + t + c23;
+   zi[0] = zero;
+   zr[1] = c23 - 0.5 * (s + t);
+   zi[1] = 0.8660254037844386 * fabs (s - t);
+   zr[2] = zr[1];
+   zi[2] = -zi[1];
+   }
+
+for (k = 0; k < 2; ++k)
+   if (!(qrbnewt (c2, c1, c0, &zr[k], &zi[k]) <= QRB_KMAX)) return (1);
+if (zi[1] != zero)
+   {  /* the conjugate of the polished root */
+   zi[1] = fabs (zi[1]);
+   zr[2] = zr[1];
+   zi[2] = -zi[1];
+   }
+else if (!(qrbnewt (c2, c1, c0, &zr[2], &zi[2]) <= QRB_KMAX))
+   return (1);
+return (0);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static int qrblock (int nmat, int n, int mi[], int nl, double *a,
+                    double *wr, double *wi, int *ierr)
+
+#else
+
+static int qrblock (nmat, n, mi, nl, a, wr, wi, ierr)
+int    nmat, n, mi[], nl;
+double *a, *wr, *wi;
+int    *ierr;
+
+#endif
+
+/* Purpose ...
+   -------
+   Eigenvalues of matrices mi[0] ... mi[nl-1] of the batch (nl <=
+   QRB_LANES, n >= 3): Householder reduction to Hessenberg form and
+   the double-shift QR method, all lanes in step.  Each lane keeps
+   its own active block; a lane whose block is finished, or which
+   is outside it at some step, takes an identity reflection.
+   Each lane is scaled by a power of two near its largest element
+   on the way in, and its eigenvalues are scaled back on the way
+   out, so that the squares formed in the reflections neither
+   overflow nor underflow.
+   Returns the number of matrices that did not converge.
+*/
+
+{
+double hb[QRB_NMAX * QRB_NMAX * QRB_LANES];
+double tau[QRB_LANES], v2[QRB_LANES], v3[QRB_LANES];
+double x0[QRB_LANES], y0[QRB_LANES], w0[QRB_LANES];
+double ssum[QRB_LANES], sprod[QRB_LANES], anorm[QRB_LANES];
+int    ihi[QRB_LANES], Lm1[QRB_LANES], its[QRB_LANES], itn[QRB_LANES];
+int    iex[QRB_LANES];
+int    i, j, k, l, L, live, nbad, en, klo, khi, rlo, chi, ki;
+double x, y, w, s, beta, den, p, tst, ss, aa, h00, h01, h10, h11;
+double zl[QRB_LANES];
+double *r0, *r1, *r2, *pk, *px, *py, *pw;
+
+/* Copy in, scaled by 2^(-iex); unused lanes hold the zero matrix
+   and are marked done. */
+for (l = 0; l < QRB_LANES; ++l) anorm[l] = zero;
+for (i = 0; i < n * n; ++i)
+   for (l = 0; l < nl; ++l)
+      {
+      x = fabs (a[(long) i * nmat + mi[l]]);
+      if (x > anorm[l]) anorm[l] = x;
+      }
+for (l = 0; l < QRB_LANES; ++l)
+   {
+   iex[l] = 0;
+   if (anorm[l] > zero) frexp (anorm[l], &iex[l]);
+   }
+for (i = 0; i < n; ++i)
+   for (j = 0; j < n; ++j)
+      {
+      pk = HB(i,j);
+      for (l = 0; l < QRB_LANES; ++l)
+         pk[l] = (l < nl) ?
+                 ldexp (a[(long) (i * n + j) * nmat + mi[l]], -iex[l]) :
+                 zero;
+      }
+
+/* Householder reduction to upper Hessenberg form */
+for (k = 0; k < n - 2; ++k)
+   {
+   for (l = 0; l < QRB_LANES; ++l)
+      {
+      s = zero;
+      for (i = k + 2; i < n; ++i) s += HB(i,k)[l] * HB(i,k)[l];
+      x = HB(k+1,k)[l];
+      beta = -SIGN (sqrt (x * x + s), x);
+      den  = (s != zero) ? x - beta : one;
+      tau[l] = (s != zero) ? (beta - x) / beta : zero;
+      HB(k+1,k)[l] = (s != zero) ? beta : x;
+      w0[l] = one / den;
+      }
+   for (i = k + 2; i < n; ++i)
+      {
+      pk = HB(i,k);
+      for (l = 0; l < QRB_LANES; ++l) pk[l] *= w0[l];
+      }
+   /* From the left: rows k+1 ... n-1, columns k+1 ... n-1 */
+   for (j = k + 1; j < n; ++j)
+      {
+      for (l = 0; l < QRB_LANES; ++l) x0[l] = HB(k+1,j)[l];
+      for (i = k + 2; i < n; ++i)
+         for (l = 0; l < QRB_LANES; ++l) x0[l] += HB(i,k)[l] * HB(i,j)[l];
+      for (l = 0; l < QRB_LANES; ++l)
+         {
+         x0[l] *= tau[l];
+         HB(k+1,j)[l] -= x0[l];
+         }
+      for (i = k + 2; i < n; ++i)
+         for (l = 0; l < QRB_LANES; ++l) HB(i,j)[l] -= x0[l] * HB(i,k)[l];
+      }
+   /* From the right: all rows, columns k+1 ... n-1 */
+   for (i = 0; i < n; ++i)
+      {
+      for (l = 0; l < QRB_LANES; ++l) x0[l] = HB(i,k+1)[l];
+      for (j = k + 2; j < n; ++j)
+         for (l = 0; l < QRB_LANES; ++l) x0[l] += HB(i,j)[l] * HB(j,k)[l];
+      for (l = 0; l < QRB_LANES; ++l)
+         {
+         x0[l] *= tau[l];
+         HB(i,k+1)[l] -= x0[l];
+         }
+      for (j = k + 2; j < n; ++j)
+         for (l = 0; l < QRB_LANES; ++l) HB(i,j)[l] -= x0[l] * HB(j,k)[l];
+      }
+   for (i = k + 2; i < n; ++i)
+      {
+      pk = HB(i,k);
+      for (l = 0; l < QRB_LANES; ++l) pk[l] = zero;
+      }
+   }
+
+for (l = 0; l < QRB_LANES; ++l)
+   {
+   anorm[l] = zero;
+   ihi[l] = (l < nl) ? n - 1 : -1;
+   Lm1[l] = -1;
+   zl[l] = zero;
+   its[l] = 0;
+   itn[l] = QRB_ITS * n;
+   if (l < nl) ierr[mi[l]] = 0;
+   }
+for (i = 0; i < n; ++i)
+   for (j = (i > 0) ? i - 1 : 0; j < n; ++j)
+      {
+      pk = HB(i,j);
+      for (l = 0; l < QRB_LANES; ++l) anorm[l] += fabs (pk[l]);
+      }
+
+nbad = 0;
+for (;;)
+   {
+   /* Deflation, and the shifts for the lanes still active */
+   live = 0;
+   klo = n;
+   khi = -1;
+   for (l = 0; l < QRB_LANES; ++l)
+      {
+      while (ihi[l] >= 0)
+         {
+         en = ihi[l];
+         for (L = en; L > 0; --L)
+            {
+            tst = fabs (HB(L-1,L-1)[l]) + fabs (HB(L,L)[l]);
+            if (tst == zero) tst = anorm[l];
+            if (fabs (HB(L,L-1)[l]) <= EPSILON * tst)
+               {
+               HB(L,L-1)[l] = zero;
+               break;
+               }
+            }
+         if (L == en)
+            {
+            wr[(long) en * nmat + mi[l]] = HB(en,en)[l];
+            wi[(long) en * nmat + mi[l]] = zero;
+            ihi[l] = en - 1;
+            its[l] = 0;
+            }
+         else if (L == en - 1)
+            {
+            qrb2x2 (HB(en-1,en-1)[l], HB(en-1,en)[l], HB(en,en-1)[l],
+                    HB(en,en)[l],
+                    &wr[(long) (en-1) * nmat + mi[l]],
+                    &wi[(long) (en-1) * nmat + mi[l]],
+                    &wr[(long) en * nmat + mi[l]],
+                    &wi[(long) en * nmat + mi[l]]);
+            ihi[l] = en - 2;
+            its[l] = 0;
+            }
+         else
+            break;
+         }
+
+      if (ihi[l] < 0) continue;
+      en = ihi[l];
+      if (itn[l] == 0)
+         {
+         /* No convergence: eigenvalues en+1 ... n-1 are correct. */
+         ierr[mi[l]] = en + 1;
+         for (i = 0; i <= en; ++i)
+            {
+            wr[(long) i * nmat + mi[l]] = zero;
+            wi[(long) i * nmat + mi[l]] = zero;
+            }
+         ++nbad;
+         ihi[l] = -1;
+         continue;
+         }
+      ++live;
+      Lm1[l] = L - 1;
+      if (L - 1 < klo) klo = L - 1;
+      if (en > khi) khi = en;
+      ++its[l];
+      --itn[l];
+      if (its[l] % 10 == 0)
+         {
+         ss = fabs (HB(en,en-1)[l]) + fabs (HB(en-1,en-2)[l]);
+         aa = 0.75 * ss + HB(en,en)[l];
+         ssum[l]  = 2.0 * aa;
+         sprod[l] = aa * aa + 0.4375 * ss * ss;
+         }
+      else
+         {
+         ssum[l]  = HB(en-1,en-1)[l] + HB(en,en)[l];
+         sprod[l] = HB(en-1,en-1)[l] * HB(en,en)[l]
+                    - HB(en-1,en)[l] * HB(en,en-1)[l];
+         }
+      /* First column of (H - s1.I)(H - s2.I) for the block */
+      h00 = HB(L,L)[l];
+      h01 = HB(L,L+1)[l];
+      h10 = HB(L+1,L)[l];
+      h11 = HB(L+1,L+1)[l];
+      s = fabs (h00) + fabs (h10) + fabs (h11) + fabs (ssum[l]);
+      if (s == zero) s = one;
+      x0[l] = (h00 * (h00 / s) + h01 * (h10 / s)) - ssum[l] * (h00 / s)
+              + sprod[l] / s;
+      y0[l] = (h10 / s) * (h00 + h11 - ssum[l]);
+      w0[l] = (h10 / s) * HB(L+2,L+1)[l];
+      }
+   if (live == 0) break;
+
+   /* One double-shift sweep, all lanes in step.  At step k the
+      reflection acts on rows and columns k+1 ... k+3.  Only the
+      union of the active blocks, rows and columns klo+1 ... khi,
+      is transformed (the eigenvalues do not depend on the rest). */
+   rlo = klo + 1;
+   chi = khi;
+   for (k = klo; k <= khi - 2; ++k)
+      {
+      /* Column k below the diagonal, or the first column of the
+         shifted product where the bulge is introduced.  The loop
+         over the lanes has no branches, only selections. */
+      px = (k >= 0) ? HB(k+1,k) : x0;
+      py = (k >= 0) ? HB(k+2,k) : y0;
+      pw = (k >= 0 && k + 3 < n) ? HB(k+3,k) : zl;
+      for (l = 0; l < QRB_LANES; ++l)
+         {
+         x = (k == Lm1[l]) ? x0[l] : px[l];
+         y = (k == Lm1[l]) ? y0[l] : py[l];
+         w = (k == Lm1[l]) ? w0[l] : pw[l];
+         w = (k + 3 > ihi[l]) ? zero : w;
+         s = y * y + w * w;
+         s = (k < Lm1[l] || k > ihi[l] - 2) ? zero : s;
+         beta = -SIGN (sqrt (x * x + s), x);
+         den  = (s != zero) ? x - beta : one;
+         tau[l] = (s != zero) ? (beta - x) / beta : zero;
+         v2[l] = (s != zero) ? y / den : zero;
+         v3[l] = (s != zero) ? w / den : zero;
+         ki = (k > Lm1[l] && s != zero);
+         px[l] = ki ? beta : px[l];
+         py[l] = ki ? zero : py[l];
+         pw[l] = ki ? zero : pw[l];
+         }
+
+      /* From the left, rows k+1 ... k+3 */
+      for (j = k + 1; j <= chi; ++j)
+         {
+         r0 = HB(k+1,j);
+         r1 = HB(k+2,j);
+         if (k + 3 <= chi)
+            {
+            r2 = HB(k+3,j);
+            for (l = 0; l < QRB_LANES; ++l)
+               {
+               p = tau[l] * (r0[l] + v2[l] * r1[l] + v3[l] * r2[l]);
+               r0[l] -= p;
+               r1[l] -= p * v2[l];
+               r2[l] -= p * v3[l];
+               }
+            }
+         else
+            {
+            for (l = 0; l < QRB_LANES; ++l)
+               {
+               p = tau[l] * (r0[l] + v2[l] * r1[l]);
+               r0[l] -= p;
+               r1[l] -= p * v2[l];
+               }
+            }
+         }
+
+      /* From the right, columns k+1 ... k+3 */
+      for (i = rlo; i <= k + 4 && i <= chi; ++i)
+         {
+         r0 = HB(i,k+1);
+         r1 = HB(i,k+2);
+         if (k + 3 <= chi)
+            {
+            r2 = HB(i,k+3);
+            for (l = 0; l < QRB_LANES; ++l)
+               {
+               p = tau[l] * (r0[l] + v2[l] * r1[l] + v3[l] * r2[l]);
+               r0[l] -= p;
+               r1[l] -= p * v2[l];
+               r2[l] -= p * v3[l];
+               }
+            }
+         else
+            {
+            for (l = 0; l < QRB_LANES; ++l)
+               {
+               p = tau[l] * (r0[l] + v2[l] * r1[l]);
+               r0[l] -= p;
+               r1[l] -= p * v2[l];
+               }
+            }
+         }
+      }
+   }
+
+/* Undo the scaling. */
+for (l = 0; l < nl; ++l)
+   {
+   if (iex[l] == 0) continue;
+   for (i = 0; i < n; ++i)
+      {
+      wr[(long) i * nmat + mi[l]] = ldexp (wr[(long) i * nmat + mi[l]],
+                                            iex[l]);
+      wi[(long) i * nmat + mi[l]] = ldexp (wi[(long) i * nmat + mi[l]],
+                                            iex[l]);
+      }
+   }
+
+return (nbad);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int qrbatch (int nmat, int n, double a[], double wr[], double wi[],
+             int ierr[], int *flag)
+
+#else
+
+int qrbatch (nmat, n, a, wr, wi, ierr, flag)
+int    nmat, n;
+double a[], wr[], wi[];
+int    ierr[], *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Compute the eigenvalues of each of a batch of small real general
+   matrices, all of the same order.
+
+   Input ...
+   -----
+   nmat  : number of matrices in the batch
+   n     : order of the matrices, 1 <= n <= QRB_NMAX (16)
+   a     : the matrices, interleaved: element [i][j] of matrix m is
+           a[(i*n + j)*nmat + m], i, j = 0 ... n-1, m = 0 ... nmat-1.
+           a is not changed.
+
+   Output ...
+   ------
+   wr    : real parts of the eigenvalues, interleaved in the same
+           way: eigenvalue k of matrix m is wr[k*nmat + m] +
+           i wi[k*nmat + m].  There is no particular order but
+           conjugate pairs appear together with the value having
+           positive imaginary part first.
+   wi    : imaginary parts of the eigenvalues
+   ierr  : error flag for each matrix, ierr[0 ... nmat-1]
+           = 0, normal return
+           > 0, the iteration did not converge; eigenvalues
+                ierr, ierr+1, ... n-1 of that matrix are correct
+                and the others are set to zero (as for qr()).
+   flag  : status indicator
+           flag == 0, normal return
+           flag == 1, invalid user input (n or nmat out of range,
+                      or null pointers)
+           flag == 2, some matrices did not converge; see ierr.
+
+   Workspace ...
+   ---------
+   None; no memory is allocated.
+
+   Version ... 1.0, 19 October 2026
+   -------
+
+   Notes ...
+   -----
+   (1) Matrices of order 1 and 2 are done in closed form, scaled
+       by a power of two near their largest element.  So are those
+       of order 3: the roots of the characteristic cubic are found
+       by the trigonometric or Cardano formula and each is polished
+       by Newton's method.  A matrix with a root that is sensitive
+       to the rounding errors in the coefficients of the cubic, as
+       for close or multiple eigenvalues, is passed to the QR method
+       of Note (2) instead.
+   (2) Larger matrices are taken QRB_LANES at a time: Householder
+       reduction to Hessenberg form and the double-shift QR method
+       of hqr(), with every step done for all of the lanes in a
+       fixed-length inner loop over contiguous storage.  Lanes
+       that have finished take identity transformations until the
+       slowest lane of the group converges.  Each matrix is scaled
+       by a power of two near its largest element, so that the
+       results do not depend on its overall magnitude.
+   (3) Unlike qr(), the matrices are not balanced; matrices with
+       rows and columns of very different sizes should be
+       balanced beforehand or passed to qr().
+   (4) The groups of lanes are shared among threads when compiled
+       for OpenMP (PARALLEL in cmath.h).
+
+*/
+
+{  /* begin qrbatch() */
+
+int    k, m, m0, e, nl, nbad, mi[QRB_LANES];
+double t, h[9], zr[3], zi[3];
+
+*flag = 0;
+if (a == NULL || wr == NULL || wi == NULL || ierr == NULL ||
+    nmat < 1 || n < 1 || n > QRB_NMAX)
+   {
+   *flag = 1;
+   return (0);
+   }
+
+nbad = 0;
+if (n <= 2)
+   {
+   for (m = 0; m < nmat; ++m)
+      {
+      ierr[m] = 0;
+      if (n == 1)
+         {
+         wr[m] = a[m];
+         wi[m] = zero;
+         continue;
+         }
+      /* Scale by 2^(-e), e from the largest element. */
+      t = zero;
+      for (k = 0; k < 4; ++k)
+         if (fabs (a[k * nmat + m]) > t) t = fabs (a[k * nmat + m]);
+      e = 0;
+      if (t > zero) frexp (t, &e);
+      qrb2x2 (ldexp (a[m], -e), ldexp (a[nmat + m], -e),
+              ldexp (a[2 * nmat + m], -e), ldexp (a[3 * nmat + m], -e),
+              &wr[m], &wi[m], &wr[nmat + m], &wi[nmat + m]);
+      wr[m] = ldexp (wr[m], e);  wr[nmat + m] = ldexp (wr[nmat + m], e);
+      wi[m] = ldexp (wi[m], e);  wi[nmat + m] = ldexp (wi[nmat + m], e);
+      }
+   return (0);
+   }
+
+/* The matrices are taken QRB_LANES at a time.  Those of order 3 are
+   tried in closed form first; the rest of the group goes through
+   qrblock() together. */
+#if (PARALLEL)
+#pragma omp parallel for schedule(dynamic, 16) \
+        private(m, k, e, t, h, zr, zi, mi, nl) reduction(+:nbad)
+#endif
+for (m0 = 0; m0 < nmat; m0 += QRB_LANES)
+   {
+   nl = 0;
+   for (m = m0; m < nmat && m < m0 + QRB_LANES; ++m)
+      {
+      if (n == 3)
+         {
+         /* Scale by 2^(-e), e from the largest element.  The factors
+            2^(-e) and 2^e are normal numbers for the range of e
+            taken here, so the products are those of ldexp(). */
+         t = zero;
+         for (k = 0; k < 9; ++k)
+            if (fabs (a[(long) k * nmat + m]) > t)
+               t = fabs (a[(long) k * nmat + m]);
+         e = 0;
+         if (t > zero) frexp (t, &e);
+         t = ldexp (one, -e);
+         for (k = 0; k < 9; ++k) h[k] = a[(long) k * nmat + m] * t;
+         if (e > -1020 && e < 1020 && qrb3x3 (h, zr, zi) == 0)
+            {
+            ierr[m] = 0;
+            t = ldexp (one, e);
+            for (k = 0; k < 3; ++k)
+               {
+               wr[(long) k * nmat + m] = zr[k] * t;
+               wi[(long) k * nmat + m] = zi[k] * t;
+               }
+            continue;
+            }
+         }
+      mi[nl++] = m;
+      }
+   if (nl > 0) nbad += qrblock (nmat, n, mi, nl, a, wr, wi, ierr);
+   }
+
+if (nbad > 0) *flag = 2;
+return (0);
+}  /* end of qrbatch() */
@@ -0,0 +1,548 @@
+/* rkfens.c
+   Integrate an ensemble of ODE trajectories together using the
+   Fehlberg Fourth-Fifth Order Runge-Kutta Method.
+*/
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+#include "cmath.h"
+#if (STDLIBH)
+#include <stdlib.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+/*-----------------------------------------------------------------*/
+
+/* The trajectories are taken RKE_LANES at a time.  Within a group
+   each vector is held with the lanes contiguous, element k of lane
+   l at [k*ld + l] for a group of ld lanes, so that every stage of
+   the method is a loop over the lanes.  Lanes that reach TOUT (or fail) are
+   swapped out of the group and the rest of the group carries on
+   with fewer lanes.  When compiled for OpenMP (PARALLEL in cmath.h)
+   the groups are shared among threads.  */
+
+#define  RKE_LANES  64
+
+/* REMIN is the minimum acceptable value of RELERR, as in rkf45(). */
+
+#define  RKE_REMIN  1.0e-12
+
+#define  MIN(a,b)   (((a) < (b)) ? (a) : (b))
+#define  MAX(a,b)   (((a) > (b)) ? (a) : (b))
+#define  RSIGN(a,b)  (((b) > 0.0) ? fabs(a) : -fabs(a))
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void rkefehl (int (*F)(int n, int nlane, int ld, double t[],
+                              double y[], double yp[]),
+                     int NEQN, int nact, int ld,
+                     double T[], double H[], double tt[], double ch[],
+                     double Y[], double YP[], double F1[], double F2[],
+                     double F3[], double F4[], double F5[])
+
+#else
+
+static void rkefehl (F, NEQN, nact, ld, T, H, tt, ch,
+                     Y, YP, F1, F2, F3, F4, F5)
+
+int    (*F)();
+int    NEQN, nact, ld;
+double T[], H[], tt[], ch[];
+double Y[], YP[], F1[], F2[], F3[], F4[], F5[];
+
+#endif
+
+/* Purpose ...
+   -------
+   One Fehlberg step for lanes 0 .. nact-1, each with its own
+   T and H.  The formulas and their grouping are those of fehl45().
+   The fifth order solution is left in F1[] and the stage
+   derivatives in F2[] .. F5[].  tt[] and ch[] are scratch.
+*/
+
+{
+int    k, l;
+double *y, *yp, *f1, *f2, *f3, *f4, *f5;
+
+for (l = 0; l < nact; ++l)
+   { ch[l] = H[l] / 4.0;  tt[l] = T[l] + ch[l]; }
+for (k = 0; k < NEQN; ++k)
+   {
+   y = Y + k*ld;  yp = YP + k*ld;  f5 = F5 + k*ld;
+   for (l = 0; l < nact; ++l)  f5[l] = y[l] + ch[l] * yp[l];
+   }
+(*F) (NEQN, nact, ld, tt, F5, F1);
+
+for (l = 0; l < nact; ++l)
+   { ch[l] = 3.0 * H[l] / 32.0;  tt[l] = T[l] + 3.0*H[l]/8.0; }
+for (k = 0; k < NEQN; ++k)
+   {
+   y = Y + k*ld;  yp = YP + k*ld;  f1 = F1 + k*ld;  f5 = F5 + k*ld;
+   for (l = 0; l < nact; ++l)
+      f5[l] = y[l] + ch[l] * (yp[l] + 3.0*f1[l]);
+   }
+(*F) (NEQN, nact, ld, tt, F5, F2);
+
+for (l = 0; l < nact; ++l)
+   { ch[l] = H[l] / 2197.0;  tt[l] = T[l] + 12.0*H[l]/13.0; }
+for (k = 0; k < NEQN; ++k)
+   {
+   y = Y + k*ld;  yp = YP + k*ld;  f1 = F1 + k*ld;  f2 = F2 + k*ld;
+   f5 = F5 + k*ld;
+   for (l = 0; l < nact; ++l)
+      f5[l] = y[l] + ch[l] * (1932.0 * yp[l] + (7296.0 * f2[l] -
+                                                7200.0 * f1[l]));
+   }
+(*F) (NEQN, nact, ld, tt, F5, F3);
+
+for (l = 0; l < nact; ++l)
+   { ch[l] = H[l] / 4104.0;  tt[l] = T[l] + H[l]; }
+for (k = 0; k < NEQN; ++k)
+   {
+   y = Y + k*ld;  yp = YP + k*ld;  f1 = F1 + k*ld;  f2 = F2 + k*ld;
+   f3 = F3 + k*ld;  f5 = F5 + k*ld;
+   for (l = 0; l < nact; ++l)
+      f5[l] = y[l] + ch[l] * ((8341.0 * yp[l] - 845.0 * f3[l]) +
+              (29440.0 * f2[l] - 32832.0 * f1[l]));
+   }
+(*F) (NEQN, nact, ld, tt, F5, F4);
+
+for (l = 0; l < nact; ++l)
+   { ch[l] = H[l] / 20520.0;  tt[l] = T[l] + H[l]/2.0; }
+for (k = 0; k < NEQN; ++k)
+   {
+   y = Y + k*ld;  yp = YP + k*ld;  f1 = F1 + k*ld;  f2 = F2 + k*ld;
+   f3 = F3 + k*ld;  f4 = F4 + k*ld;
+   for (l = 0; l < nact; ++l)
+      f1[l] = y[l] + ch[l] * ((-6080.0 * yp[l] + (9295.0 * f3[l] -
+              5643.0 * f4[l])) + (41040.0 * f1[l] - 28352.0 * f2[l]));
+   }
+(*F) (NEQN, nact, ld, tt, F1, F5);
+
+/* --- Compute approximate solution at T+H. --- */
+
+for (l = 0; l < nact; ++l)  ch[l] = H[l] / 7618050.0;
+for (k = 0; k < NEQN; ++k)
+   {
+   y = Y + k*ld;  yp = YP + k*ld;  f1 = F1 + k*ld;  f2 = F2 + k*ld;
+   f3 = F3 + k*ld;  f4 = F4 + k*ld;  f5 = F5 + k*ld;
+   for (l = 0; l < nact; ++l)
+      f1[l] = y[l] + ch[l] * ((902880.0 * yp[l] + (3855735.0 * f3[l] -
+              1371249.0 * f4[l])) + (3953664.0 * f2[l] +
+              277020.0 * f5[l]));
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static int rkegroup (int (*F)(int n, int nlane, int ld, double t[],
+                              double y[], double yp[]),
+                     int NEQN, int ntraj, int m0, int nb,
+                     double Y[], double T[], double TOUT,
+                     double RELERR, double ABSERR, double H[],
+                     int NFE[], int MAXNFE, int IFLAG[])
+
+#else
+
+static int rkegroup (F, NEQN, ntraj, m0, nb, Y, T, TOUT,
+                     RELERR, ABSERR, H, NFE, MAXNFE, IFLAG)
+
+int    (*F)();
+int    NEQN, ntraj, m0, nb;
+double Y[], T[], TOUT, RELERR, ABSERR, H[];
+int    NFE[], MAXNFE, IFLAG[];
+
+#endif
+
+/* Purpose ...
+   -------
+   Integrate trajectories m0 .. m0+nb-1 to TOUT, as rkfens().
+   Returns the number of them that did not reach TOUT, or -1 if
+   the workspace could not be allocated.
+*/
+
+{
+int    k, l, m, nact, nok, nbad, nmax, ld;
+int    *idx, *nf, *hf, *out, *stat;
+double *w, *yb, *ypb, *f1, *f2, *f3, *f4, *f5;
+double *tl, *hl, *tt, *ch, *eeoet, *esttol, *hmin;
+double U26, SCALE, AE, DT, TOL, YPK, ET, EE, S, temp;
+
+ld = nb;
+w = (double *) malloc((7 * NEQN + 7) * ld * sizeof(double));
+idx = (int *) malloc(5 * ld * sizeof(int));
+if (w == NULL || idx == NULL)
+   {
+   if (w != NULL) free (w);
+   if (idx != NULL) free (idx);
+   return (-1);
+   }
+yb  = w;             ypb = yb + NEQN*ld;
+f1  = ypb + NEQN*ld; f2  = f1 + NEQN*ld;  f3 = f2 + NEQN*ld;
+f4  = f3 + NEQN*ld;  f5  = f4 + NEQN*ld;
+tl  = f5 + NEQN*ld;  hl  = tl + ld;       tt = hl + ld;
+ch  = tt + ld;       eeoet = ch + ld;     esttol = eeoet + ld;
+hmin = esttol + ld;
+nf  = idx + ld;      hf  = nf + ld;       out = hf + ld;
+stat = out + ld;
+
+U26   = 26.0 * EPSILON;
+SCALE = 2.0 / RELERR;
+AE    = SCALE * ABSERR;
+
+/* --- gather the group --- */
+for (k = 0; k < NEQN; ++k)
+   for (l = 0; l < nb; ++l)  yb[k*ld + l] = Y[k*ntraj + m0 + l];
+for (l = 0; l < nb; ++l)
+   {
+   idx[l] = m0 + l;
+   tl[l]  = T[m0 + l];
+   hl[l]  = H[m0 + l];
+   nf[l]  = 1;
+   hf[l]  = 0;
+   stat[l] = 0;
+   }
+nact = nb;
+
+/* --- initial derivatives and starting stepsizes --- */
+(*F) (NEQN, nact, ld, tl, yb, ypb);
+
+for (l = 0; l < nact; ++l)
+   {
+   DT = TOUT - tl[l];
+   ch[l] = fabs (DT);   /* estimate, if H[] was zero */
+   tt[l] = 0.0;         /* TOLN */
+   }
+for (k = 0; k < NEQN; ++k)
+   {
+   for (l = 0; l < nact; ++l)
+      {
+      TOL = RELERR * fabs(yb[k*ld + l]) + ABSERR;
+      if (TOL <= 0.0) continue;
+      tt[l] = TOL;
+      YPK = fabs (ypb[k*ld + l]);
+      if ((YPK * pow(ch[l],5.0)) > TOL) ch[l] = pow((TOL/YPK),0.2);
+      }
+   }
+for (l = 0; l < nact; ++l)
+   {
+   DT = TOUT - tl[l];
+   if (hl[l] == 0.0)
+      {
+      if (tt[l] <= 0.0) ch[l] = 0.0;
+      hl[l] = MAX(ch[l], U26 * MAX(fabs(tl[l]), fabs(DT)));
+      }
+   hl[l] = RSIGN(hl[l], DT);
+   if (fabs(DT) <= U26 * fabs(tl[l]))
+      {  /* too close to the output point, extrapolate */
+      for (k = 0; k < NEQN; ++k)  yb[k*ld + l] += DT * ypb[k*ld + l];
+      tl[l] = TOUT;
+      stat[l] = 2;
+      }
+   }
+
+/* --- step by step integration, all lanes together --- */
+for (;;)
+   {
+   /* retire the lanes that are finished, moving the last active
+      lane into each gap */
+   l = 0;
+   while (l < nact)
+      {
+      if (stat[l] == 0) { ++l; continue; }
+      m = idx[l];
+      for (k = 0; k < NEQN; ++k)  Y[k*ntraj + m] = yb[k*ld + l];
+      T[m] = tl[l];
+      H[m] = hl[l];
+      if (NFE != NULL) NFE[m] = nf[l];
+      IFLAG[m] = stat[l];
+      --nact;
+      if (l < nact)
+         {
+         for (k = 0; k < NEQN; ++k)
+            {
+            yb[k*ld + l]  = yb[k*ld + nact];
+            ypb[k*ld + l] = ypb[k*ld + nact];
+            }
+         idx[l] = idx[nact];  tl[l] = tl[nact];  hl[l] = hl[nact];
+         hmin[l] = hmin[nact];
+         nf[l]  = nf[nact];   hf[l] = hf[nact];  out[l] = out[nact];
+         stat[l] = stat[nact];
+         }
+      }
+   if (nact == 0) break;
+
+   /* start a new step unless the last attempt failed: set the
+      smallest allowable stepsize and adjust the stepsize to hit
+      the output point, looking two steps ahead */
+   for (l = 0; l < nact; ++l)
+      {
+      if (hf[l]) continue;
+      out[l] = 0;
+      hmin[l] = U26 * fabs(tl[l]);
+      DT = TOUT - tl[l];
+      if (fabs(DT) < 2.0*fabs(hl[l]))
+         {
+         if (fabs(DT) <= fabs(hl[l]))
+            {
+            out[l] = 1;
+            hl[l] = DT;
+            }
+         else  hl[l] = 0.5 * DT;
+         }
+      }
+
+   /* Test number of derivative function evaluations before every
+      attempt, as rkf45() does.  The lanes that have done too much
+      work are retired on the next pass; setting up the step again
+      for the others leaves it unchanged. */
+   nmax = 0;
+   for (l = 0; l < nact; ++l)
+      if (nf[l] > MAXNFE)  { stat[l] = 4;  ++nmax; }  /* too much work */
+   if (nmax > 0) continue;
+
+   /* Advance an approximate solution over one step for each lane */
+   rkefehl (F, NEQN, nact, ld, tl, hl, tt, ch,
+            yb, ypb, f1, f2, f3, f4, f5);
+
+   /* Compute and test allowable tolerances versus local error
+      estimates, as in rkf45() */
+   for (l = 0; l < nact; ++l)  { eeoet[l] = 0.0;  nf[l] += 5; }
+   for (k = 0; k < NEQN; ++k)
+      {
+      for (l = 0; l < nact; ++l)
+         {
+         ET = fabs(yb[k*ld + l]) + fabs(f1[k*ld + l]) + AE;
+         if (ET <= 0.0)
+            {   /* Inappropriate error tolerance */
+            stat[l] = 5;
+            continue;
+            }
+         EE = fabs((-2090.0 * ypb[k*ld + l] + (21970.0 * f3[k*ld + l] -
+                   15048.0 * f4[k*ld + l])) + (22528.0 * f2[k*ld + l] -
+                   27360.0 * f5[k*ld + l]));
+         temp = EE / ET;
+         eeoet[l] = MAX(eeoet[l], temp);
+         }
+      }
+
+   nok = 0;
+   for (l = 0; l < nact; ++l)
+      {
+      if (stat[l]) { tt[l] = 0.0; continue; }
+      esttol[l] = fabs(hl[l]) * eeoet[l] * SCALE / 752400.0;
+      if (esttol[l] > 1.0)
+         {  /* --- Unsuccessful step ---
+            reduce the stepsize , try again */
+         hf[l]  = 1;
+         out[l] = 0;
+         S = 0.1;
+         if (esttol[l] < 59049.0)  S = 0.9 / pow(esttol[l], 0.2);
+         hl[l] *= S;
+         if (fabs(hl[l]) <= hmin[l])  stat[l] = 6;
+         tt[l] = 0.0;
+         }
+      else
+         {  /* --- successful step --- */
+         tl[l] += hl[l];
+         tt[l] = 1.0;
+         ++nok;
+         }
+      }
+   if (nok == 0) continue;
+
+   /* store the solutions of the successful lanes and evaluate
+      the derivatives there */
+   for (k = 0; k < NEQN; ++k)
+      for (l = 0; l < nact; ++l)
+         yb[k*ld + l] = (tt[l] != 0.0) ? f1[k*ld + l] : yb[k*ld + l];
+   (*F) (NEQN, nact, ld, tl, yb, f2);
+   for (k = 0; k < NEQN; ++k)
+      for (l = 0; l < nact; ++l)
+         ypb[k*ld + l] = (tt[l] != 0.0) ? f2[k*ld + l] : ypb[k*ld + l];
+
+   /* --- Choose next stepsize. --- */
+   for (l = 0; l < nact; ++l)
+      {
+      if (tt[l] == 0.0) continue;
+      ++nf[l];
+      S = 5.0;
+      if (esttol[l] > 1.889568E-4)  S = 0.9 / pow(esttol[l], 0.2);
+      if (hf[l]) S = MIN(S, 1.0);
+      hl[l] = RSIGN(MAX(S * fabs(hl[l]), hmin[l]), hl[l]);
+      hf[l] = 0;
+      if (out[l])
+         {  /* Integration successfully completed over the interval */
+         tl[l] = TOUT;
+         stat[l] = 2;
+         }
+      }
+   }
+
+/* --- count the failures --- */
+nbad = 0;
+for (l = 0; l < nb; ++l)  if (IFLAG[m0 + l] != 2) ++nbad;
+
+free (idx);
+free (w);
+return (nbad);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int rkfens (int (*F)(int n, int nlane, int ld, double t[],
+                     double y[], double yp[]),
+            int NEQN, int ntraj,
+            double Y[], double T[], double TOUT,
+            double RELERR, double ABSERR, double H[],
+            int NFE[], int MAXNFE, int IFLAG[])
+
+#else
+
+int rkfens (F, NEQN, ntraj, Y, T, TOUT, RELERR, ABSERR, H,
+            NFE, MAXNFE, IFLAG)
+
+int    (*F)();
+int    NEQN, ntraj;
+double Y[], T[], TOUT, RELERR, ABSERR, H[];
+int    NFE[], MAXNFE, IFLAG[];
+
+#endif
+
+/* Purpose ...
+   -------
+   Integrate the same system of NEQN first order ordinary
+   differential equations
+         dy[i]/dt = f(t,y[0],y[1],...,y[neqn-1])
+   from each of ntraj starting points (an ensemble of trajectories)
+   to the common output point TOUT, using the Fehlberg (4,5) method
+   with the error control of rkf45().  The trajectories are
+   advanced together, many at a time, and each has its own step
+   size.
+
+   Input ...
+   -----
+   (*F)()  : User supplied function
+             int F (n, nlane, ld, t, y, yp)
+             int    n, nlane, ld;
+             double t[], y[], yp[];
+             to evaluate the derivatives of nlane trajectories at
+             once: yp[k*ld + l] = dy[k]/dt for the trajectory with
+             value y[k*ld + l] at t[l], k = 0 .. n-1,
+             l = 0 .. nlane-1.  The lanes do not correspond to fixed
+             trajectories; F must depend only on t and y.
+   NEQN    : number of equations in each trajectory
+   ntraj   : number of trajectories
+   Y[]     : starting values, interleaved: element k of trajectory
+             m is Y[k*ntraj + m]
+   T[]     : T[m] is the starting value of the independent variable
+             for trajectory m
+   TOUT    : output point at which the solutions are desired
+   RELERR,
+   ABSERR  : relative and absolute error tolerances for the local
+             error test, as in rkf45().  RELERR is raised to the
+             smallest value rkf45() allows if it is less.
+   H[]     : H[m] is the first step size to be tried for trajectory
+             m, or 0.0 to have it estimated as in rkf45().
+   MAXNFE  : Maximum number of function evaluations allowed for
+             each trajectory.
+
+   Output ...
+   ------
+   Y[]     : the solutions at T[]
+   T[]     : the value of the independent variable reached; TOUT
+             if IFLAG[m] = 2
+   H[]     : the step size to try next, for continuing
+   NFE[]   : NFE[m] is the number of derivative evaluations used for
+             trajectory m.  May be NULL.
+   IFLAG[] : IFLAG[m] indicates the status of trajectory m, with
+             the values of rkf45()
+             = 2 : Integration reached TOUT.
+             = 4 : more than MAXNFE derivative evaluations were
+                   needed.
+             = 5 : the solution vanished making a pure relative
+                   error test impossible.  Use a nonzero ABSERR.
+             = 6 : the requested accuracy could not be achieved
+                   with the smallest allowable step size.
+   returns   0 if all trajectories reached TOUT,
+             the number that did not otherwise,
+             -1 for invalid input (NEQN < 1, ntraj < 1, RELERR or
+                ABSERR < 0.0, or null pointers),
+             -2 if the workspace could not be allocated.
+
+   Workspace ...
+   ---------
+   (7 * NEQN + 7) * RKE_LANES doubles and 5 * RKE_LANES ints are
+   allocated for each group of trajectories.
+
+   Version ... 1.0, 19 October 2026
+   -------
+
+   Notes ...
+   -----
+   (1) The trajectories are taken RKE_LANES (64) at a time.  Each
+       stage of the method is done for all lanes of a group in an
+       inner loop over contiguous storage, which the compiler may
+       vectorize, with a single call of F for the group.
+   (2) Every lane has its own step size.  A lane whose step fails
+       takes the smaller step on the next pass while the others
+       go on.  Lanes that finish are dropped from the group, so
+       F is called with nlane decreasing as the group finishes.
+   (3) For a single trajectory the steps taken are those of rkf45()
+       started with IFLAG = 1.  There is no one-step mode and no
+       check on the number of output points.
+   (4) The groups are shared among threads when compiled for
+       OpenMP (PARALLEL in cmath.h); F must then be safe to call
+       from several threads at once.
+*/
+
+{  /* --- start of function rkfens() --- */
+
+int    m0, nb, nbad, r, fail;
+double RER;
+
+if (F == NULL || Y == NULL || T == NULL || H == NULL || IFLAG == NULL)
+   return (-1);
+if (NEQN < 1 || ntraj < 1) return (-1);
+if (RELERR < 0.0 || ABSERR < 0.0) return (-1);
+
+/* Restrict relative error tolerance to be at least as large as
+   2*EPSILON+REMIN, as in rkf45() */
+RER = 2.0 * EPSILON + RKE_REMIN;
+if (RELERR < RER)  RELERR = RER;
+
+nbad = 0;
+fail = 0;
+#if (PARALLEL)
+#pragma omp parallel for schedule(dynamic) private(nb, r) \
+        reduction(+:nbad, fail) if (ntraj > RKE_LANES)
+#endif
+for (m0 = 0; m0 < ntraj; m0 += RKE_LANES)
+   {
+   nb = (m0 + RKE_LANES < ntraj) ? RKE_LANES : ntraj - m0;
+   r = rkegroup (F, NEQN, ntraj, m0, nb, Y, T, TOUT,
+                 RELERR, ABSERR, H, NFE, MAXNFE, IFLAG);
+   if (r < 0) ++fail;
+   else nbad += r;
+   }
+
+if (fail) return (-2);
+return (nbad);
+}  /* --- end of function rkfens() --- */
+
+/*-----------------------------------------------------------------*/
@@ -0,0 +1,463 @@
+/* rsvd.c
+   Truncated singular value decomposition by random projection.
+*/
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+
+#include "cmath.h"
+#if (STDLIBH)
+#include <stdlib.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+#define  MIN(a,b)  (((a) < (b)) ? (a) : (b))
+
+/* Products with a take RSVD_NB of its columns at a time.  When
+   compiled for OpenMP (PARALLEL in cmath.h) the rows, or the blocks
+   of columns, are shared among threads if the product involves
+   more than RSVD_PMIN elements of a.  */
+#define  RSVD_NB    64
+#define  RSVD_PMIN  32768L
+
+/* Seed of the test matrix, so that the results are repeatable.  */
+#define  RSVD_SEED  12345UL
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static double rsrand (unsigned long i)
+
+#else
+
+static double rsrand (i)
+unsigned long i;
+
+#endif
+
+/* Purpose ...
+   -------
+   Element i of the random test matrix, uniform on (-1, 1).
+   The value depends on i only (an integer hash of i and the
+   seed), so the matrix may be filled in any order.
+*/
+
+{
+unsigned long h;
+
+h = (i * 2654435761UL + RSVD_SEED) & 0xffffffffUL;
+h ^= h >> 16;
+h = (h * 0x45d9f3bUL) & 0xffffffffUL;
+h ^= h >> 16;
+h = (h * 0x45d9f3bUL) & 0xffffffffUL;
+h ^= h >> 16;
+return ((double) h / 2147483648.0 - 1.0);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void rsmul (int nm, int m, int n, double a[],
+                   int l, double x[], double y[])
+
+#else
+
+static void rsmul (nm, m, n, a, l, x, y)
+int    nm, m, n;
+double a[];
+int    l;
+double x[], y[];
+
+#endif
+
+/* Purpose ...
+   -------
+   y = a.x, with x n by l and y m by l, both stored by rows.
+*/
+
+{
+int    i, j, c;
+double t, *ai, *yi, *xj;
+
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(j, c, t, ai, yi, xj) \
+        if ((long) m * n > RSVD_PMIN)
+#endif
+for (i = 0; i < m; ++i)
+   {
+   ai = a + (long) i * nm;
+   yi = y + (long) i * l;
+   for (c = 0; c < l; ++c) yi[c] = 0.0;
+   for (j = 0; j < n; ++j)
+      {
+      t  = ai[j];
+      xj = x + (long) j * l;
+      for (c = 0; c < l; ++c) yi[c] += t * xj[c];
+      }
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void rsmult (int nm, int m, int n, double a[],
+                    int l, double y[], double z[])
+
+#else
+
+static void rsmult (nm, m, n, a, l, y, z)
+int    nm, m, n;
+double a[];
+int    l;
+double y[], z[];
+
+#endif
+
+/* Purpose ...
+   -------
+   z = a(T).y, with y m by l and z n by l, both stored by rows.
+   a is read by rows, RSVD_NB columns at a time.
+*/
+
+{
+int    jb, je, i, j, c;
+double t, *ai, *yi, *zj;
+
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(je, i, j, c, t, ai, yi, zj) \
+        if ((long) m * n > RSVD_PMIN)
+#endif
+for (jb = 0; jb < n; jb += RSVD_NB)
+   {
+   je = MIN(jb + RSVD_NB, n);
+   for (j = jb; j < je; ++j)
+      for (c = 0; c < l; ++c) z[(long) j * l + c] = 0.0;
+   for (i = 0; i < m; ++i)
+      {
+      ai = a + (long) i * nm;
+      yi = y + (long) i * l;
+      for (j = jb; j < je; ++j)
+         {
+         t  = ai[j];
+         zj = z + (long) j * l;
+         for (c = 0; c < l; ++c) zj[c] += t * yi[c];
+         }
+      }
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void rscholqr (int m, int l, double y[], double g[], int shift)
+
+#else
+
+static void rscholqr (m, l, y, g, shift)
+int    m, l;
+double y[], g[];
+int    shift;
+
+#endif
+
+/* Purpose ...
+   -------
+   One step of Cholesky QR on the m by l matrix y (stored by rows):
+   g = y(T).y = R(T).R, then y = y.inv(R).  If shift is nonzero,
+   a multiple of the trace is added to the diagonal of g first so
+   that the factorization cannot fail.  A column that is dependent
+   on those before it is set to zero.  g is l by l workspace.
+*/
+
+{
+int    i, c, d, e;
+double s, t, *yi;
+
+#if (PARALLEL)
+#pragma omp parallel for schedule(dynamic) private(c, i, t, yi) \
+        if ((long) m * l > RSVD_PMIN)
+#endif
+for (d = 0; d < l; ++d)
+   {
+   for (c = d; c < l; ++c) g[d * l + c] = 0.0;
+   for (i = 0; i < m; ++i)
+      {
+      yi = y + (long) i * l;
+      t  = yi[d];
+      for (c = d; c < l; ++c) g[d * l + c] += t * yi[c];
+      }
+   }
+
+if (shift)
+   {
+   t = 0.0;
+   for (c = 0; c < l; ++c) t += g[c * l + c];
+   t *= 11.0 * ((double) m * l + (double) l * (l + 1)) * EPSILON;
+   for (c = 0; c < l; ++c) g[c * l + c] += t;
+   }
+
+/* Upper triangular R in place of g; a zero diagonal marks a
+   dependent column. */
+for (c = 0; c < l; ++c)
+   {
+   for (d = 0; d < c; ++d)
+      {
+      if (g[d * l + d] == 0.0)
+         {
+         g[d * l + c] = 0.0;
+         continue;
+         }
+      s = g[d * l + c];
+      for (e = 0; e < d; ++e) s -= g[e * l + d] * g[e * l + c];
+      g[d * l + c] = s / g[d * l + d];
+      }
+   t = g[c * l + c];
+   s = t;
+   for (e = 0; e < c; ++e) s -= g[e * l + c] * g[e * l + c];
+   g[c * l + c] = (s > 10.0 * EPSILON * t) ? sqrt(s) : 0.0;
+   }
+
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(c, d, s, yi) \
+        if ((long) m * l > RSVD_PMIN)
+#endif
+for (i = 0; i < m; ++i)
+   {
+   yi = y + (long) i * l;
+   for (c = 0; c < l; ++c)
+      {
+      if (g[c * l + c] == 0.0)
+         {
+         yi[c] = 0.0;
+         continue;
+         }
+      s = yi[c];
+      for (d = 0; d < c; ++d) s -= yi[d] * g[d * l + c];
+      yi[c] = s / g[c * l + c];
+      }
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void rsorth (int m, int l, double y[], double g[])
+
+#else
+
+static void rsorth (m, l, y, g)
+int    m, l;
+double y[], g[];
+
+#endif
+
+/* Purpose ...
+   -------
+   Orthonormalize the columns of y by shifted Cholesky QR followed
+   by two plain steps (CholeskyQR3 of Fukaya et al., SIAM J. Sci.
+   Comput. 42 (2020) A477-A503).  Each step reads y by rows twice.
+*/
+
+{
+rscholqr (m, l, y, g, 1);
+rscholqr (m, l, y, g, 0);
+rscholqr (m, l, y, g, 0);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int rsvd (int nm, int m, int n, double a[],
+          int k, int p, int q, double w[],
+          int matu, double u[], int matv, double v[],
+          int *ierr)
+
+#else
+
+int rsvd (nm, m, n, a, k, p, q, w, matu, u, matv, v, ierr)
+int    nm, m, n;
+double a[];
+int    k, p, q;
+double w[];
+int    matu;
+double u[];
+int    matv;
+double v[];
+int    *ierr;
+
+#endif
+
+/* Purpose ...
+   -------
+   Find the k largest singular values of the real m by n matrix a,
+   and optionally the corresponding singular vectors,
+                     T
+       a  ~=  u.s.v
+   by the randomized range finder of Halko, Martinsson and Tropp.
+
+   Input ...
+   -----
+   nm    : the size of the rows of a as declared in the calling
+           program, nm >= n
+   m     : the number of rows of a
+   n     : the number of columns of a
+   a     : the matrix, a[i*nm + j] i = 0 ... m-1, j = 0 ... n-1
+   k     : the number of singular values wanted, 1 <= k <= min(m,n)
+   p     : oversampling, the number of extra columns in the
+           sketch, p >= 0.  p = 5 or 10 is usual.
+   q     : the number of power iterations, q >= 0.  q = 1 or 2
+           sharpens the result when the singular values decay slowly.
+   matu  : 1 if the left singular vectors are wanted, 0 otherwise
+   matv  : 1 if the right singular vectors are wanted, 0 otherwise
+
+   Output ...
+   ------
+   w     : the k largest singular values, in decreasing order,
+           w[j], j = 0 ... k-1
+   u     : if matu == 1, the m by k matrix of left singular vectors,
+           u[i*k + j] i = 0 ... m-1, j = 0 ... k-1.
+           Not referenced if matu == 0.
+   v     : if matv == 1, the n by k matrix of right singular vectors,
+           v[i*k + j] i = 0 ... n-1, j = 0 ... k-1.
+           Not referenced if matv == 0.
+   ierr  : status flag
+           ierr =  0, normal return
+           ierr >  0, svd() failed on the small matrix with this ierr
+           ierr = -1, could not allocate memory for workspace
+           ierr = -2, invalid user input.
+
+   Workspace ...
+   ---------
+   With l = min(k+p, m, n) (but at least 2), (m + n + 2l) * l
+   doubles and l integers are allocated.  a is not copied.
+
+   Version ... 1.0, 19 October 2026
+   -------
+
+   Notes ...
+   -----
+   (1) The sketch y = a.x of a with a random n by l matrix x is
+       orthonormalized, y = Q.  After q power iterations,
+       Q = orth(a.orth(a(T).Q)), the small matrix b(T) = a(T).Q
+       (n by l) is decomposed by svd(), b(T) = Ub.S.Vb(T).  Then
+       a ~= Q.b = (Q.Vb).S.Ub(T).
+   (2) Each product with a or a(T) reads a once, by rows; there are
+       2q + 2 of them.  The products are shared among threads when
+       compiled for OpenMP.
+   (3) The test matrix has entries uniform on (-1,1) from a hash of
+       the element index, so results are repeatable and do not
+       depend on the number of threads.
+   (4) Reference:
+       N. Halko, P.G. Martinsson and J.A. Tropp, Finding structure
+       with randomness: probabilistic algorithms for constructing
+       approximate matrix decompositions.  SIAM Review 53 (2011)
+       217-288.
+*/
+
+{  /* begin function rsvd() */
+
+int    i, j, c, d, l, it, *indx;
+double *y, *z, *vb, *g, *sig, s;
+
+*ierr = 0;
+y = z = vb = g = (double *) NULL;
+indx = (int *) NULL;
+
+if (m <= 1 || n <= 1 || nm < n || a == NULL || w == NULL ||
+    k < 1 || k > MIN(m, n) || p < 0 || q < 0 ||
+    (matu && u == NULL) || (matv && v == NULL))
+   {
+   /* illegal user input */
+   *ierr = -2;
+   goto LeaveRsvd;
+   }
+
+l = MIN(k + p, MIN(m, n));
+if (l < 2) l = 2;
+
+y    = (double *) malloc ((long) m * l * sizeof(double));
+z    = (double *) malloc ((long) n * l * sizeof(double));
+vb   = (double *) malloc ((long) l * l * sizeof(double));
+g    = (double *) malloc ((long) l * l * sizeof(double));
+sig  = g;   /* g is not needed once the range is found */
+indx = (int *) malloc (l * sizeof(int));
+if (y == NULL || z == NULL || vb == NULL || g == NULL || indx == NULL)
+   {
+   *ierr = -1;
+   goto LeaveRsvd;
+   }
+
+/* Range finder. */
+for (j = 0; j < n; ++j)
+   for (c = 0; c < l; ++c)
+      z[(long) j * l + c] = rsrand ((unsigned long) j * l + c);
+rsmul (nm, m, n, a, l, z, y);
+rsorth (m, l, y, g);
+for (it = 0; it < q; ++it)
+   {
+   rsmult (nm, m, n, a, l, y, z);
+   rsorth (n, l, z, g);
+   rsmul (nm, m, n, a, l, z, y);
+   rsorth (m, l, y, g);
+   }
+
+/* b(T) = a(T).Q, n by l, and its decomposition; Ub overwrites it. */
+rsmult (nm, m, n, a, l, y, z);
+svd (l, n, l, z, sig, matv, z, matu, vb, ierr);
+if (*ierr != 0) goto LeaveRsvd;
+
+/* The k largest, in decreasing order. */
+indexx (l, sig, indx);
+for (j = 0; j < k; ++j) w[j] = sig[indx[l - 1 - j]];
+
+if (matv)
+   {
+   for (i = 0; i < n; ++i)
+      for (j = 0; j < k; ++j)
+         v[(long) i * k + j] = z[(long) i * l + indx[l - 1 - j]];
+   }
+
+if (matu)
+   {
+   /* u = Q.Vb, a row at a time. */
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(j, d, c, s) \
+        if ((long) m * l > RSVD_PMIN)
+#endif
+   for (i = 0; i < m; ++i)
+      {
+      for (j = 0; j < k; ++j)
+         {
+         c = indx[l - 1 - j];
+         s = 0.0;
+         for (d = 0; d < l; ++d) s += y[(long) i * l + d] * vb[d * l + c];
+         u[(long) i * k + j] = s;
+         }
+      }
+   }
+
+LeaveRsvd:
+if (indx != NULL) free (indx);
+if (g  != NULL) free (g);
+if (vb != NULL) free (vb);
+if (z  != NULL) free (z);
+if (y  != NULL) free (y);
+return (0);
+}  /* end of rsvd() */
+
+/*-----------------------------------------------------------------*/
@@ -0,0 +1,482 @@
+/* sdecomp.c
+   Matrix decomposition by Gaussian elimination, in single
+   precision. */
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+#include "cmath.h"
+#if (STDLIBH)
+#include <stdlib.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+
+/*-----------------------------------------------------------------*/
+
+/* This is decomp() and solve() for matrices of float elements, for
+   use where single precision is sufficient or, as in mpsolve(), as
+   the cheap first stage of a double precision solution.  The
+   elimination is that of decomp.c line for line; see there for
+   the blocking parameters.  The update tile is twice as wide since
+   twice as many floats fit in a vector register.  */
+
+#define  SDECOMP_NB   96
+#define  SDECOMP_JB   384
+#define  SDECOMP_MR   4
+#define  SDECOMP_NR   24
+#define  SDECOMP_PMIN 65536L
+
+#define  AINDEX(i,j) ((i) * ndim + (j))
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void sdcupdate (int ndim, float *a, int i1, int i2,
+                      int j1, int j2, int k1, int k2)
+
+#else
+
+static void sdcupdate (ndim, a, i1, i2, j1, j2, k1, k2)
+
+int    ndim;
+float *a;
+int    i1, i2, j1, j2, k1, k2;
+
+#endif
+
+/* Purpose ...
+   -------
+   Rank-(k2-k1) update of the block a[i1..i2-1][j1..j2-1]
+   a[i][j] -= sum over k1 <= k < k2 of a[i][k] * a[k][j]
+*/
+
+{
+int    i, j, jj, jb, k, r, c;
+float c0[SDECOMP_NR], c1[SDECOMP_NR], c2[SDECOMP_NR], c3[SDECOMP_NR];
+float l, l0, l1, l2, l3, *pb, *pc, *p0, *p1, *p2, *p3;
+
+for (jj = j1; jj < j2; jj += SDECOMP_JB)
+   {
+   jb = (jj + SDECOMP_JB < j2) ? jj + SDECOMP_JB : j2;
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) \
+        private(j, k, r, c, c0, c1, c2, c3, l, l0, l1, l2, l3, \
+                pb, pc, p0, p1, p2, p3) \
+        if ((long) (i2 - i1) * (jb - jj) * (k2 - k1) > SDECOMP_PMIN)
+#endif
+   for (i = i1; i < i2; i += SDECOMP_MR)
+      {
+      if (i + SDECOMP_MR > i2)
+         {  /* odd rows left over */
+         for (r = i; r < i2; ++r)
+            {
+            pc = a + r * ndim;
+            for (k = k1; k < k2; ++k)
+               {
+               l  = pc[k];
+               pb = a + k * ndim;
+               for (j = jj; j < jb; ++j) pc[j] -= l * pb[j];
+               }
+            }
+         continue;
+         }
+      for (j = jj; j + SDECOMP_NR <= jb; j += SDECOMP_NR)
+         {  /* the register tile */
+         for (c = 0; c < SDECOMP_NR; ++c)
+            {
+            c0[c] = 0.0f; c1[c] = 0.0f; c2[c] = 0.0f; c3[c] = 0.0f;
+            }
+         p0 = a + i * ndim;
+         p1 = p0 + ndim;
+         p2 = p1 + ndim;
+         p3 = p2 + ndim;
+         for (k = k1; k < k2; ++k)
+            {
+            pb = a + k * ndim + j;
+            l0 = p0[k]; l1 = p1[k]; l2 = p2[k]; l3 = p3[k];
+            for (c = 0; c < SDECOMP_NR; ++c)
+               {
+               c0[c] += l0 * pb[c];
+               c1[c] += l1 * pb[c];
+               c2[c] += l2 * pb[c];
+               c3[c] += l3 * pb[c];
+               }
+            }
+         for (c = 0; c < SDECOMP_NR; ++c)
+            {
+            p0[j+c] -= c0[c]; p1[j+c] -= c1[c];
+            p2[j+c] -= c2[c]; p3[j+c] -= c3[c];
+            }
+         }
+      if (j < jb)
+         {  /* odd columns left over */
+         for (r = i; r < i + SDECOMP_MR; ++r)
+            {
+            pc = a + r * ndim;
+            for (k = k1; k < k2; ++k)
+               {
+               l  = pc[k];
+               pb = a + k * ndim;
+               for (c = j; c < jb; ++c) pc[c] -= l * pb[c];
+               }
+            }
+         }
+      }
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void sdcforsy (int n, int ndim, float *a, int pivot[],
+                     int nswap, int ncol)
+
+#else
+
+static void sdcforsy (n, ndim, a, pivot, nswap, ncol)
+
+int    n, ndim;
+float *a;
+int    pivot[], nswap, ncol;
+
+#endif
+
+/* Purpose ...
+   -------
+   Convert the multipliers left by the blocked elimination (rows
+   fully interchanged, positive sign) to the form used by solve().
+   The interchanges pivot[k], k < nswap, are undone in columns 0..k-1
+   and the multipliers in columns 0..ncol-1 are negated.
+*/
+
+{
+int    i, j, k, m, jmax;
+float t, *pa, *pb;
+
+for (k = nswap-1; k > 0; --k)
+   {
+   m = pivot[k];
+   if (m == k) continue;
+   pa = a + m * ndim;
+   pb = a + k * ndim;
+   for (j = 0; j < k; ++j) { t = pa[j]; pa[j] = pb[j]; pb[j] = t; }
+   }
+for (i = 1; i < n; ++i)
+   {
+   pa   = a + i * ndim;
+   jmax = (i < ncol) ? i : ncol;
+   for (j = 0; j < jmax; ++j) pa[j] = -pa[j];
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static int sdcelim (int n, int ndim, float *a, int pivot[],
+                   float *anorm)
+
+#else
+
+static int sdcelim (n, ndim, a, pivot, anorm)
+
+int    n, ndim;
+float *a;
+int    pivot[];
+float *anorm;
+
+#endif
+
+/* Purpose ...
+   -------
+   The elimination for sdecomp(), n >= 2.
+   Returns 0 with the factors and pivots in a and pivot[],
+   and the 1-norm of the original matrix in anorm.  Returns 3,
+   with the elimination abandoned, if a pivot smaller than
+   anorm * FEPSILON is met.
+*/
+
+{
+float t, pvt, csum[SDECOMP_NR];
+int    i, j, k, m, kb, ke, jj, jb, nswap;
+float *pa, *pb;
+
+nswap = 0;
+pivot[n-1] = 1;
+
+/* --- compute 1-norm of a, a row at a time for a strip
+   of columns --- */
+
+*anorm = 0.0f;
+for (jj = 0; jj < n; jj += SDECOMP_NR)
+   {
+   jb = (jj + SDECOMP_NR < n) ? jj + SDECOMP_NR : n;
+   for (j = jj; j < jb; ++j) csum[j-jj] = 0.0f;
+   for (i = 0; i < n; ++i)
+      {
+      pa = a+AINDEX(i,0);
+      for (j = jj; j < jb; ++j) csum[j-jj] += (float) fabs(pa[j]);
+      }
+   for (j = jj; j < jb; ++j) if (csum[j-jj] > *anorm) *anorm = csum[j-jj];
+   }
+
+/* Apply Gaussian elimination with partial pivoting,
+   SDECOMP_NB columns at a time. */
+
+for (kb = 0; kb < n; kb += SDECOMP_NB)
+   {
+   ke = (kb + SDECOMP_NB < n) ? kb + SDECOMP_NB : n;
+
+   /* Factor the panel of columns kb .. ke-1. */
+   for (k = kb; k < ke; ++k)
+      {
+      if (k < n-1)
+         {
+         /* Find pivot and label as row m.
+            This will be the element with largest magnitude in
+            the lower part of the kth column. */
+         m = k;
+         pvt = (float) fabs(a[AINDEX(m,k)]);
+         for (i = k+1; i < n; ++i)
+            {
+            t = (float) fabs(a[AINDEX(i,k)]);
+            if ( t > pvt )  { m = i; pvt = t; }
+            }
+         pivot[k] = m;
+         nswap = k + 1;
+
+         if (m != k)
+            {
+            pivot[n-1] = -pivot[n-1];
+            /* Interchange whole rows m and k. */
+            pa = a+AINDEX(m,0); pb = a+AINDEX(k,0);
+            for (j = 0; j < n; ++j)
+               {
+               t = pa[j]; pa[j] = pb[j]; pb[j] = t;
+               }
+            }
+         }
+      /* row k is now the pivot row */
+      pvt = a[AINDEX(k,k)];
+
+      /* Bail out if pivot is too small */
+      if ((float) fabs(pvt) < *anorm * FEPSILON)
+         {
+         /* Singular or nearly singular; leave the rest of
+            pivot[] harmless */
+         sdcforsy (n, ndim, a, pivot, nswap, k);
+         for (i = nswap; i < n-1; ++i) pivot[i] = i;
+         return (3);
+         }
+
+      /* compute the multipliers in the k sub-column
+         and eliminate within the panel */
+      pb = a+AINDEX(k,0);
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(pa, t, j) \
+        if ((long) (n - k) * (ke - k) > SDECOMP_PMIN)
+#endif
+      for (i = k+1; i < n; ++i)
+         {
+         pa = a+AINDEX(i,0);
+         t = pa[k] / pvt;
+         pa[k] = t;
+         for (j = k+1; j < ke; ++j) pa[j] -= t * pb[j];
+         }
+      }
+
+   if (ke < n)
+      {
+      /* Rows of U to the right of the panel,
+         independently for each strip of columns. */
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(jb, i, k, j, t, pa, pb) \
+        if ((long) (ke - kb) * (ke - kb) * (n - ke) > 2 * SDECOMP_PMIN)
+#endif
+      for (jj = ke; jj < n; jj += SDECOMP_JB)
+         {
+         jb = (jj + SDECOMP_JB < n) ? jj + SDECOMP_JB : n;
+         for (i = kb+1; i < ke; ++i)
+            {
+            pa = a+AINDEX(i,0);
+            for (k = kb; k < i; ++k)
+               {
+               t = pa[k];
+               pb = a+AINDEX(k,0);
+               for (j = jj; j < jb; ++j) pa[j] -= t * pb[j];
+               }
+            }
+         }
+
+      /* Update the trailing matrix. */
+      sdcupdate (ndim, a, ke, n, ke, n, kb, ke);
+      }
+
+   }  /* End of Gaussian elimination. */
+
+/* Undo the later interchanges in the columns of multipliers and
+   change their sign, for solve(). */
+sdcforsy (n, ndim, a, pivot, n-1, n-1);
+return (0);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int sdecomp (int n, int ndim,
+             float *a, int pivot[],
+             int *flag)
+
+#else
+
+int sdecomp (n, ndim, a, pivot, flag)
+
+int    n,
+       ndim;
+float  *a;
+int    pivot[];
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Decomposes a real matrix of float elements by gaussian
+   elimination.  Use ssolve() to compute solutions to linear systems.
+
+   Input ...
+   -----
+   n    = order of the matrix
+   ndim = row dimension of matrix as defined in the calling program
+   *a   = pointer to matrix to be triangularized
+
+   Output ...
+   ------
+   *a        = the factors, in the same form as left by decomp()
+   pivot     = the pivot vector.
+   pivot[k]  = the index of the k-th pivot row
+   pivot[n-1]= (-1)**(number of interchanges)
+   flag      = Status indicator
+               0 : successful execution
+               2 : illegal user input n < 1, a == NULL,
+                   pivot == NULL, n > ndim.
+               3 : matrix is singular; a pivot smaller than
+                   FEPSILON times the 1-norm of a was found.
+
+   Version ... 1.0,  19 October 2026
+   -------
+
+   Notes ...
+   -----
+   (1) As for decompnc(), no condition estimate is made and no
+       workspace is allocated.
+*/
+
+{   /* --- function sdecomp() --- */
+
+float anorm;
+
+*flag = 0;
+if (a == NULL || pivot == NULL || n < 1 || ndim < n)
+   {
+   *flag = 2;
+   return (0);
+   }
+
+pivot[n-1] = 1;
+if (n == 1)
+   {
+   if (*a == 0.0f) *flag = 3;
+   return (0);
+   }
+
+if (sdcelim (n, ndim, a, pivot, &anorm) != 0) *flag = 3;
+
+return (0);
+}   /* --- end of function sdecomp() --- */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int ssolve (int n, int ndim,
+            float *a, float b[],
+            int pivot[])
+
+#else
+
+int ssolve (n, ndim, a, b, pivot)
+
+int    n,
+       ndim,
+       pivot[];
+float  *a,
+       b[];
+
+#endif
+
+/* Purpose :
+   -------
+   Solution of linear system, a * x = b, with the float factors
+   from sdecomp().
+   Do not use if sdecomp() has detected singularity.
+
+   Input..
+   -----
+   n     = order of matrix
+   ndim  = row dimension of a
+   a     = triangularized matrix obtained from sdecomp()
+   b     = right hand side vector
+   pivot = pivot vector obtained from sdecomp()
+
+   Output..
+   ------
+   b = solution vector, x
+
+*/
+
+{   /* --- begin function ssolve() --- */
+
+int    i, j, k, m;
+float  t;
+
+if (n == 1)
+   {
+   /* trivial */
+   b[0] /= a[0];
+   }
+else
+   {
+   /* Forward elimination: apply multipliers. */
+   for (k = 0; k < n-1; k ++)
+      {
+      m = pivot[k];
+      t = b[m]; b[m] = b[k]; b[k] = t;
+      for (i = k+1; i < n; ++i) b[i] += a[AINDEX(i,k)] * t;
+      }
+
+   /* Back substitution. */
+   for (k = n-1; k >= 0; --k)
+      {
+      t = b[k];
+      for (j = k+1; j < n; ++j) t -= a[AINDEX(k,j)] * b[j];
+      b[k] = t / a[AINDEX(k,k)];
+      }
+   }
+
+return(0);
+}  /* --- end function ssolve() --- */
+
+/*-----------------------------------------------------------------*/
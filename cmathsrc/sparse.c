@@ -0,0 +1,954 @@
+/* sparse.c
+   Sparse matrix LU decomposition with a fill-reducing ordering. */
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+#include "cmath.h"
+#if (STDLIBH)
+#include <stdlib.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+/* Relative size of the diagonal element, against the largest
+   in its column, at which it is still taken as the pivot.  */
+
+#define  SPARSE_TOL   0.1
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static int spcheck (struct SPMAT *a)
+
+#else
+
+static int spcheck (a)
+struct SPMAT *a;
+
+#endif
+
+/* Purpose ...
+   -------
+   Returns 1 if the matrix structure a is usable, 0 if not.
+*/
+
+{
+int i, k, n;
+
+if (a == NULL || a->n < 1 || a->rowptr == NULL || a->col == NULL)
+   return (0);
+n = a->n;
+if (a->rowptr[0] != 0) return (0);
+for (i = 0; i < n; ++i)
+   {
+   if (a->rowptr[i+1] < a->rowptr[i]) return (0);
+   for (k = a->rowptr[i]; k < a->rowptr[i+1]; ++k)
+      if (a->col[k] < 0 || a->col[k] >= n) return (0);
+   }
+return (1);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int sporder (struct SPMAT *a, int q[], int *flag)
+
+#else
+
+int sporder (a, q, flag)
+
+struct SPMAT *a;
+int    q[];
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Compute a fill-reducing symmetric ordering of a sparse matrix
+   by the approximate minimum degree method, applied to the pattern
+   of a + a-transpose.
+
+   Input ...
+   -----
+   a     : the sparse matrix (only the pattern is used)
+
+   Output ...
+   ------
+   q     : the ordering, q[k] = index of the k-th row and column
+           to be eliminated, k = 0 ... n-1
+   flag  : status indicator
+           = 0, normal return
+           = 1, could not allocate memory for workspace
+           = 2, illegal user input (invalid structure a, q == NULL)
+
+   Version ... 1.0,  19 October 2026
+   -------
+
+   Notes ...
+   -----
+   (1) The elimination graph is kept as a quotient graph: each
+       variable i has a list of adjacent variables and a list of
+       adjacent elements (eliminated variables), each element a
+       list of its variables.  The degree of a variable is bounded
+       as by Amestoy, Davis & Duff (1996),
+       d[i] <= |A[i] \ Lp| + |Lp| - 1 + sum over e != p of |Le \ Lp|
+       when the new element Lp, formed by eliminating p, contains
+       i.  Elements that are subsets of Lp are absorbed.
+   (2) There is no detection of supervariables or of dense rows,
+       so the time taken is greater than for AMD proper, but the
+       orderings are of comparable quality.
+   (3) About 4 * nnz + 10 * n integers of workspace are allocated,
+       plus the element lists as they are formed.
+*/
+
+{  /* begin sporder() */
+
+int    n, i, j, k, e, p, pp, nel, mindeg, d, dext, lenp, nleft;
+int    *aptr, *alen, *adj, *cnt;
+int    *ecap, *elen, **elist, *llen, **lel;
+int    *status, *deg, *head, *next, *prev, *mark, *w, *wlist, nw;
+int    *lp, *ip, lcap;
+
+*flag = 0;
+aptr = alen = adj = cnt = ecap = elen = llen = (int *) NULL;
+status = deg = head = next = prev = mark = w = wlist = (int *) NULL;
+elist = lel = (int **) NULL;
+
+if (!spcheck (a) || q == NULL)
+   {
+   *flag = 2;
+   return (0);
+   }
+n = a->n;
+
+/* ---- workspace ---- */
+aptr   = (int *) malloc ((n+1) * sizeof(int));
+alen   = (int *) malloc (n * sizeof(int));
+cnt    = (int *) malloc (n * sizeof(int));
+adj    = (int *) malloc ((2 * a->rowptr[n] + 1) * sizeof(int));
+ecap   = (int *) malloc (n * sizeof(int));
+elen   = (int *) malloc (n * sizeof(int));
+llen   = (int *) malloc (n * sizeof(int));
+status = (int *) malloc (n * sizeof(int));
+deg    = (int *) malloc (n * sizeof(int));
+head   = (int *) malloc (n * sizeof(int));
+next   = (int *) malloc (n * sizeof(int));
+prev   = (int *) malloc (n * sizeof(int));
+mark   = (int *) malloc (n * sizeof(int));
+w      = (int *) malloc (n * sizeof(int));
+wlist  = (int *) malloc (n * sizeof(int));
+elist  = (int **) malloc (n * sizeof(int *));
+lel    = (int **) malloc (n * sizeof(int *));
+if (elist != NULL) for (i = 0; i < n; ++i) elist[i] = (int *) NULL;
+if (lel   != NULL) for (i = 0; i < n; ++i) lel[i]   = (int *) NULL;
+if (aptr == NULL || alen == NULL || cnt == NULL || adj == NULL ||
+    ecap == NULL || elen == NULL || llen == NULL || status == NULL ||
+    deg == NULL || head == NULL || next == NULL || prev == NULL ||
+    mark == NULL || w == NULL || wlist == NULL || elist == NULL ||
+    lel == NULL)
+   {
+   *flag = 1;
+   goto LeaveSporder;
+   }
+
+/* ---- adjacency of a + a-transpose, without the diagonal ---- */
+for (i = 0; i < n; ++i) cnt[i] = 0;
+for (i = 0; i < n; ++i)
+   for (k = a->rowptr[i]; k < a->rowptr[i+1]; ++k)
+      {
+      j = a->col[k];
+      if (j != i) { ++cnt[i]; ++cnt[j]; }
+      }
+aptr[0] = 0;
+for (i = 0; i < n; ++i) { aptr[i+1] = aptr[i] + cnt[i]; alen[i] = 0; }
+for (i = 0; i < n; ++i)
+   for (k = a->rowptr[i]; k < a->rowptr[i+1]; ++k)
+      {
+      j = a->col[k];
+      if (j == i) continue;
+      adj[aptr[i] + alen[i]++] = j;
+      adj[aptr[j] + alen[j]++] = i;
+      }
+/* remove duplicates */
+for (i = 0; i < n; ++i) mark[i] = -1;
+for (i = 0; i < n; ++i)
+   {
+   ip = adj + aptr[i];
+   d  = 0;
+   for (k = 0; k < alen[i]; ++k)
+      {
+      j = ip[k];
+      if (mark[j] != i) { mark[j] = i; ip[d++] = j; }
+      }
+   alen[i] = d;
+   }
+
+/* ---- degree lists ---- */
+for (d = 0; d < n; ++d) head[d] = -1;
+for (i = 0; i < n; ++i)
+   {
+   status[i] = 0;          /* 0 variable, 1 element, 2 absorbed */
+   elen[i] = 0;
+   ecap[i] = 0;
+   llen[i] = 0;
+   mark[i] = -1;
+   w[i]    = -1;
+   deg[i]  = alen[i];
+   prev[i] = -1;
+   next[i] = head[deg[i]];
+   if (next[i] >= 0) prev[next[i]] = i;
+   head[deg[i]] = i;
+   }
+
+mindeg = 0;
+nleft  = n;
+for (nel = 0; nel < n; ++nel)
+   {
+   /* ---- select the variable p of minimum degree ---- */
+   while (head[mindeg] < 0) ++mindeg;
+   p = head[mindeg];
+   head[mindeg] = next[p];
+   if (next[p] >= 0) prev[next[p]] = -1;
+   q[nel] = p;
+   --nleft;
+
+   /* ---- form the new element Lp ---- */
+   lcap = deg[p] + 1;
+   if (lcap < alen[p] + 1) lcap = alen[p] + 1;
+   lp = (int *) malloc (lcap * sizeof(int));
+   if (lp == NULL)
+      {
+      *flag = 1;
+      goto LeaveSporder;
+      }
+   lenp = 0;
+   mark[p] = nel;
+   ip = adj + aptr[p];
+   for (k = 0; k < alen[p]; ++k)
+      {
+      j = ip[k];
+      if (status[j] == 0 && mark[j] != nel)
+         { mark[j] = nel; lp[lenp++] = j; }
+      }
+   for (k = 0; k < elen[p]; ++k)
+      {
+      e = elist[p][k];
+      if (status[e] != 1) continue;
+      for (pp = 0; pp < llen[e]; ++pp)
+         {
+         j = lel[e][pp];
+         if (status[j] == 0 && mark[j] != nel)
+            {
+            if (lenp >= lcap)
+               {  /* the degree was only a bound; grow the list */
+               lcap = 2 * lcap;
+               ip = (int *) realloc (lp, lcap * sizeof(int));
+               if (ip == NULL) { free (lp); *flag = 1; goto LeaveSporder; }
+               lp = ip;
+               }
+            mark[j] = nel;
+            lp[lenp++] = j;
+            }
+         }
+      status[e] = 2;          /* absorbed into p */
+      free (lel[e]); lel[e] = (int *) NULL;
+      }
+   status[p] = 1;
+   lel[p]  = lp;
+   llen[p] = lenp;
+   free (elist[p]); elist[p] = (int *) NULL;
+   elen[p] = 0;
+   alen[p] = 0;
+
+   /* ---- |Le \ Lp| for the elements adjacent to Lp ---- */
+   nw = 0;
+   for (pp = 0; pp < lenp; ++pp)
+      {
+      i = lp[pp];
+      for (k = 0; k < elen[i]; ++k)
+         {
+         e = elist[i][k];
+         if (status[e] != 1) continue;
+         if (w[e] < 0) { w[e] = llen[e]; wlist[nw++] = e; }
+         --w[e];
+         }
+      }
+
+   /* ---- update the variables of Lp ---- */
+   for (pp = 0; pp < lenp; ++pp)
+      {
+      i = lp[pp];
+
+      /* take i out of its degree list */
+      if (prev[i] >= 0) next[prev[i]] = next[i];
+      else              head[deg[i]] = next[i];
+      if (next[i] >= 0) prev[next[i]] = prev[i];
+
+      /* prune the elements, absorbing those within Lp, and add p */
+      dext = 0;
+      d = 0;
+      for (k = 0; k < elen[i]; ++k)
+         {
+         e = elist[i][k];
+         if (status[e] != 1) continue;
+         if (w[e] == 0) { status[e] = 2; continue; }  /* Le in Lp */
+         dext += w[e];
+         elist[i][d++] = e;
+         }
+      elen[i] = d;
+      if (elen[i] + 1 > ecap[i])
+         {
+         ecap[i] = 2 * ecap[i] + 4;
+         ip = (int *) realloc (elist[i], ecap[i] * sizeof(int));
+         if (ip == NULL) { *flag = 1; goto LeaveSporder; }
+         elist[i] = ip;
+         }
+      elist[i][elen[i]++] = p;
+
+      /* prune the variables covered by Lp */
+      ip = adj + aptr[i];
+      d = 0;
+      for (k = 0; k < alen[i]; ++k)
+         {
+         j = ip[k];
+         if (status[j] == 0 && mark[j] != nel) ip[d++] = j;
+         }
+      alen[i] = d;
+
+      /* approximate external degree */
+      d = alen[i] + lenp - 1 + dext;
+      if (d > deg[i] + lenp) d = deg[i] + lenp;
+      if (d > nleft - 1) d = nleft - 1;
+      if (d < 0) d = 0;
+      deg[i] = d;
+      prev[i] = -1;
+      next[i] = head[d];
+      if (next[i] >= 0) prev[next[i]] = i;
+      head[d] = i;
+      if (d < mindeg) mindeg = d;
+      }
+
+   for (k = 0; k < nw; ++k) w[wlist[k]] = -1;
+   }
+
+LeaveSporder:
+if (elist != NULL)
+   for (i = 0; i < n; ++i) if (elist[i] != NULL) free (elist[i]);
+if (lel != NULL)
+   for (i = 0; i < n; ++i) if (lel[i] != NULL) free (lel[i]);
+if (lel    != NULL) free (lel);
+if (elist  != NULL) free (elist);
+if (wlist  != NULL) free (wlist);
+if (w      != NULL) free (w);
+if (mark   != NULL) free (mark);
+if (prev   != NULL) free (prev);
+if (next   != NULL) free (next);
+if (head   != NULL) free (head);
+if (deg    != NULL) free (deg);
+if (status != NULL) free (status);
+if (llen   != NULL) free (llen);
+if (elen   != NULL) free (elen);
+if (ecap   != NULL) free (ecap);
+if (adj    != NULL) free (adj);
+if (cnt    != NULL) free (cnt);
+if (alen   != NULL) free (alen);
+if (aptr   != NULL) free (aptr);
+return (0);
+}  /* end of sporder() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int spluinit (struct SPLU *lu)
+
+#else
+
+int spluinit (lu)
+struct SPLU *lu;
+
+#endif
+
+/* Purpose ...
+   -------
+   Initialize the factor structure lu, before its first use by
+   spdecomp().
+*/
+
+{
+lu->n    = 0;
+lu->lnz  = lu->lmax = 0;
+lu->unz  = lu->umax = 0;
+lu->q    = lu->pinv = (int *) NULL;
+lu->lp   = lu->li   = (int *) NULL;
+lu->up   = lu->ui   = (int *) NULL;
+lu->cp   = lu->ci   = (int *) NULL;
+lu->iw   = (int *) NULL;
+lu->lx   = lu->ux = lu->cx = lu->w = (double *) NULL;
+return (0);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int spfree (struct SPLU *lu)
+
+#else
+
+int spfree (lu)
+struct SPLU *lu;
+
+#endif
+
+/* Purpose ...
+   -------
+   Release the storage held by the factor structure lu.
+   The structure is left as from spluinit().
+*/
+
+{
+if (lu->q    != NULL) free (lu->q);
+if (lu->pinv != NULL) free (lu->pinv);
+if (lu->lp   != NULL) free (lu->lp);
+if (lu->li   != NULL) free (lu->li);
+if (lu->lx   != NULL) free (lu->lx);
+if (lu->up   != NULL) free (lu->up);
+if (lu->ui   != NULL) free (lu->ui);
+if (lu->ux   != NULL) free (lu->ux);
+if (lu->cp   != NULL) free (lu->cp);
+if (lu->ci   != NULL) free (lu->ci);
+if (lu->cx   != NULL) free (lu->cx);
+if (lu->iw   != NULL) free (lu->iw);
+if (lu->w    != NULL) free (lu->w);
+spluinit (lu);
+return (0);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static int spreach (struct SPLU *lu, int k, int *xi, int *mark)
+
+#else
+
+static int spreach (lu, k, xi, mark)
+struct SPLU *lu;
+int    k, *xi, *mark;
+
+#endif
+
+/* Purpose ...
+   -------
+   Find the rows reached from column k of the permuted matrix
+   through the graph of the columns of L computed so far.
+   They are returned in topological order in xi[top .. n-1]
+   and top is returned.  xi[0 .. n-1] is used as the stack of
+   positions and mark[] holds k for the rows visited.
+*/
+
+{
+int n, top, head, p, j, jc, i, done, *pstack;
+
+n      = lu->n;
+top    = n;
+pstack = xi + n;
+for (p = lu->cp[k]; p < lu->cp[k+1]; ++p)
+   {
+   j = lu->ci[p];
+   if (mark[j] == k) continue;
+   /* depth first search from row j */
+   head = 0;
+   xi[0] = j;
+   while (head >= 0)
+      {
+      j  = xi[head];
+      jc = lu->pinv[j];
+      if (mark[j] != k)
+         {
+         mark[j] = k;
+         pstack[head] = (jc < 0) ? 0 : lu->lp[jc] + 1;
+         }
+      done = 1;
+      if (jc >= 0)
+         {
+         for ( ; pstack[head] < lu->lp[jc+1]; ++pstack[head])
+            {
+            i = lu->li[pstack[head]];
+            if (mark[i] == k) continue;
+            ++pstack[head];
+            xi[++head] = i;
+            done = 0;
+            break;
+            }
+         }
+      if (done)
+         {
+         --head;
+         xi[--top] = j;
+         }
+      }
+   }
+return (top);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int spdecomp (struct SPMAT *a, struct SPLU *lu, int *flag)
+
+#else
+
+int spdecomp (a, lu, flag)
+
+struct SPMAT *a;
+struct SPLU  *lu;
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Decompose a sparse real matrix by gaussian elimination.  Use
+   spsolve() to compute solutions to linear systems.
+
+   Input ...
+   -----
+   a     : the sparse matrix, in compressed row form.
+           a->n is the order of the matrix.  The elements of row i
+           are a->val[k], in columns a->col[k], for
+           k = a->rowptr[i] ... a->rowptr[i+1]-1.  The columns
+           need not be in order within a row.
+   lu    : the factor structure, set by spluinit() before its first
+           use.  If it already holds an ordering for a matrix of the
+           same order, that ordering is used again.
+
+   Output ...
+   ------
+   lu    : the ordering and the sparse factors of a
+   flag  : status indicator
+           = 0, normal return
+           = 1, could not allocate memory for workspace
+           = 2, illegal user input (invalid structure a)
+           = 3, the matrix is singular; no nonzero pivot is
+                available in some column
+           On a memory failure lu is released as by spfree(); it
+           may still be passed to spdecomp() or spfree().
+
+   Version ... 1.0,  19 October 2026
+   -------
+
+   Notes ...
+   -----
+   (1) The rows and columns are first reordered symmetrically by
+       sporder() to reduce the fill.  Columns are then eliminated
+       in that order by the left-looking method of Gilbert and
+       Peierls, each column of L and U being found by a sparse
+       triangular solve.  The diagonal element is taken as pivot
+       if it is at least SPARSE_TOL times the largest candidate in
+       its column; otherwise the largest is taken.
+   (2) Work is proportional to the number of floating point
+       operations; storage for the factors grows as needed.
+   (3) A matrix with the same pattern but new values, such as an
+       iteration matrix in a stiff integrator, may be decomposed
+       again with the same lu; only the ordering is kept.
+   (4) The sparse analogue of decomp(), but no condition estimate
+       is made.
+*/
+
+{  /* begin spdecomp() */
+
+int    n, i, j, k, p, top, ipiv, *xi, *mark, *qinv, *ip;
+double *x, amax, t, pivot, *dp;
+
+*flag = 0;
+if (!spcheck (a) || a->val == NULL || lu == NULL)
+   {
+   *flag = 2;
+   return (0);
+   }
+n = a->n;
+
+/* ---- the ordering, if not already known ---- */
+if (lu->n != n || lu->q == NULL)
+   {
+   spfree (lu);
+   lu->n = n;
+   lu->q = (int *) malloc (n * sizeof(int));
+   if (lu->q == NULL) { spfree (lu); *flag = 1; return (0); }
+   sporder (a, lu->q, flag);
+   if (*flag != 0) { spfree (lu); return (0); }
+   lu->pinv = (int *) malloc (n * sizeof(int));
+   lu->lp   = (int *) malloc ((n+1) * sizeof(int));
+   lu->up   = (int *) malloc ((n+1) * sizeof(int));
+   lu->cp   = (int *) malloc ((n+1) * sizeof(int));
+   lu->iw   = (int *) malloc (4 * n * sizeof(int));
+   lu->w    = (double *) malloc (n * sizeof(double));
+   if (lu->pinv == NULL || lu->lp == NULL || lu->up == NULL ||
+       lu->cp == NULL || lu->iw == NULL || lu->w == NULL)
+      {
+      spfree (lu);
+      *flag = 1;
+      return (0);
+      }
+   }
+
+/* ---- the permuted matrix, a(q,q), by columns ---- */
+if (lu->ci == NULL || lu->cp[n] < a->rowptr[n])
+   {
+   if (lu->ci != NULL) free (lu->ci);
+   if (lu->cx != NULL) free (lu->cx);
+   lu->ci = (int *) malloc ((a->rowptr[n] + 1) * sizeof(int));
+   lu->cx = (double *) malloc ((a->rowptr[n] + 1) * sizeof(double));
+   if (lu->ci == NULL || lu->cx == NULL)
+      {
+      spfree (lu);
+      *flag = 1;
+      return (0);
+      }
+   }
+xi   = lu->iw;
+mark = lu->iw + 2 * n;
+qinv = lu->iw + 3 * n;
+for (k = 0; k < n; ++k) qinv[lu->q[k]] = k;
+for (k = 0; k <= n; ++k) lu->cp[k] = 0;
+for (i = 0; i < n; ++i)
+   for (p = a->rowptr[i]; p < a->rowptr[i+1]; ++p)
+      ++lu->cp[qinv[a->col[p]] + 1];
+for (k = 0; k < n; ++k) lu->cp[k+1] += lu->cp[k];
+for (k = 0; k < n; ++k) mark[k] = lu->cp[k];
+for (i = 0; i < n; ++i)
+   for (p = a->rowptr[i]; p < a->rowptr[i+1]; ++p)
+      {
+      j = qinv[a->col[p]];
+      lu->ci[mark[j]]   = qinv[i];
+      lu->cx[mark[j]++] = a->val[p];
+      }
+
+/* ---- initial storage for the factors ---- */
+if (lu->lx == NULL)
+   {
+   lu->lmax = lu->umax = 4 * a->rowptr[n] + n;
+   lu->li = (int *) malloc (lu->lmax * sizeof(int));
+   lu->lx = (double *) malloc (lu->lmax * sizeof(double));
+   lu->ui = (int *) malloc (lu->umax * sizeof(int));
+   lu->ux = (double *) malloc (lu->umax * sizeof(double));
+   if (lu->li == NULL || lu->lx == NULL ||
+       lu->ui == NULL || lu->ux == NULL)
+      {
+      spfree (lu);
+      *flag = 1;
+      return (0);
+      }
+   }
+
+x = lu->w;
+for (i = 0; i < n; ++i) { x[i] = 0.0; mark[i] = -1; lu->pinv[i] = -1; }
+lu->lnz = lu->unz = 0;
+
+for (k = 0; k < n; ++k)
+   {
+   lu->lp[k] = lu->lnz;
+   lu->up[k] = lu->unz;
+
+   /* room for another column of each factor */
+   if (lu->lnz + n > lu->lmax)
+      {
+      lu->lmax = 2 * lu->lmax + n;
+      ip = (int *) realloc (lu->li, lu->lmax * sizeof(int));
+      if (ip != NULL) lu->li = ip;
+      dp = (double *) realloc (lu->lx, lu->lmax * sizeof(double));
+      if (dp != NULL) lu->lx = dp;
+      if (ip == NULL || dp == NULL) { spfree (lu); *flag = 1; return (0); }
+      }
+   if (lu->unz + n > lu->umax)
+      {
+      lu->umax = 2 * lu->umax + n;
+      ip = (int *) realloc (lu->ui, lu->umax * sizeof(int));
+      if (ip != NULL) lu->ui = ip;
+      dp = (double *) realloc (lu->ux, lu->umax * sizeof(double));
+      if (dp != NULL) lu->ux = dp;
+      if (ip == NULL || dp == NULL) { spfree (lu); *flag = 1; return (0); }
+      }
+
+   /* x = L \ (column k), the rows reached being xi[top..n-1] */
+   top = spreach (lu, k, xi, mark);
+   for (p = lu->cp[k]; p < lu->cp[k+1]; ++p)
+      x[lu->ci[p]] += lu->cx[p];
+   for (p = top; p < n; ++p)
+      {
+      j = lu->pinv[xi[p]];
+      if (j < 0) continue;
+      t = x[xi[p]];
+      for (i = lu->lp[j] + 1; i < lu->lp[j+1]; ++i)
+         x[lu->li[i]] -= lu->lx[i] * t;
+      }
+
+   /* the pivot, and column k of U */
+   ipiv = -1;
+   amax = -1.0;
+   for (p = top; p < n; ++p)
+      {
+      i = xi[p];
+      if (lu->pinv[i] < 0)
+         {
+         if (fabs(x[i]) > amax) { amax = fabs(x[i]); ipiv = i; }
+         }
+      else
+         {
+         lu->ui[lu->unz]   = lu->pinv[i];
+         lu->ux[lu->unz++] = x[i];
+         }
+      }
+   if (ipiv < 0 || amax <= 0.0)
+      {
+      *flag = 3;
+      return (0);
+      }
+   if (lu->pinv[k] < 0 && mark[k] == k && fabs(x[k]) >= SPARSE_TOL * amax)
+      ipiv = k;
+   pivot = x[ipiv];
+   lu->ui[lu->unz]   = k;
+   lu->ux[lu->unz++] = pivot;
+   lu->pinv[ipiv] = k;
+
+   /* column k of L, unit diagonal first */
+   lu->li[lu->lnz]   = ipiv;
+   lu->lx[lu->lnz++] = 1.0;
+   for (p = top; p < n; ++p)
+      {
+      i = xi[p];
+      if (lu->pinv[i] < 0)
+         {
+         lu->li[lu->lnz]   = i;
+         lu->lx[lu->lnz++] = x[i] / pivot;
+         }
+      x[i] = 0.0;
+      }
+   }
+lu->lp[n] = lu->lnz;
+lu->up[n] = lu->unz;
+
+/* row indices of L in pivotal order */
+for (p = 0; p < lu->lnz; ++p) lu->li[p] = lu->pinv[lu->li[p]];
+
+return (0);
+}  /* end of spdecomp() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int spsolve (struct SPLU *lu, double b[])
+
+#else
+
+int spsolve (lu, b)
+
+struct SPLU *lu;
+double b[];
+
+#endif
+
+/* Purpose ...
+   -------
+   Solution of the linear system a * x = b with the factors of a
+   from spdecomp().  Do not use if spdecomp() has failed.
+
+   Input ...
+   -----
+   lu    : the factor structure from spdecomp()
+   b     : the right hand side vector
+
+   Output ...
+   ------
+   b     : the solution vector, x
+*/
+
+{  /* begin spsolve() */
+
+int    n, i, j, p;
+double *x, t;
+
+n = lu->n;
+x = lu->w;
+
+for (i = 0; i < n; ++i) x[lu->pinv[i]] = b[lu->q[i]];
+
+/* L y = P b, L unit lower triangular by columns */
+for (j = 0; j < n; ++j)
+   {
+   t = x[j];
+   if (t == 0.0) continue;
+   for (p = lu->lp[j] + 1; p < lu->lp[j+1]; ++p)
+      x[lu->li[p]] -= lu->lx[p] * t;
+   }
+
+/* U z = y, U by columns with the diagonal last */
+for (j = n-1; j >= 0; --j)
+   {
+   x[j] /= lu->ux[lu->up[j+1] - 1];
+   t = x[j];
+   if (t == 0.0) continue;
+   for (p = lu->up[j]; p < lu->up[j+1] - 1; ++p)
+      x[lu->ui[p]] -= lu->ux[p] * t;
+   }
+
+for (j = 0; j < n; ++j) b[lu->q[j]] = x[j];
+
+return (0);
+}  /* end of spsolve() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int spcolor (struct SPMAT *a, int group[], int *ngroup, int *flag)
+
+#else
+
+int spcolor (a, group, ngroup, flag)
+
+struct SPMAT *a;
+int    group[], *ngroup, *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Partition the columns of a sparse matrix into groups such that
+   no two columns of a group have an element in the same row.  All
+   the columns of a group may then be perturbed together when a
+   sparse jacobian is estimated by finite differences
+   (Curtis, Powell & Reid 1974), one function evaluation per group.
+
+   Input ...
+   -----
+   a      : the sparse matrix (only the pattern is used)
+
+   Output ...
+   ------
+   group  : group[j] = the group of column j, 0 ... ngroup-1
+   ngroup : the number of groups
+   flag   : status indicator
+            = 0, normal return
+            = 1, could not allocate memory for workspace
+            = 2, illegal user input
+
+   Notes ...
+   -----
+   (1) Columns are taken in order and each is put in the first
+       group that it does not conflict with.
+*/
+
+{  /* begin spcolor() */
+
+int    n, i, j, k, p, g, *cp, *ci, *cnt, *used;
+
+*flag = 0;
+cp = ci = cnt = used = (int *) NULL;
+if (!spcheck (a) || group == NULL || ngroup == NULL)
+   {
+   *flag = 2;
+   return (0);
+   }
+n = a->n;
+
+/* the pattern by columns, to find the rows of each column */
+cp   = (int *) malloc ((n+1) * sizeof(int));
+cnt  = (int *) malloc ((n+1) * sizeof(int));
+used = (int *) malloc ((n+1) * sizeof(int));
+ci   = (int *) malloc ((a->rowptr[n] + 1) * sizeof(int));
+if (cp == NULL || cnt == NULL || used == NULL || ci == NULL)
+   {
+   *flag = 1;
+   goto LeaveSpcolor;
+   }
+for (j = 0; j <= n; ++j) cp[j] = 0;
+for (p = 0; p < a->rowptr[n]; ++p) ++cp[a->col[p] + 1];
+for (j = 0; j < n; ++j) cp[j+1] += cp[j];
+for (j = 0; j < n; ++j) cnt[j] = cp[j];
+for (i = 0; i < n; ++i)
+   for (p = a->rowptr[i]; p < a->rowptr[i+1]; ++p)
+      ci[cnt[a->col[p]]++] = i;
+
+*ngroup = 0;
+for (g = 0; g <= n; ++g) used[g] = -1;
+for (j = 0; j < n; ++j)
+   {
+   /* mark the groups of the columns sharing a row with j */
+   for (p = cp[j]; p < cp[j+1]; ++p)
+      {
+      i = ci[p];
+      for (k = a->rowptr[i]; k < a->rowptr[i+1]; ++k)
+         if (a->col[k] < j) used[group[a->col[k]]] = j;
+      }
+   for (g = 0; used[g] == j; ++g) ;
+   group[j] = g;
+   if (g + 1 > *ngroup) *ngroup = g + 1;
+   }
+
+LeaveSpcolor:
+if (ci   != NULL) free (ci);
+if (used != NULL) free (used);
+if (cnt  != NULL) free (cnt);
+if (cp   != NULL) free (cp);
+return (0);
+}  /* end of spcolor() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int spmatvec (struct SPMAT *a, double x[], double y[])
+
+#else
+
+int spmatvec (a, x, y)
+
+struct SPMAT *a;
+double x[], y[];
+
+#endif
+
+/* Purpose ...
+   -------
+   Form the product y = a * x of a sparse matrix and a vector,
+   for example in the matvec() function of cgsolve(), gmres() or
+   bicgstab().  When compiled for OpenMP (PARALLEL in cmath.h)
+   the rows are shared among threads.
+*/
+
+{
+int    i, k, n;
+double t;
+
+n = a->n;
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(k, t) \
+        if (a->rowptr[n] > 65536)
+#endif
+for (i = 0; i < n; ++i)
+   {
+   t = 0.0;
+   for (k = a->rowptr[i]; k < a->rowptr[i+1]; ++k)
+      t += a->val[k] * x[a->col[k]];
+   y[i] = t;
+   }
+return (0);
+}
+
+/*-----------------------------------------------------------------*/
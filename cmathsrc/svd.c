@@ -0,0 +1,865 @@
+/* svd.c
+   Singular value decomposition.
+*/
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+
+#include "cmath.h"
+#if (STDLIBH)
+#include <stdlib.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+
+#define  zero  0.0
+#define  one   1.0
+#define  two   2.0
+#define  MINDX(i,j,rowsize)  (((i)-1) * (rowsize) + (j)-1)
+#define  VINDX(j)            ((j)-1)
+#define  MIN(a,b)            (((a) < (b)) ? (a) : (b))
+#define  MAX(a,b)            (((a) > (b)) ? (a) : (b))
+#define  SIGN(a,b)           (((b) >= 0.0) ? fabs(a) : -fabs(a))
+
+/* Matrices with m >= SVD_QRRATIO * n are first reduced to the
+   n by n triangular factor R of a = Q.R.  */
+#define  SVD_QRRATIO  2
+
+/* Row-oriented updates take SVD_NB columns at a time.  When
+   compiled for OpenMP (PARALLEL in cmath.h), the blocks of columns,
+   and the rows for the plane rotations, are shared among threads
+   if more than SVD_PMIN elements are involved.  */
+#define  SVD_NB       256
+#define  SVD_PMIN     32768L
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void svrank1 (double *a, int nm, int r0, int r1, int c0, int c1,
+                     double *x, int incx, double *y, int incy,
+                     double d1, double d2, double *s)
+
+#else
+
+static void svrank1 (a, nm, r0, r1, c0, c1, x, incx, y, incy, d1, d2, s)
+double *a;
+int    nm, r0, r1, c0, c1;
+double *x;
+int    incx;
+double *y;
+int    incy;
+double d1, d2, *s;
+
+#endif
+
+/* Purpose ...
+   -------
+   For the block of a in rows r0 ... r1, columns c0 ... c1,
+   form s[j] = sum over k of x[k*incx] * a[k*nm + j], then
+   add ((s[j] / d1) / d2) * y[k*incy] to a[k*nm + j].
+   Both passes run along the rows of a.  s[c0 ... c1] is workspace.
+*/
+
+{
+int    jb, je, j, k;
+double t, *ak;
+
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(je, j, k, t, ak) \
+        if ((long) (r1 - r0 + 1) * (c1 - c0 + 1) > SVD_PMIN)
+#endif
+for (jb = c0; jb <= c1; jb += SVD_NB)
+   {
+   je = (jb + SVD_NB - 1 < c1) ? jb + SVD_NB - 1 : c1;
+   for (j = jb; j <= je; ++j) s[j] = zero;
+   for (k = r0; k <= r1; ++k)
+      {
+      t  = x[(long) k * incx];
+      ak = a + (long) k * nm;
+      for (j = jb; j <= je; ++j) s[j] += t * ak[j];
+      }
+   for (j = jb; j <= je; ++j) s[j] = (s[j] / d1) / d2;
+   for (k = r0; k <= r1; ++k)
+      {
+      t  = y[(long) k * incy];
+      ak = a + (long) k * nm;
+      for (j = jb; j <= je; ++j) ak[j] += s[j] * t;
+      }
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void svrotate (double *a, int nm, int rows, int L, int k,
+                      double *c, double *s)
+
+#else
+
+static void svrotate (a, nm, rows, L, k, c, s)
+double *a;
+int    nm, rows, L, k;
+double *c, *s;
+
+#endif
+
+/* Purpose ...
+   -------
+   Apply the plane rotations (c[i], s[i]) to columns i and i+1 of a,
+   for i = L ... k-1 in turn, one row at a time.
+*/
+
+{
+int    i, j;
+double x, z, *aj;
+
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(i, x, z, aj) \
+        if ((long) rows * (k - L) > SVD_PMIN)
+#endif
+for (j = 0; j < rows; ++j)
+   {
+   aj = a + (long) j * nm;
+   for (i = L; i < k; ++i)
+      {
+      x = aj[i];
+      z = aj[i+1];
+      aj[i]   = x * c[i] + z * s[i];
+      aj[i+1] = -x * s[i] + z * c[i];
+      }
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static int svdgr (int nm, int m, int n,
+                  double a[], double w[],
+                  int matu, double u[],
+                  int matv, double v[],
+                  double *rv1)
+
+#else
+
+static int svdgr (nm, m, n, a, w, matu, u, matv, v, rv1)
+int nm; int m; int n;
+double a[]; double w[];
+int matu; double u[];
+int matv; double v[];
+double *rv1;
+
+#endif
+
+/* Purpose ...
+   -------
+   The Golub-Reinsch decomposition for svd(), with workspace rv1
+   of 6n doubles.  Returns the value for ierr, 0 or k.
+*/
+
+{
+int i, j, k, L, i1, k1, L1, mn, its;
+double c, f, g, h, s, x, y, z, scale, anorm, t;
+double *rv2, *cu, *su, *cv, *sv;
+
+rv2 = rv1 + n;
+cu  = rv1 + 2 * n;
+su  = rv1 + 3 * n;
+cv  = rv1 + 4 * n;
+sv  = rv1 + 5 * n;
+
+if (u != a)
+   {
+   for (i = 1; i <= m; ++i)
+      {
+      for (j = 1; j <= n; ++j) u[MINDX(i,j,nm)] = a[MINDX(i,j,nm)];
+      }
+   }
+
+/*  Householder reduction to bidiagonal form..... */
+
+g = 0.0;
+scale = 0.0;
+anorm = 0.0;
+
+for (i = 1; i <= n; ++i)
+   {
+   L = i + 1;
+   rv1[VINDX(i)] = scale * g;
+   g = 0.0;
+   s = 0.0;
+   scale = 0.0;
+   if (i <= m)
+      {
+      for (k = i; k <= m; ++k) scale += fabs(u[MINDX(k,i,nm)]);
+
+      if (scale != 0.0)
+         {
+         for (k = i; k <= m; ++k)
+            {
+            t = u[MINDX(k,i,nm)] / scale;
+            s = s + t * t;
+            u[MINDX(k,i,nm)] = t;
+            }
+
+         f = u[MINDX(i,i,nm)];
+         g = -( SIGN(sqrt(s), f) );
+         h = f * g - s;
+         u[MINDX(i,i,nm)] = f - g;
+         if (i != n)
+            {
+            svrank1 (u, nm, i-1, m-1, L-1, n-1, &u[VINDX(i)], nm,
+                     &u[VINDX(i)], nm, h, one, rv2);
+            }
+
+         for (k = i; k <= m; ++k) u[MINDX(k,i,nm)] *= scale;
+         }
+      }
+
+   w[VINDX(i)] = scale * g;
+   g = 0.0;
+   s = 0.0;
+   scale = 0.0;
+   if ((i <= m) && (i != n))
+      {
+      for (k = L; k <= n; ++k) scale += fabs(u[MINDX(i,k,nm)]);
+
+      if (scale != 0.0)
+         {
+         for (k = L; k <= n; ++k)
+            {
+            t = u[MINDX(i,k,nm)] / scale;
+            s = s + t * t;
+            u[MINDX(i,k,nm)] = t;
+            }
+         f = u[MINDX(i,L,nm)];
+         g = -( SIGN(sqrt(s), f) );
+         h = f * g - s;
+         u[MINDX(i,L,nm)] = f - g;
+         for (k = L; k <= n; ++k) rv1[VINDX(k)] = u[MINDX(i,k,nm)] / h;
+         if (i != m)
+            {
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(k, s) \
+        if ((long) (m - i) * (n - i) > SVD_PMIN)
+#endif
+            for (j = L; j <= m; ++j)
+               {
+               s = 0.0;
+               for (k = L; k <= n; ++k)
+                  s += u[MINDX(j,k,nm)] * u[MINDX(i,k,nm)];
+               for (k = L; k <= n; ++k)
+                  u[MINDX(j,k,nm)] += s * rv1[VINDX(k)];
+               }
+            }
+         for (k = L; k <= n; ++k) u[MINDX(i,k,nm)] *= scale;
+         }
+      }
+
+   anorm = MAX( anorm, fabs(w[VINDX(i)]) + fabs(rv1[VINDX(i)]) );
+   }
+
+/*  Accumulation of right-hand transformations.... */
+
+if (matv)
+   {
+   for (i = n; i >= 1; --i)
+      {
+      if (i != n)
+         {
+         if (g != 0.0)
+            {
+            /* Double division avoids possible underflow.... */
+            for (j = L; j <= n; ++j)
+               v[MINDX(j,i,nm)] = (u[MINDX(i,j,nm)] / u[MINDX(i,L,nm)]) / g;
+            svrank1 (v, nm, L-1, n-1, L-1, n-1, &u[MINDX(i,1,nm)], 1,
+                     &v[VINDX(i)], nm, one, one, rv2);
+            }
+            for (j = L; j <= n; ++j)
+               {
+               v[MINDX(i,j,nm)] = 0.0;
+               v[MINDX(j,i,nm)] = 0.0;
+               }
+            }
+
+      v[MINDX(i,i,nm)] = 1.0;
+      g = rv1[VINDX(i)];
+      L = i;
+      }
+   }
+
+/*  Accumulation of Left-hand transformations.... */
+
+if (matu)
+   {
+   /* for i = min(m,n) step -1 until 1 do.... */
+   mn = MIN(m, n);
+   for (i = mn; i >= 1; --i)
+      {
+      L = i + 1;
+      g = w[VINDX(i)];
+      if (i != n)
+         {
+         for (j = L; j <= n; ++j) u[MINDX(i,j,nm)] = 0.0;
+         }
+
+      if (g != 0.0)
+         {
+         if (i != mn)
+            {
+            /* double division avoids possible underflow;
+               u(i,j) is zero, so the sums may start at row i. */
+            svrank1 (u, nm, i-1, m-1, L-1, n-1, &u[VINDX(i)], nm,
+                     &u[VINDX(i)], nm, u[MINDX(i,i,nm)], g, rv2);
+            }
+
+         for (j = i; j <= m; ++j) u[MINDX(j,i,nm)] /= g;
+         }
+      else
+         {
+         for (j = i; j <= m; ++j)  u[MINDX(j,i,nm)] = 0.0;
+         }
+
+      u[MINDX(i,i,nm)] += 1.0;
+      }
+   }
+
+/* Diagonalization of the bidiagonal form. */
+
+/* for each singular value do... */
+for (k = n; k >= 1; --k)
+   {
+   k1 = k - 1;
+   L1 = k1;
+   its = 0;
+
+   /* Start of REPEAT Loop ... */
+   L520:
+
+   /* Test for splitting. */
+
+   for (L = k; L >= 1; --L)
+      {
+      L1 = L - 1;
+      if ((fabs(rv1[VINDX(L)]) + anorm) == anorm) goto L565;
+      /* rv1[VINDX(1)] is always zero, so there is no exit */
+      /* through the bottom of the Loop.... */
+      if ((fabs(w[VINDX(L1)]) + anorm) == anorm) goto L540;
+      }
+
+   /* Cancellation of rv1[VINDX(L)] if L greater than 1 .... */
+
+   L540:
+   c = 0.0;
+   s = 1.0;
+
+   for (i = L; i <= k; ++i)
+      {
+      f = s * rv1[VINDX(i)];
+      rv1[VINDX(i)] *= c;
+      /* Break from this Loop? ... */
+      if ((fabs(f) + anorm) == anorm) goto L565;
+      g = w[VINDX(i)];
+      h = sqrt(f * f + g * g);
+      w[VINDX(i)] = h;
+      c = g / h;
+      s = -f / h;
+      if (matu)
+         {
+         for (j = 1; j <= m; ++j)
+            {
+            y = u[MINDX(j,L1,nm)];
+            z = u[MINDX(j,i,nm)];
+            u[MINDX(j,L1,nm)] = y * c + z * s;
+            u[MINDX(j,i,nm)] = -y * s + z * c;
+            }
+         }
+      }
+
+   /* Test for convergence. */
+
+   L565:
+   z = w[VINDX(k)];
+   if (L != k)
+      {
+      /* shift from bottom 2 by 2 minor.... */
+      if (its == 30)
+         {
+         /* set error -- no convergence to a */
+         /* singular value after 30 iterations.... */
+         return (k);
+         }
+      ++its;
+      x = w[VINDX(L)];
+      y = w[VINDX(k1)];
+      g = rv1[VINDX(k1)];
+      h = rv1[VINDX(k)];
+      f = ((y - z) * (y + z) + (g - h) * (g + h)) / (2.0 * h * y);
+      g = sqrt(f * f + 1.0);
+      f = ((x - z) * (x + z) + h * (y / (f + SIGN(g,f)) - h)) / x;
+
+      /* Next QR transformation. */
+      c = 1.0;
+      s = 1.0;
+      for (i1 = L; i1 <= k1; ++i1)
+         {
+         i = i1 + 1;
+         g = rv1[VINDX(i)];
+         y = w[VINDX(i)];
+         h = s * g;
+         g = c * g;
+         z = sqrt(f * f + h * h);
+         rv1[VINDX(i1)] = z;
+         c = f / z;
+         s = h / z;
+         f = x * c + g * s;
+         g = -x * s + g * c;
+         h = y * s;
+         y = y * c;
+         cv[VINDX(i1)] = c;
+         sv[VINDX(i1)] = s;
+         z = sqrt(f * f + h * h);
+         w[VINDX(i1)] = z;
+         /* Rotation can be arbitrary if z is zero. */
+         if (z != 0.0)
+            {
+            c = f / z;
+            s = h / z;
+            }
+         f = c * g + s * y;
+         x = -s * g + c * y;
+         cu[VINDX(i1)] = c;
+         su[VINDX(i1)] = s;
+         }
+
+      /* Apply the rotations of this step to v and u, a row at a
+         time rather than a pair of columns at a time. */
+      if (matv) svrotate (v, nm, n, L-1, k1, cv, sv);
+      if (matu) svrotate (u, nm, m, L-1, k1, cu, su);
+
+      rv1[VINDX(L)] = 0.0;
+      rv1[VINDX(k)] = f;
+      w[VINDX(k)] = x;
+      goto L520;
+      }
+
+   /* Convergence. */
+
+   if (z < 0.0)
+      {
+      /* singular value, w(k) is made non-negative. */
+      w[VINDX(k)] = -z;
+      if (matv)
+         {
+         for (j = 1; j <= n; ++j) v[MINDX(j,k,nm)] = -v[MINDX(j,k,nm)];
+         }
+      }
+
+   }
+
+return (0);
+}  /* end of svdgr() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int svd (int nm, int m, int n,
+         double a[], double w[],
+         int matu, double u[],
+         int matv, double v[],
+         int *ierr)
+
+#else
+
+int svd (nm, m, n, a, w, matu, u, matv, v, ierr)
+int nm; int m; int n;
+double a[]; double w[];
+int matu; double u[];
+int matv; double v[];
+int *ierr;
+
+#endif
+
+/* Purpose ...
+   -------
+   This subroutine determines the singular value decomposition
+                  T
+       a  =  u.s.v
+   of a real m by n rectangular matrix.  (T represents the transpose.)
+   Householder bidiagonalization and a variant of the qr algorithm
+   are used to decompose the matrix a.
+
+   Input ...
+   -----
+   nm    : must be set to the size of the rows of two-dimensional
+           arrays a, u and v(transpose) as declared in the calling
+           program.  Note that nm must be at least as large as the
+           maximum of m and n.
+   m     : is the number of rows of a and u and v(transpose).
+   n     : is the number of columns of a and u and the order of v.
+   a     : contains the rectangular input matrix to be decomposed.
+           a[i*nm + j] i = 0 ... m-1, j = 0 ... n-1
+   matu  : should be set to 1 if the u matrix in the decomposition
+           is desired, and to 0 otherwise.
+   matv  : should be set to 1 if the v matrix in the decomposition
+           is desired, and to 0 otherwise.
+
+   Output ...
+   ------
+   a     : is unaltered (unless overwritten by u or v).
+   w     : contains the n (non-negative) singular values of a (the
+           diagonal elements of s).  They are unordered.  If an
+           error exit is made, the singular values should be correct
+           for indices ierr, ierr+1, ..., n-1.
+           w[j], j = 0 ... n-1
+   u     : contains the matrix u (orthogonal column vectors) of the
+           decomposition if matu == 1 otherwise u is used as a
+           temporary array (see Note 4).  If you wish to save on storage space, the
+           memory occupied by u may coincide that occupied by a.
+           If an error exit is made, the columns of u corresponding
+           to indices of correct singular values should be correct.
+           u[i*nm + j] i = 0 ... m-1, j = 0 ... n-1
+   v     : contains the matrix v (orthogonal) of the decomposition if
+           matv == 1 otherwise v is not referenced.  The memory occupied
+           by v may also coincide with a if u is not needed.  If an error
+           exit is made, the columns of v corresponding to indices of
+           correct singular values should be correct.
+           v[i*nm + j] i = 0 ... m-1, j = 0 ... n-1
+   ierr  : status flag
+           ierr =  0, normal return
+           ierr =  k, if the k-1-th singular value has not been
+                      determined after 30 iterations.
+           ierr = -1, could not allocate memory for workspace
+           ierr = -2, invalid user input.
+
+   Workspace ...
+   ---------
+   rv1 is a temporary storage array of 7n double elements.
+   For m >= SVD_QRRATIO * n, m*n + n*n doubles are also allocated
+   (2*n*n if matu == 0), and another n*n if matv == 1.
+
+   This C code written by ...  Peter & Nigel,
+   ----------------------      Design Software,
+                               42 Gubberley St,
+                               Kenmore, 4069,
+                               Australia.
+
+   Version ... 1.0, 13 nov 1989
+   -------     2.0, 19 October 2026, QR first for tall matrices,
+                    row-oriented updates
+
+   Notes ...
+   -----
+   (1) This program has been adapted from "Computer Methods for
+       Mathematical Computations" by Forsythe, Malcolm and Moler
+       (1977),pp 229-235.
+   (2) That FORTRAN program is in turn a translation of the algol
+       procedure svd,
+       Num. Math. 14, 403-420(1970) by Golub and Reinsch.
+       Handbook for Auto. Comp., Vol II-Linear Algebra, 134-151(1971).
+   (3) The Householder updates and the accumulation of u and v are
+       done as rank-1 updates that run along the rows of the arrays
+       (svrank1()), and the plane rotations of each QR step are saved
+       and applied to u and v a row at a time (svrotate()).  The
+       arithmetic is that of version 1.0, in a cache friendly order,
+       and the rows or blocks of columns are shared among threads
+       when compiled for OpenMP.
+   (4) For m >= SVD_QRRATIO * n, a = Q.R is found first by Householder
+       QR and the n by n factor R is decomposed, R = Ur.S.V(T); then
+       u = Q.Ur.  This is Chan's R-bidiagonalization, T.F. Chan, ACM
+       Trans. Math. Softw. 8 (1982) 72-83.  The cost of the
+       decomposition no longer grows with m*n*n for the bidiagonal
+       form and again for u, but for the QR factorization only.
+       In this case u is not referenced if matu == 0, and R is
+       then formed from n rows of a at a time so that Q is not
+       stored.
+   (5) When matu == 0 (matv == 0) no work is done for u (v) beyond
+       the reduction to bidiagonal form.
+   (6) The reduction to bidiagonal form is still the unblocked
+       (level-2) Householder method and the singular values are
+       still found by the implicit QR iteration.  A blocked (level-3)
+       reduction and a divide-and-conquer or one-sided Jacobi stage
+       are not provided; the gain over version 1.0 comes from the
+       memory order of Note (3), the threads, and for tall
+       matrices the QR factorization of Note (4).
+
+----------------------------------------------------------------------
+*/
+
+{  /* begin function svd() */
+
+int    i, j, k, i0, nb, tall;
+double *rv1, *g, *r, *vr, *hv, *t, alpha, s, x0, h;
+
+*ierr = 0;
+rv1 = g = r = vr = (double *) NULL;
+
+if (n <= 1 || m <= 1 || (nm < n && nm < m) || a == NULL || w == NULL ||
+    (u == NULL && (matu || m < SVD_QRRATIO * n)) || (matv && v == NULL))
+   {
+   /* illegal user input */
+   *ierr = -2;
+   goto LeaveSvd;
+   }
+
+tall = (m >= SVD_QRRATIO * n);
+rv1 = (double *) malloc (7 * n * sizeof(double));
+if (tall)
+   {
+   g  = (double *) malloc ((long) (matu ? m : n) * n * sizeof(double));
+   r  = (double *) malloc ((long) n * n * sizeof(double));
+   if (matv) vr = (double *) malloc ((long) n * n * sizeof(double));
+   }
+if (rv1 == NULL || (tall && (g == NULL || r == NULL || (matv && vr == NULL))))
+   {
+   *ierr = -1;
+   goto LeaveSvd;
+   }
+
+if (!tall)
+   {
+   *ierr = svdgr (nm, m, n, a, w, matu, u, matv, v, rv1);
+   goto LeaveSvd;
+   }
+
+if (!matu)
+   {
+   /* Only R is needed.  The rows of a are taken n at a time into
+      g and the triangle r is updated with them, reflector k acting
+      on row k of r and column k of g. */
+   t = rv1 + 6 * n;
+   for (i = 0; i < n * n; ++i) r[i] = zero;
+   for (i0 = 0; i0 < m; i0 += n)
+      {
+      nb = MIN(n, m - i0);
+      for (i = 0; i < nb; ++i)
+         for (j = 0; j < n; ++j) g[i * n + j] = a[(i0 + i) * nm + j];
+      for (k = 0; k < n; ++k)
+         {
+         s = zero;
+         for (i = 0; i < nb; ++i) s += g[i * n + k] * g[i * n + k];
+         if (s == zero) continue;
+         s += r[k * n + k] * r[k * n + k];
+         alpha = -SIGN(sqrt(s), r[k * n + k]);
+         x0 = r[k * n + k] - alpha;
+         h = s - alpha * r[k * n + k];
+         r[k * n + k] = alpha;
+         if (k == n - 1) continue;
+         for (j = k + 1; j < n; ++j) t[j] = x0 * r[k * n + j];
+         for (i = 0; i < nb; ++i)
+            for (j = k + 1; j < n; ++j) t[j] += g[i * n + k] * g[i * n + j];
+         for (j = k + 1; j < n; ++j)
+            {
+            t[j] /= h;
+            r[k * n + j] -= t[j] * x0;
+            }
+         for (i = 0; i < nb; ++i)
+            for (j = k + 1; j < n; ++j) g[i * n + j] -= t[j] * g[i * n + k];
+         }
+      }
+   goto DecompR;
+   }
+
+/* Householder QR of a copy of a, g = Q.R.  Reflector k is
+   I - x.x(T)/hv[k], x kept in column k of g from row k down;
+   the diagonal of R goes to rv1[n+k]. */
+hv = rv1 + 6 * n;
+for (i = 0; i < m; ++i)
+   for (j = 0; j < n; ++j) g[(long) i * n + j] = a[i * nm + j];
+for (k = 0; k < n; ++k)
+   {
+   s = zero;
+   for (i = k; i < m; ++i) s += g[(long) i * n + k] * g[(long) i * n + k];
+   if (s == zero)
+      {
+      hv[k] = zero;
+      rv1[n + k] = zero;
+      continue;
+      }
+   alpha = -SIGN(sqrt(s), g[k * n + k]);
+   hv[k] = s - alpha * g[k * n + k];
+   g[k * n + k] -= alpha;
+   rv1[n + k] = alpha;
+   if (k < n - 1)
+      svrank1 (g, n, k, m - 1, k + 1, n - 1, g + k, n, g + k, n,
+               -hv[k], one, rv1);
+   }
+for (i = 0; i < n; ++i)
+   {
+   for (j = 0; j < i; ++j) r[i * n + j] = zero;
+   r[i * n + i] = rv1[n + i];
+   for (j = i + 1; j < n; ++j) r[i * n + j] = g[i * n + j];
+   }
+
+/* Decompose R = Ur.S.V(T), then u = Q.Ur. */
+DecompR:
+*ierr = svdgr (n, n, n, r, w, matu, r, matv, vr, rv1);
+if (matu)
+   {
+   for (i = 0; i < m; ++i)
+      for (j = 0; j < n; ++j)
+         u[i * nm + j] = (i < n) ? r[i * n + j] : zero;
+   for (k = n - 1; k >= 0; --k)
+      {
+      if (hv[k] == zero) continue;
+      svrank1 (u, nm, k, m - 1, 0, n - 1, g + k, n, g + k, n,
+               -hv[k], one, rv1);
+      }
+   }
+if (matv)
+   {
+   for (i = 0; i < n; ++i)
+      for (j = 0; j < n; ++j) v[i * nm + j] = vr[i * n + j];
+   }
+
+LeaveSvd:
+if (vr  != NULL) { free(vr);  vr = NULL; }
+if (r   != NULL) { free(r);  r = NULL; }
+if (g   != NULL) { free(g);  g = NULL; }
+if (rv1 != NULL) { free(rv1);  rv1 = NULL; }
+return (0);
+}
+
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int svdsolve (int nm, int m, int n,
+    double u[], double w[], double v[], double b[], double x[],
+    double tol, int *ierr)
+
+#else
+
+int svdsolve (nm, m, n, u, w, v, b, x, tol, ierr)
+int nm; int m; int n;
+double u[]; double w[]; double v[];
+double b[]; double x[];
+double tol;
+int *ierr;
+
+#endif
+
+/* Purpose ...
+   -------
+   Given the singular value decomposition
+                  T
+       a  =  u.s.v
+   of a real m by n rectangular matrix.  (T represents the transpose.)
+   This routine generates the solution to the linear system
+       a.x = b
+   as                 T
+       x = v . 1/s . u . b
+
+   Input ...
+   -----
+   nm    : must be set to the size of the rows of two-dimensional
+           arrays a, u and v(transpose) as declared in the calling
+           program.  Note that nm must be at least as large as the
+           maximum of m and n.
+   m     : is the number of rows of a and u and v(transpose).
+   n     : is the number of columns of a and u and the order of v.
+   u     : contains the matrix u (orthogonal column vectors) of the
+           decomposition as returned by svd().
+           u[i*nm + j] i = 0 ... m-1, j = 0 ... n-1
+   w     : contains the n (non-negative) singular values of a (the
+           diagonal elements of s) as returned by svd().
+           w[j], j = 0 ... n-1
+   v     : contains the matrix v (orthogonal) of the decomposition as
+           returned by svd().
+           v[i*nm + j] i = 0 ... m-1, j = 0 ... n-1
+   b     : The right hand side vector, b[j], j = 0 ... m-1.
+   tol   : the tolerance below which the singular values will be
+           ignored (or set to zero)
+
+   Output ...
+   ------
+   x     : The solution vector, x[j], j = 0 ... n-1.
+   ierr  : status flag
+           ierr =  0, normal return
+           ierr = -1, could not allocate memory for workspace
+           ierr = -2, invalid user input.
+
+   Workspace ...
+   ---------
+
+   This C code written by ...  Peter & Nigel,
+   ----------------------      Design Software,
+                               42 Gubberley St,
+                               Kenmore, 4069,
+                               Australia.
+
+   Version ... 1.0, 15 nov 1989
+   -------     1.1, 19 October 2026, u is read by rows
+
+   Notes ...
+   -----
+
+----------------------------------------------------------------------
+*/
+
+{  /* begin function svdsolve() */
+
+int i, j;
+double s, *tv;
+
+*ierr = 0;
+tv = (double *) NULL;
+
+if (n <= 1 || m <= 1 || (nm < n && nm < m) || u == NULL || w == NULL ||
+    v == NULL || b == NULL || x == NULL || tol <= 0.0)
+   {
+   /* illegal user input */
+   *ierr = -2;
+   goto LeaveSolve;
+   }
+
+tv = (double *) malloc (n * sizeof(double));
+if (tv == NULL)
+   {
+   *ierr = -1;
+   goto LeaveSolve;
+   }
+
+/* Calculate u(transpose) . b, a row of u at a time. */
+for (j = 0; j < n; ++j) tv[j] = 0.0;
+for (i = 0; i < m; ++i)
+   {
+   s = b[i];
+   for (j = 0; j < n; ++j) tv[j] += u[i * nm + j] * s;
+   }
+for (j = 0; j < n; ++j)
+   {
+   /* nonzero result only if w[j] is significant. */
+   if (w[j] >= tol)
+      tv[j] /= w[j];  /* divide by singular value */
+   else
+      tv[j] = 0.0;
+   }
+
+/* Matrix multiply by v to get x. */
+for (j = 0; j < n; ++j)
+   {
+   s = 0.0;
+   for (i = 0; i < n; ++i) s += v[j * nm + i] * tv[i];
+   x[j] = s;
+   }
+
+LeaveSolve:
+if (tv != NULL) { free(tv);  tv = NULL; }
+return (0);
+}  /* end of svdsolve() */
+
+/*-----------------------------------------------------------------*/
@@ -0,0 +1,1163 @@
+/* symeig.c
+   Eigenvalues and eigenvectors of a real symmetric matrix.
+*/
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+
+#include "cmath.h"
+#if (STDLIBH)
+#include <stdlib.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+#define  SIGN(a,b)  (((b) >= 0.0) ? fabs(a) : -fabs(a))
+#define  MAX(a,b)   (((a) > (b)) ? (a) : (b))
+
+/* Tridiagonal problems of order SYMEIG_DCMIN or less are solved by
+   the QL method; larger ones are split in two and merged
+   (divide and conquer).  */
+#define  SYMEIG_DCMIN  32
+
+/* The back transformation treats SYMEIG_NB columns of z at a time.
+   When compiled for OpenMP (PARALLEL in cmath.h), the rows of the
+   reduction and merges, and the blocks of columns of the back
+   transformation, are shared among threads if the work involves
+   more than SYMEIG_PMIN elements.  */
+#define  SYMEIG_NB    64
+#define  SYMEIG_PMIN  32768L
+
+/* Iteration limits for the QL method (per eigenvalue) and for
+   the roots of the secular equation.  */
+#define  SYMEIG_QLIT   30
+#define  SYMEIG_ROOTIT 200
+
+/* Eigenvalues closer than SYMEIG_GRP * norm belong to the same
+   group for the inverse iteration, and their vectors are kept
+   orthogonal.  */
+#define  SYMEIG_GRP    1.0e-3
+
+static double zero = 0.0;
+static double one  = 1.0;
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void sehouse (int m, double *x, double *tau, double *beta)
+
+#else
+
+static void sehouse (m, x, tau, beta)
+int    m;
+double *x, *tau, *beta;
+
+#endif
+
+/* Purpose ...
+   -------
+   Householder reflection I - tau.v.v(T) taking x[0 ... m-1] to
+   (beta, 0, ... 0).  v overwrites x, with v[0] = 1.  tau = 0 if
+   x is already in that form.
+*/
+
+{
+int    i;
+double s, t, alpha;
+
+s = zero;
+for (i = 1; i < m; ++i) s += x[i] * x[i];
+if (s == zero)
+   {
+   *tau = zero;
+   *beta = x[0];
+   return;
+   }
+alpha = x[0];
+*beta = sqrt (alpha * alpha + s);
+if (alpha > zero) *beta = -(*beta);
+*tau = (*beta - alpha) / *beta;
+t = one / (alpha - *beta);
+for (i = 1; i < m; ++i) x[i] *= t;
+x[0] = one;
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void setrid (int nm, int n, double *a, double *d, double *e,
+                    double *tau, double *p)
+
+#else
+
+static void setrid (nm, n, a, d, e, tau, p)
+int    nm, n;
+double *a, *d, *e, *tau, *p;
+
+#endif
+
+/* Purpose ...
+   -------
+   Reduce the full symmetric matrix a to tridiagonal form by
+   Householder reflections H(k) = I - tau[k].v.v(T), k = 0 ... n-3.
+   On exit d[] holds the diagonal and e[0 ... n-2] the off-diagonal.
+   v is left in row k of a, a[k*nm + k+1 ... n-1], with v[0] = 1.
+   p[] (2n elements) is workspace.
+   The rank-2 update of step k and the product A22.v of step k+1
+   share one pass over the rows of the trailing matrix.
+*/
+
+{
+int    i, j, k, m;
+double *x, *x1, *ai, *pn, *pt, t, vi, wi;
+
+pn = p + n;
+for (k = 0; k < n - 2; ++k)
+   {
+   m = n - k - 1;
+   x = a + (long) k * nm + k + 1;
+   if (k == 0)
+      {
+      d[0] = a[0];
+      sehouse (m, x, tau, e);
+      if (tau[0] != zero)
+         {
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(j, t, ai) \
+        if ((long) m * m > SYMEIG_PMIN)
+#endif
+         for (i = 0; i < m; ++i)
+            {
+            ai = a + (long) (1 + i) * nm + 1;
+            t = zero;
+            for (j = 0; j < m; ++j) t += ai[j] * x[j];
+            p[i] = tau[0] * t;
+            }
+         }
+      }
+
+   if (tau[k] != zero)
+      {
+      /* w = p - (tau/2)(p.v) v, stored over p; then row k+1 */
+      t = zero;
+      for (i = 0; i < m; ++i) t += p[i] * x[i];
+      t *= 0.5 * tau[k];
+      for (i = 0; i < m; ++i) p[i] -= t * x[i];
+      ai = a + (long) (k + 1) * nm + k + 1;
+      for (j = 0; j < m; ++j) ai[j] -= x[0] * p[j] + p[0] * x[j];
+      }
+
+   /* The reflection for step k+1, from the updated row k+1. */
+   x1 = a + (long) (k + 1) * nm + k + 2;
+   d[k+1] = x1[-1];
+   if (k + 1 < n - 2) sehouse (m - 1, x1, tau + k + 1, e + k + 1);
+
+   /* A22 = A22 - v.w(T) - w.v(T) on rows k+2 ..., and the next
+      p = tau.A22.v1 from the same rows. */
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(j, t, ai, vi, wi) \
+        if ((long) m * m > SYMEIG_PMIN)
+#endif
+   for (i = 1; i < m; ++i)
+      {
+      ai = a + (long) (k + 1 + i) * nm + k + 1;
+      if (tau[k] != zero)
+         {
+         vi = x[i];
+         wi = p[i];
+         for (j = 0; j < m; ++j) ai[j] -= vi * p[j] + wi * x[j];
+         }
+      if (k + 1 < n - 2 && tau[k+1] != zero)
+         {
+         t = zero;
+         for (j = 1; j < m; ++j) t += ai[j] * x1[j-1];
+         pn[i-1] = tau[k+1] * t;
+         }
+      }
+   pt = p;
+   p  = pn;
+   pn = pt;
+   }
+
+if (n >= 2)
+   {
+   d[n-2] = a[(long) (n-2) * nm + n-2];
+   e[n-2] = a[(long) (n-2) * nm + n-1];
+   }
+d[n-1] = a[(long) (n-1) * nm + n-1];
+e[n-1] = zero;
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void seback (int nm, int n, double *a, double *tau,
+                    int m, double *z)
+
+#else
+
+static void seback (nm, n, a, tau, m, z)
+int    nm, n;
+double *a, *tau;
+int    m;
+double *z;
+
+#endif
+
+/* Purpose ...
+   -------
+   Form H(0).H(1) ... H(n-3).z for the n by m matrix z.  Each block
+   of SYMEIG_NB columns of z takes all of the reflections in turn
+   while it is in cache.
+*/
+
+{
+int    jb, je, i, j, k;
+double s[SYMEIG_NB], t, *v, *zi;
+
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(je, i, j, k, s, t, v, zi) \
+        if ((long) n * m > SYMEIG_PMIN)
+#endif
+for (jb = 0; jb < m; jb += SYMEIG_NB)
+   {
+   je = (jb + SYMEIG_NB < m) ? jb + SYMEIG_NB : m;
+   for (k = n - 3; k >= 0; --k)
+      {
+      if (tau[k] == zero) continue;
+      v = a + (long) k * nm + k + 1;
+      for (j = jb; j < je; ++j) s[j-jb] = zero;
+      for (i = 0; i < n - k - 1; ++i)
+         {
+         t  = v[i];
+         zi = z + (long) (k + 1 + i) * nm;
+         for (j = jb; j < je; ++j) s[j-jb] += t * zi[j];
+         }
+      for (j = jb; j < je; ++j) s[j-jb] *= tau[k];
+      for (i = 0; i < n - k - 1; ++i)
+         {
+         t  = v[i];
+         zi = z + (long) (k + 1 + i) * nm;
+         for (j = jb; j < je; ++j) zi[j] -= s[j-jb] * t;
+         }
+      }
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static int seql (int n, double *d, double *e, double *q, int ldq)
+
+#else
+
+static int seql (n, d, e, q, ldq)
+int    n;
+double *d, *e, *q;
+int    ldq;
+
+#endif
+
+/* Purpose ...
+   -------
+   Eigenvalues of the symmetric tridiagonal matrix (d, e) by the
+   implicit QL method.  e[i] couples rows i and i+1 and e[n-1] must
+   be zero; e is destroyed.  If q is not NULL, the rotations are
+   applied to the columns of the n by n matrix q (row size ldq).
+   Returns 0, or l+1 if eigenvalue l needed too many iterations.
+   The eigenvalues are not sorted.
+   An off-diagonal element is neglected if it is small relative to
+   its neighbouring diagonal elements or to the norm of T (as in
+   LAPACK's dsteqr), so that tiny eigenvalues next to O(eps.norm)
+   couplings do not stall the iteration.
+*/
+
+{
+int    i, k, l, m, iter;
+double b, c, dd, f, g, p, r, s, anorm, *qk;
+
+anorm = zero;
+for (i = 0; i < n; ++i)
+   {
+   dd = fabs (d[i]) + fabs (e[i]) + ((i > 0) ? fabs (e[i-1]) : zero);
+   if (dd > anorm) anorm = dd;
+   }
+for (m = 0; m < n - 1; ++m)
+   if (fabs (e[m]) <= EPSILON * anorm) e[m] = zero;
+
+for (l = 0; l < n; ++l)
+   {
+   iter = 0;
+   do
+      {
+      for (m = l; m < n - 1; ++m)
+         {
+         dd = fabs (d[m]) + fabs (d[m+1]);
+         if (fabs (e[m]) <= EPSILON * dd ||
+             fabs (e[m]) <= EPSILON * anorm) break;
+         }
+      if (m != l)
+         {
+         if (iter++ == SYMEIG_QLIT) return (l + 1);
+         g = (d[l+1] - d[l]) / (2.0 * e[l]);
+         r = sqrt (g * g + one);
+         g = d[m] - d[l] + e[l] / (g + SIGN(r, g));
+         s = c = one;
+         p = zero;
+         for (i = m - 1; i >= l; --i)
+            {
+            f = s * e[i];
+            b = c * e[i];
+            r = (fabs (f) > fabs (g)) ?
+                fabs (f) * sqrt (one + (g/f) * (g/f)) :
+                ((g == zero) ? zero : fabs (g) * sqrt (one + (f/g) * (f/g)));
+            e[i+1] = r;
+            if (r == zero)
+               {
+               d[i+1] -= p;
+               e[m] = zero;
+               break;
+               }
+            s = f / r;
+            c = g / r;
+            g = d[i+1] - p;
+            r = (d[i] - g) * s + 2.0 * c * b;
+            p = s * r;
+            d[i+1] = g + p;
+            g = c * r - b;
+            if (q != NULL)
+               {
+               for (k = 0; k < n; ++k)
+                  {
+                  qk = q + (long) k * ldq;
+                  f = qk[i+1];
+                  qk[i+1] = s * qk[i] + c * f;
+                  qk[i]   = c * qk[i] - s * f;
+                  }
+               }
+            }
+         if (r == zero && i >= l) continue;
+         d[l] -= p;
+         e[l] = g;
+         e[m] = zero;
+         }
+      } while (m != l);
+   }
+return (0);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void seroot (int K, int i, double *dl, double *zl, double rho,
+                    double *delta, double *lam)
+
+#else
+
+static void seroot (K, i, dl, zl, rho, delta, lam)
+int    K, i;
+double *dl, *zl, rho, *delta, *lam;
+
+#endif
+
+/* Purpose ...
+   -------
+   Root i of the secular equation
+       1 + rho * sum (zl[j]^2 / (dl[j] - lam)) = 0,
+   with dl[] increasing, sum zl[j]^2 = 1 and rho > 0.  The root
+   lies in (dl[i], dl[i+1]), or (dl[K-1], dl[K-1] + rho) for the
+   last.  It is found relative to the nearer of its two poles, so
+   that the differences delta[j] = dl[j] - lam are accurate.
+   Newton steps are safeguarded by bisection.
+*/
+
+{
+int    j, org, it;
+double a, b, t, f, fp, bound, tau, tn;
+
+if (i < K - 1)
+   {
+   t = 0.5 * (dl[i+1] - dl[i]);
+   f = one / rho;
+   for (j = 0; j < K; ++j) f += zl[j] * zl[j] / ((dl[j] - dl[i]) - t);
+   if (f >= zero)
+      {
+      org = i;
+      a = zero;
+      b = t;
+      }
+   else
+      {
+      org = i + 1;
+      a = -t;
+      b = zero;
+      }
+   }
+else
+   {
+   org = K - 1;
+   a = zero;
+   b = rho;
+   }
+
+for (j = 0; j < K; ++j) delta[j] = dl[j] - dl[org];
+tau = 0.5 * (a + b);
+for (it = 0; it < SYMEIG_ROOTIT; ++it)
+   {
+   f = bound = one / rho;
+   fp = zero;
+   for (j = 0; j < K; ++j)
+      {
+      t = zl[j] / (delta[j] - tau);
+      f += zl[j] * t;
+      fp += t * t;
+      bound += fabs (zl[j] * t);
+      }
+   if (fabs (f) <= 8.0 * EPSILON * bound) break;
+   if (f < zero) a = tau; else b = tau;
+   tn = tau - f / fp;
+   if (tn <= a || tn >= b) tn = 0.5 * (a + b);
+   if (tn == tau) break;
+   tau = tn;
+   }
+
+for (j = 0; j < K; ++j) delta[j] -= tau;
+*lam = dl[org] + tau;
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static int semerge (int n, int k, double *d, double *q, int ldq,
+                    double rho)
+
+#else
+
+static int semerge (n, k, d, q, ldq, rho)
+int    n, k;
+double *d, *q;
+int    ldq;
+double rho;
+
+#endif
+
+/* Purpose ...
+   -------
+   Merge step of the divide and conquer method.  On entry d[] and
+   the block diagonal q hold the sorted eigensystems of the two
+   halves, of order k and n-k, and rho is the off-diagonal element
+   that was removed.  On exit they hold the eigensystem of
+       diag(d) + |rho|.u.u(T)
+   in the original basis, sorted, where u is formed from the last
+   row of the first block and the first row of the second.
+   Returns 0, or -1 if workspace could not be allocated.
+*/
+
+{
+int    i, j, r, t, K, nd, pj, *idx, *perm, *src;
+double *z, *dl, *zl, *lam, *val, *dm, *u, *qn, *qr, *g, *o;
+double c, s, tt, tol, dmax, zmax, sc;
+double o0, o1, o2, o3, *g0, *g1, *g2, *g3;
+int    ierr;
+
+ierr = 0;
+idx = (int *) malloc (3 * n * sizeof(int));
+z   = (double *) malloc (5 * n * sizeof(double));
+dm  = (double *) malloc ((long) n * n * sizeof(double));
+u   = (double *) malloc ((long) n * n * sizeof(double));
+qn  = (double *) malloc ((long) n * n * sizeof(double));
+if (idx == NULL || z == NULL || dm == NULL || u == NULL || qn == NULL)
+   {
+   ierr = -1;
+   goto LeaveSemerge;
+   }
+perm = idx + n;
+src  = idx + 2 * n;
+dl   = z + n;
+zl   = z + 2 * n;
+lam  = z + 3 * n;
+val  = z + 4 * n;
+
+/* The rank-one modifier, normalized to unit length. */
+sc = (rho >= zero) ? one : -one;
+for (i = 0; i < k; ++i) z[i] = q[(long) (k-1) * ldq + i];
+for (i = k; i < n; ++i) z[i] = sc * q[(long) k * ldq + i];
+sc = zero;
+for (i = 0; i < n; ++i) sc += z[i] * z[i];
+rho = fabs (rho) * sc;
+sc = one / sqrt (sc);
+dmax = zmax = zero;
+for (i = 0; i < n; ++i)
+   {
+   z[i] *= sc;
+   if (fabs (z[i]) > zmax) zmax = fabs (z[i]);
+   if (fabs (d[i]) > dmax) dmax = fabs (d[i]);
+   }
+tol = 8.0 * EPSILON * MAX(dmax, zmax);
+
+/* Deflation, in order of increasing d.  A tiny component of z
+   leaves the pair (d[j], column j of q) as it is.  For two close
+   values of d, a rotation of the columns zeros one component.
+   Kept indices fill idx[] from the front, deflated ones from the
+   back.  */
+indexx (n, d, perm);
+K = 0;
+nd = n;
+pj = -1;
+for (t = 0; t < n; ++t)
+   {
+   j = perm[t];
+   if (rho * fabs (z[j]) <= tol)
+      {
+      idx[--nd] = j;
+      continue;
+      }
+   if (pj < 0)
+      {
+      pj = j;
+      continue;
+      }
+   s  = z[pj];
+   c  = z[j];
+   tt = sqrt (c * c + s * s);
+   c /= tt;
+   s  = -s / tt;
+   if (fabs ((d[j] - d[pj]) * c * s) <= tol)
+      {
+      z[j]  = tt;
+      z[pj] = zero;
+      for (r = 0; r < n; ++r)
+         {
+         qr = q + (long) r * ldq;
+         o0 = qr[pj];
+         o1 = qr[j];
+         qr[pj] = c * o0 + s * o1;
+         qr[j]  = c * o1 - s * o0;
+         }
+      tt    = d[pj] * c * c + d[j] * s * s;
+      d[j]  = d[pj] * s * s + d[j] * c * c;
+      d[pj] = tt;
+      idx[--nd] = pj;
+      }
+   else
+      {
+      idx[K++] = pj;
+      }
+   pj = j;
+   }
+if (pj >= 0) idx[K++] = pj;
+
+if (K > 0)
+   {
+   for (i = 0; i < K; ++i)
+      {
+      dl[i] = d[idx[i]];
+      zl[i] = z[idx[i]];
+      }
+
+   /* Roots of the secular equation; row i of dm holds dl[] - lam[i]. */
+#if (PARALLEL)
+#pragma omp parallel for schedule(dynamic, 8) if ((long) K * K > SYMEIG_PMIN)
+#endif
+   for (i = 0; i < K; ++i)
+      seroot (K, i, dl, zl, rho, dm + (long) i * K, lam + i);
+
+   /* Recompute z from the roots (Gu and Eisenstat) so that the
+      vectors are orthogonal to working precision; keep it in val. */
+   for (i = 0; i < K; ++i)
+      {
+      s = -dm[(long) i * K + i];
+      for (j = 0; j < K; ++j)
+         {
+         if (j == i) continue;
+         s *= -dm[(long) j * K + i] / (dl[j] - dl[i]);
+         }
+      val[i] = SIGN(sqrt (fabs (s)), zl[i]);
+      }
+
+   /* Eigenvectors of the modified diagonal matrix, column j of u. */
+   for (j = 0; j < K; ++j)
+      {
+      s = zero;
+      for (i = 0; i < K; ++i)
+         {
+         tt = val[i] / dm[(long) j * K + i];
+         u[(long) i * K + j] = tt;
+         s += tt * tt;
+         }
+      s = one / sqrt (s);
+      for (i = 0; i < K; ++i) u[(long) i * K + j] *= s;
+      }
+
+   /* The kept columns of q, gathered into qn, times u, into dm. */
+   for (r = 0; r < n; ++r)
+      {
+      qr = q + (long) r * ldq;
+      g  = qn + (long) r * K;
+      for (i = 0; i < K; ++i) g[i] = qr[idx[i]];
+      }
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) \
+        private(i, j, t, g0, g1, g2, g3, o, o0, o1, o2, o3) \
+        if ((long) n * K > SYMEIG_PMIN / 8)
+#endif
+   for (r = 0; r < n; r += 4)
+      {
+      t = (r + 4 <= n) ? 4 : n - r;
+      g0 = qn + (long) r * K;
+      g1 = (t > 1) ? g0 + K : g0;
+      g2 = (t > 2) ? g1 + K : g1;
+      g3 = (t > 3) ? g2 + K : g2;
+      for (j = 0; j < K; ++j)
+         {
+         o0 = o1 = o2 = o3 = zero;
+         for (i = 0; i < K; ++i)
+            {
+            o = u + (long) i * K + j;
+            o0 += g0[i] * (*o);
+            o1 += g1[i] * (*o);
+            o2 += g2[i] * (*o);
+            o3 += g3[i] * (*o);
+            }
+         dm[(long) r * K + j] = o0;
+         if (t > 1) dm[(long) (r+1) * K + j] = o1;
+         if (t > 2) dm[(long) (r+2) * K + j] = o2;
+         if (t > 3) dm[(long) (r+3) * K + j] = o3;
+         }
+      }
+   }
+
+/* Sort the new eigenvalues together with the deflated ones.
+   src[] >= 0 refers to a column of dm, src[] < 0 to column
+   -src[]-1 of q.  */
+for (i = 0; i < K; ++i)
+   {
+   val[i] = lam[i];
+   src[i] = i;
+   }
+for (i = K; i < n; ++i)
+   {
+   val[i] = d[idx[i]];
+   src[i] = -idx[i] - 1;
+   }
+indexx (n, val, perm);
+for (r = 0; r < n; ++r)
+   {
+   qr = q + (long) r * ldq;
+   g  = qn + (long) r * n;
+   for (t = 0; t < n; ++t)
+      {
+      j = src[perm[t]];
+      g[t] = (j >= 0) ? dm[(long) r * K + j] : qr[-j-1];
+      }
+   }
+for (r = 0; r < n; ++r)
+   {
+   qr = q + (long) r * ldq;
+   g  = qn + (long) r * n;
+   for (t = 0; t < n; ++t) qr[t] = g[t];
+   }
+for (t = 0; t < n; ++t) d[t] = val[perm[t]];
+
+LeaveSemerge:
+if (idx != NULL) free (idx);
+if (z != NULL) free (z);
+if (dm != NULL) free (dm);
+if (u != NULL) free (u);
+if (qn != NULL) free (qn);
+return (ierr);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static int sedc (int n, double *d, double *e, double *q, int ldq)
+
+#else
+
+static int sedc (n, d, e, q, ldq)
+int    n;
+double *d, *e, *q;
+int    ldq;
+
+#endif
+
+/* Purpose ...
+   -------
+   Eigenvalues (sorted, in d) and eigenvectors (the columns of the
+   n by n matrix q, row size ldq) of the symmetric tridiagonal
+   matrix (d, e) by the divide and conquer method of Cuppen.
+   e[0 ... n-2] is destroyed.  Returns 0, -1 if workspace could
+   not be allocated, or > 0 if the QL method failed on a block.
+*/
+
+{
+int    i, j, k, ierr;
+double rho, t, *qi;
+
+if (n <= SYMEIG_DCMIN)
+   {
+   for (i = 0; i < n; ++i)
+      {
+      qi = q + (long) i * ldq;
+      for (j = 0; j < n; ++j) qi[j] = zero;
+      qi[i] = one;
+      }
+   e[n-1] = zero;
+   ierr = seql (n, d, e, q, ldq);
+   if (ierr != 0) return (ierr);
+
+   /* Selection sort of the small eigensystem. */
+   for (i = 0; i < n - 1; ++i)
+      {
+      k = i;
+      for (j = i + 1; j < n; ++j) if (d[j] < d[k]) k = j;
+      if (k == i) continue;
+      t = d[i];
+      d[i] = d[k];
+      d[k] = t;
+      for (j = 0; j < n; ++j)
+         {
+         qi = q + (long) j * ldq;
+         t = qi[i];
+         qi[i] = qi[k];
+         qi[k] = t;
+         }
+      }
+   return (0);
+   }
+
+/* Tear the matrix at row k: T = diag(T1, T2) + |rho|.u.u(T). */
+k = n / 2;
+rho = e[k-1];
+d[k-1] -= fabs (rho);
+d[k]   -= fabs (rho);
+
+ierr = sedc (k, d, e, q, ldq);
+if (ierr != 0) return (ierr);
+ierr = sedc (n - k, d + k, e + k, q + (long) k * ldq + k, ldq);
+if (ierr != 0) return (ierr);
+
+for (i = 0; i < k; ++i)
+   {
+   qi = q + (long) i * ldq;
+   for (j = k; j < n; ++j) qi[j] = zero;
+   }
+for (i = k; i < n; ++i)
+   {
+   qi = q + (long) i * ldq;
+   for (j = 0; j < k; ++j) qi[j] = zero;
+   }
+
+return (semerge (n, k, d, q, ldq, rho));
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static int sesturm (int n, double *d, double *e2, double pivmin,
+                    double x)
+
+#else
+
+static int sesturm (n, d, e2, pivmin, x)
+int    n;
+double *d, *e2, pivmin, x;
+
+#endif
+
+/* Purpose ...
+   -------
+   The number of eigenvalues of the tridiagonal matrix (d, e) that
+   are less than x, from the signs of the pivots of T - x.I.
+   e2[i] = e[i]^2.
+*/
+
+{
+int    i, count;
+double p;
+
+p = d[0] - x;
+if (fabs (p) < pivmin) p = -pivmin;
+count = (p < zero) ? 1 : 0;
+for (i = 1; i < n; ++i)
+   {
+   p = d[i] - x - e2[i-1] / p;
+   if (fabs (p) < pivmin) p = -pivmin;
+   if (p < zero) ++count;
+   }
+return (count);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void seinvit (int n, double *d, double *e, double lam,
+                     double eps, double *x, double *w)
+
+#else
+
+static void seinvit (n, d, e, lam, eps, x, w)
+int    n;
+double *d, *e, lam, eps, *x, *w;
+
+#endif
+
+/* Purpose ...
+   -------
+   Solve (T - lam.I).y = x for the tridiagonal T = (d, e) by
+   Gaussian elimination with partial pivoting, and overwrite x
+   with y.  Pivots smaller than eps in magnitude are replaced by
+   eps with their sign, so that y stays finite when lam is an
+   exact eigenvalue.  w[] (4n elements) is workspace.
+*/
+
+{
+int    i;
+double c, s, sub, dn, sn, m, t;
+double *u1, *u2, *u3, *mult;
+
+u1 = w;
+u2 = w + n;
+u3 = w + 2 * n;
+mult = w + 3 * n;
+
+c = d[0] - lam;
+s = (n > 1) ? e[0] : zero;
+for (i = 0; i < n - 1; ++i)
+   {
+   sub = e[i];
+   dn  = d[i+1] - lam;
+   sn  = (i + 2 < n) ? e[i+1] : zero;
+   if (fabs (c) >= fabs (sub))
+      {
+      if (fabs (c) < eps) c = (c < zero) ? -eps : eps;
+      m = sub / c;
+      u1[i] = c;
+      u2[i] = s;
+      u3[i] = zero;
+      c = dn - m * s;
+      s = sn;
+      mult[i] = m;
+      }
+   else
+      {
+      /* Interchange rows i and i+1, and the elements of x. */
+      m = c / sub;
+      u1[i] = sub;
+      u2[i] = dn;
+      u3[i] = sn;
+      c = s - m * dn;
+      s = -m * sn;
+      mult[i] = m;
+      t = x[i];
+      x[i] = x[i+1];
+      x[i+1] = t;
+      }
+   x[i+1] -= mult[i] * x[i];
+   }
+if (fabs (c) < eps) c = (c < zero) ? -eps : eps;
+u1[n-1] = c;
+
+/* Back substitution with the upper triangle (u1, u2, u3). */
+x[n-1] /= u1[n-1];
+if (n > 1) x[n-2] = (x[n-2] - u2[n-2] * x[n-1]) / u1[n-2];
+for (i = n - 3; i >= 0; --i)
+   x[i] = (x[i] - u2[i] * x[i+1] - u3[i] * x[i+2]) / u1[i];
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int symeig (int nm, int n, double a[], double w[],
+            int matz, double z[], int il, int iu, int *ierr)
+
+#else
+
+int symeig (nm, n, a, w, matz, z, il, iu, ierr)
+int    nm, n;
+double a[], w[];
+int    matz;
+double z[];
+int    il, iu;
+int    *ierr;
+
+#endif
+
+/* Purpose ...
+   -------
+   Compute the eigenvalues, and optionally the eigenvectors, of a
+   real symmetric matrix.  Either all of them or those with indices
+   il ... iu (counting from the smallest) may be requested.
+
+   Input ...
+   -----
+   nm    : the size of the rows of a and z as declared in the
+           calling program, nm >= n
+   n     : the order of the matrix
+   a     : the matrix, a[i*nm + j] i, j = 0 ... n-1.  Only the
+           lower triangle (j <= i) is referenced.
+   matz  : 1 if the eigenvectors are wanted, 0 otherwise
+   il    : index of the first eigenvalue wanted, 0 <= il
+   iu    : index of the last eigenvalue wanted, il <= iu <= n-1.
+           il = 0, iu = n-1 gives all of them.
+
+   Output ...
+   ------
+   a     : the contents are destroyed
+   w     : the eigenvalues il ... iu in ascending order,
+           w[j], j = 0 ... iu-il
+   z     : if matz == 1, the orthonormal eigenvectors,
+           z[i*nm + j] i = 0 ... n-1, j = 0 ... iu-il, column j
+           belonging to w[j].  Not referenced if matz == 0.
+   ierr  : status flag
+           ierr =  0, normal return
+           ierr >  0, the QL iteration for a tridiagonal block did
+                      not converge
+           ierr = -1, could not allocate memory for workspace
+           ierr = -2, invalid user input.
+
+   Workspace ...
+   ---------
+   5n doubles, and n integers when there are no vectors.  When all
+   of the eigenvectors are wanted, each merge of the divide and
+   conquer method allocates a further 3n^2 doubles for its order n;
+   with a subset of them, (m + 4)n doubles for m = iu-il+1.
+
+   Version ... 1.0, 19 October 2026
+   -------
+
+   Notes ...
+   -----
+   (1) The matrix is reduced to tridiagonal form T by Householder
+       reflections.  The updates of the trailing matrix, and the
+       back transformation of the vectors, are shared among threads
+       when compiled for OpenMP.
+   (2) All eigenvalues without vectors: QL method on T, O(n^2).
+       All eigenvalues with vectors: Cuppen's divide and conquer
+       on T with the deflation of Dongarra and Sorensen and the
+       vectors of Gu and Eisenstat.  Its cost is dominated by a
+       matrix product per merge, usually much less than the QL
+       method's accumulation of rotations.
+       A subset: bisection with Sturm counts, then (if matz == 1)
+       inverse iteration, with vectors of close eigenvalues kept
+       orthogonal.
+   (3) Unlike qr() and qrv(), the results are real; there is no
+       wi[] and the vectors need no qrvector().
+   (4) References:
+       J.J.M. Cuppen, A divide and conquer method for the symmetric
+       tridiagonal eigenproblem.  Numer. Math. 36 (1981) 177-195.
+       M. Gu and S.C. Eisenstat, A divide-and-conquer algorithm for
+       the symmetric tridiagonal eigenproblem.  SIAM J. Matrix Anal.
+       Appl. 16 (1995) 172-191.
+*/
+
+{  /* begin function symeig() */
+
+int    i, j, k, m, it, g0, *indx;
+double *d, *e, *tau, *p, *ws, *x, *xj;
+double s, t, norm, pivmin, lo, hi, mid, lam, eps, sep, *ai;
+
+*ierr = 0;
+d = ws = (double *) NULL;
+indx = (int *) NULL;
+
+if (n < 1 || nm < n || a == NULL || w == NULL ||
+    il < 0 || iu < il || iu > n - 1 || (matz && z == NULL))
+   {
+   /* illegal user input */
+   *ierr = -2;
+   goto LeaveSymeig;
+   }
+m = iu - il + 1;
+
+d = (double *) malloc (5 * n * sizeof(double));
+if (d == NULL)
+   {
+   *ierr = -1;
+   goto LeaveSymeig;
+   }
+e   = d + n;
+tau = d + 2 * n;
+p   = d + 3 * n;
+
+/* Fill in the upper triangle and reduce. */
+for (i = 0; i < n; ++i)
+   {
+   ai = a + (long) i * nm;
+   for (j = 0; j < i; ++j) a[(long) j * nm + i] = ai[j];
+   }
+setrid (nm, n, a, d, e, tau, p);
+
+norm = zero;
+for (i = 0; i < n; ++i)
+   {
+   t = fabs (d[i]) + fabs (e[i]) + ((i > 0) ? fabs (e[i-1]) : zero);
+   if (t > norm) norm = t;
+   }
+
+if (m == n && matz == 0)
+   {
+   /* All eigenvalues by QL. */
+   *ierr = seql (n, d, e, (double *) NULL, 0);
+   if (*ierr != 0) goto LeaveSymeig;
+   indx = (int *) malloc (n * sizeof(int));
+   if (indx == NULL)
+      {
+      *ierr = -1;
+      goto LeaveSymeig;
+      }
+   if (n > 1) indexx (n, d, indx); else indx[0] = 0;
+   for (i = 0; i < n; ++i) w[i] = d[indx[i]];
+   }
+else if (m == n)
+   {
+   /* All eigenpairs by divide and conquer, on T scaled to unit
+      norm, then back to a. */
+   if (norm == zero)
+      {
+      for (i = 0; i < n; ++i)
+         {
+         w[i] = zero;
+         for (j = 0; j < n; ++j) z[(long) i * nm + j] = zero;
+         z[(long) i * nm + i] = one;
+         }
+      goto LeaveSymeig;
+      }
+   for (i = 0; i < n; ++i)
+      {
+      d[i] /= norm;
+      e[i] /= norm;
+      }
+   *ierr = sedc (n, d, e, z, nm);
+   if (*ierr != 0) goto LeaveSymeig;
+   for (i = 0; i < n; ++i) w[i] = d[i] * norm;
+   seback (nm, n, a, tau, n, z);
+   }
+else
+   {
+   /* Bisection for eigenvalues il ... iu; p[] holds e^2. */
+   pivmin = 1.0e-290;
+   lo = hi = d[0];
+   for (i = 0; i < n; ++i)
+      {
+      t = fabs (e[i]) + ((i > 0) ? fabs (e[i-1]) : zero);
+      if (d[i] - t < lo) lo = d[i] - t;
+      if (d[i] + t > hi) hi = d[i] + t;
+      p[i] = e[i] * e[i];
+      if (p[i] * 1.0e-290 > pivmin) pivmin = p[i] * 1.0e-290;
+      }
+   t = 2.0 * EPSILON * MAX(fabs (lo), fabs (hi)) + pivmin;
+   lo -= t;
+   hi += t;
+
+#if (PARALLEL)
+#pragma omp parallel for schedule(dynamic, 4) private(s, t, mid) \
+        if ((long) n * m > SYMEIG_PMIN / 64)
+#endif
+   for (k = 0; k < m; ++k)
+      {
+      s = lo;
+      t = hi;
+      while (t - s > 2.0 * EPSILON * (fabs (s) + fabs (t)) + pivmin)
+         {
+         mid = 0.5 * (s + t);
+         if (mid <= s || mid >= t) break;
+         if (sesturm (n, d, p, pivmin, mid) > il + k) t = mid;
+         else s = mid;
+         }
+      w[k] = 0.5 * (s + t);
+      }
+
+   if (matz)
+      {
+      /* Inverse iteration; the vectors are built as the rows of
+         x and transposed into z.  */
+      ws = (double *) malloc (((long) m * n + 4 * n) * sizeof(double));
+      if (ws == NULL)
+         {
+         *ierr = -1;
+         goto LeaveSymeig;
+         }
+      x = ws + 4 * n;
+      eps = EPSILON * MAX(norm, 1.0e-290);
+      sep = SYMEIG_GRP * norm;
+      g0 = 0;
+      lam = zero;
+      for (k = 0; k < m; ++k)
+         {
+         /* Start of a new group of close eigenvalues?  Nearly
+            equal ones are shifted apart a little. */
+         if (k == 0 || w[k] - w[k-1] > sep)
+            {
+            g0 = k;
+            lam = w[k];
+            }
+         else
+            {
+            lam = w[k];
+            if (lam - w[k-1] < 10.0 * eps) lam = w[k-1] + 10.0 * eps;
+            }
+         xj = x + (long) k * n;
+         for (i = 0; i < n; ++i)
+            xj[i] = one + 0.5 * cos ((double) (i + 1) * (k + 1));
+         for (it = 0; it < 3; ++it)
+            {
+            seinvit (n, d, e, lam, eps, xj, ws);
+            for (j = g0; j < k; ++j)
+               {
+               s = zero;
+               for (i = 0; i < n; ++i) s += x[(long) j * n + i] * xj[i];
+               for (i = 0; i < n; ++i) xj[i] -= s * x[(long) j * n + i];
+               }
+            /* Normalize, scaling by the largest element first. */
+            t = zero;
+            for (i = 0; i < n; ++i) if (fabs (xj[i]) > t) t = fabs (xj[i]);
+            if (t > zero)
+               {
+               t = one / t;
+               s = zero;
+               for (i = 0; i < n; ++i)
+                  {
+                  xj[i] *= t;
+                  s += xj[i] * xj[i];
+                  }
+               s = one / sqrt (s);
+               }
+            else s = zero;
+            for (i = 0; i < n; ++i) xj[i] *= s;
+            }
+         }
+      for (i = 0; i < n; ++i)
+         for (k = 0; k < m; ++k)
+            z[(long) i * nm + k] = x[(long) k * n + i];
+      seback (nm, n, a, tau, m, z);
+      }
+   }
+
+LeaveSymeig:
+if (d != NULL) free (d);
+if (ws != NULL) free (ws);
+if (indx != NULL) free (indx);
+return (0);
+}  /* end of symeig() */
+
+/*-----------------------------------------------------------------*/
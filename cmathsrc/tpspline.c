@@ -0,0 +1,677 @@
+/* tpspline.c
+   Tensor-product bicubic and tricubic interpolating splines. */
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+#include "cmath.h"
+#if (STDLIBH)
+#include <stdlib.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static int tpseg (int n, double x[], double u, int *last)
+
+#else
+
+static int tpseg (n, x, u, last)
+int    n;
+double x[], u;
+int    *last;
+
+#endif
+
+/* Purpose ...
+   -------
+   Find the segment i, 0 <= i <= n-2, with x[i] <= u <= x[i+1].
+   The search starts from *last, as in seval().  Points beyond the
+   ends are put in the first or last segment.
+*/
+
+{
+int i, j, k;
+
+i = *last;
+if (i > n-2) i = 0;
+if (i < 0)   i = 0;
+
+if ((x[i] > u) || (x[i+1] < u))
+  {  /* ---- perform a binary search ---- */
+  i = 0;
+  j = n;
+  do
+    {
+    k = (i + j) / 2;         /* split the domain to search */
+    if (u < x[k])  j = k;    /* move the upper bound */
+    if (u >= x[k]) i = k;    /* move the lower bound */
+    }                        /* there are no more segments to search */
+  while (j > i+1);
+  if (i > n-2) i = n-2;
+  }
+*last = i;
+return (i);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int spl2make (int nx, int ny,
+              double x[], double y[], double f[],
+              struct SPL2STRC *s, int *flag)
+
+#else
+
+int spl2make (nx, ny, x, y, f, s, flag)
+
+int    nx, ny;
+double x[], y[], f[];
+struct SPL2STRC *s;
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Set up the bicubic spline interpolating the table
+   f(x[i], y[j]) = f[i*ny + j], i = 0 .. nx-1, j = 0 .. ny-1.
+
+   In the cell x[i] <= u <= x[i+1], y[j] <= v <= y[j+1]
+
+   S(u,v) = sum  sum  coef[(i*(ny-1) + j)*16 + p*4 + q] * wx**p * wy**q
+             p    q
+   where wx = u - x[i], wy = v - y[j], p, q = 0 .. 3.
+
+   Input :
+   -------
+   nx, ny  : the number of knots along each axis (>= 2)
+   x[], y[]: the knots along each axis in strictly increasing order
+   f[]     : the table of values, stored with y varying fastest
+
+   Output :
+   --------
+   s       : the spline.  Its memory should be released with
+             spl2dest() when no longer required.
+   flag    : status flag
+            = 0 normal return
+            = 1 less than two knots along an axis
+            = 2 x[] or y[] are not in ascending order
+            = 3 could not allocate memory
+
+   Version ... 1.0, 19 October 2026
+
+   Notes ...
+   -----
+   (1) spline() (with its default end conditions) is applied to
+       each line of data along x, and then to each of the resulting
+       coefficients along y.  The result is the tensor product of
+       the 1-D splines and is the same whichever axis is done first.
+   (2) The 16 coefficients of each cell are contiguous so that an
+       evaluation touches a single block of memory.
+*/
+
+/*----------------------------------------------------------------*/
+
+{  /* begin procedure spl2make() */
+
+int    i, j, p, ncx, ncy, nmax;
+double *a, *t, *b, *c, *d, *cc;
+
+*flag  = 0;
+a      = NULL;
+t      = NULL;
+s->x   = NULL;
+s->y   = NULL;
+s->coef = NULL;
+
+if (nx < 2 || ny < 2)
+   {
+   *flag = 1;
+   goto LeaveSpl2make;
+   }
+ncx  = nx - 1;
+ncy  = ny - 1;
+nmax = (nx > ny) ? nx : ny;
+
+s->nx   = nx;
+s->ny   = ny;
+s->x    = (double *) malloc (nx * sizeof(double));
+s->y    = (double *) malloc (ny * sizeof(double));
+s->coef = (double *) malloc (16 * ncx * ncy * sizeof(double));
+a       = (double *) malloc (4 * ncx * ny * sizeof(double));
+t       = (double *) malloc (4 * nmax * sizeof(double));
+if (s->x == NULL || s->y == NULL || s->coef == NULL ||
+    a == NULL || t == NULL)
+   {
+   *flag = 3;
+   goto LeaveSpl2make;
+   }
+b = t + nmax;
+c = b + nmax;
+d = c + nmax;
+for (i = 0; i < nx; ++i) s->x[i] = x[i];
+for (j = 0; j < ny; ++j) s->y[j] = y[j];
+
+/* ---- Splines along x : a[(p*ncx + i)*ny + j] ---- */
+for (j = 0; j < ny; ++j)
+   {
+   for (i = 0; i < nx; ++i) t[i] = f[i*ny + j];
+   spline (nx, 0, 0, 0.0, 0.0, x, t, b, c, d, flag);
+   if (*flag != 0) goto LeaveSpl2make;
+   for (i = 0; i < ncx; ++i)
+      {
+      a[(0*ncx + i)*ny + j] = t[i];
+      a[(1*ncx + i)*ny + j] = b[i];
+      a[(2*ncx + i)*ny + j] = c[i];
+      a[(3*ncx + i)*ny + j] = d[i];
+      }
+   }
+
+/* ---- Splines of each x-coefficient along y ---- */
+for (i = 0; i < ncx; ++i)
+   {
+   for (p = 0; p < 4; ++p)
+      {
+      for (j = 0; j < ny; ++j) t[j] = a[(p*ncx + i)*ny + j];
+      spline (ny, 0, 0, 0.0, 0.0, y, t, b, c, d, flag);
+      if (*flag != 0) goto LeaveSpl2make;
+      for (j = 0; j < ncy; ++j)
+         {
+         cc    = s->coef + (i*ncy + j)*16 + p*4;
+         cc[0] = t[j];
+         cc[1] = b[j];
+         cc[2] = c[j];
+         cc[3] = d[j];
+         }
+      }
+   }
+
+LeaveSpl2make:
+if (t != NULL) { free(t); t = NULL; }
+if (a != NULL) { free(a); a = NULL; }
+if (*flag != 0) spl2dest (s);
+return 0;
+}  /* end of spl2make() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int spl2dest (struct SPL2STRC *s)
+
+#else
+
+int spl2dest (s)
+
+struct SPL2STRC *s;
+
+#endif
+
+/* Purpose ...
+   -------
+   Release the memory held by a bicubic spline structure.
+*/
+
+{
+if (s->x    != NULL) { free(s->x);    s->x = NULL; }
+if (s->y    != NULL) { free(s->y);    s->y = NULL; }
+if (s->coef != NULL) { free(s->coef); s->coef = NULL; }
+return 0;
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+double spl2eval (double u, double v, struct SPL2STRC *s,
+                 int *lastx, int *lasty)
+
+#else
+
+double spl2eval (u, v, s, lastx, lasty)
+
+double u, v;
+struct SPL2STRC *s;
+int    *lastx, *lasty;
+
+#endif
+
+/* Purpose ...
+   -------
+   Evaluate the bicubic spline at (u, v).
+
+   Input :
+   -------
+   u, v    : the point at which the spline is to be evaluated
+   s       : the spline set up by spl2make()
+   lastx,
+   lasty   : the segments along each axis used by the last call
+
+   Output :
+   --------
+   spl2eval : the value of the spline at (u, v)
+   lastx,
+   lasty    : the segments in which u and v lie
+
+   Notes ...
+   -----
+   (1) As for seval(), a binary search is done only when a
+       coordinate is not in the same segment as before.
+   (2) Points outside the table are extrapolated from the
+       nearest cell.
+*/
+
+{
+int    i, j, p;
+double wx, wy, r, *cc;
+
+i  = tpseg (s->nx, s->x, u, lastx);
+j  = tpseg (s->ny, s->y, v, lasty);
+wx = u - s->x[i];
+wy = v - s->y[j];
+cc = s->coef + (i*(s->ny - 1) + j)*16;
+
+r = 0.0;
+for (p = 3; p >= 0; --p)
+   r = r * wx + (cc[p*4] + wy * (cc[p*4+1] + wy * (cc[p*4+2] + wy * cc[p*4+3])));
+return (r);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int spl2evalv (struct SPL2STRC *s, int n,
+               double u[], double v[], double f[])
+
+#else
+
+int spl2evalv (s, n, u, v, f)
+
+struct SPL2STRC *s;
+int    n;
+double u[], v[], f[];
+
+#endif
+
+/* Purpose ...
+   -------
+   Evaluate the bicubic spline at the n points (u[k], v[k]),
+   returning the values in f[k].  The segment search along each
+   axis starts from the segment of the previous point, so points
+   that move along a line or sweep a region cost almost no
+   searching.
+*/
+
+{
+int k, lastx, lasty;
+
+lastx = 0;
+lasty = 0;
+for (k = 0; k < n; ++k) f[k] = spl2eval (u[k], v[k], s, &lastx, &lasty);
+return 0;
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int spl2grid (struct SPL2STRC *s, int nu, double u[],
+              int nv, double v[], double f[], int *flag)
+
+#else
+
+int spl2grid (s, nu, u, nv, v, f, flag)
+
+struct SPL2STRC *s;
+int    nu;
+double u[];
+int    nv;
+double v[], f[];
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Evaluate the bicubic spline on the grid u[a] x v[b], returning
+   f[a*nv + b].  The segment of each u[a] and v[b] is found once
+   only, and for each u[a] the cell coefficients are reduced to a
+   cubic in v before the values along v are computed.
+
+   Output :
+   --------
+   f       : the values on the grid
+   flag    : = 0 normal return
+             = 3 could not allocate workspace
+*/
+
+{
+int    a, b, p, q, last, *jv, ncy;
+double *wv, wx, g[4], *cc;
+
+*flag = 0;
+ncy   = s->ny - 1;
+jv    = (int *) malloc (nv * sizeof(int));
+wv    = (double *) malloc (nv * sizeof(double));
+if (jv == NULL || wv == NULL)
+   {
+   *flag = 3;
+   goto LeaveSpl2grid;
+   }
+
+last = 0;
+for (b = 0; b < nv; ++b)
+   {
+   jv[b] = tpseg (s->ny, s->y, v[b], &last);
+   wv[b] = v[b] - s->y[jv[b]];
+   }
+
+last = 0;
+for (a = 0; a < nu; ++a)
+   {
+   p  = tpseg (s->nx, s->x, u[a], &last);
+   wx = u[a] - s->x[p];
+   cc = s->coef + p*ncy*16;
+   for (b = 0; b < nv; ++b)
+      {
+      if (b == 0 || jv[b] != jv[b-1])
+         {  /* collapse the cell to a cubic in wy */
+         for (q = 0; q < 4; ++q)
+            g[q] = cc[jv[b]*16 + q] + wx * (cc[jv[b]*16 + 4 + q] +
+                   wx * (cc[jv[b]*16 + 8 + q] + wx * cc[jv[b]*16 + 12 + q]));
+         }
+      f[a*nv + b] = g[0] + wv[b] * (g[1] + wv[b] * (g[2] + wv[b] * g[3]));
+      }
+   }
+
+LeaveSpl2grid:
+if (wv != NULL) { free(wv); wv = NULL; }
+if (jv != NULL) { free(jv); jv = NULL; }
+return 0;
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int spl3make (int nx, int ny, int nz,
+              double x[], double y[], double z[], double f[],
+              struct SPL3STRC *s, int *flag)
+
+#else
+
+int spl3make (nx, ny, nz, x, y, z, f, s, flag)
+
+int    nx, ny, nz;
+double x[], y[], z[], f[];
+struct SPL3STRC *s;
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Set up the tricubic spline interpolating the table
+   f(x[i], y[j], z[k]) = f[(i*ny + j)*nz + k].
+
+   In the cell (i, j, k)
+
+   S(u,v,w) = sum  sum  sum  coef[cell*64 + p*16 + q*4 + r]
+               p    q    r        * wx**p * wy**q * wz**r
+   where cell = (i*(ny-1) + j)*(nz-1) + k
+   and   wx = u - x[i], wy = v - y[j], wz = w - z[k].
+
+   Input :
+   -------
+   nx, ny, nz : the number of knots along each axis (>= 2)
+   x, y, z    : the knots along each axis in strictly
+                increasing order
+   f[]        : the table of values, stored with z varying
+                fastest and x slowest
+
+   Output :
+   --------
+   s       : the spline.  Its memory should be released with
+             spl3dest() when no longer required.
+   flag    : status flag, as for spl2make()
+
+   Notes ...
+   -----
+   (1) As for spl2make(), spline() is applied along x, then along
+       y and lastly along z.  The 64 coefficients of each cell are
+       contiguous.
+*/
+
+/*----------------------------------------------------------------*/
+
+{  /* begin procedure spl3make() */
+
+int    i, j, k, p, q, ncx, ncy, ncz, nmax;
+double *a1, *a2, *t, *b, *c, *d, *cc;
+
+*flag   = 0;
+a1      = NULL;
+a2      = NULL;
+t       = NULL;
+s->x    = NULL;
+s->y    = NULL;
+s->z    = NULL;
+s->coef = NULL;
+
+if (nx < 2 || ny < 2 || nz < 2)
+   {
+   *flag = 1;
+   goto LeaveSpl3make;
+   }
+ncx  = nx - 1;
+ncy  = ny - 1;
+ncz  = nz - 1;
+nmax = (nx > ny) ? nx : ny;
+if (nz > nmax) nmax = nz;
+
+s->nx   = nx;
+s->ny   = ny;
+s->nz   = nz;
+s->x    = (double *) malloc (nx * sizeof(double));
+s->y    = (double *) malloc (ny * sizeof(double));
+s->z    = (double *) malloc (nz * sizeof(double));
+s->coef = (double *) malloc (64 * ncx * ncy * ncz * sizeof(double));
+a1      = (double *) malloc (4 * ncx * ny * nz * sizeof(double));
+a2      = (double *) malloc (16 * ncx * ncy * nz * sizeof(double));
+t       = (double *) malloc (4 * nmax * sizeof(double));
+if (s->x == NULL || s->y == NULL || s->z == NULL || s->coef == NULL ||
+    a1 == NULL || a2 == NULL || t == NULL)
+   {
+   *flag = 3;
+   goto LeaveSpl3make;
+   }
+b = t + nmax;
+c = b + nmax;
+d = c + nmax;
+for (i = 0; i < nx; ++i) s->x[i] = x[i];
+for (j = 0; j < ny; ++j) s->y[j] = y[j];
+for (k = 0; k < nz; ++k) s->z[k] = z[k];
+
+/* ---- Along x : a1[((p*ncx + i)*ny + j)*nz + k] ---- */
+for (j = 0; j < ny; ++j)
+   for (k = 0; k < nz; ++k)
+      {
+      for (i = 0; i < nx; ++i) t[i] = f[(i*ny + j)*nz + k];
+      spline (nx, 0, 0, 0.0, 0.0, x, t, b, c, d, flag);
+      if (*flag != 0) goto LeaveSpl3make;
+      for (i = 0; i < ncx; ++i)
+         {
+         a1[((0*ncx + i)*ny + j)*nz + k] = t[i];
+         a1[((1*ncx + i)*ny + j)*nz + k] = b[i];
+         a1[((2*ncx + i)*ny + j)*nz + k] = c[i];
+         a1[((3*ncx + i)*ny + j)*nz + k] = d[i];
+         }
+      }
+
+/* ---- Along y : a2[(((p*4 + q)*ncx + i)*ncy + j)*nz + k] ---- */
+for (p = 0; p < 4; ++p)
+   for (i = 0; i < ncx; ++i)
+      for (k = 0; k < nz; ++k)
+         {
+         for (j = 0; j < ny; ++j) t[j] = a1[((p*ncx + i)*ny + j)*nz + k];
+         spline (ny, 0, 0, 0.0, 0.0, y, t, b, c, d, flag);
+         if (*flag != 0) goto LeaveSpl3make;
+         for (j = 0; j < ncy; ++j)
+            {
+            a2[(((p*4 + 0)*ncx + i)*ncy + j)*nz + k] = t[j];
+            a2[(((p*4 + 1)*ncx + i)*ncy + j)*nz + k] = b[j];
+            a2[(((p*4 + 2)*ncx + i)*ncy + j)*nz + k] = c[j];
+            a2[(((p*4 + 3)*ncx + i)*ncy + j)*nz + k] = d[j];
+            }
+         }
+
+/* ---- Along z, into the cell blocks ---- */
+for (p = 0; p < 4; ++p)
+   for (q = 0; q < 4; ++q)
+      for (i = 0; i < ncx; ++i)
+         for (j = 0; j < ncy; ++j)
+            {
+            for (k = 0; k < nz; ++k)
+               t[k] = a2[(((p*4 + q)*ncx + i)*ncy + j)*nz + k];
+            spline (nz, 0, 0, 0.0, 0.0, z, t, b, c, d, flag);
+            if (*flag != 0) goto LeaveSpl3make;
+            for (k = 0; k < ncz; ++k)
+               {
+               cc    = s->coef + ((i*ncy + j)*ncz + k)*64 + p*16 + q*4;
+               cc[0] = t[k];
+               cc[1] = b[k];
+               cc[2] = c[k];
+               cc[3] = d[k];
+               }
+            }
+
+LeaveSpl3make:
+if (t  != NULL) { free(t);  t = NULL; }
+if (a2 != NULL) { free(a2); a2 = NULL; }
+if (a1 != NULL) { free(a1); a1 = NULL; }
+if (*flag != 0) spl3dest (s);
+return 0;
+}  /* end of spl3make() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int spl3dest (struct SPL3STRC *s)
+
+#else
+
+int spl3dest (s)
+
+struct SPL3STRC *s;
+
+#endif
+
+/* Purpose ...
+   -------
+   Release the memory held by a tricubic spline structure.
+*/
+
+{
+if (s->x    != NULL) { free(s->x);    s->x = NULL; }
+if (s->y    != NULL) { free(s->y);    s->y = NULL; }
+if (s->z    != NULL) { free(s->z);    s->z = NULL; }
+if (s->coef != NULL) { free(s->coef); s->coef = NULL; }
+return 0;
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+double spl3eval (double u, double v, double w, struct SPL3STRC *s,
+                 int *lastx, int *lasty, int *lastz)
+
+#else
+
+double spl3eval (u, v, w, s, lastx, lasty, lastz)
+
+double u, v, w;
+struct SPL3STRC *s;
+int    *lastx, *lasty, *lastz;
+
+#endif
+
+/* Purpose ...
+   -------
+   Evaluate the tricubic spline at (u, v, w).  The segment
+   searches start from lastx, lasty and lastz as in spl2eval().
+*/
+
+{
+int    i, j, k, p, q;
+double wx, wy, wz, r, rq, *cc;
+
+i  = tpseg (s->nx, s->x, u, lastx);
+j  = tpseg (s->ny, s->y, v, lasty);
+k  = tpseg (s->nz, s->z, w, lastz);
+wx = u - s->x[i];
+wy = v - s->y[j];
+wz = w - s->z[k];
+cc = s->coef + ((i*(s->ny - 1) + j)*(s->nz - 1) + k)*64;
+
+r = 0.0;
+for (p = 3; p >= 0; --p)
+   {
+   rq = 0.0;
+   for (q = 3; q >= 0; --q)
+      rq = rq * wy + (cc[p*16 + q*4] + wz * (cc[p*16 + q*4 + 1] +
+                      wz * (cc[p*16 + q*4 + 2] + wz * cc[p*16 + q*4 + 3])));
+   r = r * wx + rq;
+   }
+return (r);
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int spl3evalv (struct SPL3STRC *s, int n,
+               double u[], double v[], double w[], double f[])
+
+#else
+
+int spl3evalv (s, n, u, v, w, f)
+
+struct SPL3STRC *s;
+int    n;
+double u[], v[], w[], f[];
+
+#endif
+
+/* Purpose ...
+   -------
+   Evaluate the tricubic spline at the n points (u[k], v[k], w[k]),
+   returning the values in f[k].  As for spl2evalv(), the segment
+   searches start from those of the previous point.
+*/
+
+{
+int k, lastx, lasty, lastz;
+
+lastx = 0;
+lasty = 0;
+lastz = 0;
+for (k = 0; k < n; ++k)
+   f[k] = spl3eval (u[k], v[k], w[k], s, &lastx, &lasty, &lastz);
+return 0;
+}
+/*-------------------------------------------------------------------*/
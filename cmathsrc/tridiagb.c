@@ -0,0 +1,206 @@
+/* tridiagb.c
+   Timing driver for btridiag(), btrisolve() and tricr(). */
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+/* Purpose ...
+   -------
+   Time btridiag() and btrisolve() on a batch of tridiagonal
+   systems, and tricr() on one long system, against tridiag() and
+   trisolve(), for an increasing number of OpenMP threads.  The
+   times, the speedup and the largest error in the solutions are
+   reported.
+
+   Usage ...
+   -----
+   tridiagb.x [n [nbatch [nlong]]]
+   n      : order of each system in the batch (default 256)
+   nbatch : number of systems in the batch (default 4096)
+   nlong  : order of the long system (default 4000000)
+
+   Build ...
+   -----
+   make tridiagb.x  from the top directory, or
+   cc -O2 -fopenmp tridiagb.c btridiag.c tridiag.c cmathmsg.c -lm
+
+   Version ... 1.0, 19 October 2026
+   -------
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "cmath.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+static double seconds ()
+{
+#ifdef _OPENMP
+return (omp_get_wtime ());
+#else
+return ((double) clock () / CLOCKS_PER_SEC);
+#endif
+}
+
+int main (argc, argv)
+int  argc;
+char *argv[];
+{
+double *ld, *d, *ud, *x, *bld, *bd, *bud, *bx, t0, t1, t2, err;
+int    n, nbatch, nlong, nthr, maxthr, i, j, p, flag;
+
+n      = (argc > 1) ? atoi (argv[1]) : 256;
+nbatch = (argc > 2) ? atoi (argv[2]) : 4096;
+nlong  = (argc > 3) ? atoi (argv[3]) : 4000000;
+#ifdef _OPENMP
+maxthr = omp_get_max_threads ();
+#else
+maxthr = 1;
+#endif
+if (n < 3 || nbatch < 1 || nlong < 3)
+   {
+   printf ("usage : tridiagb [n [nbatch [nlong]]]\n");
+   return (1);
+   }
+
+i = (n * nbatch > nlong) ? n * nbatch : nlong;
+ld  = (double *) malloc (i * sizeof(double));
+d   = (double *) malloc (i * sizeof(double));
+ud  = (double *) malloc (i * sizeof(double));
+x   = (double *) malloc (i * sizeof(double));
+bld = (double *) malloc (i * sizeof(double));
+bd  = (double *) malloc (i * sizeof(double));
+bud = (double *) malloc (i * sizeof(double));
+bx  = (double *) malloc (i * sizeof(double));
+if (ld == NULL || d == NULL || ud == NULL || x == NULL ||
+    bld == NULL || bd == NULL || bud == NULL || bx == NULL)
+   {
+   printf ("could not allocate memory\n");
+   return (1);
+   }
+
+printf ("\n\n  --- CMATH --- Design Software 1989\n");
+printf ("\nTiming driver for the batched and cyclic reduction ");
+printf ("tridiagonal solvers\n");
+
+/* --- a batch of diagonally dominant systems, x[j] = 1 --- */
+srand (1);
+for (p = 0; p < nbatch; ++p)
+   for (j = 0; j < n; ++j)
+      {
+      i = p * n + j;
+      ld[i] = (double) rand () / RAND_MAX - 0.5;
+      ud[i] = (double) rand () / RAND_MAX - 0.5;
+      d[i]  = 2.0 + (double) rand () / RAND_MAX;
+      }
+
+printf ("\n%d systems of order %d\n", nbatch, n);
+printf ("threads   tridiag ms   btridiag ms   speedup   error\n");
+for (nthr = 1; nthr <= maxthr;
+     nthr = (nthr < maxthr && 2 * nthr > maxthr) ? maxthr : 2 * nthr)
+   {
+#ifdef _OPENMP
+   omp_set_num_threads (nthr);
+#endif
+   /* one system at a time, each held contiguously */
+   for (p = 0; p < nbatch; ++p)
+      for (j = 0; j < n; ++j)
+         {
+         i = p * n + j;
+         bld[i] = ld[i]; bd[i] = d[i]; bud[i] = ud[i];
+         bx[i] = d[i] + ((j > 0) ? ld[i] : 0.0) + ((j < n-1) ? ud[i] : 0.0);
+         }
+   t0 = seconds ();
+   for (p = 0; p < nbatch; ++p)
+      {
+      tridiag (n, bld + p * n, bd + p * n, bud + p * n, &flag);
+      trisolve (n, bld + p * n, bd + p * n, bud + p * n, bx + p * n, &flag);
+      }
+   t1 = seconds () - t0;
+
+   /* the batch, interleaved, against the solutions above */
+   for (p = 0; p < nbatch; ++p)
+      for (j = 0; j < n; ++j) x[j * nbatch + p] = bx[p * n + j];
+   for (p = 0; p < nbatch; ++p)
+      for (j = 0; j < n; ++j)
+         {
+         i = p * n + j;
+         bld[j * nbatch + p] = ld[i];
+         bd[j * nbatch + p]  = d[i];
+         bud[j * nbatch + p] = ud[i];
+         bx[j * nbatch + p]  = d[i] + ((j > 0) ? ld[i] : 0.0)
+                               + ((j < n-1) ? ud[i] : 0.0);
+         }
+   t0 = seconds ();
+   btridiag (n, nbatch, nbatch, bld, bd, bud, &flag);
+   btrisolve (n, nbatch, nbatch, bld, bd, bud, bx, &flag);
+   t2 = seconds () - t0;
+   if (flag != 0)
+      {
+      printf ("btrisolve : %s\n", cmathmsg (BTRISOLV_C, flag));
+      return (1);
+      }
+   err = 0.0;
+   for (i = 0; i < n * nbatch; ++i)
+      if (fabs (bx[i] - x[i]) > err) err = fabs (bx[i] - x[i]);
+
+   printf ("%5d   %10.2f   %11.2f   %7.2f   %8.1e\n", nthr,
+           t1 * 1.0e3, t2 * 1.0e3, t1 / t2, err);
+   }
+
+/* --- one long system --- */
+srand (2);
+for (i = 0; i < nlong; ++i)
+   {
+   ld[i] = (double) rand () / RAND_MAX - 0.5;
+   ud[i] = (double) rand () / RAND_MAX - 0.5;
+   d[i]  = 2.0 + (double) rand () / RAND_MAX;
+   }
+printf ("\none system of order %d\n", nlong);
+printf ("threads   tridiag ms   tricr ms   speedup   error\n");
+for (nthr = 1; nthr <= maxthr;
+     nthr = (nthr < maxthr && 2 * nthr > maxthr) ? maxthr : 2 * nthr)
+   {
+#ifdef _OPENMP
+   omp_set_num_threads (nthr);
+#endif
+   for (i = 0; i < nlong; ++i)
+      x[i] = d[i] + ((i > 0) ? ld[i] : 0.0) + ((i < nlong-1) ? ud[i] : 0.0);
+   t0 = seconds ();
+   tricr (nlong, ld, d, ud, x, &flag);
+   t2 = seconds () - t0;
+   if (flag != 0)
+      {
+      printf ("tricr : %s\n", cmathmsg (TRICR_C, flag));
+      return (1);
+      }
+   err = 0.0;
+   for (i = 0; i < nlong; ++i)
+      if (fabs (x[i] - 1.0) > err) err = fabs (x[i] - 1.0);
+
+   /* the serial baseline works on copies, as it overwrites them */
+   for (i = 0; i < nlong; ++i)
+      {
+      bld[i] = ld[i]; bd[i] = d[i]; bud[i] = ud[i];
+      bx[i] = d[i] + ((i > 0) ? ld[i] : 0.0) + ((i < nlong-1) ? ud[i] : 0.0);
+      }
+   t0 = seconds ();
+   tridiag (nlong, bld, bd, bud, &flag);
+   trisolve (nlong, bld, bd, bud, bx, &flag);
+   t1 = seconds () - t0;
+
+   printf ("%5d   %10.2f   %8.2f   %7.2f   %8.1e\n", nthr,
+           t1 * 1.0e3, t2 * 1.0e3, t1 / t2, err);
+   }
+
+free (bx); free (bud); free (bd); free (bld);
+free (x); free (ud); free (d); free (ld);
+return (0);
+}
@@ -0,0 +1,445 @@
+/* tsqr.c
+   Linear least squares for tall data, accumulated a block of rows
+   at a time (tall skinny QR).  */
+
+/************************************************/
+/*                                              */
+/*  CMATH.  Copyright (c) 1989 Design Software  */
+/*                                              */
+/************************************************/
+
+#include "cmath.h"
+#if (STDLIBH)
+#include <stdlib.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#ifndef NULL
+#define  NULL  0
+#endif
+
+#define  MAX(a,b)  (((a) > (b)) ? (a) : (b))
+
+/* When compiled for OpenMP (PARALLEL in cmath.h), a call to
+   tsqradd() with many rows splits them into as many as TSQR_NBLK
+   blocks, of at least TSQR_BROWS rows each.  The blocks are reduced
+   to triangular form by separate threads and the triangles are
+   then merged.  */
+#define  TSQR_NBLK   16
+#define  TSQR_BROWS  512
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+static void tsrow (int n1, double r[], double x[], int k0)
+
+#else
+
+static void tsrow (n1, r, x, k0)
+int    n1;
+double r[], x[];
+int    k0;
+
+#endif
+
+/* Purpose ...
+   -------
+   Rotate the row x (length n1, zero before element k0) into the
+   n1 by n1 upper triangle r, so that r(T).r grows by x.x(T).
+   x is destroyed.  The diagonal of r is kept non-negative.
+*/
+
+{
+int    j, k;
+double a, b, h, c, s, t, *rk;
+
+for (k = k0; k < n1; ++k)
+   {
+   if (x[k] == 0.0) continue;
+   rk = r + (long) k * n1;
+   a = fabs(rk[k]);
+   b = fabs(x[k]);
+   if (a > b)
+      h = a * sqrt(1.0 + (b / a) * (b / a));
+   else
+      h = b * sqrt(1.0 + (a / b) * (a / b));
+   c = rk[k] / h;
+   s = x[k] / h;
+   rk[k] = h;
+   for (j = k + 1; j < n1; ++j)
+      {
+      t = rk[j];
+      rk[j] = c * t + s * x[j];
+      x[j]  = c * x[j] - s * t;
+      }
+   }
+}
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int tsqrinit (int n, struct TSQR *ts, int *flag)
+
+#else
+
+int tsqrinit (n, ts, flag)
+int    n;
+struct TSQR *ts;
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Set up the accumulator for the linear least squares problem
+         minimize | A.c - y |
+   with n unknowns c and any number of rows, which are supplied a
+   block at a time to tsqradd().  The solution is found by
+   tsqrsolve().
+
+   Input ...
+   -----
+   n     : the number of unknowns, n >= 1
+
+   Output ...
+   ------
+   ts    : the accumulator, with no rows.  Release it with tsqrfree().
+   flag  : status indicator
+           = 0, normal return
+           = 1, could not allocate memory for workspace
+           = 2, illegal user input
+
+   Workspace ...
+   ---------
+   (n+1)*(n+2) doubles, and TSQR_NBLK*(n+1)*(n+2) more when compiled
+   for OpenMP.  This does not depend on the number of rows.
+
+   Version ... 1.0,  19 October 2026
+   -------
+*/
+
+{  /* begin tsqrinit() */
+int    n1, k;
+
+*flag = 0;
+if (ts == NULL)
+   {
+   *flag = 2;
+   return (0);
+   }
+ts->n = 0;
+ts->nrow = 0;
+ts->r = ts->x = ts->rb = (double *) NULL;
+if (n < 1)
+   {
+   *flag = 2;
+   return (0);
+   }
+
+n1 = n + 1;
+ts->n = n;
+ts->r = (double *) malloc ((long) n1 * n1 * sizeof(double));
+ts->x = (double *) malloc (n1 * sizeof(double));
+#if (PARALLEL)
+ts->rb = (double *) malloc ((long) TSQR_NBLK * n1 * (n1 + 1) * sizeof(double));
+if (ts->rb == NULL) *flag = 1;
+#endif
+if (ts->r == NULL || ts->x == NULL || *flag != 0)
+   {
+   *flag = 1;
+   tsqrfree (ts);
+   return (0);
+   }
+for (k = 0; k < n1 * n1; ++k) ts->r[k] = 0.0;
+return (0);
+}  /* end of tsqrinit() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int tsqradd (struct TSQR *ts, int nrow, int lda, double a[], int *flag)
+
+#else
+
+int tsqradd (ts, nrow, lda, a, flag)
+struct TSQR *ts;
+int    nrow, lda;
+double a[];
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Add a block of rows to the least squares problem held by ts.
+
+   Input ...
+   -----
+   ts    : the accumulator from tsqrinit()
+   nrow  : the number of rows in this block, nrow >= 0
+   lda   : the distance between rows in a, lda >= n+1
+   a     : the rows, each the n elements of A followed by the
+           element of y, a[i*lda + j] j = 0 ... n-1 for A,
+           a[i*lda + n] for y, i = 0 ... nrow-1.  a is not altered,
+           so it may be, for example, a memory-mapped file.
+
+   Output ...
+   ------
+   ts    : the triangular factor R of all the rows so far
+   flag  : status indicator
+           = 0, normal return
+           = 2, illegal user input
+
+   Version ... 1.0,  19 October 2026
+   -------
+
+   Notes ...
+   -----
+   (1) The (n+1) by (n+1) triangle R of the rows [A y] is kept, with
+       R(T).R = [A y](T).[A y].  Each row is rotated into R by plane
+       rotations, about 3 (n+1)^2 operations, with unit stride.
+   (2) When compiled for OpenMP and nrow is at least twice
+       max(TSQR_BROWS, 8(n+1)), the rows are split into blocks that
+       are reduced by separate threads, and the block triangles are
+       then rotated into R.
+*/
+
+{  /* begin tsqradd() */
+int    n1, i, j, b, nblk, i0, i1;
+double *rb, *x, *xb;
+
+*flag = 0;
+if (ts == NULL || ts->r == NULL || nrow < 0 ||
+    (nrow > 0 && (a == NULL || lda < ts->n + 1)))
+   {
+   *flag = 2;
+   return (0);
+   }
+n1 = ts->n + 1;
+x  = ts->x;
+
+nblk = 1;
+#if (PARALLEL)
+nblk = nrow / MAX(TSQR_BROWS, 8 * n1);
+if (nblk > TSQR_NBLK) nblk = TSQR_NBLK;
+#endif
+
+if (nblk <= 1)
+   {
+   for (i = 0; i < nrow; ++i)
+      {
+      for (j = 0; j < n1; ++j) x[j] = a[(long) i * lda + j];
+      tsrow (n1, ts->r, x, 0);
+      }
+   }
+else
+   {
+   /* Each block of rows into its own triangle, followed in ts->rb
+      by a scratch row, then the triangles into R. */
+#if (PARALLEL)
+#pragma omp parallel for schedule(static) private(rb, xb, i0, i1, i, j)
+#endif
+   for (b = 0; b < nblk; ++b)
+      {
+      rb = ts->rb + (long) b * n1 * (n1 + 1);
+      xb = rb + (long) n1 * n1;
+      for (j = 0; j < n1 * n1; ++j) rb[j] = 0.0;
+      i0 = (int) ((long) nrow * b / nblk);
+      i1 = (int) ((long) nrow * (b + 1) / nblk);
+      for (i = i0; i < i1; ++i)
+         {
+         for (j = 0; j < n1; ++j) xb[j] = a[(long) i * lda + j];
+         tsrow (n1, rb, xb, 0);
+         }
+      }
+   for (b = 0; b < nblk; ++b)
+      {
+      rb = ts->rb + (long) b * n1 * (n1 + 1);
+      for (i = 0; i < n1; ++i)
+         {
+         for (j = i; j < n1; ++j) x[j] = rb[(long) i * n1 + j];
+         tsrow (n1, ts->r, x, i);
+         }
+      }
+   }
+
+ts->nrow += nrow;
+return (0);
+}  /* end of tsqradd() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int tsqrsolve (struct TSQR *ts, double relerr, double c[],
+               double *resid, int *flag)
+
+#else
+
+int tsqrsolve (ts, relerr, c, resid, flag)
+struct TSQR *ts;
+double relerr, c[], *resid;
+int    *flag;
+
+#endif
+
+/* Purpose ...
+   -------
+   Solve the least squares problem accumulated in ts by tsqradd().
+
+   Input ...
+   -----
+   ts     : the accumulator
+   relerr : relative error of the data; singular values of R below
+            relerr times the largest are ignored, as in lsp().
+            relerr is taken as at least n * 1.0e-16.
+
+   Output ...
+   ------
+   c      : the n unknowns, c[0] ... c[n-1]
+   resid  : the square root of the sum of the squares of the
+            residuals, | A.c - y |
+   flag   : status indicator
+            = 0, normal return
+            = 1, could not allocate memory for workspace
+            = 2, illegal user input
+            = 3, svd() failed to converge
+
+   Workspace ...
+   ---------
+   3 n*n + n doubles are allocated.
+
+   Version ... 1.0,  19 October 2026
+   -------
+
+   Notes ...
+   -----
+   (1) With R = [R11 r; 0 rho], the problem is R11.c = r, which is
+       solved with svd() and svdsolve().  Then
+       | A.c - y |^2 = | R11.c - r |^2 + rho^2.
+   (2) ts is not changed; more rows may be added and the problem
+       solved again.
+*/
+
+{  /* begin tsqrsolve() */
+int    n, n1, i, j, ierr;
+double *r11, *u, *v, *sigma, *rhs, sigmax, t, s;
+
+*flag = 0;
+r11 = u = v = sigma = (double *) NULL;
+if (ts == NULL || ts->r == NULL || c == NULL || resid == NULL)
+   {
+   *flag = 2;
+   return (0);
+   }
+n  = ts->n;
+n1 = n + 1;
+
+if (n == 1)
+   {
+   /* A single unknown: R = [t s; 0 rho]. */
+   t = ts->r[0];
+   s = ts->r[1];
+   if (t > 0.0)
+      {
+      c[0] = s / t;
+      *resid = fabs(ts->r[3]);
+      }
+   else
+      {
+      c[0] = 0.0;
+      *resid = sqrt(s * s + ts->r[3] * ts->r[3]);
+      }
+   return (0);
+   }
+
+r11   = (double *) malloc ((long) n * n * sizeof(double));
+u     = (double *) malloc ((long) n * n * sizeof(double));
+v     = (double *) malloc ((long) n * n * sizeof(double));
+sigma = (double *) malloc (2 * n * sizeof(double));
+if (r11 == NULL || u == NULL || v == NULL || sigma == NULL)
+   {
+   *flag = 1;
+   goto LeaveTsqrsolve;
+   }
+rhs = sigma + n;
+
+for (i = 0; i < n; ++i)
+   {
+   for (j = 0; j < n; ++j) r11[i * n + j] = ts->r[(long) i * n1 + j];
+   rhs[i] = ts->r[(long) i * n1 + n];
+   }
+
+svd (n, n, n, r11, sigma, 1, u, 1, v, &ierr);
+if (ierr != 0)
+   {
+   *flag = (ierr == -1) ? 1 : 3;
+   goto LeaveTsqrsolve;
+   }
+
+sigmax = 0.0;
+for (j = 0; j < n; ++j) if (sigma[j] > sigmax) sigmax = sigma[j];
+t = n * 1.0e-16;
+relerr = MAX(fabs(relerr), t);
+if (sigmax == 0.0) sigmax = 1.0;
+
+svdsolve (n, n, n, u, sigma, v, rhs, c, relerr * sigmax, &ierr);
+if (ierr != 0)
+   {
+   *flag = (ierr == -1) ? 1 : 2;
+   goto LeaveTsqrsolve;
+   }
+
+/* The residual, from the triangle. */
+s = ts->r[(long) n * n1 + n];
+s = s * s;
+for (i = 0; i < n; ++i)
+   {
+   t = -rhs[i];
+   for (j = i; j < n; ++j) t += ts->r[(long) i * n1 + j] * c[j];
+   s += t * t;
+   }
+*resid = sqrt(s);
+
+LeaveTsqrsolve:
+if (sigma != NULL) free (sigma);
+if (v   != NULL) free (v);
+if (u   != NULL) free (u);
+if (r11 != NULL) free (r11);
+return (0);
+}  /* end of tsqrsolve() */
+
+/*-----------------------------------------------------------------*/
+
+#if (PROTOTYPE)
+
+int tsqrfree (struct TSQR *ts)
+
+#else
+
+int tsqrfree (ts)
+struct TSQR *ts;
+
+#endif
+
+/* Purpose ...
+   -------
+   Release the storage of an accumulator from tsqrinit().
+*/
+
+{  /* begin tsqrfree() */
+if (ts == NULL) return (0);
+if (ts->rb != NULL) free (ts->rb);
+if (ts->x  != NULL) free (ts->x);
+if (ts->r  != NULL) free (ts->r);
+ts->r = ts->x = ts->rb = (double *) NULL;
+ts->n = 0;
+ts->nrow = 0;
+return (0);
+}  /* end of tsqrfree() */
+
+/*-----------------------------------------------------------------*/